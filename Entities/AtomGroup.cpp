@@ -368,7 +368,11 @@ namespace RTE {
 		HitData hitData;
 
 		// Thread locals for performance (avoid memory allocs)
-		thread_local std::unordered_map<MOID, std::vector<Atom *>> hitMOAtoms;
+		thread_local RotatedAtomOffsets rotatedOffsets;
+		thread_local std::vector<float> angularTravelsX;
+		thread_local std::vector<float> angularTravelsY;
+		// Only a handful of MOs get hit on any one step, so pairs of MOID and Atom in a flat vector, grouped by MOID when responding, are cheaper than a map of vectors.
+		thread_local std::vector<std::pair<MOID, Atom *>> hitMOAtoms;
 		hitMOAtoms.clear();
 		thread_local std::vector<Atom *> hitTerrAtoms;
 		hitTerrAtoms.clear();
@@ -382,9 +386,14 @@ namespace RTE {
 
 		// Loop for all the different straight segments (between bounces etc) that have to be traveled during the travelTime.
 		do {
+			// The rotation doesn't change until the segment is traveled, so the Atom offsets only need rotating once for both the setup passes below.
+			RotateAtomOffsets(rotatedOffsets);
+			const std::size_t atomCount = m_Atoms.size();
+
 			// First see what Atoms are inside either the terrain or another MO, and cause collisions responses before even starting the segment
-			for (Atom *atom : m_Atoms) {
-				const Vector startOff = m_OwnerMOSR->RotateOffset(atom->GetOffset());
+			for (std::size_t atomIndex = 0; atomIndex < atomCount; ++atomIndex) {
+				Atom *atom = m_Atoms[atomIndex];
+				const Vector startOff(rotatedOffsets.X[atomIndex], rotatedOffsets.Y[atomIndex]);
 
 				if (atom->SetupPos(position + startOff)) {
 					hitData.Reset();
@@ -454,13 +463,24 @@ namespace RTE {
 				break;
 			}
 
-			for (Atom *atom : m_Atoms) {
-				// Calculate the segment trajectory for each individual Atom, with rotations considered.
-				const Vector startOff = m_OwnerMOSR->RotateOffset(atom->GetOffset());
-				const Vector trajFromAngularTravel = Vector(startOff).RadRotate(rotDelta) - startOff;
+			// Calculate the trajectory each individual Atom travels due to the rotation over the segment, working out the rotation once for all of them. Same as Vector::RadRotate on each offset.
+			angularTravelsX.resize(atomCount);
+			angularTravelsY.resize(atomCount);
+			const float segRotCos = std::cos(-rotDelta);
+			const float segRotSin = std::sin(-rotDelta);
+			for (std::size_t atomIndex = 0; atomIndex < atomCount; ++atomIndex) {
+				const float startOffX = rotatedOffsets.X[atomIndex];
+				const float startOffY = rotatedOffsets.Y[atomIndex];
+				angularTravelsX[atomIndex] = (startOffX * segRotCos - startOffY * segRotSin) - startOffX;
+				angularTravelsY[atomIndex] = (startOffX * segRotSin + startOffY * segRotCos) - startOffY;
+			}
+
+			for (std::size_t atomIndex = 0; atomIndex < atomCount; ++atomIndex) {
+				Atom *atom = m_Atoms[atomIndex];
+				const Vector startOff(rotatedOffsets.X[atomIndex], rotatedOffsets.Y[atomIndex]);
 
 				// Set up the initial rasterized step for each Atom and save the longest trajectory.
-				if (atom->SetupSeg(position + startOff, linSegTraj + trajFromAngularTravel) > stepsOnSeg) { stepsOnSeg = atom->GetStepsLeft(); }
+				if (atom->SetupSeg(position + startOff, linSegTraj + Vector(angularTravelsX[atomIndex], angularTravelsY[atomIndex])) > stepsOnSeg) { stepsOnSeg = atom->GetStepsLeft(); }
 			}
 
 			for (Atom *atom : m_Atoms) {
@@ -497,7 +517,7 @@ namespace RTE {
 								MovableObject *moCollidedWith = g_MovableMan.GetMOFromID(tempMOID);
 								if (moCollidedWith && moCollidedWith->HitWhatMOID() == g_NoMOID) { moCollidedWith->SetHitWhatMOID(m_OwnerMOSR->m_MOID); }
 
-								hitMOAtoms[tempMOID].push_back(atom);
+								hitMOAtoms.emplace_back(tempMOID, atom);
 
 								// Add the hit MO to the ignore list of ignored MOIDs
 								//AddMOIDToIgnore(tempMOID);
@@ -665,11 +685,18 @@ namespace RTE {
 					hitData.MomInertia[HITOR] = m_MomentOfInertia;
 					hitData.ImpulseFactor[HITOR] = 1.0F / static_cast<float>(atomsHitMOsCount);
 
-					for (auto &MOAtomMapEntry : hitMOAtoms) {
+					// Group the Atoms by the MO they hit, keeping the order they hit in within each group.
+					std::stable_sort(hitMOAtoms.begin(), hitMOAtoms.end(), [](const std::pair<MOID, Atom *> &lhs, const std::pair<MOID, Atom *> &rhs) { return lhs.first < rhs.first; });
+
+					for (auto hitMOGroupStart = hitMOAtoms.begin(); hitMOGroupStart != hitMOAtoms.end(); ) {
+						const MOID hitMOID = hitMOGroupStart->first;
+						const auto hitMOGroupEnd = std::find_if(hitMOGroupStart, hitMOAtoms.end(), [hitMOID](const std::pair<MOID, Atom *> &hitMOAtomEntry) { return hitMOAtomEntry.first != hitMOID; });
+
 						// The denominator that the MovableObject being hit should divide its mass with for each Atom of this AtomGroup that is colliding with it during this step.
-						hitData.ImpulseFactor[HITEE] = 1.0F / static_cast<float>(MOAtomMapEntry.second.size());
+						hitData.ImpulseFactor[HITEE] = 1.0F / static_cast<float>(std::distance(hitMOGroupStart, hitMOGroupEnd));
 
-						for (Atom *hitMOAtom : MOAtomMapEntry.second) {
+						for (; hitMOGroupStart != hitMOGroupEnd; ++hitMOGroupStart) {
+							Atom *hitMOAtom = hitMOGroupStart->second;
 							// Step back all Atoms that hit MOs during this step iteration. This is so we aren't intersecting the hit MO anymore.
 							hitMOAtom->StepBack();
 							//hitData.HitPoint = hitMOAtom->GetCurrentPos();
@@ -1837,4 +1864,35 @@ namespace RTE {
 		atomToAdd->SetIgnoreMOIDsByGroup(&m_IgnoreMOIDs);
 		m_Atoms.push_back(atomToAdd);
 	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void AtomGroup::RotateAtomOffsets(RotatedAtomOffsets &rotatedOffsets) const {
+		const std::size_t atomCount = m_Atoms.size();
+		rotatedOffsets.X.resize(atomCount);
+		rotatedOffsets.Y.resize(atomCount);
+		float *offsetsX = rotatedOffsets.X.data();
+		float *offsetsY = rotatedOffsets.Y.data();
+
+		for (std::size_t atomIndex = 0; atomIndex < atomCount; ++atomIndex) {
+			const Vector &atomOffset = m_Atoms[atomIndex]->GetOffset();
+			offsetsX[atomIndex] = atomOffset.GetX();
+			offsetsY[atomIndex] = atomOffset.GetY();
+		}
+
+		// Flipping and rotating are both linear, so the owner's rotated unit vectors are the columns every offset gets transformed by. This gives the same results as RotateOffset on each offset.
+		const Vector rotatedUnitX = m_OwnerMOSR->RotateOffset(Vector(1.0F, 0.0F));
+		const Vector rotatedUnitY = m_OwnerMOSR->RotateOffset(Vector(0.0F, 1.0F));
+		const float xToX = rotatedUnitX.GetX();
+		const float xToY = rotatedUnitX.GetY();
+		const float yToX = rotatedUnitY.GetX();
+		const float yToY = rotatedUnitY.GetY();
+
+		for (std::size_t atomIndex = 0; atomIndex < atomCount; ++atomIndex) {
+			const float offsetX = offsetsX[atomIndex];
+			const float offsetY = offsetsY[atomIndex];
+			offsetsX[atomIndex] = offsetX * xToX + offsetY * yToX;
+			offsetsY[atomIndex] = offsetX * xToY + offsetY * yToY;
+		}
+	}
 }
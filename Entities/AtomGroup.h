@@ -381,8 +381,8 @@ namespace RTE {
 
 		static Entity::ClassInfo m_sClass; //!< ClassInfo for this class.
 
-		// TODO: It's probably worth trying out changing this from a list to a vector. m_Atoms is iterated over often and we could probably get some big gainz by doing this swap.
-		// The downside is anytime attachables with atoms get added we may have the cost of resizing the vector but that's an uncommon use case while iterating over atoms happens multiple times per frame.
+		// The Atoms are kept as pointers rather than inline, because m_SubGroups, Attachables and Legs all hold on to them and they have to stay put when Atoms are added or removed.
+		// Hot loops that only need the Atom offsets work on them gathered into flat arrays instead, see RotateAtomOffsets.
 		std::vector<Atom *> m_Atoms; //!< List of Atoms that constitute the group. Owned by this.
 		std::unordered_map<long, std::vector<Atom *>> m_SubGroups; //!< Sub groupings of Atoms. Points to Atoms owned in m_Atoms. Not owned.
 
@@ -433,6 +433,23 @@ namespace RTE {
 		void AddAtomToGroup(MOSRotating *ownerMOSRotating, const Vector &spriteOffset, int x, int y, bool calcNormal);
 #pragma endregion
 
+#pragma region Travel Breakdown
+		/// <summary>
+		/// The offsets of all the Atoms of an AtomGroup rotated by the owner's rotation and flipping, kept as separate arrays of X and Y components so they can be worked on in vectorized loops.
+		/// </summary>
+		struct RotatedAtomOffsets {
+			std::vector<float> X; //!< The X components of the rotated offsets, in the same order as m_Atoms.
+			std::vector<float> Y; //!< The Y components of the rotated offsets, in the same order as m_Atoms.
+		};
+
+		/// <summary>
+		/// Rotates the offsets of all the Atoms of this AtomGroup by the owner MOSRotating's current rotation and flipping, as one batch.
+		/// The rotation is worked out once for the whole batch instead of once per Atom.
+		/// </summary>
+		/// <param name="rotatedOffsets">The RotatedAtomOffsets to fill. Resized to hold one offset per Atom.</param>
+		void RotateAtomOffsets(RotatedAtomOffsets &rotatedOffsets) const;
+#pragma endregion
+
 		/// <summary>
 		/// Clears all the member variables of this AtomGroup, effectively resetting the members of this abstraction level only.
 		/// </summary>
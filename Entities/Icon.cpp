@@ -43,7 +43,10 @@ namespace RTE {
 	int Icon::ReadProperty(const std::string_view &propName, Reader &reader) {
 		StartPropertyList(return Entity::ReadProperty(propName, reader));
 		
-		MatchProperty("BitmapFile", { reader >> m_BitmapFile; });
+		MatchProperty("BitmapFile", {
+			reader >> m_BitmapFile;
+			m_BitmapFile.QueueImageDecode();
+		});
 		MatchProperty("FrameCount", { reader >> m_FrameCount; });
 
 		EndPropertyList;
@@ -3,6 +3,7 @@
 #include "Atom.h"
 #include "PostProcessMan.h"
 #include "FrameMan.h"
+#include "SpatialPartitionGrid.h"
 
 namespace RTE {
 
@@ -18,6 +19,8 @@ namespace RTE {
 		m_MaxLethalRange = 1;
 		m_LethalSharpness = 1;
 		m_Staininess = 0;
+		m_BulkSimulationAllowed = true;
+		m_OccupancyMarkedPos.Reset();
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -155,6 +158,13 @@ namespace RTE {
 		return m_Pos.GetFloorIntX() == pixelX && m_Pos.GetFloorIntY() == pixelY;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void MOPixel::MarkOccupancy(SpatialPartitionGrid &grid) const {
+		m_OccupancyMarkedPos = m_Pos;
+		grid.MarkOccupiedBox(m_Pos.GetFloorIntX(), m_Pos.GetFloorIntY(), m_Pos.GetFloorIntX(), m_Pos.GetFloorIntY());
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void MOPixel::Travel() {
@@ -179,6 +189,12 @@ namespace RTE {
 		m_Atom->ClearMOIDIgnoreList();
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool MOPixel::CanTravelConcurrently() const {
+		return m_PinStrength || IsTooFast() || m_Atom->IsTravelPathClear(g_TimerMan.GetDeltaTimeSecs());
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	bool MOPixel::CollideAtPoint(HitData &hd) {
@@ -11,6 +11,7 @@ namespace RTE {
 	/// A movable object with mass that is graphically represented by a single pixel.
 	/// </summary>
 	class MOPixel : public MovableObject {
+		friend class PixelParticleSystem;
 
 	public:
 
@@ -152,6 +153,18 @@ namespace RTE {
 		/// <param name="staininess">The new staininess value.</param>
 		void SetStaininess(float staininess) { m_Staininess = staininess; }
 
+		/// <summary>
+		/// Gets whether this MOPixel may be handed over to MovableMan's PixelParticleSystem while it's flying freely, during which its state isn't kept up to date.
+		/// </summary>
+		/// <returns>Whether this MOPixel may be simulated in bulk.</returns>
+		bool IsBulkSimulationAllowed() const { return m_BulkSimulationAllowed; }
+
+		/// <summary>
+		/// Sets whether this MOPixel may be handed over to MovableMan's PixelParticleSystem while it's flying freely. Should be disabled for MOPixels something holds on to and reads from after adding them.
+		/// </summary>
+		/// <param name="allowBulkSimulation">Whether this MOPixel may be simulated in bulk.</param>
+		void SetBulkSimulationAllowed(bool allowBulkSimulation) { m_BulkSimulationAllowed = allowBulkSimulation; }
+
 		/// <summary>
 		/// Whether a set of X, Y coordinates overlap us (in world space).
 		/// </summary>
@@ -159,6 +172,18 @@ namespace RTE {
 		/// <param name="pixelY">The given Y coordinate, in world space.</param>
 		/// <returns>Whether the given coordinate overlap us.</returns>
 		bool HitTestAtPixel(int pixelX, int pixelY) const override;
+
+		/// <summary>
+		/// Marks the Scene pixel this could currently be hit at by HitTestAtPixel as occupied in the occupancy masks of the given SpatialPartitionGrid, and remembers where this was when doing so.
+		/// </summary>
+		/// <param name="grid">The SpatialPartitionGrid to mark the pixel in.</param>
+		void MarkOccupancy(SpatialPartitionGrid &grid) const override;
+
+		/// <summary>
+		/// Gets whether this is still where it was when it was last marked with MarkOccupancy, meaning the occupancy masks still cover the pixel it can be hit at.
+		/// </summary>
+		/// <returns>Whether the occupancy masks this was last marked in are still current for this.</returns>
+		bool IsOccupancyMaskCurrent() const override { return m_OccupancyMarkedPos == m_Pos; }
 #pragma endregion
 
 #pragma region Virtual Override Methods
@@ -167,6 +192,18 @@ namespace RTE {
 		/// </summary>
 		void Travel() override;
 
+		/// <summary>
+		/// Gets whether this type of MovableObject can have ApplyForces(), PreTravel() and Travel() run on a worker thread, concurrently with other MovableObjects.
+		/// </summary>
+		/// <returns>Whether this MovableObject supports concurrent travel.</returns>
+		bool SupportsConcurrentTravel() const override { return true; }
+
+		/// <summary>
+		/// Gets whether the upcoming Travel() of this MOPixel won't collide with anything, so it can safely run concurrently with other MovableObjects. ApplyForces() and PreTravel() must have been called first.
+		/// </summary>
+		/// <returns>Whether this MOPixel can travel concurrently this frame.</returns>
+		bool CanTravelConcurrently() const override;
+
 		/// <summary>
 		/// Calculates the collision response when another MO's Atom collides with this MO's physical representation.
 		/// The effects will be applied directly to this MO, and also represented in the passed in HitData.
@@ -221,6 +258,8 @@ namespace RTE {
 		float m_MaxLethalRange; //!< Upper bound multiplier for setting LethalRange at random. By default, 1.0 equals one screen.
 		float m_LethalSharpness; //!< When Sharpness has decreased below this threshold the MO becomes m_HitsMOs = false. Default is Sharpness * 0.5.
 		float m_Staininess; //!< How likely a pixel is to stain a surface when it collides with it. Defaults to 0 (never stain).
+		bool m_BulkSimulationAllowed; //!< Whether this MOPixel may be handed over to MovableMan's PixelParticleSystem while it's flying freely.
+		mutable Vector m_OccupancyMarkedPos; //!< The position this MOPixel was at when it was last marked in a SpatialPartitionGrid's occupancy masks.
 
 	private:
 
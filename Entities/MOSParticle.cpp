@@ -149,6 +149,12 @@ namespace RTE {
 		}
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool MOSParticle::CanTravelConcurrently() const {
+		return m_PinStrength || IsTooFast() || m_Atom->IsTravelPathClear(g_TimerMan.GetDeltaTimeSecs());
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void MOSParticle::Update() {
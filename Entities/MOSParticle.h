@@ -103,6 +103,18 @@ namespace RTE {
 		/// </summary>
 		void Travel() override;
 
+		/// <summary>
+		/// Gets whether this type of MovableObject can have ApplyForces(), PreTravel() and Travel() run on a worker thread, concurrently with other MovableObjects.
+		/// </summary>
+		/// <returns>Whether this MovableObject supports concurrent travel.</returns>
+		bool SupportsConcurrentTravel() const override { return true; }
+
+		/// <summary>
+		/// Gets whether the upcoming Travel() of this MOSParticle won't collide with anything, so it can safely run concurrently with other MovableObjects. ApplyForces() and PreTravel() must have been called first.
+		/// </summary>
+		/// <returns>Whether this MOSParticle can travel concurrently this frame.</returns>
+		bool CanTravelConcurrently() const override;
+
 		/// <summary>
 		/// Calculates the collision response when another MO's Atom collides with this MO's physical representation. 
 		/// The effects will be applied directly to this MO, and also represented in the passed in HitData.
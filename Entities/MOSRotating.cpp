@@ -1058,11 +1058,17 @@ void MOSRotating::CreateGibsWhenGibbing(const Vector &impactImpulse, MovableObje
         g_CameraMan.AddScreenShake(m_GibScreenShakeAmount, m_Pos);
     }
 
+    // All gib particles are cloned in batches per Gib and handed to MovableMan in one go at the end, instead of going through the pool and MovableMan's locks once per particle.
+    std::vector<Entity *> gibParticleClones;
+    std::vector<MovableObject *> gibParticlesToAdd;
+
     for (const Gib &gibSettingsObject : m_Gibs) {
-        if (gibSettingsObject.GetCount() == 0) {
+        if (gibSettingsObject.GetCount() <= 0) {
             continue;
         }
-        MovableObject *gibParticleClone = dynamic_cast<MovableObject *>(gibSettingsObject.GetParticlePreset()->Clone());
+        gibParticleClones.clear();
+        gibSettingsObject.GetParticlePreset()->CloneBatch(gibParticleClones, gibSettingsObject.GetCount());
+        MovableObject *gibParticleClone = static_cast<MovableObject *>(gibParticleClones.front());
 
 		int count = gibSettingsObject.GetCount();
 		float lifeVariation = gibSettingsObject.GetLifeVariation();
@@ -1096,7 +1102,7 @@ void MOSRotating::CreateGibsWhenGibbing(const Vector &impactImpulse, MovableObje
 			float goldenAngle = 2.39996F;
 
 			for (int i = 0; i < count; i++) {
-				if (i > 0) { gibParticleClone = dynamic_cast<MovableObject *>(gibSettingsObject.GetParticlePreset()->Clone()); }
+				gibParticleClone = static_cast<MovableObject *>(gibParticleClones[i]);
 
 				float radius = std::sqrt(static_cast<float>(count - i));
 				gibParticleClone->SetPos(m_Pos + rotatedGibOffset);
@@ -1115,11 +1121,11 @@ void MOSRotating::CreateGibsWhenGibbing(const Vector &impactImpulse, MovableObje
 					gibParticleClone->SetIgnoresTeamHits(true);
 				}
 
-				g_MovableMan.AddParticle(gibParticleClone);
+				gibParticlesToAdd.push_back(gibParticleClone);
 			}
 		} else {
 			for (int i = 0; i < count; i++) {
-				if (i > 0) { gibParticleClone = dynamic_cast<MovableObject *>(gibSettingsObject.GetParticlePreset()->Clone()); }
+				gibParticleClone = static_cast<MovableObject *>(gibParticleClones[i]);
 
 				if (gibParticleClone->GetLifetime() != 0) {
 					gibParticleClone->SetLifetime(std::max(static_cast<int>(static_cast<float>(gibParticleClone->GetLifetime()) * (1.0F + (lifeVariation * RandomNormalNum()))), 1));
@@ -1162,10 +1168,11 @@ void MOSRotating::CreateGibsWhenGibbing(const Vector &impactImpulse, MovableObje
 					gibParticleClone->SetIgnoresTeamHits(true);
 				}
 
-				g_MovableMan.AddParticle(gibParticleClone);
+				gibParticlesToAdd.push_back(gibParticleClone);
 			}
 		}
     }
+    g_MovableMan.AddParticles(gibParticlesToAdd);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -15,6 +15,7 @@
 
 #include "AEmitter.h"
 #include "PresetMan.h"
+#include "SpatialPartitionGrid.h"
 
 namespace RTE {
 
@@ -51,6 +52,10 @@ void MOSprite::Clear()
     m_SettleMaterialDisabled = false;
     m_pEntryWound = 0;
     m_pExitWound = 0;
+	m_OccupancyMarkedPos.Reset();
+	m_OccupancyMarkedRotAngle = 0;
+	m_OccupancyMarkedFrame = 0;
+	m_OccupancyMarkedHFlipped = false;
 }
 
 
@@ -167,7 +172,10 @@ int MOSprite::Create(const MOSprite &reference)
 int MOSprite::ReadProperty(const std::string_view &propName, Reader &reader) {
 	StartPropertyList(return MovableObject::ReadProperty(propName, reader));
     
-    MatchProperty("SpriteFile", { reader >> m_SpriteFile; });
+	MatchProperty("SpriteFile", {
+		reader >> m_SpriteFile;
+		m_SpriteFile.QueueImageDecode();
+	});
 	MatchProperty("IconFile", {
 		reader >> m_IconFile;
 		m_GraphicalIcon = m_IconFile.GetAsBitmap();
@@ -327,6 +335,34 @@ bool MOSprite::HitTestAtPixel(int pixelX, int pixelY) const {
     return is_inside_bitmap(sprite, localX, localY, 0) && _getpixel(sprite, localX, localY) != ColorKeys::g_MaskColor;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void MOSprite::MarkOccupancy(SpatialPartitionGrid &grid) const {
+    m_OccupancyMarkedPos = m_Pos;
+    m_OccupancyMarkedRotAngle = m_Rotation.GetRadAngle();
+    m_OccupancyMarkedFrame = m_Frame;
+    m_OccupancyMarkedHFlipped = m_HFlipped;
+
+    // HitTestAtPixel maps Scene pixels into the sprite, so map the sprite's corners the opposite way and mark their bounds, clamped to the sprite radius it also checks against.
+    // Mirroring that (rotated and flipped, but unscaled) mapping exactly is what makes it safe to skip the hit test for any pixel left unmarked.
+    const BITMAP *sprite = m_aSprite[m_Frame];
+    const std::array<Vector, 4> spriteCorners = { Vector(0, 0), Vector(static_cast<float>(sprite->w), 0), Vector(0, static_cast<float>(sprite->h)), Vector(static_cast<float>(sprite->w), static_cast<float>(sprite->h)) };
+
+    Vector boundsMin(m_SpriteRadius, m_SpriteRadius);
+    Vector boundsMax(-m_SpriteRadius, -m_SpriteRadius);
+    for (const Vector &spriteCorner : spriteCorners) {
+        // Undo the division in HitTestAtPixel. Matrix flipping is applied before rotating either way, so it has to be undone after rotating here.
+        Vector cornerOffset = Matrix(m_Rotation.GetRadAngle()) * (spriteCorner + m_SpriteOffset).GetXFlipped(m_HFlipped);
+        cornerOffset.SetXY(m_Rotation.GetXFlipped() ? -cornerOffset.m_X : cornerOffset.m_X, m_Rotation.GetYFlipped() ? -cornerOffset.m_Y : cornerOffset.m_Y);
+        boundsMin.SetXY(std::min(boundsMin.m_X, cornerOffset.m_X), std::min(boundsMin.m_Y, cornerOffset.m_Y));
+        boundsMax.SetXY(std::max(boundsMax.m_X, cornerOffset.m_X), std::max(boundsMax.m_Y, cornerOffset.m_Y));
+    }
+    boundsMin.SetXY(std::max(boundsMin.m_X, -m_SpriteRadius), std::max(boundsMin.m_Y, -m_SpriteRadius));
+    boundsMax.SetXY(std::min(boundsMax.m_X, m_SpriteRadius), std::min(boundsMax.m_Y, m_SpriteRadius));
+
+    grid.MarkOccupiedBox(static_cast<int>(std::floor(m_Pos.m_X + boundsMin.m_X)), static_cast<int>(std::floor(m_Pos.m_Y + boundsMin.m_Y)), static_cast<int>(std::ceil(m_Pos.m_X + boundsMax.m_X)), static_cast<int>(std::ceil(m_Pos.m_Y + boundsMax.m_Y)));
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          SetFrame
 //////////////////////////////////////////////////////////////////////////////////////////
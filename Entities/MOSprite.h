@@ -264,6 +264,18 @@ public:
     /// <returns>Whether the given coordinate overlap us.</returns>
     bool HitTestAtPixel(int pixelX, int pixelY) const override;
 
+    /// <summary>
+    /// Marks every Scene pixel this could currently be hit at by HitTestAtPixel as occupied in the occupancy masks of the given SpatialPartitionGrid, and remembers the state this was in when doing so.
+    /// </summary>
+    /// <param name="grid">The SpatialPartitionGrid to mark pixels in.</param>
+    void MarkOccupancy(SpatialPartitionGrid &grid) const override;
+
+    /// <summary>
+    /// Gets whether this is still in the state it was in when it was last marked with MarkOccupancy, meaning the occupancy masks still cover every pixel it can be hit at.
+    /// </summary>
+    /// <returns>Whether the occupancy masks this was last marked in are still current for this.</returns>
+    bool IsOccupancyMaskCurrent() const override { return m_OccupancyMarkedPos == m_Pos && m_OccupancyMarkedRotAngle == m_Rotation.GetRadAngle() && m_OccupancyMarkedFrame == m_Frame && m_OccupancyMarkedHFlipped == m_HFlipped; }
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetAngularVel
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -605,6 +617,11 @@ protected:
     // Exit wound template
     const AEmitter *m_pExitWound;
 
+	mutable Vector m_OccupancyMarkedPos; //!< The position this was at when it was last marked in a SpatialPartitionGrid's occupancy masks.
+	mutable float m_OccupancyMarkedRotAngle; //!< The rotation angle this had when it was last marked in a SpatialPartitionGrid's occupancy masks.
+	mutable unsigned int m_OccupancyMarkedFrame; //!< The sprite frame this showed when it was last marked in a SpatialPartitionGrid's occupancy masks.
+	mutable bool m_OccupancyMarkedHFlipped; //!< Whether this was flipped when it was last marked in a SpatialPartitionGrid's occupancy masks.
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Private member variable and method declarations
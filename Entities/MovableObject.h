@@ -32,6 +32,7 @@ struct HitData;
 class MOSRotating;
 class PieMenu;
 class SLTerrain;
+class SpatialPartitionGrid;
 class LuaStateWrapper;
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1033,6 +1034,18 @@ enum MOType
     /// <returns>Whether the given coordinate overlap us.</returns>
     virtual bool HitTestAtPixel(int pixelX, int pixelY) const { return false; }
 
+    /// <summary>
+    /// Marks every Scene pixel this could currently be hit at by HitTestAtPixel as occupied in the occupancy masks of the given SpatialPartitionGrid, and remembers the state this was in when doing so.
+    /// </summary>
+    /// <param name="grid">The SpatialPartitionGrid to mark pixels in.</param>
+    virtual void MarkOccupancy(SpatialPartitionGrid &grid) const {}
+
+    /// <summary>
+    /// Gets whether this is still in the state it was in when it was last marked with MarkOccupancy, meaning the occupancy masks still cover every pixel it can be hit at.
+    /// </summary>
+    /// <returns>Whether the occupancy masks this was last marked in are still current for this.</returns>
+    virtual bool IsOccupancyMaskCurrent() const { return true; }
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          HasObject
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1487,6 +1500,18 @@ enum MOType
 
     virtual void Travel();
 
+    /// <summary>
+    /// Gets whether this type of MovableObject can have ApplyForces(), PreTravel() and Travel() run on a worker thread, concurrently with other MovableObjects.
+    /// </summary>
+    /// <returns>Whether this MovableObject supports concurrent travel.</returns>
+    virtual bool SupportsConcurrentTravel() const { return false; }
+
+    /// <summary>
+    /// Gets whether the upcoming Travel() of this MovableObject won't collide with anything, so it can safely run concurrently with other MovableObjects. ApplyForces() and PreTravel() must have been called first.
+    /// </summary>
+    /// <returns>Whether this MovableObject can travel concurrently this frame.</returns>
+    virtual bool CanTravelConcurrently() const { return false; }
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Virtual method:  PostTravel
@@ -213,7 +213,19 @@ namespace RTE {
 
 	void SLBackground::Draw(BITMAP *targetBitmap, Box &targetBox, bool offsetNeedsScrollRatioAdjustment) {
 		SceneLayer::Draw(targetBitmap, targetBox, !IsAutoScrolling());
+		DrawFillColors(targetBitmap, targetBox, m_Offset);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SLBackground::DrawAtOffset(BITMAP *targetBitmap, Box &targetBox, const Vector &offset, bool offsetNeedsScrollRatioAdjustment) const {
+		SceneLayer::DrawAtOffset(targetBitmap, targetBox, offset, !IsAutoScrolling());
+		DrawFillColors(targetBitmap, targetBox, GetDrawOffset(targetBitmap, targetBox, offset, !IsAutoScrolling()));
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+	void SLBackground::DrawFillColors(BITMAP *targetBitmap, const Box &targetBox, const Vector &drawOffset) const {
 		int bitmapWidth = m_ScaledDimensions.GetFloorIntX();
 		int bitmapHeight = m_ScaledDimensions.GetFloorIntY();
 		int targetBoxCornerX = targetBox.GetCorner().GetFloorIntX();
@@ -225,12 +237,12 @@ namespace RTE {
 
 		// Detect if non-wrapping layer dimensions can't cover the whole target area with its main bitmap. If so, fill in the gap with appropriate solid color sampled from the hanging edge.
 		if (!m_WrapX && bitmapWidth <= targetBoxWidth) {
-			if (m_FillColorLeft != ColorKeys::g_MaskColor && m_Offset.GetFloorIntX() != 0) { rectfill(targetBitmap, targetBoxCornerX, targetBoxCornerY, targetBoxCornerX - m_Offset.GetFloorIntX(), targetBoxCornerY + targetBoxHeight, m_FillColorLeft); }
-			if (m_FillColorRight != ColorKeys::g_MaskColor) { rectfill(targetBitmap, targetBoxCornerX + bitmapWidth - m_Offset.GetFloorIntX(), targetBoxCornerY, targetBoxCornerX + targetBoxWidth, targetBoxCornerY + targetBoxHeight, m_FillColorRight); }
+			if (m_FillColorLeft != ColorKeys::g_MaskColor && drawOffset.GetFloorIntX() != 0) { rectfill(targetBitmap, targetBoxCornerX, targetBoxCornerY, targetBoxCornerX - drawOffset.GetFloorIntX(), targetBoxCornerY + targetBoxHeight, m_FillColorLeft); }
+			if (m_FillColorRight != ColorKeys::g_MaskColor) { rectfill(targetBitmap, targetBoxCornerX + bitmapWidth - drawOffset.GetFloorIntX(), targetBoxCornerY, targetBoxCornerX + targetBoxWidth, targetBoxCornerY + targetBoxHeight, m_FillColorRight); }
 		}
 		if (!m_WrapY && bitmapHeight <= targetBoxHeight) {
-			if (m_FillColorUp != ColorKeys::g_MaskColor && m_Offset.GetFloorIntY() != 0) { rectfill(targetBitmap, targetBoxCornerX, targetBoxCornerY, targetBoxCornerX + targetBoxWidth, targetBoxCornerY - m_Offset.GetFloorIntY(), m_FillColorUp); }
-			if (m_FillColorDown != ColorKeys::g_MaskColor) { rectfill(targetBitmap, targetBoxCornerX, targetBoxCornerY + bitmapHeight - m_Offset.GetFloorIntY(), targetBoxCornerX + targetBoxWidth, targetBoxCornerY + targetBoxHeight, m_FillColorDown); }
+			if (m_FillColorUp != ColorKeys::g_MaskColor && drawOffset.GetFloorIntY() != 0) { rectfill(targetBitmap, targetBoxCornerX, targetBoxCornerY, targetBoxCornerX + targetBoxWidth, targetBoxCornerY - drawOffset.GetFloorIntY(), m_FillColorUp); }
+			if (m_FillColorDown != ColorKeys::g_MaskColor) { rectfill(targetBitmap, targetBoxCornerX, targetBoxCornerY + bitmapHeight - drawOffset.GetFloorIntY(), targetBoxCornerX + targetBoxWidth, targetBoxCornerY + targetBoxHeight, m_FillColorDown); }
 		}
 		set_clip_rect(targetBitmap, 0, 0, targetBitmap->w - 1, targetBitmap->h - 1);
 	}
@@ -200,6 +200,15 @@ namespace RTE {
 		/// <param name="targetBox">The box on the target bitmap to limit drawing to, with the corner of box being where the scroll position lines up.</param>
 		/// <param name="offsetNeedsScrollRatioAdjustment">Whether the offset of this SceneLayer or the passed in offset override need to be adjusted to scroll ratio.</param>
 		void Draw(BITMAP *targetBitmap, Box &targetBox, bool offsetNeedsScrollRatioAdjustment = false) override;
+
+		/// <summary>
+		/// Draws this SLBackground scrolled to the given offset to a bitmap, without changing its own offset.
+		/// </summary>
+		/// <param name="targetBitmap">The bitmap to draw to.</param>
+		/// <param name="targetBox">The box on the target bitmap to limit drawing to, with the corner of box being where the scroll position lines up.</param>
+		/// <param name="offset">The scrolled offset to draw at, as it would have been set with SetOffset.</param>
+		/// <param name="offsetNeedsScrollRatioAdjustment">Whether the passed in offset needs to be adjusted to scroll ratio.</param>
+		void DrawAtOffset(BITMAP *targetBitmap, Box &targetBox, const Vector &offset, bool offsetNeedsScrollRatioAdjustment = false) const override;
 #pragma endregion
 
 	private:
@@ -236,6 +245,14 @@ namespace RTE {
 
 		bool m_IgnoreAutoScale; //!< Whether auto-scaling settings are ignored and the read-in scale factor is used instead.
 
+		/// <summary>
+		/// Fills the gaps a non-wrapping SLBackground's bitmap leaves on the target area with the fill colors.
+		/// </summary>
+		/// <param name="targetBitmap">The bitmap to draw to.</param>
+		/// <param name="targetBox">The box on the target bitmap to limit drawing to.</param>
+		/// <param name="drawOffset">The offset the bitmap was drawn from.</param>
+		void DrawFillColors(BITMAP *targetBitmap, const Box &targetBox, const Vector &drawOffset) const;
+
 		/// <summary>
 		/// Clears all the member variables of this SLBackground, effectively resetting the members of this abstraction level only.
 		/// </summary>
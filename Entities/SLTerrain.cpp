@@ -264,6 +264,10 @@ namespace RTE {
 	int SLTerrain::LoadData() {
 		SceneLayer::LoadData();
 
+		// The image info of the BitmapFile isn't available when it's an entry of a save game archive, so the dimensions read in Create may not be valid until now.
+		m_Width = m_MainBitmap->w;
+		m_Height = m_MainBitmap->h;
+
 		RTEAssert(m_FGColorLayer.get(), "Terrain's foreground layer not instantiated before trying to load its data!");
 		RTEAssert(m_BGColorLayer.get(), "Terrain's background layer not instantiated before trying to load its data!");
 
@@ -295,13 +299,13 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	int SLTerrain::SaveData(const std::string &pathBase, bool doAsyncSaves) {
+	int SLTerrain::SaveData(const std::string &pathBase, bool doAsyncSaves, const std::shared_ptr<SaveGameArchive> &archive) {
 		if (pathBase.empty()) {
 			return -1;
 		}
-		SceneLayer::SaveData(pathBase + " Mat.png", doAsyncSaves);
-		m_FGColorLayer->SaveData(pathBase + " FG.png", doAsyncSaves);
-		m_BGColorLayer->SaveData(pathBase + " BG.png", doAsyncSaves);
+		SceneLayer::SaveData(pathBase + " Mat.png", doAsyncSaves, archive);
+		m_FGColorLayer->SaveData(pathBase + " FG.png", doAsyncSaves, archive);
+		m_BGColorLayer->SaveData(pathBase + " BG.png", doAsyncSaves, archive);
 		return 0;
 	}
 
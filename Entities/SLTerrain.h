@@ -78,8 +78,9 @@ namespace RTE {
 		/// </summary>
 		/// <param name="pathBase">The filepath base to the where to save the Bitmap data. This means everything up to the extension. "FG" and "Mat" etc will be added.</param>
 		/// <param name="doAsyncSaves">Whether or not to save asynchronously.</param>
+		/// <param name="archive">The save game archive to save the bitmap data to instead of disk, if any.</param>
 		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
-		int SaveData(const std::string &pathBase, bool doAsyncSaves = true) override;
+		int SaveData(const std::string &pathBase, bool doAsyncSaves = true, const std::shared_ptr<SaveGameArchive> &archive = nullptr) override;
 
 		/// <summary>
 		/// Clears out any previously loaded bitmap data from memory.
@@ -119,6 +120,18 @@ namespace RTE {
 		/// <returns>A pointer to the background color bitmap.</returns>
 		BITMAP * GetBGColorBitmap() { return m_BGColorLayer->GetBitmap(); }
 
+		/// <summary>
+		/// Gets the foreground color layer of this SLTerrain, so it can be drawn without changing which layer Draw() draws. Ownership is NOT transferred!
+		/// </summary>
+		/// <returns>A pointer to the foreground color layer.</returns>
+		SceneLayer * GetFGColorLayer() const { return m_FGColorLayer.get(); }
+
+		/// <summary>
+		/// Gets the background color layer of this SLTerrain, so it can be drawn without changing which layer Draw() draws. Ownership is NOT transferred!
+		/// </summary>
+		/// <returns>A pointer to the background color layer.</returns>
+		SceneLayer * GetBGColorLayer() const { return m_BGColorLayer.get(); }
+
 		/// <summary>
 		/// Gets the material bitmap of this SLTerrain.
 		/// </summary>
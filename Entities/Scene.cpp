@@ -934,9 +934,10 @@ int Scene::LoadData(bool placeObjects, bool initPathfinding, bool placeUnits)
     {
 		// Create the pathfinding stuff based on the current scene
 		int pathFinderGridNodeSize = g_SettingsMan.GetPathFinderGridNodeSize();
+		int pathFinderClusterSize = g_SettingsMan.GetPathFinderClusterSize();
 
         for (int i = 0; i < m_pPathFinders.size(); ++i) {
-            m_pPathFinders[i] = std::make_unique<PathFinder>(pathFinderGridNodeSize);
+            m_pPathFinders[i] = std::make_unique<PathFinder>(pathFinderGridNodeSize, pathFinderClusterSize);
         }
         ResetPathFinding();
     }
@@ -1031,7 +1032,7 @@ int Scene::ExpandAIPlanAssemblySchemes()
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Saves currently loaded bitmap data in memory to disk.
 
-int Scene::SaveData(std::string pathBase, bool doAsyncSaves)
+int Scene::SaveData(std::string pathBase, bool doAsyncSaves, const std::shared_ptr<SaveGameArchive> &archive)
 {
     const std::string fullPathBase = g_PresetMan.GetFullModulePath(pathBase);
     if (fullPathBase.empty())
@@ -1041,7 +1042,7 @@ int Scene::SaveData(std::string pathBase, bool doAsyncSaves)
         return 0;
 
     // Save Terrain's data
-    if (m_pTerrain->SaveData(fullPathBase, doAsyncSaves) < 0)
+    if (m_pTerrain->SaveData(fullPathBase, doAsyncSaves, archive) < 0)
     {
         RTEAbort("Saving Terrain " + m_pTerrain->GetPresetName() + "\'s data failed!");
         return -1;
@@ -1057,7 +1058,7 @@ int Scene::SaveData(std::string pathBase, bool doAsyncSaves)
         {
             std::snprintf(str, sizeof(str), "T%d", team);
             // Save unseen layer data to disk
-            if (m_apUnseenLayer[team]->SaveData(fullPathBase + " US" + str + ".png", doAsyncSaves) < 0)
+            if (m_apUnseenLayer[team]->SaveData(fullPathBase + " US" + str + ".png", doAsyncSaves, archive) < 0)
             {
                 g_ConsoleMan.PrintString("ERROR: Saving unseen layer " + m_apUnseenLayer[team]->GetPresetName() + "\'s data failed!");
                 return -1;
@@ -1757,7 +1758,8 @@ void Scene::FillUnseenLayer(Vector pixelSize, int team, bool createNow)
     {
         BITMAP *pUnseenBitmap = create_bitmap_ex(8, GetWidth() / m_UnseenPixelSize[team].m_X, GetHeight() / m_UnseenPixelSize[team].m_Y);
         clear_to_color(pUnseenBitmap, g_BlackColor);
-        // Replace any old unseen layer with the new one that is generated
+        // Replace any old unseen layer with the new one that is generated, once a pipelined draw is done reading it
+        g_FrameMan.WaitForPipelinedDraw();
         delete m_apUnseenLayer[team];
         m_apUnseenLayer[team] = new SceneLayer();
         m_apUnseenLayer[team]->Create(pUnseenBitmap, true, Vector(), WrapsX(), WrapsY(), Vector(1.0, 1.0));
@@ -1777,7 +1779,8 @@ void Scene::SetUnseenLayer(SceneLayer *pNewLayer, int team)
     if (team == Activity::NoTeam || !pNewLayer)
         return;
 
-    // Replace any old unseen layer with the new one that is generated
+    // Replace any old unseen layer with the new one that is generated, once a pipelined draw is done reading it
+    g_FrameMan.WaitForPipelinedDraw();
     delete m_apUnseenLayer[team];
     m_apUnseenLayer[team] = pNewLayer;
     // Calculate how many times smaller the unseen map is compared to the entire terrain's dimensions, and set it as the scale factor on the Unseen layer
@@ -2975,15 +2978,7 @@ void Scene::UpdatePathFinding()
     constexpr int nodeUpdatesPerCall = 100;
     constexpr int maxUnupdatedMaterialAreas = 1000;
 
-    // If any pathing requests are active, don't update things yet, wait till they're finished
-	// TODO: this can indefinitely block updates if pathing requests are made every frame. Figure out a solution for this
-	// Either force-complete pathing requests occasionally, or delay starting new pathing requests if we've not updated in a while
-    for (int team = Activity::Teams::NoTeam; team < Activity::Teams::MaxTeamCount; ++team) {
-		if (GetPathFinder(static_cast<Activity::Teams>(team))->GetCurrentPathingRequests() != 0) {
-            return;
-        };
-	}
-
+    // Pathing requests in flight keep reading the node cost snapshot they started with, so updates don't need to wait for them and changes reach new requests on the next call.
     int nodesToUpdate = nodeUpdatesPerCall / g_ActivityMan.GetActivity()->GetTeamCount();
     if (m_pTerrain->GetUpdatedMaterialAreas().size() > maxUnupdatedMaterialAreas) {
         // Our list of boxes is getting too big and a bit out of hand, so clear everything.
@@ -3124,10 +3119,7 @@ void Scene::Update()
 	}
 
     if (m_NavigatableAreasUpToDate == false) {
-        // Need to block until all current pathfinding requests are finished. Ugh, if only we had a better way (interrupt/cancel a path request to start a new one?)
-        // TODO: Make the PathRequest struct more capable and maybe we can delay starting or cancel mid-request?
-        BlockUntilAllPathingRequestsComplete();
-
+        // Navigatability is published in node cost snapshots too, so pathing requests in flight are unaffected and don't need to be waited for.
         m_NavigatableAreasUpToDate = true;
         for (int team = Activity::Teams::NoTeam; team < Activity::Teams::MaxTeamCount; ++team) {
             PathFinder& pathFinder = *GetPathFinder(static_cast<Activity::Teams>(team));
@@ -31,6 +31,7 @@ class SceneLayer;
 class BunkerAssembly;
 class SceneObject;
 class Deployment;
+class SaveGameArchive;
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -394,14 +395,15 @@ EntityAllocation(Scene)
 //////////////////////////////////////////////////////////////////////////////////////////
 // Virtual method:  SaveData
 //////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Saves data currently in memory to disk.
+// Description:     Saves data currently in memory to disk, or to a save game archive.
 // Arguments:       The filepath base to the where to save the Bitmap data. This means
 //                  everything up to the extension. "FG" and "Mat" etc will be added.
 //					Whether or not to save asynchronously.
+//                  The save game archive to save the Bitmap data to instead of disk, if any.
 // Return value:    An error return value signaling success or any particular failure.
 //                  Anything below 0 is an error signal.
 
-	int SaveData(std::string pathBase, bool doAsyncSaves = true);
+	int SaveData(std::string pathBase, bool doAsyncSaves = true, const std::shared_ptr<SaveGameArchive> &archive = nullptr);
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -5,6 +5,7 @@
 #include "SettingsMan.h"
 #include "ActivityMan.h"
 #include "ThreadMan.h"
+#include "SaveGameArchive.h"
 
 #include "tracy/Tracy.hpp"
 
@@ -201,7 +202,7 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	template <bool TRACK_DRAWINGS>
-	int SceneLayerImpl<TRACK_DRAWINGS>::SaveData(const std::string &bitmapPath, bool doAsyncSaves) {
+	int SceneLayerImpl<TRACK_DRAWINGS>::SaveData(const std::string &bitmapPath, bool doAsyncSaves, const std::shared_ptr<SaveGameArchive> &archive) {
 		if (bitmapPath.empty()) {
 			return -1;
 		}
@@ -211,16 +212,32 @@ namespace RTE {
 			BITMAP *outputBitmap = create_bitmap_ex(bitmap_color_depth(m_MainBitmap), m_MainBitmap->w, m_MainBitmap->h);
 			blit(m_MainBitmap, outputBitmap, 0, 0, 0, 0, m_MainBitmap->w, m_MainBitmap->h);
 
-			auto saveLayerBitmap = [bitmapPath, doAsyncSaves](BITMAP *bitmapToSave) {
-				PALETTE palette;
-				get_palette(palette);
-				if (save_png(bitmapPath.c_str(), bitmapToSave, palette) != 0) {
-					RTEAbort(std::string("Failed to save SceneLayerImpl bitmap to path and name: " + bitmapPath));
-				}
-				destroy_bitmap(bitmapToSave);
-			};
+			std::function<void(BITMAP *)> saveLayerBitmap;
+			if (archive) {
+				std::string entryName = std::filesystem::path(bitmapPath).filename().replace_extension(SaveGameArchive::c_BitmapEntryExtension).generic_string();
+				m_BitmapFile.SetDataPath(archive->GetEntryPath(entryName));
+
+				saveLayerBitmap = [entryName, archive = archive](BITMAP *bitmapToSave) mutable {
+					if (!archive->WriteBitmapEntry(entryName, bitmapToSave)) {
+						RTEAbort(std::string("Failed to save SceneLayerImpl bitmap to save game archive entry: " + archive->GetEntryPath(entryName)));
+					}
+					destroy_bitmap(bitmapToSave);
+					// Let go of the archive before the task is done, so that whoever waits on the save game task finds it finished once the last entry is written.
+					archive.reset();
+				};
+			} else {
+				m_BitmapFile.SetDataPath(bitmapPath);
+
+				saveLayerBitmap = [bitmapPath](BITMAP *bitmapToSave) {
+					PALETTE palette;
+					get_palette(palette);
+					if (save_png(bitmapPath.c_str(), bitmapToSave, palette) != 0) {
+						RTEAbort(std::string("Failed to save SceneLayerImpl bitmap to path and name: " + bitmapPath));
+					}
+					destroy_bitmap(bitmapToSave);
+				};
+			}
 
-			m_BitmapFile.SetDataPath(bitmapPath);
 			if (doAsyncSaves) {
 				g_ActivityMan.GetSaveGameTask().push_back( g_ThreadMan.GetBackgroundThreadPool().submit(saveLayerBitmap, outputBitmap) );
 			} else {
@@ -414,27 +431,97 @@ namespace RTE {
 		}
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	template <bool TRACK_DRAWINGS>
+	void SceneLayerImpl<TRACK_DRAWINGS>::GetDrawingsOnTarget(const Box &targetBox, std::vector<IntRect> &targetDrawings, int &originX, int &originY) const {
+		int boxLeft = targetBox.GetCorner().GetFloorIntX();
+		int boxTop = targetBox.GetCorner().GetFloorIntY();
+		int boxRight = boxLeft + static_cast<int>(targetBox.GetWidth()) - 1;
+		int boxBottom = boxTop + static_cast<int>(targetBox.GetHeight()) - 1;
+		originX = boxLeft - m_Offset.GetFloorIntX();
+		originY = boxTop - m_Offset.GetFloorIntY();
+
+		if constexpr (TRACK_DRAWINGS) {
+			int layerWidth = m_ScaledDimensions.GetFloorIntX();
+			int layerHeight = m_ScaledDimensions.GetFloorIntY();
+
+			// Gets the first copy of an area along one axis that could be on the target. Wrapping layers are drawn again every layer size, non-wrapping ones only once.
+			auto firstCopy = [](int start, int end, int boxStart, int period, bool wraps) {
+				if (wraps && period > 0) {
+					int copiesBefore = (end < boxStart) ? (boxStart - end + period - 1) / period : -((end - boxStart) / period);
+					start += copiesBefore * period;
+				}
+				return start;
+			};
+
+			for (const IntRect &drawing : m_Drawings) {
+				int width = drawing.m_Right - drawing.m_Left;
+				int height = drawing.m_Bottom - drawing.m_Top;
+				int firstLeft = firstCopy(drawing.m_Left + originX, drawing.m_Right + originX, boxLeft, layerWidth, m_WrapX);
+				int firstTop = firstCopy(drawing.m_Top + originY, drawing.m_Bottom + originY, boxTop, layerHeight, m_WrapY);
+
+				for (int top = firstTop; top <= boxBottom; top += layerHeight) {
+					for (int left = firstLeft; left <= boxRight; left += layerWidth) {
+						IntRect targetDrawing(std::max(left, boxLeft), std::max(top, boxTop), std::min(left + width, boxRight), std::min(top + height, boxBottom));
+						if (targetDrawing.m_Left <= targetDrawing.m_Right && targetDrawing.m_Top <= targetDrawing.m_Bottom) { targetDrawings.push_back(targetDrawing); }
+						if (!m_WrapX || layerWidth <= 0) {
+							break;
+						}
+					}
+					if (!m_WrapY || layerHeight <= 0) {
+						break;
+					}
+				}
+			}
+		}
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	template <bool TRACK_DRAWINGS>
 	void SceneLayerImpl<TRACK_DRAWINGS>::Draw(BITMAP *targetBitmap, Box &targetBox, bool offsetNeedsScrollRatioAdjustment) {
 		RTEAssert(m_MainBitmap, "Data of this SceneLayerImpl has not been loaded before trying to draw!");
 
-		if (offsetNeedsScrollRatioAdjustment) { m_Offset.SetXY(std::floor(m_Offset.GetX() * m_ScrollRatio.GetX()), std::floor(m_Offset.GetY() * m_ScrollRatio.GetY())); }
 		if (targetBox.IsEmpty()) { targetBox = Box(Vector(), static_cast<float>(targetBitmap->w), static_cast<float>(targetBitmap->h)); }
-		if (!m_WrapX && static_cast<float>(targetBitmap->w) > targetBox.GetWidth()) { m_Offset.SetX(0); }
-		if (!m_WrapY && static_cast<float>(targetBitmap->h) > targetBox.GetHeight()) { m_Offset.SetY(0); }
+		m_Offset = GetDrawOffset(targetBitmap, targetBox, m_Offset, offsetNeedsScrollRatioAdjustment);
+		DrawFromOffset(targetBitmap, targetBox, m_Offset);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-		m_Offset -= m_OriginOffset;
-		WrapPosition(m_Offset);
+	template <bool TRACK_DRAWINGS>
+	void SceneLayerImpl<TRACK_DRAWINGS>::DrawAtOffset(BITMAP *targetBitmap, Box &targetBox, const Vector &offset, bool offsetNeedsScrollRatioAdjustment) const {
+		RTEAssert(m_MainBitmap, "Data of this SceneLayerImpl has not been loaded before trying to draw!");
 
+		if (targetBox.IsEmpty()) { targetBox = Box(Vector(), static_cast<float>(targetBitmap->w), static_cast<float>(targetBitmap->h)); }
+		DrawFromOffset(targetBitmap, targetBox, GetDrawOffset(targetBitmap, targetBox, offset, offsetNeedsScrollRatioAdjustment));
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	template <bool TRACK_DRAWINGS>
+	Vector SceneLayerImpl<TRACK_DRAWINGS>::GetDrawOffset(const BITMAP *targetBitmap, const Box &targetBox, Vector offset, bool offsetNeedsScrollRatioAdjustment) const {
+		if (offsetNeedsScrollRatioAdjustment) { offset.SetXY(std::floor(offset.GetX() * m_ScrollRatio.GetX()), std::floor(offset.GetY() * m_ScrollRatio.GetY())); }
+		if (!m_WrapX && static_cast<float>(targetBitmap->w) > targetBox.GetWidth()) { offset.SetX(0); }
+		if (!m_WrapY && static_cast<float>(targetBitmap->h) > targetBox.GetHeight()) { offset.SetY(0); }
+
+		offset -= m_OriginOffset;
+		WrapPosition(offset);
+		return offset;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	template <bool TRACK_DRAWINGS>
+	void SceneLayerImpl<TRACK_DRAWINGS>::DrawFromOffset(BITMAP *targetBitmap, const Box &targetBox, const Vector &drawOffset) const {
 		set_clip_rect(targetBitmap, targetBox.GetCorner().GetFloorIntX(), targetBox.GetCorner().GetFloorIntY(), static_cast<int>(targetBox.GetCorner().GetX() + targetBox.GetWidth()) - 1, static_cast<int>(targetBox.GetCorner().GetY() + targetBox.GetHeight()) - 1);
 		bool drawScaled = m_ScaleFactor.GetX() > 1.0F || m_ScaleFactor.GetY() > 1.0F;
 
 		if (m_MainBitmap->w > targetBitmap->w && m_MainBitmap->h > targetBitmap->h) {
-			DrawWrapped(targetBitmap, targetBox, drawScaled);
+			DrawWrapped(targetBitmap, targetBox, drawOffset, drawScaled);
 		} else {
-			DrawTiled(targetBitmap, targetBox, drawScaled);
+			DrawTiled(targetBitmap, targetBox, drawOffset, drawScaled);
 		}
 		set_clip_rect(targetBitmap, 0, 0, targetBitmap->w - 1, targetBitmap->h - 1);
 	}
@@ -442,14 +529,14 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	template <bool TRACK_DRAWINGS>
-	void SceneLayerImpl<TRACK_DRAWINGS>::DrawWrapped(BITMAP *targetBitmap, const Box &targetBox, bool drawScaled) const {
+	void SceneLayerImpl<TRACK_DRAWINGS>::DrawWrapped(BITMAP *targetBitmap, const Box &targetBox, const Vector &drawOffset, bool drawScaled) const {
 		if (!drawScaled) {
-			std::array<int, 2> sourcePosX = { m_Offset.GetFloorIntX(), 0 };
-			std::array<int, 2> sourcePosY = { m_Offset.GetFloorIntY(), 0 };
-			std::array<int, 2> sourceWidth = { m_MainBitmap->w - m_Offset.GetFloorIntX(), m_Offset.GetFloorIntX() };
-			std::array<int, 2> sourceHeight = { m_MainBitmap->h - m_Offset.GetFloorIntY(), m_Offset.GetFloorIntY() };
-			std::array<int, 2> destPosX = { targetBox.GetCorner().GetFloorIntX(), targetBox.GetCorner().GetFloorIntX() + m_MainBitmap->w - m_Offset.GetFloorIntX() };
-			std::array<int, 2> destPosY = { targetBox.GetCorner().GetFloorIntY(), targetBox.GetCorner().GetFloorIntY() + m_MainBitmap->h - m_Offset.GetFloorIntY() };
+			std::array<int, 2> sourcePosX = { drawOffset.GetFloorIntX(), 0 };
+			std::array<int, 2> sourcePosY = { drawOffset.GetFloorIntY(), 0 };
+			std::array<int, 2> sourceWidth = { m_MainBitmap->w - drawOffset.GetFloorIntX(), drawOffset.GetFloorIntX() };
+			std::array<int, 2> sourceHeight = { m_MainBitmap->h - drawOffset.GetFloorIntY(), drawOffset.GetFloorIntY() };
+			std::array<int, 2> destPosX = { targetBox.GetCorner().GetFloorIntX(), targetBox.GetCorner().GetFloorIntX() + m_MainBitmap->w - drawOffset.GetFloorIntX() };
+			std::array<int, 2> destPosY = { targetBox.GetCorner().GetFloorIntY(), targetBox.GetCorner().GetFloorIntY() + m_MainBitmap->h - drawOffset.GetFloorIntY() };
 
 			for (int i = 0; i < 2; ++i) {
 				for (int j = 0; j < 2; ++j) {
@@ -461,10 +548,10 @@ namespace RTE {
 				}
 			}
 		} else {
-			std::array<int, 2> sourceWidth = { m_MainBitmap->w, m_Offset.GetFloorIntX() / m_ScaleFactor.GetFloorIntX() };
-			std::array<int, 2> sourceHeight = { m_MainBitmap->h, m_Offset.GetFloorIntY() / m_ScaleFactor.GetFloorIntY() };
-			std::array<int, 2> destPosX = { targetBox.GetCorner().GetFloorIntX() - m_Offset.GetFloorIntX(), targetBox.GetCorner().GetFloorIntX() + m_ScaledDimensions.GetFloorIntX() - m_Offset.GetFloorIntX() };
-			std::array<int, 2> destPosY = { targetBox.GetCorner().GetFloorIntY() - m_Offset.GetFloorIntY(), targetBox.GetCorner().GetFloorIntY() + m_ScaledDimensions.GetFloorIntY() - m_Offset.GetFloorIntY() };
+			std::array<int, 2> sourceWidth = { m_MainBitmap->w, drawOffset.GetFloorIntX() / m_ScaleFactor.GetFloorIntX() };
+			std::array<int, 2> sourceHeight = { m_MainBitmap->h, drawOffset.GetFloorIntY() / m_ScaleFactor.GetFloorIntY() };
+			std::array<int, 2> destPosX = { targetBox.GetCorner().GetFloorIntX() - drawOffset.GetFloorIntX(), targetBox.GetCorner().GetFloorIntX() + m_ScaledDimensions.GetFloorIntX() - drawOffset.GetFloorIntX() };
+			std::array<int, 2> destPosY = { targetBox.GetCorner().GetFloorIntY() - drawOffset.GetFloorIntY(), targetBox.GetCorner().GetFloorIntY() + m_ScaledDimensions.GetFloorIntY() - drawOffset.GetFloorIntY() };
 
 			for (int i = 0; i < 2; ++i) {
 				for (int j = 0; j < 2; ++j) {
@@ -481,17 +568,17 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	template <bool TRACK_DRAWINGS>
-	void SceneLayerImpl<TRACK_DRAWINGS>::DrawTiled(BITMAP *targetBitmap, const Box &targetBox, bool drawScaled) const {
+	void SceneLayerImpl<TRACK_DRAWINGS>::DrawTiled(BITMAP *targetBitmap, const Box &targetBox, const Vector &drawOffset, bool drawScaled) const {
 		int bitmapWidth = m_ScaledDimensions.GetFloorIntX();
 		int bitmapHeight = m_ScaledDimensions.GetFloorIntY();
-		int areaToCoverX = m_Offset.GetFloorIntX() + targetBox.GetCorner().GetFloorIntX() + std::min(targetBitmap->w, static_cast<int>(targetBox.GetWidth()));
-		int areaToCoverY = m_Offset.GetFloorIntY() + targetBox.GetCorner().GetFloorIntY() + std::min(targetBitmap->h, static_cast<int>(targetBox.GetHeight()));
+		int areaToCoverX = drawOffset.GetFloorIntX() + targetBox.GetCorner().GetFloorIntX() + std::min(targetBitmap->w, static_cast<int>(targetBox.GetWidth()));
+		int areaToCoverY = drawOffset.GetFloorIntY() + targetBox.GetCorner().GetFloorIntY() + std::min(targetBitmap->h, static_cast<int>(targetBox.GetHeight()));
 
 		for (int tiledOffsetX = 0; tiledOffsetX < areaToCoverX;) {
-			int destX = targetBox.GetCorner().GetFloorIntX() + tiledOffsetX - m_Offset.GetFloorIntX();
+			int destX = targetBox.GetCorner().GetFloorIntX() + tiledOffsetX - drawOffset.GetFloorIntX();
 
 			for (int tiledOffsetY = 0; tiledOffsetY < areaToCoverY;) {
-				int destY = targetBox.GetCorner().GetFloorIntY() + tiledOffsetY - m_Offset.GetFloorIntY();
+				int destY = targetBox.GetCorner().GetFloorIntY() + tiledOffsetY - drawOffset.GetFloorIntY();
 
 				if (!drawScaled) {
 					if (m_DrawMasked) {
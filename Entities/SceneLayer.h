@@ -7,6 +7,8 @@
 
 namespace RTE {
 
+	class SaveGameArchive;
+
 	/// <summary>
 	/// A scrolling layer of the Scene.
 	/// </summary>
@@ -100,12 +102,13 @@ namespace RTE {
 		virtual int LoadData();
 
 		/// <summary>
-		/// Saves data currently in memory to disk.
+		/// Saves data currently in memory to disk, or to a save game archive.
 		/// </summary>
-		/// <param name="bitmapPath">The filepath to the where to save the bitmap data.</param>
+		/// <param name="bitmapPath">The filepath to the where to save the bitmap data. If saving to an archive, its file name is used as the entry's name, with the extension swapped for the archive's bitmap entry one.</param>
 		/// <param name="doAsyncSaves">Whether or not to save asynchronously.</param>
+		/// <param name="archive">The save game archive to save the bitmap data to instead of disk, if any.</param>
 		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
-		virtual int SaveData(const std::string &bitmapPath, bool doAsyncSaves = true);
+		virtual int SaveData(const std::string &bitmapPath, bool doAsyncSaves = true, const std::shared_ptr<SaveGameArchive> &archive = nullptr);
 
 		/// <summary>
 		/// Clears out any previously loaded bitmap data from memory.
@@ -257,6 +260,16 @@ namespace RTE {
 		/// <param name="center">The position of the center of the area to be drawn upon.</param>
 		/// <param name="radius">The radius of the area to be drawn upon.</param>
 		void RegisterDrawing(const Vector &center, float radius);
+
+		/// <summary>
+		/// Gets where the areas drawn upon since the last clear ended up on a target bitmap the last time this SceneLayer was drawn to it, including any wrapped copies.
+		/// Only meaningful right after an unscaled Draw() with the same target box, as drawing moves the scroll offset.
+		/// </summary>
+		/// <param name="targetBox">The box on the target bitmap this SceneLayer was drawn to. The areas are clipped to it.</param>
+		/// <param name="targetDrawings">Vector to add the areas to, in target bitmap pixels. Bounds are inclusive.</param>
+		/// <param name="originX">Set to the X position on the target bitmap this SceneLayer's left edge was drawn at, before wrapping.</param>
+		/// <param name="originY">Set to the Y position on the target bitmap this SceneLayer's top edge was drawn at, before wrapping.</param>
+		void GetDrawingsOnTarget(const Box &targetBox, std::vector<IntRect> &targetDrawings, int &originX, int &originY) const;
 #pragma endregion
 
 #pragma region Virtual Methods
@@ -272,6 +285,15 @@ namespace RTE {
 		/// <param name="targetBox">The box on the target bitmap to limit drawing to, with the corner of box being where the scroll position lines up.</param>
 		/// <param name="offsetNeedsScrollRatioAdjustment">Whether the offset of this SceneLayer or the passed in offset override need to be adjusted to scroll ratio.</param>
 		virtual void Draw(BITMAP *targetBitmap, Box &targetBox, bool offsetNeedsScrollRatioAdjustment = false);
+
+		/// <summary>
+		/// Draws this SceneLayer scrolled to the given offset to a bitmap, without changing its own offset, so it can be drawn on another thread while its offset is being set for the next frame.
+		/// </summary>
+		/// <param name="targetBitmap">The bitmap to draw to.</param>
+		/// <param name="targetBox">The box on the target bitmap to limit drawing to, with the corner of box being where the scroll position lines up.</param>
+		/// <param name="offset">The scrolled offset to draw at, as it would have been set with SetOffset.</param>
+		/// <param name="offsetNeedsScrollRatioAdjustment">Whether the passed in offset needs to be adjusted to scroll ratio.</param>
+		virtual void DrawAtOffset(BITMAP *targetBitmap, Box &targetBox, const Vector &offset, bool offsetNeedsScrollRatioAdjustment = false) const;
 #pragma endregion
 
 	protected:
@@ -316,21 +338,41 @@ namespace RTE {
 		bool ForceBoundsOrWrapPosition(Vector &pos, bool forceBounds) const;
 
 #pragma region Draw Breakdown
+		/// <summary>
+		/// Gets the offset this SceneLayer's bitmap is actually drawn from for a scrolled offset, adjusted to scroll ratio, bounds and origin offset and wrapped.
+		/// </summary>
+		/// <param name="targetBitmap">The bitmap to draw to.</param>
+		/// <param name="targetBox">The box on the target bitmap to limit drawing to. Must not be empty.</param>
+		/// <param name="offset">The scrolled offset to draw at.</param>
+		/// <param name="offsetNeedsScrollRatioAdjustment">Whether the offset needs to be adjusted to scroll ratio.</param>
+		/// <returns>The offset to draw the bitmap from.</returns>
+		Vector GetDrawOffset(const BITMAP *targetBitmap, const Box &targetBox, Vector offset, bool offsetNeedsScrollRatioAdjustment) const;
+
+		/// <summary>
+		/// Draws this SceneLayer's bitmap to a bitmap from an offset already adjusted with GetDrawOffset.
+		/// </summary>
+		/// <param name="targetBitmap">The bitmap to draw to.</param>
+		/// <param name="targetBox">The box on the target bitmap to limit drawing to, with the corner of box being where the scroll position lines up.</param>
+		/// <param name="drawOffset">The offset to draw the bitmap from.</param>
+		void DrawFromOffset(BITMAP *targetBitmap, const Box &targetBox, const Vector &drawOffset) const;
+
 		/// <summary>
 		/// Performs wrapped drawing of this SceneLayer's bitmap to the screen in cases where it is both wider and taller than the target bitmap.
 		/// </summary>
 		/// <param name="targetBitmap">The bitmap to draw to.</param>
 		/// <param name="targetBox">The box on the target bitmap to limit drawing to, with the corner of box being where the scroll position lines up.</param>
+		/// <param name="drawOffset">The offset to draw the bitmap from.</param>
 		/// <param name="drawScaled">Whether to use scaled drawing routines or not.</param>
-		void DrawWrapped(BITMAP *targetBitmap, const Box &targetBox, bool drawScaled) const;
+		void DrawWrapped(BITMAP *targetBitmap, const Box &targetBox, const Vector &drawOffset, bool drawScaled) const;
 
 		/// <summary>
 		/// Performs tiled drawing of this SceneLayer's bitmap to the screen in cases where the target bitmap is larger in some dimension.
 		/// </summary>
 		/// <param name="targetBitmap">The bitmap to draw to.</param>
 		/// <param name="targetBox">The box on the target bitmap to limit drawing to, with the corner of box being where the scroll position lines up.</param>
+		/// <param name="drawOffset">The offset to draw the bitmap from.</param>
 		/// <param name="drawScaled">Whether to use scaled drawing routines or not.</param>
-		void DrawTiled(BITMAP *targetBitmap, const Box &targetBox, bool drawScaled) const;
+		void DrawTiled(BITMAP *targetBitmap, const Box &targetBox, const Vector &drawOffset, bool drawScaled) const;
 #pragma endregion
 
 	private:
@@ -64,7 +64,10 @@ namespace RTE {
 	int TerrainDebris::ReadProperty(const std::string_view &propName, Reader &reader) {
 		StartPropertyList(return Entity::ReadProperty(propName, reader));
 		
-		MatchProperty("DebrisFile", { reader >> m_DebrisFile; });
+		MatchProperty("DebrisFile", {
+			reader >> m_DebrisFile;
+			m_DebrisFile.QueueImageDecode();
+		});
 		MatchProperty("DebrisPieceCount", {
 			reader >> m_BitmapCount;
 			m_Bitmaps.reserve(m_BitmapCount);
@@ -428,6 +428,13 @@ namespace RTE {
 		/// <param name="particle">A pointer to the particle to be added.</param>
 		static void AddParticle(MovableMan &movableMan, MovableObject *particle);
 
+		/// <summary>
+		/// Gets the regular particles in MovableMan, after promoting any that are simulated in bulk so scripts see and can modify all of them.
+		/// </summary>
+		/// <param name="movableMan">A reference to MovableMan, provided by Lua.</param>
+		/// <returns>A pointer to MovableMan's regular particles.</returns>
+		static std::deque<MovableObject *> * GetParticles(MovableMan &movableMan);
+
 		static void SendGlobalMessage1(MovableMan &movableMan, const std::string& message);
 		static void SendGlobalMessage2(MovableMan &movableMan, const std::string& message, luabind::object context);
 	};
@@ -520,6 +527,13 @@ namespace RTE {
 		/// <param name="boxToWrap">The Box to wrap.</param>
 		/// <returns>A list of Boxes that make up the Box to wrap, wrapped appropriately for the current Scene.</returns>
 		static const std::list<Box> * WrapBoxes(SceneMan &sceneMan, const Box &boxToWrap);
+
+		/// <summary>
+		/// Performs a batch of ray casts from a Lua table of RayQueries, writing the results back to them.
+		/// </summary>
+		/// <param name="sceneMan">A reference to SceneMan, provided by Lua.</param>
+		/// <param name="rayQueriesTable">A Lua table of the RayQueries to perform.</param>
+		static void CastRays(SceneMan &sceneMan, const luabind::object &rayQueriesTable);
 	};
 #pragma endregion
 
@@ -537,6 +537,7 @@ namespace RTE {
 		if (movableMan.ValidMO(movableObject)) {
 			g_ConsoleMan.PrintString("ERROR: Tried to add a MovableObject that already exists in the simulation! " + movableObject->GetPresetName());
 		} else {
+			if (MOPixel *pixel = dynamic_cast<MOPixel *>(movableObject)) { pixel->SetBulkSimulationAllowed(false); }
 			movableMan.AddMO(movableObject);
 		}
 	}
@@ -567,10 +568,19 @@ namespace RTE {
 		if (movableMan.ValidMO(particle)) {
 			g_ConsoleMan.PrintString("ERROR: Tried to add a Particle that already exists in the simulation!" + particle->GetPresetName());
 		} else {
+			// The script may keep a reference to this particle, so it must always be fully simulated to stay up to date.
+			if (MOPixel *pixel = dynamic_cast<MOPixel *>(particle)) { pixel->SetBulkSimulationAllowed(false); }
 			movableMan.AddParticle(particle);
 		}
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::deque<MovableObject *> * LuaAdaptersMovableMan::GetParticles(MovableMan &movableMan) {
+		movableMan.PromoteAllPixelParticles();
+		return &movableMan.m_Particles;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void LuaAdaptersMovableMan::SendGlobalMessage1(MovableMan &movableMan, const std::string &message) {
@@ -653,6 +663,30 @@ namespace RTE {
 		return wrappedBoxes;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void LuaAdaptersSceneMan::CastRays(SceneMan &sceneMan, const luabind::object &rayQueriesTable) {
+		if (!rayQueriesTable.is_valid() || luabind::type(rayQueriesTable) != LUA_TTABLE) {
+			return;
+		}
+		// The queries are cast from a contiguous copy, since Lua owns the originals.
+		std::vector<RayQuery *> luaRayQueries;
+		for (luabind::iterator tableItr(rayQueriesTable), tableEnd; tableItr != tableEnd; ++tableItr) {
+			luaRayQueries.emplace_back(luabind::object_cast<RayQuery *>(*tableItr));
+		}
+		std::vector<RayQuery> rayQueries;
+		rayQueries.reserve(luaRayQueries.size());
+		for (const RayQuery *luaRayQuery : luaRayQueries) {
+			rayQueries.emplace_back(*luaRayQuery);
+		}
+
+		sceneMan.CastRays(rayQueries);
+
+		for (size_t i = 0; i < rayQueries.size(); ++i) {
+			*luaRayQueries[i] = rayQueries[i];
+		}
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void LuaAdaptersPrimitiveMan::DrawPolygonPrimitive(PrimitiveMan &primitiveMan, const Vector &centerPos, int color, const luabind::object &verticesTable) {
@@ -28,6 +28,7 @@ namespace RTE {
 		PER_LUA_BINDING(PresetMan)					\
 		PER_LUA_BINDING(PrimitiveMan)				\
 		PER_LUA_BINDING(SceneMan)					\
+		PER_LUA_BINDING(RayQuery)					\
 		PER_LUA_BINDING(SettingsMan)				\
 		PER_LUA_BINDING(TimerMan)					\
 		PER_LUA_BINDING(UInputMan)					\
@@ -216,6 +217,7 @@ namespace RTE {
 		LuaBindingRegisterFunctionDeclarationForType(PresetMan);
 		LuaBindingRegisterFunctionDeclarationForType(PrimitiveMan);
 		LuaBindingRegisterFunctionDeclarationForType(SceneMan);
+		LuaBindingRegisterFunctionDeclarationForType(RayQuery);
 		LuaBindingRegisterFunctionDeclarationForType(SettingsMan);
 		LuaBindingRegisterFunctionDeclarationForType(TimerMan);
 		LuaBindingRegisterFunctionDeclarationForType(UInputMan);
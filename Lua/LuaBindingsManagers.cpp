@@ -110,7 +110,7 @@ namespace RTE {
 
 		.def_readwrite("Actors", &MovableMan::m_Actors, luabind::return_stl_iterator)
 		.def_readwrite("Items", &MovableMan::m_Items, luabind::return_stl_iterator)
-		.def_readwrite("Particles", &MovableMan::m_Particles, luabind::return_stl_iterator)
+		.property("Particles", &LuaAdaptersMovableMan::GetParticles, luabind::return_stl_iterator)
 		.def_readwrite("AddedActors", &MovableMan::m_AddedActors, luabind::return_stl_iterator)
 		.def_readwrite("AddedItems", &MovableMan::m_AddedItems, luabind::return_stl_iterator)
 		.def_readwrite("AddedParticles", &MovableMan::m_AddedParticles, luabind::return_stl_iterator)
@@ -131,6 +131,11 @@ namespace RTE {
 		.def("GetClosestEnemyActor", &MovableMan::GetClosestEnemyActor)
 		.def("GetFirstTeamActor", &MovableMan::GetFirstTeamActor)
 		.def("GetClosestActor", &MovableMan::GetClosestActor)
+		.def("GetNearestActors", (const std::vector<Actor *> * (MovableMan::*)(const Vector &scenePoint, int count))&MovableMan::GetNearestActors, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
+		.def("GetNearestActors", (const std::vector<Actor *> * (MovableMan::*)(const Vector &scenePoint, int count, float maxRadius))&MovableMan::GetNearestActors, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
+		.def("GetNearestActors", (const std::vector<Actor *> * (MovableMan::*)(const Vector &scenePoint, int count, float maxRadius, int ignoreTeam))&MovableMan::GetNearestActors, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
+		.def("GetActorsInRadius", (const std::vector<Actor *> * (MovableMan::*)(const Vector &centre, float radius))&MovableMan::GetActorsInRadius, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
+		.def("GetActorsInRadius", (const std::vector<Actor *> * (MovableMan::*)(const Vector &centre, float radius, int ignoreTeam))&MovableMan::GetActorsInRadius, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
 		.def("GetClosestBrainActor", &MovableMan::GetClosestBrainActor)
 		.def("GetFirstBrainActor", &MovableMan::GetFirstBrainActor)
 		.def("GetClosestOtherBrainActor", &MovableMan::GetClosestOtherBrainActor)
@@ -156,12 +161,16 @@ namespace RTE {
 		.def("IsParticleSettlingEnabled", &MovableMan::IsParticleSettlingEnabled)
 		.def("EnableParticleSettling", &MovableMan::EnableParticleSettling)
 		.def("IsMOSubtractionEnabled", &MovableMan::IsMOSubtractionEnabled)
-		.def("GetMOsInBox", (const std::vector<MovableObject *> * (MovableMan::*)(const Box &box) const)&MovableMan::GetMOsInBox, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
-		.def("GetMOsInBox", (const std::vector<MovableObject *> * (MovableMan::*)(const Box &box, int ignoreTeam) const)&MovableMan::GetMOsInBox, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
-		.def("GetMOsInBox", (const std::vector<MovableObject *> * (MovableMan::*)(const Box &box, int ignoreTeam, bool getsHitByMOsOnly) const)&MovableMan::GetMOsInBox, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
-		.def("GetMOsInRadius", (const std::vector<MovableObject *> * (MovableMan::*)(const Vector &centre, float radius) const)&MovableMan::GetMOsInRadius, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
-		.def("GetMOsInRadius", (const std::vector<MovableObject *> * (MovableMan::*)(const Vector &centre, float radius, int ignoreTeam) const)&MovableMan::GetMOsInRadius, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
-		.def("GetMOsInRadius", (const std::vector<MovableObject *> * (MovableMan::*)(const Vector &centre, float radius, int ignoreTeam, bool getsHitByMOsOnly) const)&MovableMan::GetMOsInRadius, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
+		.def("IsParallelParticleTravelEnabled", &MovableMan::IsParallelParticleTravelEnabled)
+		.def("EnableParallelParticleTravel", &MovableMan::EnableParallelParticleTravel)
+		.def("IsPixelParticleSystemEnabled", &MovableMan::IsPixelParticleSystemEnabled)
+		.def("EnablePixelParticleSystem", &MovableMan::EnablePixelParticleSystem)
+		.def("GetMOsInBox", (const std::vector<MovableObject *> * (MovableMan::*)(const Box &box))&MovableMan::GetMOsInBox, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
+		.def("GetMOsInBox", (const std::vector<MovableObject *> * (MovableMan::*)(const Box &box, int ignoreTeam))&MovableMan::GetMOsInBox, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
+		.def("GetMOsInBox", (const std::vector<MovableObject *> * (MovableMan::*)(const Box &box, int ignoreTeam, bool getsHitByMOsOnly))&MovableMan::GetMOsInBox, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
+		.def("GetMOsInRadius", (const std::vector<MovableObject *> * (MovableMan::*)(const Vector &centre, float radius))&MovableMan::GetMOsInRadius, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
+		.def("GetMOsInRadius", (const std::vector<MovableObject *> * (MovableMan::*)(const Vector &centre, float radius, int ignoreTeam))&MovableMan::GetMOsInRadius, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
+		.def("GetMOsInRadius", (const std::vector<MovableObject *> * (MovableMan::*)(const Vector &centre, float radius, int ignoreTeam, bool getsHitByMOsOnly))&MovableMan::GetMOsInRadius, luabind::adopt(luabind::return_value) + luabind::return_stl_iterator)
 		
 		.def("SendGlobalMessage", &LuaAdaptersMovableMan::SendGlobalMessage1)
 		.def("SendGlobalMessage", &LuaAdaptersMovableMan::SendGlobalMessage2)
@@ -332,6 +341,7 @@ namespace RTE {
 		.def("CastMORay", &SceneMan::CastMORay)
 		.def("CastFindMORay", &SceneMan::CastFindMORay)
 		.def("CastObstacleRay", &SceneMan::CastObstacleRay)
+		.def("CastRays", &LuaAdaptersSceneMan::CastRays)
 		.def("GetLastRayHitPos", &SceneMan::GetLastRayHitPos)
 		.def("FindAltitude", (float (SceneMan::*) (const Vector&, int, int)) &SceneMan::FindAltitude)
 		.def("FindAltitude", (float (SceneMan::*) (const Vector&, int, int, bool)) &SceneMan::FindAltitude)
@@ -351,6 +361,37 @@ namespace RTE {
 		.def("DislodgePixel", &SceneMan::DislodgePixel);
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	LuaBindingRegisterFunctionDefinitionForType(ManagerLuaBindings, RayQuery) {
+		return luabind::class_<RayQuery>("RayQuery")
+
+		.def(luabind::constructor<>())
+
+		.def_readwrite("Type", &RayQuery::Type)
+		.def_readwrite("Start", &RayQuery::Start)
+		.def_readwrite("Ray", &RayQuery::Ray)
+		.def_readwrite("Skip", &RayQuery::Skip)
+		.def_readwrite("IgnoreMOID", &RayQuery::IgnoreMOID)
+		.def_readwrite("IgnoreTeam", &RayQuery::IgnoreTeam)
+		.def_readwrite("Material", &RayQuery::Material)
+		.def_readwrite("IgnoreAllTerrain", &RayQuery::IgnoreAllTerrain)
+		.def_readwrite("CheckMOs", &RayQuery::CheckMOs)
+		.def_readwrite("Strength", &RayQuery::Strength)
+		.def_readonly("Hit", &RayQuery::Hit)
+		.def_readonly("HitMOID", &RayQuery::HitMOID)
+		.def_readonly("HitPos", &RayQuery::HitPos)
+		.def_readonly("FreePos", &RayQuery::FreePos)
+		.def_readonly("Distance", &RayQuery::Distance)
+
+		.enum_("RayType")[
+			luabind::value("MORay", RayQuery::MORay),
+			luabind::value("ObstacleRay", RayQuery::ObstacleRay),
+			luabind::value("StrengthRay", RayQuery::StrengthRay),
+			luabind::value("NotMaterialRay", RayQuery::NotMaterialRay)
+		];
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	LuaBindingRegisterFunctionDefinitionForType(ManagerLuaBindings, CameraMan) {
@@ -245,6 +245,7 @@ namespace RTE {
 		.def_readonly("PathLength", &PathRequest::pathLength)
 		.def_readonly("Status", &PathRequest::status)
 		.def_readonly("TotalCost", &PathRequest::totalCost)
+		.def_readonly("CostEpoch", &PathRequest::costEpoch)
 
 		.enum_("Status")[
 			luabind::value("Solved", micropather::MicroPather::SOLVED),
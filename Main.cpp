@@ -56,6 +56,17 @@ using namespace RTE;
 
 namespace RTE {
 
+	/// <summary>
+	/// Parameters of a headless benchmark run, as passed in through the "-benchmark" command-line argument.
+	/// </summary>
+	struct BenchmarkSettings {
+		bool Enabled = false; //!< Whether to run the benchmark instead of the game.
+		std::string SceneName; //!< The PresetName of the Scene to benchmark.
+		std::string ActivityName; //!< The PresetName of the Activity to benchmark.
+		int SimUpdateCount = 0; //!< How many simulation updates to run and measure.
+		std::string ReportFilePath = "BenchmarkReport.json"; //!< The file the benchmark report will be written to.
+	} s_BenchmarkSettings;
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	/// <summary>
@@ -133,6 +144,8 @@ namespace RTE {
 		g_FrameMan.Destroy();
 		g_TimerMan.Destroy();
 		g_LuaMan.Destroy();
+		// Sprites that were only loaded during play are added to the sprite cache too, so they don't need decoding next launch either.
+		ContentFile::SaveSpriteCache();
 		ContentFile::FreeAllLoaded();
 		g_ConsoleMan.Destroy();
 		g_WindowMan.Destroy();
@@ -182,6 +195,12 @@ namespace RTE {
 				} else if (!lastArg && currentArg == "-editor") {
 					g_ActivityMan.SetEditorToLaunch(argValue[++i]);
 					launchModeSet = true;
+				} else if (i + 3 < argCount && currentArg == "-benchmark") {
+					s_BenchmarkSettings.SceneName = argValue[++i];
+					s_BenchmarkSettings.ActivityName = argValue[++i];
+					s_BenchmarkSettings.SimUpdateCount = std::atoi(argValue[++i]);
+					s_BenchmarkSettings.Enabled = s_BenchmarkSettings.SimUpdateCount > 0;
+					launchModeSet = s_BenchmarkSettings.Enabled;
 				}
 			}
 			++i;
@@ -189,6 +208,60 @@ namespace RTE {
 		if (launchModeSet) { g_SettingsMan.SetSkipIntro(true); }
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// <summary>
+	/// Headless benchmark loop. Runs the set number of simulation updates of the benchmark Activity back to back with a fixed RNG seed and DeltaTime, without polling input or drawing anything, then writes the performance report.
+	/// </summary>
+	void RunBenchmarkLoop() {
+		// The window is created during manager initialization, but nothing is ever drawn to or presented in it during a benchmark so keep it out of the way.
+		SDL_HideWindow(g_WindowMan.GetWindow());
+
+		if (!g_ActivityMan.SetStartBenchmarkActivity(s_BenchmarkSettings.SceneName, s_BenchmarkSettings.ActivityName)) {
+			return;
+		}
+		g_TimerMan.PauseSim(false);
+
+		// Reseed so Scene loading and Actor placement are reproducible between runs regardless of what consumed random numbers during module loading.
+		SeedRNG();
+		if (!g_ActivityMan.RestartActivity()) {
+			g_ConsoleMan.PrintString("ERROR: Failed to start the benchmark Activity!");
+			return;
+		}
+		g_PerformanceMan.ClearBenchmarkSamples();
+
+		for (int simUpdate = 0; simUpdate < s_BenchmarkSettings.SimUpdateCount && g_ActivityMan.IsInActivity(); ++simUpdate) {
+			ZoneScopedN("Benchmark Simulation Update");
+
+			g_PerformanceMan.NewPerformanceSample();
+			g_TimerMan.UpdateSimFixedStep();
+
+			g_PerformanceMan.StartPerformanceMeasurement(PerformanceMan::SimTotal);
+
+			g_FrameMan.Update();
+			g_LuaMan.Update();
+			g_ActivityMan.Update();
+
+			if (g_SceneMan.GetScene()) {
+				g_SceneMan.GetScene()->Update();
+			}
+
+			g_LuaMan.ClearScriptTimings();
+			g_MovableMan.Update();
+
+			g_ActivityMan.LateUpdateGlobalScripts();
+
+			g_PerformanceMan.StopPerformanceMeasurement(PerformanceMan::SimTotal);
+			g_PerformanceMan.RecordBenchmarkSample();
+		}
+
+		if (g_PerformanceMan.WriteBenchmarkReport(s_BenchmarkSettings.ReportFilePath)) {
+			g_ConsoleMan.PrintString("SYSTEM: Benchmark report written to \"" + s_BenchmarkSettings.ReportFilePath + "\".");
+		} else {
+			g_ConsoleMan.PrintString("ERROR: Failed to write benchmark report to \"" + s_BenchmarkSettings.ReportFilePath + "\"!");
+		}
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	/// <summary>
@@ -237,6 +310,7 @@ namespace RTE {
 	/// Game menus loop.
 	/// </summary>
 	void RunMenuLoop() {
+		g_FrameMan.WaitForPipelinedDraw();
 		g_UInputMan.DisableKeys(false);
 		g_UInputMan.TrapMousePos(false);
 
@@ -360,6 +434,7 @@ namespace RTE {
 					}
 				}
 				if (g_ActivityMan.ActivitySetToRestart()) {
+					g_FrameMan.WaitForPipelinedDraw();
 					g_LoadingScreen.DrawLoadingSplash();
 					g_WindowMan.UploadFrame();
 					if (!g_ActivityMan.RestartActivity()) {
@@ -457,7 +532,9 @@ int main(int argc, char **argv) {
 
 	g_PresetMan.LoadAllDataModules();
 
-	if (!System::IsInExternalModuleValidationMode()) {
+	if (s_BenchmarkSettings.Enabled) {
+		RunBenchmarkLoop();
+	} else if (!System::IsInExternalModuleValidationMode()) {
 		// Load the different input device icons. This can't be done during UInputMan::Create() because the icon presets don't exist so we need to do this after modules are loaded.
 		g_UInputMan.LoadDeviceIcons();
 
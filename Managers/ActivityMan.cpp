@@ -15,6 +15,7 @@
 
 #include "GAScripted.h"
 #include "SLTerrain.h"
+#include "SaveGameArchive.h"
 
 #include "EditorActivity.h"
 #include "SceneEditor.h"
@@ -86,10 +87,17 @@ namespace RTE {
 			return false;
 		}
 
-		// TODO, save to a zip instead of a directory
-		std::filesystem::create_directory(g_PresetMan.GetFullModulePath(c_UserScriptedSavesModuleName) + "/" + fileName);
+		const std::string saveFilePath = g_PresetMan.GetFullModulePath(c_UserScriptedSavesModuleName) + "/" + fileName;
 
-		if (scene->SaveData(c_UserScriptedSavesModuleName + "/" + fileName + "/Save") < 0) {
+		// The archive is shared by all the tasks writing entries to it, and finished by whichever of them lets go of it last.
+		std::shared_ptr<SaveGameArchive> archive = std::make_shared<SaveGameArchive>();
+		// Saves used to be directories full of layer bitmaps, so an outdated one under the same name is removed once the archive replaces it.
+		if (archive->Create(saveFilePath + SaveGameArchive::c_FileExtension, saveFilePath) < 0) {
+			g_ConsoleMan.PrintString("ERROR: Failed to create save game archive while saving!");
+			return false;
+		}
+
+		if (scene->SaveData(c_UserScriptedSavesModuleName + "/" + fileName + SaveGameArchive::c_FileExtension + "/Save", true, archive) < 0) {
 			// This print is actually pointless because game will abort if it fails to save layer bitmaps. It stays here for now because in reality the game doesn't properly abort if the layer bitmaps fail to save. It is what it is.
 			g_ConsoleMan.PrintString("ERROR: Failed to save scene bitmaps while saving!");
 			return false;
@@ -111,7 +119,9 @@ namespace RTE {
 		modifiableScene->GetTerrain()->MigrateToModule(g_PresetMan.GetModuleID(c_UserScriptedSavesModuleName));
 
 		// Block the main thread for a bit to let the Writer access the relevant data.
-		std::unique_ptr<Writer> writer(std::make_unique<Writer>(g_PresetMan.GetFullModulePath(c_UserScriptedSavesModuleName) + "/" + fileName + "/Save.ini"));
+		std::unique_ptr<std::ostringstream> saveDataStream = std::make_unique<std::ostringstream>();
+		std::ostringstream *saveData = saveDataStream.get();
+		std::unique_ptr<Writer> writer(std::make_unique<Writer>(std::move(saveDataStream)));
 		writer->NewPropertyWithValue("Activity", activity);
 
 		// Pull all stuff from MovableMan into the Scene for saving, so existing Actors/ADoors are saved, without transferring ownership, so the game can continue.
@@ -128,9 +138,16 @@ namespace RTE {
 		writer->NewPropertyWithValue("PlaceUnitsIfSceneIsRestarted", g_SceneMan.GetPlaceUnitsOnLoad());
 		writer->NewPropertyWithValue("Scene", modifiableScene.get());
 
-		auto saveWriterData = [](Writer* writerToSave) {
+		std::function<void(Writer *)> saveWriterData = [saveData, archive](Writer* writerToSave) mutable {
+			// The Writer owns the stream and destroys it when ending the write, so take what was written first.
+			std::string saveDataText = saveData->str();
 			writerToSave->EndWrite();
+			if (!archive->WriteTextEntry(SaveGameArchive::c_SaveDataEntryName, saveDataText)) {
+				RTEAbort("Failed to save game data to save game archive entry: " + archive->GetEntryPath(SaveGameArchive::c_SaveDataEntryName));
+			}
 			delete writerToSave;
+			// Let go of the archive before the task is done, so that whoever waits on the save game task finds it finished once the last entry is written.
+			archive.reset();
 		};
 
 		// For some reason I can't std::move a unique ptr in, so just releasing and deleting manually...
@@ -148,15 +165,27 @@ namespace RTE {
 	bool ActivityMan::LoadAndLaunchGame(const std::string &fileName) {	
 		m_SaveGameTask.wait();
 
-		std::string saveFilePath = g_PresetMan.GetFullModulePath(c_UserScriptedSavesModuleName) + "/" + fileName + "/Save.ini";
-
-		if (!std::filesystem::exists(saveFilePath)) {
+		const std::string saveFilePath = g_PresetMan.GetFullModulePath(c_UserScriptedSavesModuleName) + "/" + fileName;
+		const std::string archivePath = saveFilePath + SaveGameArchive::c_FileExtension;
+
+		Reader reader;
+		if (std::filesystem::exists(archivePath)) {
+			// Everything is read straight out of the archive. The layer bitmaps are handed to ContentFile so the Scene picks them up when it's loaded, instead of looking for them on disk.
+			std::string saveData;
+			if (!SaveGameArchive::ReadTextEntry(archivePath, SaveGameArchive::c_SaveDataEntryName, saveData) || !SaveGameArchive::PreloadBitmapEntries(archivePath)) {
+				ContentFile::FreePreloadedBitmaps();
+				RTEError::ShowMessageBox("Game loading failed! The saved game \"" + fileName + "\" is corrupt.");
+				return false;
+			}
+			reader.Create(std::make_unique<ReaderStream>(std::make_shared<const std::string>(std::move(saveData))), SaveGameArchive::GetEntryPath(archivePath, SaveGameArchive::c_SaveDataEntryName), true, nullptr, false);
+		} else if (std::filesystem::exists(saveFilePath + "/Save.ini")) {
+			// Saves from before they were archived are directories holding the data file and the layer bitmaps as separate files.
+			reader.Create(saveFilePath + "/Save.ini", true, nullptr, false);
+		} else {
 			RTEError::ShowMessageBox("Game loading failed! Make sure you have a saved game called \"" + fileName + "\"");
 			return false;
 		}
 
-		Reader reader(saveFilePath, true, nullptr, false);
-
 		std::unique_ptr<Scene> scene(std::make_unique<Scene>());
 		std::unique_ptr<GAScripted> activity(std::make_unique<GAScripted>());
 
@@ -185,6 +214,8 @@ namespace RTE {
 		scene->SetPresetName(originalScenePresetName);
 		// For starting Activity, we need to directly clone the Activity we want to start.
 		StartActivity(dynamic_cast<GAScripted*>(activity->Clone()));
+		// The Scene was loaded when the Activity started, so any preloaded bitmaps it didn't take aren't needed.
+		ContentFile::FreePreloadedBitmaps();
 		// When this method exits, our Scene object will be destroyed, which will cause problems if you try to restart it. To avoid this, set the Scene to load to the preset object with the same name.
 		g_SceneMan.SetSceneToLoad(originalScenePresetName, placeObjectsIfSceneIsRestarted, placeUnitsIfSceneIsRestarted);
 
@@ -207,6 +238,22 @@ namespace RTE {
 		g_SceneMan.SetSceneToLoad("Tutorial Bunker");
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool ActivityMan::SetStartBenchmarkActivity(const std::string &sceneName, const std::string &activityName) {
+		const Activity *activityPreset = dynamic_cast<const Activity *>(g_PresetMan.GetEntityPreset("Activity", activityName));
+		if (!activityPreset) {
+			g_ConsoleMan.PrintString("ERROR: Finding Activity preset \'" + activityName + "\' for benchmark failed! Has it been properly defined?");
+			return false;
+		}
+		if (g_SceneMan.SetSceneToLoad(sceneName) < 0) {
+			return false;
+		}
+		SetStartActivity(dynamic_cast<Activity *>(activityPreset->Clone()));
+		m_ActivityNeedsRestart = true;
+		return true;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void ActivityMan::SetStartEditorActivity(const std::string_view &editorToLaunch) {
@@ -197,6 +197,14 @@ namespace RTE {
 		/// </summary>
 		void SetStartTutorialActivity();
 
+		/// <summary>
+		/// Loads the specified Scene and starts the specified Activity preset. Used for headless benchmark runs.
+		/// </summary>
+		/// <param name="sceneName">The PresetName of the Scene to load.</param>
+		/// <param name="activityName">The PresetName of the Activity to start.</param>
+		/// <returns>Whether both presets were found and the Activity was set to be launched next time ResetActivity is called.</returns>
+		bool SetStartBenchmarkActivity(const std::string &sceneName, const std::string &activityName);
+
 		/// <summary>
 		/// Loads "Editor Scene" and starts the given editor Activity.
 		/// </summary>
@@ -6,6 +6,8 @@
 #include "PrimitiveMan.h"
 #include "PerformanceMan.h"
 #include "ActivityMan.h"
+#include "MovableMan.h"
+#include "ThreadMan.h"
 #include "CameraMan.h"
 #include "ConsoleMan.h"
 #include "SettingsMan.h"
@@ -63,6 +65,9 @@ namespace RTE {
 		m_StoreNetworkBackBuffer = false;
 		m_NetworkFrameCurrent = 0;
 		m_NetworkFrameReady = 1;
+		m_PipelinedDrawingEnabled = false;
+		m_PipelinedFramePending = false;
+		m_PipelinedScreenCount = 0;
 		m_PaletteFile = ContentFile("Base.rte/palette.bmp");
 		m_BlackColor = 245;
 		m_AlmostBlackColor = 245;
@@ -81,12 +86,15 @@ namespace RTE {
 			m_FlashScreenColor[screenCount] = -1;
 			m_FlashedLastFrame[screenCount] = false;
 			m_FlashTimer[screenCount].Reset();
+			m_PipelinedGUIScreens[screenCount].reset();
+			m_NetworkFrameMODrawingsIntermediate[screenCount] = NetworkFrameMODrawings();
 
 			for (int bufferFrame = 0; bufferFrame < 2; bufferFrame++) {
 				m_NetworkBackBufferIntermediate8[bufferFrame][screenCount].reset();
 				m_NetworkBackBufferFinal8[bufferFrame][screenCount].reset();
 				m_NetworkBackBufferIntermediateGUI8[bufferFrame][screenCount].reset();
 				m_NetworkBackBufferFinalGUI8[bufferFrame][screenCount].reset();
+				m_NetworkFrameMODrawings[bufferFrame][screenCount] = NetworkFrameMODrawings();
 			}
 		}
 	}
@@ -122,6 +130,8 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	int FrameMan::CreateBackBuffers() {
+		WaitForPipelinedDraw();
+
 		int resX = g_WindowMan.GetResX();
 		int resY = g_WindowMan.GetResY();
 
@@ -195,6 +205,8 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void FrameMan::Destroy() {
+		WaitForPipelinedDraw(false);
+
 		for (const GUIScreen *guiScreen : m_GUIScreens) {
 			delete guiScreen;
 		}
@@ -244,6 +256,8 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void FrameMan::ResetSplitScreens(bool hSplit, bool vSplit) {
+		WaitForPipelinedDraw();
+
 		if (m_PlayerScreen) { release_bitmap(m_PlayerScreen.get()); }
 
 		// Override screen splitting according to settings if needed
@@ -510,6 +524,8 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	int FrameMan::SaveBitmap(SaveBitmapMode modeToSave, const std::string &nameBase, BITMAP *bitmapToSave) {
+		WaitForPipelinedDraw();
+
 		if ((modeToSave == WorldDump || modeToSave == ScenePreviewDump) && !g_ActivityMan.ActivityRunning()) {
 			return 0;
 		}
@@ -811,6 +827,12 @@ namespace RTE {
 	void FrameMan::Draw() {
 		ZoneScopedN("Draw");
 
+		if (m_PipelinedDrawingEnabled && CanDrawPipelined()) {
+			DrawPipelined();
+			return;
+		}
+		WaitForPipelinedDraw();
+
 		// Count how many split screens we'll need
 		int screenCount = (m_HSplit ? 2 : 1) * (m_VSplit ? 2 : 1);
 		RTEAssert(screenCount <= 1 || m_PlayerScreen, "Splitscreen surface not ready when needed!");
@@ -872,6 +894,14 @@ namespace RTE {
 				g_SceneMan.Draw(drawScreen, drawScreenGUI, targetPos);
 			} else {
 				g_SceneMan.Draw(drawScreen, drawScreenGUI, targetPos, true, true);
+
+				NetworkFrameMODrawings &moDrawings = m_NetworkFrameMODrawingsIntermediate[playerScreen];
+				moDrawings.Drawings.clear();
+				moDrawings.IsComplete = g_SceneMan.GetMOColorLayerDrawingsOnTarget(drawScreen, moDrawings.Drawings, moDrawings.OriginX, moDrawings.OriginY);
+				moDrawings.SceneWidth = g_SceneMan.GetSceneWidth();
+				moDrawings.SceneHeight = g_SceneMan.GetSceneHeight();
+				moDrawings.WrapsX = g_SceneMan.SceneWrapsX();
+				moDrawings.WrapsY = g_SceneMan.SceneWrapsY();
 			}
 
 			// Get only the scene-relative post effects that affect this player's screen
@@ -1010,6 +1040,149 @@ namespace RTE {
 		}
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void FrameMan::WaitForPipelinedDraw(bool finishPendingFrame) {
+		if (finishPendingFrame) {
+			PresentPipelinedFrame();
+			return;
+		}
+		if (m_PipelinedDrawTask.valid()) { m_PipelinedDrawTask.get(); }
+		m_PipelinedFramePending = false;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool FrameMan::CanDrawPipelined() const {
+		if (IsInMultiplayerMode() || m_StoreNetworkBackBuffer || m_DrawNetworkBackBuffer || !g_ActivityMan.IsInActivity() || !g_SceneMan.GetScene()) {
+			return false;
+		}
+		int screenCount = (m_HSplit ? 2 : 1) * (m_VSplit ? 2 : 1);
+		return g_SceneMan.GetLayerDrawMode() == LayerDrawMode::g_LayerNormal && (screenCount == 1 || m_PlayerScreen);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void FrameMan::DrawPipelined() {
+		bool hadPendingFrame = m_PipelinedFramePending;
+		if (hadPendingFrame) { PresentPipelinedFrame(); }
+
+		m_PipelinedScreenCount = (m_HSplit ? 2 : 1) * (m_VSplit ? 2 : 1);
+
+		g_PostProcessMan.ClearScreenPostEffects();
+
+		// These accumulate the effects for each player's screen area, and are then transferred to the post-processing lists with the player screen offset applied
+		std::list<PostEffect> screenRelativeEffects;
+		std::list<Box> screenRelativeGlowBoxes;
+
+		Activity *activity = g_ActivityMan.GetActivity();
+
+		// Everything the simulation may change while the render thread draws is drawn to the GUI screens or captured here, on the main thread.
+		for (int playerScreen = 0; playerScreen < m_PipelinedScreenCount; ++playerScreen) {
+			screenRelativeEffects.clear();
+			screenRelativeGlowBoxes.clear();
+
+			BITMAP *drawScreen = (m_PipelinedScreenCount == 1) ? m_BackBuffer8.get() : m_PlayerScreen.get();
+			std::unique_ptr<BITMAP, BitmapDeleter> &guiScreen = m_PipelinedGUIScreens[playerScreen];
+			if (!guiScreen || guiScreen->w != drawScreen->w || guiScreen->h != drawScreen->h) {
+				guiScreen = std::unique_ptr<BITMAP, BitmapDeleter>(create_bitmap_ex(8, drawScreen->w, drawScreen->h));
+			}
+			clear_to_color(guiScreen.get(), ColorKeys::g_MaskColor);
+
+			AllegroBitmap playerGUIBitmap(guiScreen.get());
+
+			PipelinedScreenState &screenState = m_PipelinedScreenStates[playerScreen];
+			screenState.m_Offset = g_CameraMan.GetOffset(playerScreen);
+			screenState.m_UnwrappedOffset = g_CameraMan.GetUnwrappedOffset(playerScreen);
+			screenState.m_Team = g_CameraMan.GetScreenTeam(playerScreen);
+			screenState.m_ScreenOffset.Reset();
+
+			// Updating the layers animates the background layers, which uses the simulation's random number generator, so it's done here instead of on the render thread.
+			g_SceneMan.UpdatePipelinedLayers(screenState.m_Offset, screenState.m_UnwrappedOffset, screenState.m_BackgroundLayerOffsets);
+
+			Vector targetPos = screenState.m_Offset;
+			if (!g_SceneMan.SceneWrapsX() && drawScreen->w > g_SceneMan.GetSceneWidth()) { targetPos.m_X += (drawScreen->w - g_SceneMan.GetSceneWidth()) / 2; }
+			if (!g_SceneMan.SceneWrapsY() && drawScreen->h > g_SceneMan.GetSceneHeight()) { targetPos.m_Y += (drawScreen->h - g_SceneMan.GetSceneHeight()) / 2; }
+
+			g_MovableMan.DrawHUD(guiScreen.get(), targetPos, playerScreen);
+			g_PrimitiveMan.DrawPrimitives(playerScreen, guiScreen.get(), targetPos);
+			activity->DrawGUI(guiScreen.get(), targetPos, playerScreen);
+
+			g_PostProcessMan.GetPostScreenEffectsWrapped(targetPos, drawScreen->w, drawScreen->h, screenRelativeEffects, activity->GetTeamOfPlayer(activity->PlayerOfScreen(playerScreen)));
+			g_PostProcessMan.GetGlowAreasWrapped(targetPos, drawScreen->w, drawScreen->h, screenRelativeGlowBoxes);
+
+			DrawScreenText(playerScreen, playerGUIBitmap);
+
+			if (m_PipelinedScreenCount > 1) { UpdateScreenOffsetForSplitScreen(playerScreen, screenState.m_ScreenOffset); }
+
+			DrawScreenFlash(playerScreen, guiScreen.get());
+
+			g_PostProcessMan.AdjustEffectsPosToPlayerScreen(playerScreen, drawScreen, screenState.m_ScreenOffset, screenRelativeEffects, screenRelativeGlowBoxes);
+		}
+
+		g_SceneMan.UpdateCleanAir();
+		SceneLayerTracked *moColorLayer = g_SceneMan.PublishMOColorLayer();
+
+		// Clears the pixels that have been revealed from the unseen layers
+		g_SceneMan.ClearSeenPixels();
+
+		m_PipelinedFramePending = true;
+		m_PipelinedDrawTask = g_ThreadMan.GetPriorityThreadPool().submit([this, moColorLayer]() { DrawPipelinedWorldLayers(moColorLayer); });
+
+		// Without a pending frame there's nothing to present yet, so this one is finished right away instead of presenting a stale backbuffer.
+		if (!hadPendingFrame) { PresentPipelinedFrame(); }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void FrameMan::DrawPipelinedWorldLayers(SceneLayerTracked *moColorLayer) {
+		ZoneScopedN("Draw Pipelined World Layers");
+
+		for (int playerScreen = 0; playerScreen < m_PipelinedScreenCount; ++playerScreen) {
+			BITMAP *drawScreen = (m_PipelinedScreenCount == 1) ? m_BackBuffer8.get() : m_PlayerScreen.get();
+			const PipelinedScreenState &screenState = m_PipelinedScreenStates[playerScreen];
+
+			// Need to clear the backbuffers because Scene background layers can be too small to fill the whole backbuffer or drawn masked resulting in artifacts from the previous frame.
+			clear_to_color(drawScreen, m_BlackColor);
+
+			g_SceneMan.DrawPipelined(drawScreen, screenState.m_Offset, screenState.m_BackgroundLayerOffsets, screenState.m_Team, moColorLayer);
+
+			set_clip_state(drawScreen, 1);
+			masked_blit(m_PipelinedGUIScreens[playerScreen].get(), drawScreen, 0, 0, 0, 0, drawScreen->w, drawScreen->h);
+
+			if (m_PipelinedScreenCount > 1) {
+				// Draw the intermediate draw splitscreen to the appropriate spot on the back buffer
+				blit(drawScreen, m_BackBuffer8.get(), 0, 0, screenState.m_ScreenOffset.GetFloorIntX(), screenState.m_ScreenOffset.GetFloorIntY(), drawScreen->w, drawScreen->h);
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void FrameMan::PresentPipelinedFrame() {
+		if (m_PipelinedDrawTask.valid()) { m_PipelinedDrawTask.get(); }
+		if (!m_PipelinedFramePending) {
+			return;
+		}
+		m_PipelinedFramePending = false;
+
+		// Draw separating lines for split-screens
+		if (m_HSplit) {
+			hline(m_BackBuffer8.get(), 0, (m_BackBuffer8->h / 2) - 1, m_BackBuffer8->w - 1, m_AlmostBlackColor);
+			hline(m_BackBuffer8.get(), 0, (m_BackBuffer8->h / 2), m_BackBuffer8->w - 1, m_AlmostBlackColor);
+		}
+		if (m_VSplit) {
+			vline(m_BackBuffer8.get(), (m_BackBuffer8->w / 2) - 1, 0, m_BackBuffer8->h - 1, m_AlmostBlackColor);
+			vline(m_BackBuffer8.get(), (m_BackBuffer8->w / 2), 0, m_BackBuffer8->h - 1, m_AlmostBlackColor);
+		}
+
+		g_PostProcessMan.PostProcess();
+
+		// Draw the performance stats and console on top of everything.
+		g_PerformanceMan.Draw(m_BackBuffer32.get());
+		g_ConsoleMan.Draw(m_BackBuffer32.get());
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void FrameMan::DrawWorldDump(bool drawForScenePreview) const {
@@ -1083,6 +1256,8 @@ namespace RTE {
 			m_NetworkBitmapLock[i].lock();
 			blit(m_NetworkBackBufferIntermediate8[m_NetworkFrameCurrent][i].get(), m_NetworkBackBufferFinal8[m_NetworkFrameCurrent][i].get(), 0, 0, 0, 0, m_NetworkBackBufferFinal8[m_NetworkFrameCurrent][i]->w, m_NetworkBackBufferFinal8[m_NetworkFrameCurrent][i]->h);
 			blit(m_NetworkBackBufferIntermediateGUI8[m_NetworkFrameCurrent][i].get(), m_NetworkBackBufferFinalGUI8[m_NetworkFrameCurrent][i].get(), 0, 0, 0, 0, m_NetworkBackBufferFinalGUI8[m_NetworkFrameCurrent][i]->w, m_NetworkBackBufferFinalGUI8[m_NetworkFrameCurrent][i]->h);
+			std::swap(m_NetworkFrameMODrawings[m_NetworkFrameCurrent][i], m_NetworkFrameMODrawingsIntermediate[i]);
+			m_NetworkFrameMODrawingsIntermediate[i].IsComplete = false;
 			m_NetworkBitmapLock[i].unlock();
 
 #ifndef RELEASE_BUILD
@@ -13,6 +13,7 @@ namespace RTE {
 	class AllegroBitmap;
 	class GUIFont;
 	class ScreenShader;
+	class SceneLayerTracked;
 
 	struct BitmapDeleter {
 		void operator() (BITMAP *bitmap) const;
@@ -29,6 +30,20 @@ namespace RTE {
 
 		static constexpr int c_BPP = 32; //!< Color depth (bits per pixel).
 
+		/// <summary>
+		/// Where the MOs drawn on a network player's frame are, so the server can work out which parts of the frame changed since the last one it sent without comparing them.
+		/// </summary>
+		struct NetworkFrameMODrawings {
+			bool IsComplete = false; //!< Whether Drawings covers everything drawn on the frame's MO layer. If not, the whole frame needs to be treated as changed.
+			std::vector<IntRect> Drawings; //!< The areas MOs were drawn within, in frame pixels. Bounds are inclusive.
+			int OriginX = 0; //!< X position on the frame the Scene's left edge was drawn at, before wrapping.
+			int OriginY = 0; //!< Y position on the frame the Scene's top edge was drawn at, before wrapping.
+			int SceneWidth = 0; //!< Width of the Scene, which is the period positions on the frame wrap around at if it wraps horizontally.
+			int SceneHeight = 0; //!< Height of the Scene, which is the period positions on the frame wrap around at if it wraps vertically.
+			bool WrapsX = false; //!< Whether the Scene wraps horizontally.
+			bool WrapsY = false; //!< Whether the Scene wraps vertically.
+		};
+
 		Vector SLOffset[c_MaxScreenCount][c_MaxLayersStoredForNetwork]; //!< SceneLayer offsets for each screen in online multiplayer.
 
 #pragma region Creation
@@ -64,8 +79,16 @@ namespace RTE {
 
 		/// <summary>
 		/// Draws the current frame to the screen.
+		/// If pipelined drawing is enabled and possible, this instead presents the previous frame and hands the world layers of the current frame over to a render thread, to be drawn while the next frame is simulated.
 		/// </summary>
 		void Draw();
+
+		/// <summary>
+		/// Waits for the render thread to finish drawing a pipelined frame, if it's drawing one, and post-processes that frame so it isn't lost.
+		/// Must be called before anything the render thread reads (Scene layers, backbuffers and player screens) is deleted or re-created.
+		/// </summary>
+		/// <param name="finishPendingFrame">Whether to post-process the pending frame. Only skip this while shutting down, when the frame will never be shown and what post-processing needs may already be destroyed.</param>
+		void WaitForPipelinedDraw(bool finishPendingFrame = true);
 #pragma endregion
 
 #pragma region Getters
@@ -88,6 +111,20 @@ namespace RTE {
 		BITMAP * GetOverlayBitmap32() const { return m_OverlayBitmap32.get(); }
 #pragma endregion
 
+#pragma region Pipelined Drawing Handling
+		/// <summary>
+		/// Gets whether the world layers of each frame are drawn on a render thread while the next frame is simulated, at the cost of a frame of latency.
+		/// </summary>
+		/// <returns>Whether pipelined drawing is enabled.</returns>
+		bool IsPipelinedDrawingEnabled() const { return m_PipelinedDrawingEnabled; }
+
+		/// <summary>
+		/// Sets whether the world layers of each frame are drawn on a render thread while the next frame is simulated, at the cost of a frame of latency.
+		/// </summary>
+		/// <param name="enable">Whether to enable pipelined drawing.</param>
+		void SetPipelinedDrawingEnabled(bool enable) { m_PipelinedDrawingEnabled = enable; }
+#pragma endregion
+
 #pragma region Split-Screen Handling
 		/// <summary>
 		/// Gets whether the screen is split horizontally across the screen, ie as two splitscreens one above the other.
@@ -370,6 +407,13 @@ namespace RTE {
 		/// <returns>A pointer to the 8bpp intermediate GUI BITMAP. OWNERSHIP IS NOT TRANSFERRED!</returns>
 		BITMAP * GetNetworkBackBufferIntermediateGUI8Current(int player) const { return m_NetworkBackBufferIntermediateGUI8[m_NetworkFrameCurrent][player].get(); }
 
+		/// <summary>
+		/// Gets where the MOs were drawn on the ready frame of a network player. This goes along with the ready backbuffer bitmaps and is swapped out with them.
+		/// </summary>
+		/// <param name="player">Which player screen to get the MO drawings for.</param>
+		/// <returns>The MO drawings of the ready frame.</returns>
+		const NetworkFrameMODrawings & GetNetworkFrameMODrawingsReady(int player) const { return m_NetworkFrameMODrawings[m_NetworkFrameReady][player]; }
+
 		// TODO: Figure out.
 		/// <summary>
 		///
@@ -525,6 +569,8 @@ namespace RTE {
 		std::unique_ptr<BITMAP, BitmapDeleter> m_NetworkBackBufferFinalGUI8[2][c_MaxScreenCount]; //!< Per-player allocated frame buffer to copy Intermediate before sending. Used to draw UI only.
 
 		Vector m_TargetPos[2][c_MaxScreenCount]; //!< Frame target position for network players.
+		NetworkFrameMODrawings m_NetworkFrameMODrawings[2][c_MaxScreenCount]; //!< Where the MOs were drawn on each network player's frame.
+		NetworkFrameMODrawings m_NetworkFrameMODrawingsIntermediate[c_MaxScreenCount]; //!< Where the MOs were drawn on each network player's intermediate frame, moved to m_NetworkFrameMODrawings along with the frame.
 
 		bool m_StoreNetworkBackBuffer; //!< If true, dumps the contents of the m_BackBuffer8 to the network backbuffers every frame.
 		bool m_DrawNetworkBackBuffer; //!< If true, draws the contents of the network backbuffers on top of m_BackBuffer8 every frame in FrameMan.Draw.
@@ -534,6 +580,24 @@ namespace RTE {
 
 		std::mutex m_NetworkBitmapLock[c_MaxScreenCount]; //!< Mutex lock for thread safe updating of the network backbuffer bitmaps.
 
+		/// <summary>
+		/// The state of a player screen captured on the main thread, for the render thread to draw the world layers of a pipelined frame with.
+		/// </summary>
+		struct PipelinedScreenState {
+			Vector m_Offset; //!< The camera offset of the screen.
+			Vector m_UnwrappedOffset; //!< The camera offset of the screen without wrapping applied.
+			Vector m_ScreenOffset; //!< The position of the screen on the backbuffer.
+			int m_Team; //!< The team whose unseen layer is drawn on the screen.
+			std::vector<Vector> m_BackgroundLayerOffsets; //!< The offset each background layer of the Scene is drawn at on the screen, as updated on the main thread.
+		};
+
+		bool m_PipelinedDrawingEnabled; //!< Whether the world layers of each frame are drawn on a render thread while the next frame is simulated, at the cost of a frame of latency.
+		bool m_PipelinedFramePending; //!< Whether a pipelined frame was handed over to the render thread and still needs to be post-processed and presented.
+		int m_PipelinedScreenCount; //!< How many player screens the pending pipelined frame has.
+		std::future<void> m_PipelinedDrawTask; //!< The render thread task drawing the world layers of the pending pipelined frame.
+		std::array<PipelinedScreenState, c_MaxScreenCount> m_PipelinedScreenStates; //!< The captured state of each player screen of the pending pipelined frame.
+		std::array<std::unique_ptr<BITMAP, BitmapDeleter>, c_MaxScreenCount> m_PipelinedGUIScreens; //!< The bitmaps the GUI of each player screen of a pipelined frame is drawn to on the main thread, to be drawn over its world layers by the render thread.
+
 #pragma region Initialize Breakdown
 		/// <summary>
 		/// Creates all the frame buffer bitmaps to be used by FrameMan. This is called during Initialize().
@@ -575,6 +639,30 @@ namespace RTE {
 		void PrepareFrameForNetwork();
 #pragma endregion
 
+#pragma region Pipelined Draw Breakdown
+		/// <summary>
+		/// Gets whether the current frame can be drawn pipelined. Multiplayer, network backbuffers and the debug layer draw modes always draw serially.
+		/// </summary>
+		/// <returns>Whether the current frame can be drawn pipelined.</returns>
+		bool CanDrawPipelined() const;
+
+		/// <summary>
+		/// Presents the pending pipelined frame, if any, then captures everything the current frame needs from the simulation and hands its world layers over to the render thread. This is called during Draw().
+		/// </summary>
+		void DrawPipelined();
+
+		/// <summary>
+		/// Draws the world layers of the pending pipelined frame to the backbuffer, with its GUI on top. This runs on the render thread.
+		/// </summary>
+		/// <param name="moColorLayer">The color MO layer published for the pending pipelined frame.</param>
+		void DrawPipelinedWorldLayers(SceneLayerTracked *moColorLayer);
+
+		/// <summary>
+		/// Waits for the render thread to finish the pending pipelined frame, if there is one, then post-processes it and draws the performance stats and console on top. This is called during DrawPipelined() and WaitForPipelinedDraw().
+		/// </summary>
+		void PresentPipelinedFrame();
+#pragma endregion
+
 #pragma region Screen Capture
 		/// <summary>
 		/// Draws the current frame of the whole scene to a temporary buffer that is later saved as a screenshot.
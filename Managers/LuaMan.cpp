@@ -161,6 +161,7 @@ namespace RTE {
 			RegisterLuaBindingsOfType(ManagerLuaBindings, PresetMan),
 			RegisterLuaBindingsOfType(ManagerLuaBindings, PrimitiveMan),
 			RegisterLuaBindingsOfType(ManagerLuaBindings, SceneMan),
+			RegisterLuaBindingsOfType(ManagerLuaBindings, RayQuery),
 			RegisterLuaBindingsOfType(ManagerLuaBindings, SettingsMan),
 			RegisterLuaBindingsOfType(ManagerLuaBindings, TimerMan),
 			RegisterLuaBindingsOfType(ManagerLuaBindings, UInputMan),
@@ -86,10 +86,18 @@ void MovableMan::Clear()
     m_AddedAlarmEvents.clear();
     m_AlarmEvents.clear();
     m_MOIDIndex.clear();
+    m_StaleOccupancyMasks.clear();
+    m_AnyOccupancyMaskStale = false;
+    m_AllOccupancyMasksStale = true;
+    m_FirstPixelParticleMOID = g_NoMOID;
     m_SplashRatio = 0.75;
 	m_MaxDroppedItems = 100;
     m_SettlingEnabled = true;
     m_MOSubtractionEnabled = true;
+    m_ParallelParticleTravelEnabled = false;
+    m_PixelParticleSystemEnabled = true;
+    m_UpdatingParticles = false;
+    m_ActorProximityGridIsCurrent = false;
 }
 
 
@@ -143,9 +151,12 @@ int MovableMan::Save(Writer &writer) const
     for (std::deque<Actor *>::const_iterator itr = m_Actors.begin(); itr != m_Actors.end(); ++itr)
         writer << **itr;
 
-    writer << m_Particles.size();
+    m_PixelParticles.SyncAllToObjects();
+    writer << (m_Particles.size() + m_PixelParticles.GetParticleCount());
     for (std::deque<MovableObject *>::const_iterator itr2 = m_Particles.begin(); itr2 != m_Particles.end(); ++itr2)
         writer << **itr2;
+    for (const MOPixel *pixelParticle : m_PixelParticles.GetParticleObjects())
+        writer << *pixelParticle;
 
     return 0;
 }
@@ -158,6 +169,7 @@ int MovableMan::Save(Writer &writer) const
 
 void MovableMan::Destroy()
 {
+    PromoteAllPixelParticles();
     for (std::deque<Actor *>::iterator it1 = m_Actors.begin(); it1 != m_Actors.end(); ++it1)
         delete (*it1);
     for (std::deque<MovableObject *>::iterator it2 = m_Items.begin(); it2 != m_Items.end(); ++it2)
@@ -206,6 +218,33 @@ MOID MovableMan::GetMOIDPixel(int pixelX, int pixelY, const std::vector<int> &mo
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+bool MovableMan::AreOccupancyMasksCurrent(const std::vector<int> &moidList) const {
+    if (m_AllOccupancyMasksStale) {
+        return false;
+    } else if (!m_AnyOccupancyMaskStale) {
+        return true;
+    }
+    return std::none_of(moidList.begin(), moidList.end(), [this](MOID moid) {
+        return moid >= 0 && moid < static_cast<int>(m_StaleOccupancyMasks.size()) && m_StaleOccupancyMasks[moid];
+    });
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void MovableMan::UpdateStaleOccupancyMasks(MOID firstMOID, int moidCount, bool checkIfCurrent) {
+    if (firstMOID == g_NoMOID || firstMOID < 0) {
+        return;
+    }
+    int lastMOID = std::min(firstMOID + moidCount, static_cast<int>(m_StaleOccupancyMasks.size()));
+    for (int moid = firstMOID; moid < lastMOID; ++moid) {
+        const MovableObject *mo = m_MOIDIndex[moid];
+        m_StaleOccupancyMasks[moid] = (mo && (!checkIfCurrent || !mo->IsOccupancyMaskCurrent())) ? 1 : 0;
+    }
+    m_AnyOccupancyMaskStale = true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          RegisterObject
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -219,8 +258,9 @@ void MovableMan::RegisterObject(MovableObject * mo)
         return;
     }
 
-    std::lock_guard<std::mutex> guard(m_ObjectRegisteredMutex);
-    m_KnownObjects[mo->GetUniqueID()] = mo;
+    KnownObjectsShard &knownObjectsShard = GetKnownObjectsShard(mo->GetUniqueID());
+    std::lock_guard<std::mutex> guard(knownObjectsShard.Mutex);
+    knownObjectsShard.Objects[mo->GetUniqueID()] = mo;
 }
 
 
@@ -237,23 +277,32 @@ void MovableMan::UnregisterObject(MovableObject * mo)
         return;
     }
 
-    std::lock_guard<std::mutex> guard(m_ObjectRegisteredMutex);
-    m_KnownObjects.erase(mo->GetUniqueID());
+    KnownObjectsShard &knownObjectsShard = GetKnownObjectsShard(mo->GetUniqueID());
+    std::lock_guard<std::mutex> guard(knownObjectsShard.Mutex);
+    knownObjectsShard.Objects.erase(mo->GetUniqueID());
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-const std::vector<MovableObject *> * MovableMan::GetMOsInBox(const Box &box, int ignoreTeam, bool getsHitByMOsOnly) const {
+const std::vector<MovableObject *> * MovableMan::GetMOsInBox(const Box &box, int ignoreTeam, bool getsHitByMOsOnly) {
     std::vector<MovableObject *> *vectorForLua = new std::vector<MovableObject *>();
     *vectorForLua = std::move(g_SceneMan.GetMOIDGrid().GetMOsInBox(box, ignoreTeam, getsHitByMOsOnly));
+    // The found MOs are handed to Lua, so any bulk-simulated particles among them have to be promoted to keep their MOPixels up to date
+    for (const MovableObject *mo : *vectorForLua) {
+        PromotePixelParticle(mo);
+    }
     return vectorForLua;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-const std::vector<MovableObject *> * MovableMan::GetMOsInRadius(const Vector &centre, float radius, int ignoreTeam, bool getsHitByMOsOnly) const {
+const std::vector<MovableObject *> * MovableMan::GetMOsInRadius(const Vector &centre, float radius, int ignoreTeam, bool getsHitByMOsOnly) {
     std::vector<MovableObject *> *vectorForLua = new std::vector<MovableObject *>();
     *vectorForLua = std::move(g_SceneMan.GetMOIDGrid().GetMOsInRadius(centre, radius, ignoreTeam, getsHitByMOsOnly));
+    // The found MOs are handed to Lua, so any bulk-simulated particles among them have to be promoted to keep their MOPixels up to date
+    for (const MovableObject *mo : *vectorForLua) {
+        PromotePixelParticle(mo);
+    }
     return vectorForLua;
 }
 
@@ -265,6 +314,7 @@ const std::vector<MovableObject *> * MovableMan::GetMOsInRadius(const Vector &ce
 
 void MovableMan::PurgeAllMOs()
 {
+    PromoteAllPixelParticles();
     for (std::deque<Actor*>::iterator itr = m_Actors.begin(); itr != m_Actors.end(); ++itr) {
         (*itr)->DestroyScriptState();
     }
@@ -286,6 +336,7 @@ void MovableMan::PurgeAllMOs()
     }
 
     m_Actors.clear();
+    m_ActorProximityGridIsCurrent = false;
     m_Items.clear();
     m_Particles.clear();
     m_AddedActors.clear();
@@ -600,50 +651,39 @@ Actor * MovableMan::GetPrevTeamActor(int team, Actor *pBeforeThis)
 
 Actor * MovableMan::GetClosestTeamActor(int team, int player, const Vector &scenePoint, int maxRadius, Vector &getDistance, bool onlyPlayerControllableActors, const Actor *excludeThis)
 {
-    if (team < Activity::NoTeam || team >= Activity::MaxTeamCount || m_Actors.empty() || m_ActorRoster[team].empty())
+    if (team < Activity::NoTeam || team >= Activity::MaxTeamCount || m_Actors.empty() || (team != Activity::NoTeam && m_ActorRoster[team].empty()))
         return 0;
 
     Activity *pActivity = g_ActivityMan.GetActivity();
 
-    float sqrShortestDistance = static_cast<float>(maxRadius * maxRadius);
-    Actor *pClosestActor = 0;
+    auto isEligibleActor = [team, player, onlyPlayerControllableActors, excludeThis, pActivity](Actor *actor) {
+        if (actor == excludeThis || actor->GetTeam() != team || (onlyPlayerControllableActors && !actor->IsPlayerControllable())) {
+            return false;
+        }
+        // Actors of a specific team can't be controlled by, or be the brain of, another player
+        return team == Activity::NoTeam || player == NoPlayer || !(actor->GetController()->IsPlayerControlled(player) || (pActivity && pActivity->IsOtherPlayerBrain(actor, player)));
+    };
+
+    Actor *pClosestActor = FindClosestActor(scenePoint, maxRadius, ActorProximityGrid::GetTeamMask(team), isEligibleActor, getDistance);
 
-    // If we're looking for a noteam actor, then go through the entire actor list instead
-    if (team == Activity::NoTeam)
+    // The actors added this frame are already on their team's roster, so they're eligible as well
+    if (team != Activity::NoTeam)
     {
-        for (std::deque<Actor *>::iterator aIt = m_Actors.begin(); aIt != m_Actors.end(); ++aIt)
+        float sqrShortestDistance = pClosestActor ? getDistance.GetSqrMagnitude() : static_cast<float>(maxRadius) * static_cast<float>(maxRadius);
+
+        std::lock_guard<std::mutex> lock(m_AddedActorsMutex);
+        for (Actor *addedActor : m_AddedActors)
         {
-            if ((*aIt) == excludeThis || (*aIt)->GetTeam() != Activity::NoTeam || (onlyPlayerControllableActors && !(*aIt)->IsPlayerControllable())) {
+            if (!isEligibleActor(addedActor)) {
                 continue;
             }
-
-            // Check if even within search radius
-            float sqrDistance = g_SceneMan.ShortestDistance((*aIt)->GetPos(), scenePoint, g_SceneMan.SceneWrapsX() || g_SceneMan.SceneWrapsY()).GetSqrMagnitude();
-            if (sqrDistance < sqrShortestDistance)
-            {
-                sqrShortestDistance = sqrDistance;
-                pClosestActor = *aIt;
-            }
-        }
-    }
-    // A specific team, so use the rosters instead
-    else
-    {
-        for (std::list<Actor *>::iterator aIt = m_ActorRoster[team].begin(); aIt != m_ActorRoster[team].end(); ++aIt)
-        {
-			if ((*aIt) == excludeThis || (onlyPlayerControllableActors && !(*aIt)->IsPlayerControllable()) || (player != NoPlayer && ((*aIt)->GetController()->IsPlayerControlled(player) || (pActivity && pActivity->IsOtherPlayerBrain(*aIt, player))))) {
-				continue;
-			}
-
-            Vector distanceVec = g_SceneMan.ShortestDistance((*aIt)->GetPos(), scenePoint, g_SceneMan.SceneWrapsX() || g_SceneMan.SceneWrapsY());
-
-            // Check if even within search radius
+            Vector distanceVec = g_SceneMan.ShortestDistance(addedActor->GetPos(), scenePoint, g_SceneMan.SceneWrapsX() || g_SceneMan.SceneWrapsY());
             float sqrDistance = distanceVec.GetSqrMagnitude();
             if (sqrDistance < sqrShortestDistance)
             {
                 sqrShortestDistance = sqrDistance;
-                pClosestActor = *aIt;
-				getDistance.SetXY(distanceVec.GetX(), distanceVec.GetY());
+                pClosestActor = addedActor;
+                getDistance = distanceVec;
             }
         }
     }
@@ -662,30 +702,8 @@ Actor * MovableMan::GetClosestEnemyActor(int team, const Vector &scenePoint, int
 {
     if (team < Activity::NoTeam || team >= Activity::MaxTeamCount || m_Actors.empty())
         return 0;
-    
-    Activity *pActivity = g_ActivityMan.GetActivity();
-    
-    float sqrShortestDistance = static_cast<float>(maxRadius * maxRadius);
-    Actor *pClosestActor = 0;
-    
-    for (std::deque<Actor *>::iterator aIt = m_Actors.begin(); aIt != m_Actors.end(); ++aIt)
-    {
-        if ((*aIt)->GetTeam() == team)
-            continue;
 
-        Vector distanceVec = g_SceneMan.ShortestDistance((*aIt)->GetPos(), scenePoint, g_SceneMan.SceneWrapsX() || g_SceneMan.SceneWrapsY());
-        
-        // Check if even within search radius
-        float sqrDistance = distanceVec.GetSqrMagnitude();
-        if (sqrDistance < sqrShortestDistance)
-        {
-            sqrShortestDistance = sqrDistance;
-            pClosestActor = *aIt;
-            getDistance.SetXY(distanceVec.GetX(), distanceVec.GetY());
-        }
-    }
-    
-    return pClosestActor;
+    return FindClosestActor(scenePoint, maxRadius, ActorProximityGrid::GetAllTeamsMask() & ~ActorProximityGrid::GetTeamMask(team), [team](Actor *actor) { return actor->GetTeam() != team; }, getDistance);
 }
 
 
@@ -700,29 +718,71 @@ Actor * MovableMan::GetClosestActor(const Vector &scenePoint, int maxRadius, Vec
     if (m_Actors.empty())
         return 0;
 
-    Activity *pActivity = g_ActivityMan.GetActivity();
+    return FindClosestActor(scenePoint, maxRadius, ActorProximityGrid::GetAllTeamsMask(), [pExcludeThis](Actor *actor) { return actor != pExcludeThis; }, getDistance);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    float sqrShortestDistance = static_cast<float>(maxRadius * maxRadius);
-    Actor *pClosestActor = 0;
+const std::vector<Actor *> * MovableMan::GetNearestActors(const Vector &scenePoint, int count, float maxRadius, int ignoreTeam) {
+    std::vector<Actor *> *vectorForLua = new std::vector<Actor *>();
+    int teamMask = ActorProximityGrid::GetAllTeamsMask();
+    if (ignoreTeam != Activity::NoTeam) { teamMask &= ~ActorProximityGrid::GetTeamMask(ignoreTeam); }
 
-    for (std::deque<Actor *>::iterator aIt = m_Actors.begin(); aIt != m_Actors.end(); ++aIt)
-    {
-        if ((*aIt) == pExcludeThis)
-            continue;
+    std::shared_lock<std::shared_mutex> gridLock = LockActorProximityGridForQuery();
+    for (const ActorProximityGrid::ActorDistance &nearestActor : m_ActorProximityGrid.GetNearestActors(scenePoint, count, maxRadius, teamMask, nullptr)) {
+        vectorForLua->push_back(nearestActor.FoundActor);
+    }
+    return vectorForLua;
+}
 
-        Vector distanceVec = g_SceneMan.ShortestDistance((*aIt)->GetPos(), scenePoint, g_SceneMan.SceneWrapsX() || g_SceneMan.SceneWrapsY());
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        // Check if even within search radius
-        float sqrDistance = distanceVec.GetSqrMagnitude();
-        if (sqrDistance < sqrShortestDistance)
-        {
-            sqrShortestDistance = sqrDistance;
-            pClosestActor = *aIt;
-			getDistance.SetXY(distanceVec.GetX(), distanceVec.GetY());
-        }
+const std::vector<Actor *> * MovableMan::GetActorsInRadius(const Vector &centre, float radius, int ignoreTeam) {
+    std::vector<Actor *> *vectorForLua = new std::vector<Actor *>();
+    int teamMask = ActorProximityGrid::GetAllTeamsMask();
+    if (ignoreTeam != Activity::NoTeam) { teamMask &= ~ActorProximityGrid::GetTeamMask(ignoreTeam); }
+
+    std::shared_lock<std::shared_mutex> gridLock = LockActorProximityGridForQuery();
+    for (const ActorProximityGrid::ActorDistance &actorInRadius : m_ActorProximityGrid.GetActorsInRadius(centre, radius, teamMask, nullptr)) {
+        vectorForLua->push_back(actorInRadius.FoundActor);
     }
+    return vectorForLua;
+}
 
-    return pClosestActor;
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Actor * MovableMan::FindClosestActor(const Vector &scenePoint, int maxRadius, int teamMask, const ActorProximityGrid::ActorFilter &filter, Vector &getDistance) {
+    std::shared_lock<std::shared_mutex> gridLock = LockActorProximityGridForQuery();
+    std::vector<ActorProximityGrid::ActorDistance> closestActor = m_ActorProximityGrid.GetNearestActors(scenePoint, 1, static_cast<float>(maxRadius), teamMask, filter);
+    if (closestActor.empty()) {
+        return nullptr;
+    }
+    getDistance = closestActor[0].Distance;
+    return closestActor[0].FoundActor;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void MovableMan::RebuildActorProximityGrid() {
+    std::unique_lock<std::shared_mutex> gridLock(m_ActorProximityGridMutex);
+    m_ActorProximityGrid.Rebuild(m_Actors);
+    m_ActorProximityGridIsCurrent = true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void MovableMan::RefreshActorProximityGrid() {
+    if (m_ActorProximityGridIsCurrent) {
+        std::unique_lock<std::shared_mutex> gridLock(m_ActorProximityGridMutex);
+        m_ActorProximityGrid.Refresh(m_Actors);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::shared_lock<std::shared_mutex> MovableMan::LockActorProximityGridForQuery() {
+    if (!m_ActorProximityGridIsCurrent) { RebuildActorProximityGrid(); }
+    return std::shared_lock<std::shared_mutex>(m_ActorProximityGridMutex);
 }
 
 
@@ -898,18 +958,7 @@ void MovableMan::AddItem(HeldDevice *itemToAdd) {
 
 void MovableMan::AddParticle(MovableObject *particleToAdd){
     if (particleToAdd) {
-		g_ActivityMan.GetActivity()->ForceSetTeamAsActive(particleToAdd->GetTeam());
-        particleToAdd->SetAsAddedToMovableMan();
-		if (MOSRotating *particleToAddAsMOSRotating = dynamic_cast<MOSRotating *>(particleToAdd)) { particleToAddAsMOSRotating->CorrectAttachableAndWoundPositionsAndRotations(); }
-
-		if (particleToAdd->IsTooFast()) {
-			particleToAdd->SetToDelete(true);
-		} else {
-			//TODO consider moving particles out of grass. It's old code that was removed because it's slow to do this for every particle.
-            particleToAdd->NotResting();
-            particleToAdd->NewFrame();
-            particleToAdd->SetAge(g_TimerMan.GetDeltaTimeMS() * -1.0f);
-        }
+		PrepareParticleForAdding(particleToAdd);
 		if (particleToAdd->IsDevice()) {
             std::lock_guard<std::mutex> lock(m_AddedItemsMutex);
 			m_AddedItems.push_back(particleToAdd);
@@ -922,6 +971,55 @@ void MovableMan::AddParticle(MovableObject *particleToAdd){
     }
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void MovableMan::AddParticles(const std::vector<MovableObject *> &particlesToAdd) {
+	bool anyItems = false;
+	bool anyParticles = false;
+	for (MovableObject *particleToAdd : particlesToAdd) {
+		if (particleToAdd) {
+			PrepareParticleForAdding(particleToAdd);
+			(particleToAdd->IsDevice() ? anyItems : anyParticles) = true;
+		}
+	}
+	// Keep the batch's order within each list, same as adding them one by one would.
+	if (anyItems) {
+		std::lock_guard<std::mutex> lock(m_AddedItemsMutex);
+		for (MovableObject *particleToAdd : particlesToAdd) {
+			if (particleToAdd && particleToAdd->IsDevice()) {
+				m_AddedItems.push_back(particleToAdd);
+				m_ValidItems.insert(particleToAdd);
+			}
+		}
+	}
+	if (anyParticles) {
+		std::lock_guard<std::mutex> lock(m_AddedParticlesMutex);
+		for (MovableObject *particleToAdd : particlesToAdd) {
+			if (particleToAdd && !particleToAdd->IsDevice()) {
+				m_AddedParticles.push_back(particleToAdd);
+				m_ValidParticles.insert(particleToAdd);
+			}
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void MovableMan::PrepareParticleForAdding(MovableObject *particleToAdd) {
+	g_ActivityMan.GetActivity()->ForceSetTeamAsActive(particleToAdd->GetTeam());
+	particleToAdd->SetAsAddedToMovableMan();
+	if (MOSRotating *particleToAddAsMOSRotating = dynamic_cast<MOSRotating *>(particleToAdd)) { particleToAddAsMOSRotating->CorrectAttachableAndWoundPositionsAndRotations(); }
+
+	if (particleToAdd->IsTooFast()) {
+		particleToAdd->SetToDelete(true);
+	} else {
+		//TODO consider moving particles out of grass. It's old code that was removed because it's slow to do this for every particle.
+		particleToAdd->NotResting();
+		particleToAdd->NewFrame();
+		particleToAdd->SetAge(g_TimerMan.GetDeltaTimeMS() * -1.0f);
+	}
+}
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          RemoveActor
@@ -944,6 +1042,7 @@ Actor * MovableMan::RemoveActor(MovableObject *pActorToRem)
                 removed = *itr;
                 m_ValidActors.erase(*itr);
                 m_Actors.erase(itr);
+                m_ActorProximityGridIsCurrent = false;
                 break;
             }
         }
@@ -1052,6 +1151,16 @@ MovableObject * MovableMan::RemoveParticle(MovableObject *pMOToRem)
                     break;
                 }
             }
+        }
+        // Lastly, it might be simulated in bulk
+        if (!removed)
+        {
+            std::lock_guard<std::mutex> lock(m_ParticlesMutex);
+            if (m_PixelParticles.Release(pMOToRem))
+            {
+                removed = pMOToRem;
+                m_ValidParticles.erase(pMOToRem);
+            }
         }
 		pMOToRem->SetAsAddedToMovableMan(false);
     }
@@ -1059,6 +1168,117 @@ MovableObject * MovableMan::RemoveParticle(MovableObject *pMOToRem)
 }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          EnablePixelParticleSystem
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Sets whether plain MOPixels flying freely through the air are
+//                  simulated in bulk by the PixelParticleSystem.
+
+void MovableMan::EnablePixelParticleSystem(bool enable)
+{
+    m_PixelParticleSystemEnabled = enable;
+    if (!m_PixelParticleSystemEnabled)
+        PromoteAllPixelParticles();
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          PromoteAllPixelParticles
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Writes back the state of all particles simulated in bulk by the
+//                  PixelParticleSystem and moves them to the regular particle list.
+
+void MovableMan::PromoteAllPixelParticles()
+{
+    if (m_PixelParticles.GetParticleCount() > 0)
+    {
+        // The MOID drawing task may still be going through the particles
+        if (m_DrawMOIDsTask.valid())
+            m_DrawMOIDsTask.wait();
+
+        std::lock_guard<std::mutex> lock(m_ParticlesMutex);
+        if (m_UpdatingParticles)
+        {
+            std::lock_guard<std::mutex> addedLock(m_AddedParticlesMutex);
+            m_PixelParticles.ReleaseAll(m_AddedParticles);
+        }
+        else
+            m_PixelParticles.ReleaseAll(m_Particles);
+    }
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          PromotePixelParticle
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Writes back the state of a particle simulated in bulk by the
+//                  PixelParticleSystem and moves it to the regular particle list.
+
+bool MovableMan::PromotePixelParticle(const MovableObject *movableObject)
+{
+    if (m_PixelParticles.GetParticleCount() == 0 || !dynamic_cast<const MOPixel *>(movableObject))
+        return false;
+
+    // The MOID drawing task may still be going through the particles
+    if (m_DrawMOIDsTask.valid())
+        m_DrawMOIDsTask.wait();
+
+    std::lock_guard<std::mutex> lock(m_ParticlesMutex);
+    if (!m_PixelParticles.Release(movableObject))
+        return false;
+
+    MovableObject *promotedParticle = const_cast<MovableObject *>(movableObject);
+    if (m_UpdatingParticles)
+    {
+        std::lock_guard<std::mutex> addedLock(m_AddedParticlesMutex);
+        m_AddedParticles.push_back(promotedParticle);
+    }
+    else
+        m_Particles.push_back(promotedParticle);
+    return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          FindObjectByUniqueId
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Uses a global lookup map to find an object by it's unique id.
+
+MovableObject * MovableMan::FindObjectByUniqueID(long int id)
+{
+    MovableObject *foundObject = nullptr;
+    {
+        KnownObjectsShard &knownObjectsShard = GetKnownObjectsShard(id);
+        std::lock_guard<std::mutex> guard(knownObjectsShard.Mutex);
+        if (auto itr = knownObjectsShard.Objects.find(id); itr != knownObjectsShard.Objects.end())
+            foundObject = itr->second;
+    }
+    if (!foundObject)
+        return nullptr;
+
+    // Whoever asked for it may read or modify it, so it can't stay bulk-simulated where its MOPixel isn't kept up to date
+    PromotePixelParticle(foundObject);
+    return foundObject;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetKnownObjectsCount
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Returns the size of the object registry collection
+
+unsigned int MovableMan::GetKnownObjectsCount()
+{
+    size_t knownObjectsCount = 0;
+    for (KnownObjectsShard &knownObjectsShard : m_KnownObjects)
+    {
+        std::lock_guard<std::mutex> guard(knownObjectsShard.Mutex);
+        knownObjectsCount += knownObjectsShard.Objects.size();
+    }
+    return static_cast<unsigned int>(knownObjectsCount);
+}
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          AddActorToTeamRoster
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1124,6 +1344,7 @@ void MovableMan::ChangeActorTeam(Actor * pActor, int team)
 	RemoveActorFromTeamRoster(pActor);
 	pActor->SetTeam(team);
 	AddActorToTeamRoster(pActor);
+	m_ActorProximityGridIsCurrent = false;
 
 	// Because doors affect the team-based pathfinders, we need to tell them there's been a change.
 	// This is hackily done by erasing the door material, updating the pathfinders, then redrawing it and updating them again so they properly account for the door's new team.
@@ -1386,6 +1607,7 @@ int MovableMan::GetAllActors(bool transferOwnership, std::list<SceneObject *> &a
         m_Actors.clear();
         m_AddedActors.clear();
         m_ValidActors.clear();
+        m_ActorProximityGridIsCurrent = false;
 
         // Also clear the actor rosters
         for (int team = Activity::TeamOne; team < Activity::MaxTeamCount; ++team)
@@ -1432,6 +1654,8 @@ int MovableMan::GetAllItems(bool transferOwnership, std::list<SceneObject *> &it
 
 int MovableMan::GetAllParticles(bool transferOwnership, std::list<SceneObject *> &particleList)
 {
+    PromoteAllPixelParticles();
+
     int addedCount = 0;
 
     // Add all regular particles
@@ -1658,6 +1882,7 @@ void MovableMan::Update()
     }
 
 	m_SimUpdateFrameNumber++;
+    m_UpdatingParticles = true;
 
     // ---TEMP ---
     // These are here for multithreaded AI, but will be unnecessary when multithreaded-sim-and-render is in!
@@ -1688,6 +1913,9 @@ void MovableMan::Update()
     // Travel MOs
     Travel();
 
+    // Index where the actors ended up this frame, so proximity queries from the AI and scripts don't have to go through all of them
+    RebuildActorProximityGrid();
+
     // Prior to controller/AI update, execute lua callbacks
     g_LuaMan.ExecuteLuaScriptCallbacks();
 
@@ -1695,9 +1923,11 @@ void MovableMan::Update()
     // Fugly hack to keep backwards compat with scripts that rely on weird frame-delay-ordering behaviours
     // TODO, cleanup the pre-controller update and post-controller updates to have some consistent logic of what goes where
 	PreControllerUpdate();
+    RefreshActorProximityGrid();
 
     // Updates AI/user input
 	UpdateControllers();
+    RefreshActorProximityGrid();
 
     // Will use some common iterators
     std::deque<Actor *>::iterator aIt;
@@ -1728,6 +1958,7 @@ void MovableMan::Update()
                 g_LuaMan.SetThreadLuaStateOverride(nullptr);
             }).wait();
     }
+    RefreshActorProximityGrid();
 
     {
         ZoneScopedN("Multithreaded Scripts SyncedUpdate");
@@ -1748,6 +1979,7 @@ void MovableMan::Update()
         }
     }
     g_PerformanceMan.StopPerformanceMeasurement(PerformanceMan::ScriptsUpdate);
+    RefreshActorProximityGrid();
 
     {
         {
@@ -1870,7 +2102,12 @@ void MovableMan::Update()
             {
                 // Delete instead if it's marked for it
                 if (!(*parIt)->IsSetToDelete()) {
-                    m_Particles.push_back(*parIt);
+                    // Plain MOPixels flying through the air get simulated in bulk until they need anything more than that
+                    if (m_PixelParticleSystemEnabled && PixelParticleSystem::CanSimulate(*parIt)) {
+                        m_PixelParticles.Add(static_cast<MOPixel *>(*parIt));
+                    } else {
+                        m_Particles.push_back(*parIt);
+                    }
                 } else {
                     m_ValidParticles.erase(*parIt);
                     (*parIt)->DestroyScriptState();
@@ -2026,11 +2263,17 @@ void MovableMan::Update()
 	    }
     }
 
+    // Actors were added and deleted, so the actor proximity grid will be rebuilt on the next query
+    m_ActorProximityGridIsCurrent = false;
+
     // We've finished stuff that can interact with lua script, so it's the ideal time to start a gc run
     g_LuaMan.StartAsyncGarbageCollection();
 
+    m_UpdatingParticles = false;
+
     ////////////////////////////////////////////////////////////////////////
     // Draw the MO matter and IDs to their layers for next frame
+    m_AllOccupancyMasksStale = true;
     m_DrawMOIDsTask = g_ThreadMan.GetPriorityThreadPool().submit([this]() {
         UpdateDrawMOIDs(g_SceneMan.GetMOIDBitmap());
     });
@@ -2065,6 +2308,11 @@ void MovableMan::Travel()
         m_DrawMOIDsTask.wait();
     }
 
+    // Nothing moved since the occupancy masks were drawn, so they can be trusted for every MO until it travels
+    m_StaleOccupancyMasks.assign(m_MOIDIndex.size(), 0);
+    m_AnyOccupancyMaskStale = false;
+    m_AllOccupancyMasksStale = false;
+
     // Travel Actors
     {
         ZoneScopedN("Actors Travel");
@@ -2074,10 +2322,14 @@ void MovableMan::Travel()
         {
             if (!((*aIt)->IsUpdated()))
             {
+                MOID firstMOID = (*aIt)->GetID();
+                int moidFootprint = (*aIt)->GetMOIDFootprint();
+                UpdateStaleOccupancyMasks(firstMOID, moidFootprint, false);
                 (*aIt)->ApplyForces();
                 (*aIt)->PreTravel();
                 (*aIt)->Travel();
                 (*aIt)->PostTravel();
+                UpdateStaleOccupancyMasks(firstMOID, moidFootprint, true);
             }
             (*aIt)->NewFrame();
         }
@@ -2092,10 +2344,14 @@ void MovableMan::Travel()
         {
             if (!((*iIt)->IsUpdated()))
             {
+                MOID firstMOID = (*iIt)->GetID();
+                int moidFootprint = (*iIt)->GetMOIDFootprint();
+                UpdateStaleOccupancyMasks(firstMOID, moidFootprint, false);
                 (*iIt)->ApplyForces();
                 (*iIt)->PreTravel();
                 (*iIt)->Travel();
                 (*iIt)->PostTravel();
+                UpdateStaleOccupancyMasks(firstMOID, moidFootprint, true);
             }
             (*iIt)->NewFrame();
         }
@@ -2106,19 +2362,133 @@ void MovableMan::Travel()
         ZoneScopedN("Particles Travel");
 
         g_PerformanceMan.StartPerformanceMeasurement(PerformanceMan::ParticlesTravel);
-        for (auto parIt = m_Particles.begin(); parIt != m_Particles.end(); ++parIt)
-        {
-            if (!((*parIt)->IsUpdated()))
+        // Bulk-simulated particles go first, so any that get promoted are traveled as regular particles below this same frame
+        if (m_PixelParticles.GetParticleCount() > 0) {
+            UpdateStaleOccupancyMasks(m_FirstPixelParticleMOID, static_cast<int>(m_StaleOccupancyMasks.size()) - m_FirstPixelParticleMOID, false);
+            std::vector<MOPixel *> expiredPixelParticles;
+            m_PixelParticles.Travel(m_Particles, expiredPixelParticles);
+            for (MOPixel *expiredPixelParticle : expiredPixelParticles) {
+                m_ValidParticles.erase(expiredPixelParticle);
+                expiredPixelParticle->DestroyScriptState();
+                delete expiredPixelParticle;
+            }
+        }
+        if (m_ParallelParticleTravelEnabled) {
+            TravelParticlesInParallel();
+        } else {
+            for (auto parIt = m_Particles.begin(); parIt != m_Particles.end(); ++parIt)
             {
-                (*parIt)->ApplyForces();
-                (*parIt)->PreTravel();
-                (*parIt)->Travel();
-                (*parIt)->PostTravel();
+                if (!((*parIt)->IsUpdated()))
+                {
+                    MOID firstMOID = (*parIt)->GetID();
+                    int moidFootprint = (*parIt)->GetMOIDFootprint();
+                    UpdateStaleOccupancyMasks(firstMOID, moidFootprint, false);
+                    (*parIt)->ApplyForces();
+                    (*parIt)->PreTravel();
+                    (*parIt)->Travel();
+                    (*parIt)->PostTravel();
+                    UpdateStaleOccupancyMasks(firstMOID, moidFootprint, true);
+                }
+                (*parIt)->NewFrame();
             }
-            (*parIt)->NewFrame();
         }
         g_PerformanceMan.StopPerformanceMeasurement(PerformanceMan::ParticlesTravel);
     }
+
+    // Updates and scripts can move, turn and animate anything without it being tracked, so the occupancy masks can't be trusted again until they're redrawn
+    m_AllOccupancyMasksStale = true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+void MovableMan::TravelParticlesInParallel()
+{
+    ZoneScoped;
+
+    // Below this many particles per block, the overhead of dispatching isn't worth it.
+    static constexpr int c_MinParticlesPerBlock = 64;
+
+    const int particleCount = m_Particles.size();
+    if (particleCount == 0) {
+        return;
+    }
+    BS::thread_pool &threadPool = g_ThreadMan.GetPriorityThreadPool();
+    const int blockSize = std::max(c_MinParticlesPerBlock, particleCount / std::max(1, static_cast<int>(threadPool.get_thread_count()) * 4));
+    const int blockCount = (particleCount + blockSize - 1) / blockSize;
+
+    // Static buffers to avoid having to realloc every frame. Per-particle state is kept in chars instead of bools so each can be written from a different thread.
+    static std::vector<char> preTraveled;
+    static std::vector<char> traveled;
+    static std::vector<std::vector<Atom::DeferredTrail>> deferredTrails;
+    preTraveled.assign(particleCount, 0);
+    traveled.assign(particleCount, 0);
+    if (deferredTrails.size() < blockCount) {
+        deferredTrails.resize(blockCount);
+    }
+
+    bool scenePreLocked = g_SceneMan.SceneIsLocked();
+    if (!scenePreLocked) { g_SceneMan.LockScene(); }
+
+    // Apply forces and pre-travel everything that supports it first, so every concurrent traveler is flagged as traveling (and thus not hittable) before any paths get checked.
+    // This way the path checks only see state that doesn't change during the concurrent travel, and give the same results no matter how the blocks are scheduled.
+    threadPool.parallelize_loop(blockCount,
+        [&](int blockStart, int blockEnd) {
+            for (int block = blockStart; block < blockEnd; ++block) {
+                for (int i = block * blockSize; i < std::min((block + 1) * blockSize, particleCount); ++i) {
+                    MovableObject *particle = m_Particles[i];
+                    if (!particle->IsUpdated() && particle->SupportsConcurrentTravel()) {
+                        particle->ApplyForces();
+                        particle->PreTravel();
+                        preTraveled[i] = 1;
+                    }
+                }
+            }
+        }, blockCount).wait();
+
+    // Travel the particles that won't collide with anything. Their trails are recorded to per-block buffers instead of being drawn.
+    threadPool.parallelize_loop(blockCount,
+        [&](int blockStart, int blockEnd) {
+            for (int block = blockStart; block < blockEnd; ++block) {
+                deferredTrails[block].clear();
+                Atom::SetDeferredTrailBuffer(&deferredTrails[block]);
+                for (int i = block * blockSize; i < std::min((block + 1) * blockSize, particleCount); ++i) {
+                    MovableObject *particle = m_Particles[i];
+                    if (preTraveled[i] && particle->CanTravelConcurrently()) {
+                        particle->Travel();
+                        traveled[i] = 1;
+                    }
+                }
+                Atom::SetDeferredTrailBuffer(nullptr);
+            }
+        }, blockCount).wait();
+
+    // Merge the recorded trails in block order, which is the original particle order.
+    for (int block = 0; block < blockCount; ++block) {
+        Atom::DrawDeferredTrails(deferredTrails[block]);
+    }
+
+    // Travel everything else serially, so terrain penetration, MO hits, sticking and anything they spawn happen in the same order as they would without parallel travel.
+    // The concurrent travelers are flagged as traveling until their PostTravel, so they can't be hit whatever their occupancy masks say, and only need checking after it.
+    for (int i = 0; i < particleCount; ++i) {
+        MovableObject *particle = m_Particles[i];
+        if (!particle->IsUpdated()) {
+            MOID firstMOID = particle->GetID();
+            int moidFootprint = particle->GetMOIDFootprint();
+            if (!traveled[i]) { UpdateStaleOccupancyMasks(firstMOID, moidFootprint, false); }
+            if (!preTraveled[i]) {
+                particle->ApplyForces();
+                particle->PreTravel();
+            }
+            if (!traveled[i]) {
+                particle->Travel();
+            }
+            particle->PostTravel();
+            UpdateStaleOccupancyMasks(firstMOID, moidFootprint, true);
+        }
+        particle->NewFrame();
+    }
+
+    if (!scenePreLocked) { g_SceneMan.UnlockScene(); }
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -2193,6 +2563,8 @@ void MovableMan::DrawMatter(BITMAP *pTargetBitmap, Vector &targetPos)
 
     for (std::deque<MovableObject *>::iterator parIt = --m_Particles.end(); parIt != --m_Particles.begin(); --parIt)
         (*parIt)->Draw(pTargetBitmap, targetPos, g_DrawMaterial);
+
+    m_PixelParticles.Draw(pTargetBitmap, targetPos, g_DrawMaterial);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -2286,6 +2658,11 @@ void MovableMan::UpdateDrawMOIDs(BITMAP *pTargetBitmap)
         }
     }
 
+    // Bulk-simulated particles need MOIDs too, so spatial queries can find them
+    m_FirstPixelParticleMOID = m_MOIDIndex.size();
+    m_PixelParticles.DrawMOIDs(pTargetBitmap, m_MOIDIndex);
+    currentMOID = m_MOIDIndex.size();
+
     // COUNT MOID USAGE PER TEAM  //////////////////////////////////////////////////
     for (int team = Activity::TeamOne; team < Activity::MaxTeamCount; team++) {
         m_TeamMOIDCount[team] = 0;
@@ -2317,6 +2694,8 @@ void MovableMan::Draw(BITMAP *pTargetBitmap, const Vector &targetPos)
     {
         ZoneScopedN("Particles Draw");
 
+        m_PixelParticles.Draw(pTargetBitmap, targetPos, g_DrawColor);
+
         for (std::deque<MovableObject*>::iterator parIt = m_Particles.begin(); parIt != m_Particles.end(); ++parIt) {
             (*parIt)->Draw(pTargetBitmap, targetPos);
         }
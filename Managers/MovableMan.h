@@ -17,6 +17,11 @@
 #include "Serializable.h"
 #include "Singleton.h"
 #include "Activity.h"
+#include "PixelParticleSystem.h"
+#include "ActorProximityGrid.h"
+
+#include "tsl/hopscotch_map.h"
+#include "tsl/hopscotch_set.h"
 
 #define g_MovableMan MovableMan::Instance()
 
@@ -66,6 +71,7 @@ struct AlarmEvent {
 class MovableMan : public Singleton<MovableMan>, public Serializable {
 	friend class SettingsMan;
     friend struct ManagerLuaBindings;
+    friend struct LuaAdaptersMovableMan;
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -160,6 +166,14 @@ public:
     /// <returns>The topmost MOID currently at the specified pixel coordinates.</returns>
     MOID GetMOIDPixel(int pixelX, int pixelY, const std::vector<int> &moidList);
 
+    /// <summary>
+    /// Gets whether all the MOs of the given MOIDs are still in the state they were marked in the MOID grid's occupancy masks, so the masks can be trusted for them.
+    /// This only looks up the staleness tracked while traveling, so it's cheap enough to be called for every pixel query.
+    /// </summary>
+    /// <param name="moidList">The collection of MOIDs to check.</param>
+    /// <returns>Whether the occupancy masks are still current for all the given MOIDs.</returns>
+    bool AreOccupancyMasksCurrent(const std::vector<int> &moidList) const;
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetTeamMOIDCount
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -321,6 +335,50 @@ public:
 
     Actor * GetClosestActor(const Vector &scenePoint, int maxRadius, Vector &getDistance, const Actor *pExcludeThis = 0);
 
+	/// <summary>
+	/// Gets the Actors in the internal Actor list that are closest to a specific scene point, and whose team is not ignored.
+	/// </summary>
+	/// <param name="scenePoint">The Scene point to search for the closest to.</param>
+	/// <param name="count">The maximum number of Actors to get.</param>
+	/// <param name="maxRadius">The maximum radius around that scene point to search.</param>
+	/// <param name="ignoreTeam">The team to ignore. NoTeam means no team is ignored.</param>
+	/// <returns>Pointers to the closest Actors within the radius, ordered from the closest to the furthest and at most count of them.</returns>
+	const std::vector<Actor *> * GetNearestActors(const Vector &scenePoint, int count, float maxRadius, int ignoreTeam);
+
+	/// <summary>
+	/// Gets the Actors in the internal Actor list that are closest to a specific scene point.
+	/// </summary>
+	/// <param name="scenePoint">The Scene point to search for the closest to.</param>
+	/// <param name="count">The maximum number of Actors to get.</param>
+	/// <param name="maxRadius">The maximum radius around that scene point to search.</param>
+	/// <returns>Pointers to the closest Actors within the radius, ordered from the closest to the furthest and at most count of them.</returns>
+	const std::vector<Actor *> * GetNearestActors(const Vector &scenePoint, int count, float maxRadius) { return GetNearestActors(scenePoint, count, maxRadius, Activity::NoTeam); }
+
+	/// <summary>
+	/// Gets the Actors in the internal Actor list that are closest to a specific scene point, regardless of how far away they are.
+	/// </summary>
+	/// <param name="scenePoint">The Scene point to search for the closest to.</param>
+	/// <param name="count">The maximum number of Actors to get.</param>
+	/// <returns>Pointers to the closest Actors, ordered from the closest to the furthest and at most count of them.</returns>
+	const std::vector<Actor *> * GetNearestActors(const Vector &scenePoint, int count) { return GetNearestActors(scenePoint, count, std::numeric_limits<float>::max()); }
+
+	/// <summary>
+	/// Gets the Actors in the internal Actor list that are within the specified radius of the given centre position, and whose team is not ignored.
+	/// </summary>
+	/// <param name="centre">The position to check for Actors in.</param>
+	/// <param name="radius">The radius to check for Actors within.</param>
+	/// <param name="ignoreTeam">The team to ignore. NoTeam means no team is ignored.</param>
+	/// <returns>Pointers to the Actors that are within the specified radius of the given centre position, and whose team is not ignored.</returns>
+	const std::vector<Actor *> * GetActorsInRadius(const Vector &centre, float radius, int ignoreTeam);
+
+	/// <summary>
+	/// Gets the Actors in the internal Actor list that are within the specified radius of the given centre position.
+	/// </summary>
+	/// <param name="centre">The position to check for Actors in.</param>
+	/// <param name="radius">The radius to check for Actors within.</param>
+	/// <returns>Pointers to the Actors that are within the specified radius of the given centre position.</returns>
+	const std::vector<Actor *> * GetActorsInRadius(const Vector &centre, float radius) { return GetActorsInRadius(centre, radius, Activity::NoTeam); }
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetClosestBrainActor
@@ -402,7 +460,7 @@ public:
 // Arguments:       None.
 // Return value:    The number of particles.
 
-    long GetParticleCount() const { return m_Particles.size(); }
+    long GetParticleCount() const { return m_Particles.size() + m_PixelParticles.GetParticleCount(); }
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -472,6 +530,12 @@ public:
     /// <param name="particleToAdd">A pointer to the MovableObject to add. Ownership is transferred!</param>
     void AddParticle(MovableObject *particleToAdd);
 
+    /// <summary>
+    /// Adds a batch of MovableObjects to the internal lists of particles and items, e.g. all the particles of a gib. Each list is locked only once for the whole batch. Ownership IS transferred!
+    /// </summary>
+    /// <param name="particlesToAdd">The MovableObjects to add. Ownership of the MovableObjects is transferred!</param>
+    void AddParticles(const std::vector<MovableObject *> &particlesToAdd);
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          RemoveActor
@@ -751,6 +815,76 @@ public:
     bool IsMOSubtractionEnabled() { return m_MOSubtractionEnabled; }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          IsParallelParticleTravelEnabled
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Shows whether particles that won't collide with anything this frame
+//                  are traveled in parallel on the priority thread pool.
+// Arguments:       None.
+// Return value:    Whether enabled or not.
+
+    bool IsParallelParticleTravelEnabled() const { return m_ParallelParticleTravelEnabled; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          EnableParallelParticleTravel
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Sets whether particles that won't collide with anything this frame
+//                  are traveled in parallel on the priority thread pool.
+// Arguments:       Whether to enable or not.
+// Return value:    None.
+
+    void EnableParallelParticleTravel(bool enable = true) { m_ParallelParticleTravelEnabled = enable; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          IsPixelParticleSystemEnabled
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Shows whether plain MOPixels flying freely through the air are
+//                  simulated in bulk by the PixelParticleSystem.
+// Arguments:       None.
+// Return value:    Whether enabled or not.
+
+    bool IsPixelParticleSystemEnabled() const { return m_PixelParticleSystemEnabled; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          EnablePixelParticleSystem
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Sets whether plain MOPixels flying freely through the air are
+//                  simulated in bulk by the PixelParticleSystem. Disabling it promotes
+//                  all particles it holds back to regular particles.
+// Arguments:       Whether to enable or not.
+// Return value:    None.
+
+    void EnablePixelParticleSystem(bool enable = true);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          PromoteAllPixelParticles
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Writes back the state of all particles simulated in bulk by the
+//                  PixelParticleSystem and moves them to the regular particle list, so
+//                  they can be safely read or modified from anywhere, e.g. from Lua.
+// Arguments:       None.
+// Return value:    None.
+
+    void PromoteAllPixelParticles();
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          PromotePixelParticle
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Writes back the state of a particle simulated in bulk by the
+//                  PixelParticleSystem and moves it to the regular particle list, so it
+//                  can be safely read or modified from anywhere, e.g. from Lua.
+// Arguments:       The MovableObject to promote. Anything that isn't simulated in bulk
+//                  is left alone.
+// Return value:    Whether the MovableObject was simulated in bulk and got promoted.
+
+    bool PromotePixelParticle(const MovableObject *movableObject);
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          RedrawOverlappingMOIDs
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -859,7 +993,7 @@ public:
 // Arguments:       Unique Id to look for.
 // Return value:    Object found or 0 if not found any.
 
-	MovableObject * FindObjectByUniqueID(long int id) { if (m_KnownObjects.count(id) > 0) return m_KnownObjects[id]; else return 0; }
+	MovableObject * FindObjectByUniqueID(long int id);
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -869,7 +1003,7 @@ public:
 // Arguments:       None.
 // Return value:    Size of the objects registry.
 
-	unsigned int GetKnownObjectsCount() { return m_KnownObjects.size(); }
+	unsigned int GetKnownObjectsCount();
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -888,7 +1022,7 @@ public:
 	/// <param name="ignoreTeam">The team to ignore.</param>
 	/// <param name="getsHitByMOsOnly">Whether to only include MOs that have GetsHitByMOs enabled, or all MOs.</param>
 	/// <returns>Pointers to the MOs that are within the given Box, and whose team is not ignored.</returns>
-	const std::vector<MovableObject *> *GetMOsInBox(const Box &box, int ignoreTeam, bool getsHitByMOsOnly) const;
+	const std::vector<MovableObject *> *GetMOsInBox(const Box &box, int ignoreTeam, bool getsHitByMOsOnly);
 
     /// <summary>
     /// Gets pointers to the MOs that are within the given Box, and whose team is not ignored.
@@ -896,14 +1030,14 @@ public:
     /// <param name="box">The Box to get MOs within.</param>
     /// <param name="ignoreTeam">The team to ignore.</param>
     /// <returns>Pointers to the MOs that are within the given Box, and whose team is not ignored.</returns>
-	const std::vector<MovableObject *> *GetMOsInBox(const Box &box, int ignoreTeam) const { return GetMOsInBox(box, ignoreTeam, false); }
+	const std::vector<MovableObject *> *GetMOsInBox(const Box &box, int ignoreTeam) { return GetMOsInBox(box, ignoreTeam, false); }
 
 	/// <summary>
 	/// Gets pointers to the MOs that are within the given Box.
 	/// </summary>
 	/// <param name="box">The Box to get MOs within.</param>
 	/// <returns>Pointers to the MOs that are within the given Box.</returns>
-    const std::vector<MovableObject *> * GetMOsInBox(const Box &box) const { return GetMOsInBox(box, Activity::NoTeam); }
+    const std::vector<MovableObject *> * GetMOsInBox(const Box &box) { return GetMOsInBox(box, Activity::NoTeam); }
 
 	/// <summary>
 	/// Gets pointers to the MOs that are within the specified radius of the given centre position, and whose team is not ignored.
@@ -913,7 +1047,7 @@ public:
 	/// <param name="ignoreTeam">The team to ignore.</param>
 	/// <param name="getsHitByMOsOnly">Whether to only include MOs that have GetsHitByMOs enabled, or all MOs.</param>
 	/// <returns>Pointers to the MOs that are within the specified radius of the given centre position, and whose team is not ignored.</returns>
-	const std::vector<MovableObject *> *GetMOsInRadius(const Vector &centre, float radius, int ignoreTeam, bool getsHitByMOsOnly) const;
+	const std::vector<MovableObject *> *GetMOsInRadius(const Vector &centre, float radius, int ignoreTeam, bool getsHitByMOsOnly);
 
 	/// <summary>
 	/// Gets pointers to the MOs that are within the specified radius of the given centre position, and whose team is not ignored.
@@ -922,7 +1056,7 @@ public:
 	/// <param name="radius">The radius to check for MOs within.</param>
 	/// <param name="ignoreTeam">The team to ignore.</param>
 	/// <returns>Pointers to the MOs that are within the specified radius of the given centre position, and whose team is not ignored.</returns>
-	const std::vector<MovableObject *> *GetMOsInRadius(const Vector &centre, float radius, int ignoreTeam) const { return GetMOsInRadius(centre, radius, ignoreTeam, false); }
+	const std::vector<MovableObject *> *GetMOsInRadius(const Vector &centre, float radius, int ignoreTeam) { return GetMOsInRadius(centre, radius, ignoreTeam, false); }
 
 	/// <summary>
 	/// Gets pointers to the MOs that are within the specified radius of the given centre position.
@@ -930,7 +1064,7 @@ public:
 	/// <param name="centre">The position to check for MOs in.</param>
 	/// <param name="radius">The radius to check for MOs within.</param>
 	/// <returns>Pointers to the MOs that are within the specified radius of the given centre position.</returns>
-    const std::vector<MovableObject *> * GetMOsInRadius(const Vector &centre, float radius) const { return GetMOsInRadius(centre, radius, Activity::NoTeam); }
+    const std::vector<MovableObject *> * GetMOsInRadius(const Vector &centre, float radius) { return GetMOsInRadius(centre, radius, Activity::NoTeam); }
 
     /// <summary>
     /// Runs a lua function on all MOs in the simulation, including owned child MOs.
@@ -947,6 +1081,25 @@ public:
 
 protected:
 
+    // Hashes MO pointers for the validity sets. Pool allocated MOs are aligned, so the low bits of their addresses are always the same and have to be mixed with the rest before the sets mask them off.
+    struct MOPointerHash {
+        size_t operator()(const MovableObject *mo) const { uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(mo)) * 0x9E3779B97F4A7C15ULL; return static_cast<size_t>(hash ^ (hash >> 32)); }
+    };
+
+    // Number of shards the global lookup of objects by unique ID is split into, so objects created on different threads rarely wait on each other to register. Must be a power of two.
+    static constexpr long int c_KnownObjectsShardCount = 64;
+
+    // Hashes unique IDs within a shard. All IDs in a shard have the same low bits, so those are dropped.
+    struct KnownObjectIDHash {
+        size_t operator()(long int id) const { return static_cast<size_t>(static_cast<unsigned long int>(id) / c_KnownObjectsShardCount); }
+    };
+
+    // A shard of the global lookup of objects by unique ID, holding the objects whose unique IDs' low bits match its index
+    struct KnownObjectsShard {
+        std::mutex Mutex;
+        tsl::hopscotch_map<long int, MovableObject *, KnownObjectIDHash> Objects;
+    };
+
     // All actors in the scene
     std::deque<Actor *> m_Actors;
     // A map to give a unique contiguous identifier per-actor. This is re-created per frame.
@@ -955,6 +1108,8 @@ protected:
     std::deque<MovableObject *> m_Items;
     // List of free, dead particles flying around
     std::deque<MovableObject *> m_Particles;
+    // Plain MOPixels flying freely through the air, simulated in bulk. They are owned by this, same as the ones in m_Particles, and are registered in m_ValidParticles.
+    PixelParticleSystem m_PixelParticles;
     // These are the actors/items/particles which were added during a frame.
     // They are moved to the containers above at the end of the frame.
     std::deque<Actor *> m_AddedActors;
@@ -965,9 +1120,10 @@ protected:
     // It's entirely possible that stuff is deleted in the game but a reference to it is kept in Lua. Which is awful. Obviously.
     // Or perhaps even more concerningly, stuff can be deleted, re-allocated over the same space, and then readded to movableman. Which even this solution does nothing to fix.
     // Anyways, until we fix up ownership semantics... this is the best we can do.
-    std::unordered_set<const MovableObject *> m_ValidActors;
-    std::unordered_set<const MovableObject *> m_ValidItems;
-    std::unordered_set<const MovableObject *> m_ValidParticles;
+    // These are open addressing sets, so adding and deleting MOs doesn't allocate and free a node every time.
+    tsl::hopscotch_set<const MovableObject *, MOPointerHash> m_ValidActors;
+    tsl::hopscotch_set<const MovableObject *, MOPointerHash> m_ValidItems;
+    tsl::hopscotch_set<const MovableObject *, MOPointerHash> m_ValidParticles;
 
     // Mutexes to ensure MOs aren't being removed from separate threads at the same time
     std::mutex m_ActorsMutex;
@@ -979,9 +1135,6 @@ protected:
     std::mutex m_AddedItemsMutex;
     std::mutex m_AddedParticlesMutex;
 
-    // Mutex to ensure objects aren't registered/deregistered from separate threads at the same time
-    std::mutex m_ObjectRegisteredMutex;
-
     // Mutex to ensure actors don't change team roster from seperate threads at the same time
     std::mutex m_ActorRosterMutex;
 
@@ -1007,6 +1160,14 @@ protected:
 
     // The list created each frame to register all the current MO's
     std::vector<MovableObject *> m_MOIDIndex;
+    // Whether the MO of each MOID may have moved, turned or changed frame since it was marked in the MOID grid's occupancy masks, indexed by MOID. Only kept up to date while traveling
+    std::vector<char> m_StaleOccupancyMasks;
+    // Whether any entry of m_StaleOccupancyMasks was set since the masks were drawn, so queries don't need to look them up until something travels
+    bool m_AnyOccupancyMaskStale;
+    // Whether none of the occupancy masks can be trusted, because the MOs are being updated or the masks redrawn
+    bool m_AllOccupancyMasksStale;
+    // The first MOID given to the bulk-simulated particles when the masks were drawn
+    MOID m_FirstPixelParticleMOID;
 
     // The ration of terrain pixels to be converted into MOPixel:s upon
     // deep impact of MO.
@@ -1018,11 +1179,24 @@ protected:
     bool m_SettlingEnabled;
     // Whtehr MO's vcanng et subtracted form the terrain at all
     bool m_MOSubtractionEnabled;
+    // Whether particles that won't collide with anything are traveled in parallel
+    bool m_ParallelParticleTravelEnabled;
+    // Whether plain MOPixels flying freely through the air are simulated in bulk by m_PixelParticles
+    bool m_PixelParticleSystemEnabled;
+    // Whether Update is going through m_Particles, so particles promoted from m_PixelParticles have to be added like new ones instead of being put straight in it
+    bool m_UpdatingParticles;
 
 	unsigned int m_SimUpdateFrameNumber;
 
-	// Global map which stores all objects so they could be foud by their unique ID
-	std::map<long int, MovableObject *> m_KnownObjects;
+    // Wrap-aware grid of m_Actors split by team, used for the closest actor, nearest actors and actors in radius queries
+    ActorProximityGrid m_ActorProximityGrid;
+    // Whether m_ActorProximityGrid was built from the current contents of m_Actors, or has to be rebuilt before the next query
+    std::atomic<bool> m_ActorProximityGridIsCurrent;
+    // Mutex to ensure m_ActorProximityGrid isn't rebuilt while it's being queried from other threads
+    std::shared_mutex m_ActorProximityGridMutex;
+
+	// Global lookup which stores all objects so they could be found by their unique ID, split into shards by the low bits of the ID
+	std::array<KnownObjectsShard, c_KnownObjectsShardCount> m_KnownObjects;
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1042,11 +1216,65 @@ private:
 
     void Clear();
 
+    /// <summary>
+    /// Readies a MovableObject that's about to be added to the particle or item lists for its first frame in MovableMan.
+    /// </summary>
+    /// <param name="particleToAdd">The MovableObject to ready.</param>
+    void PrepareParticleForAdding(MovableObject *particleToAdd);
+
+    /// <summary>
+    /// Gets the shard of the global object lookup that holds the object with the given unique ID.
+    /// </summary>
+    /// <param name="id">The unique ID to get the shard for.</param>
+    /// <returns>The shard that holds the object with the given unique ID, if it's registered.</returns>
+    KnownObjectsShard & GetKnownObjectsShard(long int id) { return m_KnownObjects[static_cast<unsigned long int>(id) % c_KnownObjectsShardCount]; }
+
+    /// <summary>
+    /// Rebuilds the actor proximity grid from the current positions and teams of all Actors in m_Actors.
+    /// </summary>
+    void RebuildActorProximityGrid();
+
+    /// <summary>
+    /// Refreshes the actor proximity grid after Actors moved during an update phase, if it's current. Otherwise it's rebuilt by the next query anyway.
+    /// </summary>
+    void RefreshActorProximityGrid();
+
+    /// <summary>
+    /// Locks the actor proximity grid for querying, rebuilding it first if m_Actors changed since it was last built.
+    /// </summary>
+    /// <returns>A shared lock on the actor proximity grid, which has to be held while querying it.</returns>
+    std::shared_lock<std::shared_mutex> LockActorProximityGridForQuery();
+
+    /// <summary>
+    /// Gets the Actor in m_Actors closest to a scene point, out of the ones of the given teams that pass the given filter.
+    /// </summary>
+    /// <param name="scenePoint">The Scene point to search for the closest to.</param>
+    /// <param name="maxRadius">The maximum radius around that scene point to search.</param>
+    /// <param name="teamMask">Mask of the teams whose Actors to include, made with ActorProximityGrid::GetTeamMask() or ActorProximityGrid::GetAllTeamsMask().</param>
+    /// <param name="filter">A filter Actors have to pass to be included.</param>
+    /// <param name="getDistance">A Vector to be filled out with the distance of the returned closest to the search point. Will be unaltered if no Actor was found within radius.</param>
+    /// <returns>The closest Actor, or nullptr if none was found within the radius.</returns>
+    Actor * FindClosestActor(const Vector &scenePoint, int maxRadius, int teamMask, const ActorProximityGrid::ActorFilter &filter, Vector &getDistance);
+
     /// <summary>
     /// Travels all of our MOs, updating their location/velocity/physical characteristics.
     /// </summary>
     void Travel();
 
+    /// <summary>
+    /// Marks the occupancy masks of a range of MOIDs as stale, or checks whether they still are once their MOs have traveled.
+    /// </summary>
+    /// <param name="firstMOID">The first MOID of the range, usually the MOID of a root MO. Nothing is done if this is g_NoMOID.</param>
+    /// <param name="moidCount">The number of MOIDs in the range, usually the MOID footprint of the root MO.</param>
+    /// <param name="checkIfCurrent">Whether to check each MO for whether its occupancy mask is still current instead of marking it stale outright.</param>
+    void UpdateStaleOccupancyMasks(MOID firstMOID, int moidCount, bool checkIfCurrent);
+
+    /// <summary>
+    /// Travels all of our particles, with the ones that won't collide with anything this frame traveled in parallel on the priority thread pool.
+    /// Everything else is traveled serially afterwards in the original order, and trails drawn by the parallel travel are merged in that order as well, so the outcome doesn't depend on thread timing.
+    /// </summary>
+    void TravelParticlesInParallel();
+
     /// <summary>
     /// Updates the controllers of all the actors we own.
     /// This is needed for a tricky reason - we want the controller from the activity to override the normal controller state
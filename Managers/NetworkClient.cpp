@@ -32,6 +32,11 @@ namespace RTE {
 		m_CurrentBoxWidth = 0;
 		m_CurrentBoxHeight = 0;
 		m_CurrentFrameDeltaCompressed = false;
+		m_PreviousBoxWidth = 0;
+		m_PreviousBoxHeight = 0;
+		m_PreviousFrameInterlaced = false;
+		m_PreviousFrameShiftX = 0;
+		m_PreviousFrameShiftY = 0;
 		m_ShowFillRate = false;
 		m_UseNATPunchThroughService = false;
 		m_CurrentFrameInterlaced = false;
@@ -272,6 +277,32 @@ namespace RTE {
 
 		if (!g_SettingsMan.UseExperimentalMultiplayerSpeedBoosts()) { DrawFrame(frameData->FrameNumber, frameData->Interlaced, !frameData->DeltaCompressed); }
 
+		// The server shifted its copy of the previous frame to follow the Scene scrolling, so shift ours the same way before the deltas of the new frame are added to it.
+		if (frameData->DeltaCompressed && (frameData->ShiftX != 0 || frameData->ShiftY != 0)) {
+			BITMAP *bmp = g_FrameMan.GetNetworkBackBufferIntermediate8Ready(0);
+			int shiftX = frameData->ShiftX;
+			int shiftY = frameData->ShiftY;
+
+			blit(bmp, bmp, std::max(-shiftX, 0), std::max(-shiftY, 0), std::max(shiftX, 0), std::max(shiftY, 0), bmp->w - std::abs(shiftX), bmp->h - std::abs(shiftY));
+			if (shiftX > 0) {
+				rectfill(bmp, 0, 0, shiftX - 1, bmp->h - 1, g_MaskColor);
+			} else if (shiftX < 0) {
+				rectfill(bmp, bmp->w + shiftX, 0, bmp->w - 1, bmp->h - 1, g_MaskColor);
+			}
+			if (shiftY > 0) {
+				rectfill(bmp, 0, 0, bmp->w - 1, shiftY - 1, g_MaskColor);
+			} else if (shiftY < 0) {
+				rectfill(bmp, 0, bmp->h + shiftY, bmp->w - 1, bmp->h - 1, g_MaskColor);
+			}
+		}
+
+		// Boxes of the previous frame can still arrive after this, so keep what's needed to unpack them where the shift moved their pixels.
+		m_PreviousBoxWidth = m_CurrentBoxWidth;
+		m_PreviousBoxHeight = m_CurrentBoxHeight;
+		m_PreviousFrameInterlaced = m_CurrentFrameInterlaced;
+		m_PreviousFrameShiftX = frameData->DeltaCompressed ? frameData->ShiftX : 0;
+		m_PreviousFrameShiftY = frameData->DeltaCompressed ? frameData->ShiftY : 0;
+
 		m_PostEffects[m_CurrentFrameNum].clear();
 		m_CurrentFrameNum = frameData->FrameNumber;
 		m_CurrentFrameInterlaced = frameData->Interlaced;
@@ -336,27 +367,44 @@ namespace RTE {
 	void NetworkClient::ReceiveFrameBoxMsg(RakNet::Packet *packet) {
 		const MsgFrameBox *frameData = (MsgFrameBox *)packet->data;
 
-		if (m_CurrentBoxWidth == 0 || m_CurrentBoxHeight == 0) {
+		// A box of the previous frame that arrived after the setup of this one was already folded into the server's copy of the previous frame, so it still has to be unpacked, just where the shift moved its pixels to.
+		// The frame numbers wrap at c_FramesToRemember, but boxes are sequenced behind the setup of their frame, so any box not of this frame is of the previous one.
+		bool isLateBox = frameData->FrameNumber != m_CurrentFrameNum;
+		// If this frame isn't delta compressed, its boxes replace everything the previous frame's would have left behind.
+		if (isLateBox && !m_CurrentFrameDeltaCompressed) {
+			return;
+		}
+		int boxWidth = isLateBox ? m_PreviousBoxWidth : m_CurrentBoxWidth;
+		int boxHeight = isLateBox ? m_PreviousBoxHeight : m_CurrentBoxHeight;
+		bool frameInterlaced = isLateBox ? m_PreviousFrameInterlaced : m_CurrentFrameInterlaced;
+		if (boxWidth == 0 || boxHeight == 0) {
 			return;
 		}
 
-		int bpx = frameData->BoxX * m_CurrentBoxWidth;
-		int bpy = frameData->BoxY * m_CurrentBoxHeight;
+		int bpx = frameData->BoxX * boxWidth;
+		int bpy = frameData->BoxY * boxHeight;
 		m_CurrentSceneLayerReceived = -1;
 
 		BITMAP *bmp = nullptr;
 		bool isDelta = frameData->Id == ID_SRV_FRAME_BOX_MO_DELTA || frameData->Id == ID_SRV_FRAME_BOX_UI_DELTA;
+		int shiftX = 0;
+		int shiftY = 0;
 
 		if (frameData->Id == ID_SRV_FRAME_BOX_MO || frameData->Id == ID_SRV_FRAME_BOX_MO_DELTA) {
 			bmp = g_FrameMan.GetNetworkBackBufferIntermediate8Ready(0);
+			// Only the MO layer is shifted to follow the Scene scrolling.
+			if (isLateBox) {
+				shiftX = m_PreviousFrameShiftX;
+				shiftY = m_PreviousFrameShiftY;
+			}
 		} else if (frameData->Id == ID_SRV_FRAME_BOX_UI || frameData->Id == ID_SRV_FRAME_BOX_UI_DELTA) {
 			bmp = g_FrameMan.GetNetworkBackBufferIntermediateGUI8Ready(0);
 		}
 
 		acquire_bitmap(bmp);
 
-		int maxWidth = m_CurrentBoxWidth;
-		int maxHeight = m_CurrentBoxHeight;
+		int maxWidth = boxWidth;
+		int maxHeight = boxHeight;
 
 		// If box with default size is out of bounds, then it was truncated by the screen edge
 		if (bpx + maxWidth >= bmp->w) { maxWidth = bmp->w - bpx; }
@@ -365,7 +413,7 @@ namespace RTE {
 		int size = frameData->DataSize;
 		int uncompressedSize = maxWidth * maxHeight;
 
-		if (m_CurrentFrameInterlaced) { uncompressedSize = maxWidth * (maxHeight / 2); }
+		if (frameInterlaced) { uncompressedSize = maxWidth * (maxHeight / 2); }
 
 		float compressionRatio = static_cast<float>(size) / static_cast<float>(uncompressedSize);
 
@@ -373,9 +421,13 @@ namespace RTE {
 		m_CompressedData += uncompressedSize;
 
 		if (bpx + maxWidth - 1 < bmp->w && bpy + maxHeight - 1 < bmp->h && bpx >= 0 && bpy >= 0) {
+			// The part of the box that's still on the bitmap after shifting it, relative to the box.
+			int visibleLeft = std::max(-(bpx + shiftX), 0);
+			int visibleRight = std::min(maxWidth, bmp->w - (bpx + shiftX));
+
 			// Unpack box
 			if (frameData->DataSize == 0) {
-				rectfill(bmp, bpx, bpy, bpx + maxWidth - 1, bpy + maxHeight - 1, g_MaskColor);
+				rectfill(bmp, bpx + shiftX, bpy + shiftY, bpx + shiftX + maxWidth - 1, bpy + shiftY + maxHeight - 1, g_MaskColor);
 			} else {
 				if (frameData->DataSize == uncompressedSize) {
 #ifdef _WIN32
@@ -392,28 +444,34 @@ namespace RTE {
 				int lineStart = 0;
 				int lineStep = 1;
 
-				if (m_CurrentFrameInterlaced) {
+				if (frameInterlaced) {
 					lineStep = 2;
-					if (m_CurrentFrameNum % 2 != 0) { lineStart = 1; }
+					if (frameData->FrameNumber % 2 != 0) { lineStart = 1; }
 				}
 
 				if (isDelta) {
 					const unsigned char *lineAddr = m_PixelLineBuffer;
 					for (int y = lineStart; y < maxHeight; y += lineStep) {
-						for (int x = 0; x < maxWidth; x++) {
-							*(bmp->line[bpy + y] + bpx + x) += lineAddr[x];
+						int targetY = bpy + shiftY + y;
+						if (targetY >= 0 && targetY < bmp->h) {
+							for (int x = visibleLeft; x < visibleRight; x++) {
+								*(bmp->line[targetY] + bpx + shiftX + x) += lineAddr[x];
+							}
 						}
 						lineAddr += maxWidth;
 					}
-				} else {
+				} else if (visibleLeft < visibleRight) {
 					// Copy box to bitmap line by line
 					const unsigned char *lineAddr = m_PixelLineBuffer;
 					for (int y = lineStart; y < maxHeight; y += lineStep) {
+						int targetY = bpy + shiftY + y;
+						if (targetY >= 0 && targetY < bmp->h) {
 #ifdef _WIN32
-						memcpy_s(bmp->line[bpy + y] + bpx, maxWidth, lineAddr, maxWidth);
+							memcpy_s(bmp->line[targetY] + bpx + shiftX + visibleLeft, visibleRight - visibleLeft, lineAddr + visibleLeft, visibleRight - visibleLeft);
 #else
-						memcpy(bmp->line[bpy + y] + bpx, lineAddr, maxWidth);
+							memcpy(bmp->line[targetY] + bpx + shiftX + visibleLeft, lineAddr + visibleLeft, visibleRight - visibleLeft);
 #endif
+						}
 						lineAddr += maxWidth;
 					}
 				}
@@ -422,7 +480,7 @@ namespace RTE {
 					rect(bmp, bpx, bpy, bpx + maxWidth - 1, bpy + maxHeight - 1, g_WhiteColor);
 
 					int color = isDelta ? ColorKeys::g_GreenColor : ColorKeys::g_RedColor;
-					if (maxHeight == m_CurrentBoxHeight) {
+					if (maxHeight == boxHeight) {
 						line(bmp, bpx, bpy, bpx + maxWidth - 1, bpy, color);
 						line(bmp, bpx, bpy, bpx, bpy + compressionRatio * maxHeight, color);
 						line(bmp, bpx + maxWidth - 1, bpy, bpx + maxWidth - 1, bpy + compressionRatio * maxHeight, color);
@@ -578,32 +636,31 @@ namespace RTE {
 			return;
 		}
 
-		if (frameData->W == 1 && frameData->H == 1) {
-			BITMAP *bmp = 0;
-			bmp = frameData->Back ? m_SceneBackgroundBitmap : m_SceneForegroundBitmap;
-			putpixel(bmp, frameData->X, frameData->Y, frameData->Color);
-		} else {
-			int size = frameData->UncompressedSize;
+		const TerrainChangeNetworkData *changeData = (TerrainChangeNetworkData *)(packet->data + sizeof(MsgTerrainChange));
+		const unsigned char *pixelData = (const unsigned char *)(changeData + frameData->ChangeCount);
+		int size = frameData->UncompressedSize;
 
-			if (frameData->DataSize == frameData->UncompressedSize) {
+		if (frameData->DataSize == frameData->UncompressedSize) {
 #ifdef _WIN32
-				memcpy_s(m_PixelLineBuffer, size, packet->data + sizeof(MsgTerrainChange), size);
+			memcpy_s(m_PixelLineBuffer, size, pixelData, size);
 #else
-				memcpy(m_PixelLineBuffer, packet->data + sizeof(MsgTerrainChange), size);
+			memcpy(m_PixelLineBuffer, pixelData, size);
 #endif
-			} else {
-				LZ4_decompress_safe((char *)(packet->data + sizeof(MsgTerrainChange)), (char *)m_PixelLineBuffer, frameData->DataSize, size);
-			}
+		} else {
+			LZ4_decompress_safe((char *)pixelData, (char *)m_PixelLineBuffer, frameData->DataSize, size);
+		}
 
-			// Copy bitmap data to scene bitmap
+		// Copy bitmap data of each changed area to scene bitmap
+		const unsigned char *src = m_PixelLineBuffer;
+		for (int i = 0; i < frameData->ChangeCount; i++) {
 			const BITMAP *bmp = 0;
-			bmp = (frameData->Back) ? m_SceneBackgroundBitmap : m_SceneForegroundBitmap;
+			bmp = (changeData->Back) ? m_SceneBackgroundBitmap : m_SceneForegroundBitmap;
 
-			const unsigned char *src = m_PixelLineBuffer;
-			for (int y = 0; y < frameData->H && frameData->Y + y < bmp->h; y++) {
-				memcpy(bmp->line[frameData->Y + y] + frameData->X, src, frameData->W);
-				src += frameData->W;
+			for (int y = 0; y < changeData->H && changeData->Y + y < bmp->h; y++) {
+				memcpy(bmp->line[changeData->Y + y] + changeData->X, src, changeData->W);
+				src += changeData->W;
 			}
+			changeData++;
 		}
 	}
 
@@ -170,6 +170,11 @@ namespace RTE {
 		int m_CurrentBoxHeight; //!< The received frame box height.
 		bool m_CurrentFrameInterlaced; //!< Whether the received frame data is interlaced.
 		bool m_CurrentFrameDeltaCompressed; //!< Whether the received frame data is delta compressed.
+		int m_PreviousBoxWidth; //!< The box width of the frame received before the current one.
+		int m_PreviousBoxHeight; //!< The box height of the frame received before the current one.
+		bool m_PreviousFrameInterlaced; //!< Whether the frame received before the current one is interlaced.
+		int m_PreviousFrameShiftX; //!< How far the frame received before the current one was shifted horizontally when the current one was set up.
+		int m_PreviousFrameShiftY; //!< How far the frame received before the current one was shifted vertically when the current one was set up.
 
 		bool m_ShowFillRate; //!<
 
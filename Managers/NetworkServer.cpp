@@ -16,6 +16,9 @@
 #include "TimerMan.h"
 #include "AudioMan.h"
 #include "FrameMan.h"
+#include "ThreadMan.h"
+
+#include "FrameBoxKernels.h"
 
 #include "RakNetStatistics.h"
 #include "RakSleep.h"
@@ -94,6 +97,12 @@ namespace RTE {
 
 			m_FrameNumbers[i] = 0;
 
+			m_LastSentMODrawings[i] = FrameMan::NetworkFrameMODrawings();
+			m_TrackChangedFrameBoxes[i] = false;
+			m_ChangedFrameBoxes[i].clear();
+			m_FrameShiftX[i] = 0;
+			m_FrameShiftY[i] = 0;
+
 			m_Ping[i] = 0;
 			m_PingTimer[i] = nullptr;
 
@@ -131,6 +140,7 @@ namespace RTE {
 
 			m_EmptyBlocks[i] = 0;
 			m_FullBlocks[i] = 0;
+			m_SkippedBlocks[i] = 0;
 		}
 
 		m_UseHighCompression = true;
@@ -209,6 +219,8 @@ namespace RTE {
 
 			if (m_LZ4FastCompressionState[i]) { free(m_LZ4FastCompressionState[i]); }
 			m_LZ4FastCompressionState[i] = 0;
+
+			m_FrameBoxEncoders[i].clear();
 		}
 		Clear();
 	}
@@ -319,7 +331,9 @@ namespace RTE {
 			for (short player = 0; player < c_MaxClients; player++) {
 				if (IsPlayerConnected(player)) {
 					m_Mutex[player].lock();
-					m_PendingTerrainChanges[player].push(terrainChange);
+					TerrainChangeJournal &terrainChanges = m_TerrainChanges[player];
+					if (terrainChanges.GetSceneWidth() != g_SceneMan.GetSceneWidth() || terrainChanges.GetSceneHeight() != g_SceneMan.GetSceneHeight()) { terrainChanges.Create(g_SceneMan.GetSceneWidth(), g_SceneMan.GetSceneHeight()); }
+					terrainChanges.MarkChanged(terrainChange.x, terrainChange.y, terrainChange.w, terrainChange.h, terrainChange.back);
 					m_Mutex[player].unlock();
 				}
 			}
@@ -900,12 +914,7 @@ namespace RTE {
 
 	void NetworkServer::ClearTerrainChangeQueue(short player) {
 		m_Mutex[player].lock();
-		while (!m_PendingTerrainChanges[player].empty()) {
-			m_PendingTerrainChanges[player].pop();
-		}
-		while (!m_CurrentTerrainChanges[player].empty()) {
-			m_CurrentTerrainChanges[player].pop();
-		}
+		m_TerrainChanges[player].Reset();
 		m_Mutex[player].unlock();
 	}
 
@@ -915,7 +924,7 @@ namespace RTE {
 		bool result;
 
 		m_Mutex[player].lock();
-		result = !m_PendingTerrainChanges[player].empty();
+		result = !m_TerrainChanges[player].IsEmpty();
 		m_Mutex[player].unlock();
 
 		return result;
@@ -925,135 +934,92 @@ namespace RTE {
 
 	void NetworkServer::ProcessTerrainChanges(short player) {
 		m_Mutex[player].lock();
-		while (!m_PendingTerrainChanges[player].empty()) {
-			m_CurrentTerrainChanges[player].push(m_PendingTerrainChanges[player].front());
-			m_PendingTerrainChanges[player].pop();
-		}
+		m_TerrainChanges[player].TakeChangedAreas(m_ChangedTerrainAreas[player], c_MaxTerrainChangeAreaSize);
 		m_Mutex[player].unlock();
 
-		while (!m_CurrentTerrainChanges[player].empty()) {
-			int maxSize = 1280;
-
-			NetworkTerrainChange terrainChange = m_CurrentTerrainChanges[player].front();
-			m_CurrentTerrainChanges[player].pop();
-
-			// Fragment region if it does not fit one packet
-			if (terrainChange.w * terrainChange.h > maxSize) {
-				int size = 0;
-				int height = 1;
-				int heightStart = 0;
-
-				for (int y = 0; y < terrainChange.h; y++) {
-					height++;
-					size += terrainChange.w;
-
-					// Store changed block if the size is over the MTU or if it's the last block.
-					if (size + terrainChange.w >= maxSize || y == terrainChange.h - 1) {
-						NetworkTerrainChange tcf;
-						tcf.x = terrainChange.x;
-						tcf.y = terrainChange.y + heightStart;
-						tcf.w = terrainChange.w;
-						tcf.h = height;
-						tcf.back = terrainChange.back;
-						tcf.color = terrainChange.color;
-
-						SendTerrainChangeMsg(player, tcf);
-
-						size = 0;
-						heightStart = y;
-						height = 1;
-					}
-				}
-			} else {
-				SendTerrainChangeMsg(player, terrainChange);
+		const std::vector<TerrainChangeJournal::ChangedArea> &changedAreas = m_ChangedTerrainAreas[player];
+
+		// Pack as many areas into each message as fit in it uncompressed, so it can still be sent if compression doesn't help.
+		size_t batchStart = 0;
+		int batchPixelCount = 0;
+		for (size_t areaIndex = 0; areaIndex < changedAreas.size(); ++areaIndex) {
+			int areaPixelCount = changedAreas[areaIndex].W * changedAreas[areaIndex].H;
+			size_t batchSize = sizeof(MsgTerrainChange) + (areaIndex - batchStart + 1) * sizeof(TerrainChangeNetworkData) + batchPixelCount + areaPixelCount;
+			if (areaIndex > batchStart && batchSize > c_MaxPixelLineBufferSize) {
+				SendTerrainChangeMsg(player, batchStart, areaIndex - batchStart);
+				batchStart = areaIndex;
+				batchPixelCount = 0;
 			}
+			batchPixelCount += areaPixelCount;
 		}
+		if (batchStart < changedAreas.size()) { SendTerrainChangeMsg(player, batchStart, changedAreas.size() - batchStart); }
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void NetworkServer::SendTerrainChangeMsg(short player, NetworkTerrainChange terrainChange) {
-		if (terrainChange.w == 1 && terrainChange.h == 1) {
-			MsgTerrainChange msg = {};
-			msg.Id = ID_SRV_TERRAIN;
-			msg.X = terrainChange.x;
-			msg.Y = terrainChange.y;
-			msg.W = terrainChange.w;
-			msg.H = terrainChange.h;
-			msg.DataSize = 0;
-			msg.UncompressedSize = 0;
-			msg.SceneId = m_SceneID;
-			msg.Color = terrainChange.color;
-			msg.Back = terrainChange.back;
-
-			int payloadSize = sizeof(MsgTerrainChange);
-
-			m_Server->Send((const char *)&msg, payloadSize, MEDIUM_PRIORITY, RELIABLE, 0, m_ClientConnections[player].ClientId, false);
-
-			m_DataSentCurrent[player][STAT_CURRENT] += payloadSize;
-			m_DataSentTotal[player] += payloadSize;
-
-			m_TerrainDataSentCurrent[player][STAT_CURRENT] += payloadSize;
-			m_TerrainDataSentTotal[player] += payloadSize;
-
-			m_DataUncompressedCurrent[player][STAT_CURRENT] += payloadSize;
-			m_DataUncompressedTotal[player] += payloadSize;
-		} else {
-			MsgTerrainChange *msg = (MsgTerrainChange *)m_CompressedLineBuffer[player];
-			msg->Id = ID_SRV_TERRAIN;
-			msg->X = terrainChange.x;
-			msg->Y = terrainChange.y;
-			msg->W = terrainChange.w;
-			msg->H = terrainChange.h;
-			int size = msg->W * msg->H;
-			msg->DataSize = size;
-			msg->UncompressedSize = size;
-			msg->SceneId = m_SceneID;
-			msg->Color = terrainChange.color;
-			msg->Back = terrainChange.back;
-
-			Scene * scene = g_SceneMan.GetScene();
-			SLTerrain * terrain = scene->GetTerrain();
-
-			const BITMAP *bmp = 0;
-			bmp = msg->Back ? terrain->GetBGColorBitmap() : terrain->GetFGColorBitmap();
-
-			unsigned char *dest = (unsigned char *)(m_PixelLineBuffer[player]);
-
-			// Copy bitmap data
-			for (int y = 0; y < msg->H && msg->Y + y < bmp->h; y++) {
-				memcpy(dest, bmp->line[msg->Y + y] + msg->X, msg->W);
-				dest += msg->W;
+	void NetworkServer::SendTerrainChangeMsg(short player, size_t firstArea, size_t areaCount) {
+		MsgTerrainChange *msg = (MsgTerrainChange *)m_CompressedLineBuffer[player];
+		msg->Id = ID_SRV_TERRAIN;
+		msg->SceneId = m_SceneID;
+		msg->ChangeCount = areaCount;
+
+		Scene * scene = g_SceneMan.GetScene();
+		SLTerrain * terrain = scene->GetTerrain();
+
+		TerrainChangeNetworkData *changeData = (TerrainChangeNetworkData *)(m_CompressedLineBuffer[player] + sizeof(MsgTerrainChange));
+		unsigned char *dest = (unsigned char *)(m_PixelLineBuffer[player]);
+		int size = 0;
+
+		for (size_t areaIndex = firstArea; areaIndex < firstArea + areaCount; ++areaIndex) {
+			const TerrainChangeJournal::ChangedArea &changedArea = m_ChangedTerrainAreas[player][areaIndex];
+			changeData->X = changedArea.X;
+			changeData->Y = changedArea.Y;
+			changeData->W = changedArea.W;
+			changeData->H = changedArea.H;
+			changeData->Back = changedArea.Back;
+			changeData++;
+
+			// Copy bitmap data. The pixels are read as they are now rather than as they were when the change was registered, so multiple changes to the same pixel only send the last one.
+			const BITMAP *bmp = changedArea.Back ? terrain->GetBGColorBitmap() : terrain->GetFGColorBitmap();
+			for (int y = 0; y < changedArea.H && changedArea.Y + y < bmp->h; y++) {
+				memcpy(dest, bmp->line[changedArea.Y + y] + changedArea.X, changedArea.W);
+				dest += changedArea.W;
+				size += changedArea.W;
 			}
+		}
+		msg->DataSize = size;
+		msg->UncompressedSize = size;
+
+		unsigned char *pixelData = (unsigned char *)changeData;
+		int pixelDataCapacity = c_MaxPixelLineBufferSize - static_cast<int>(pixelData - m_CompressedLineBuffer[player]);
 
-			int result = 0;
+		int result = 0;
 
-			result = LZ4_compress_HC_extStateHC(m_LZ4CompressionState[player], (char *)m_PixelLineBuffer[player], (char *)(m_CompressedLineBuffer[player] + sizeof(MsgTerrainChange)), size, size, LZ4HC_CLEVEL_OPT_MIN);
+		result = LZ4_compress_HC_extStateHC(m_LZ4CompressionState[player], (char *)m_PixelLineBuffer[player], (char *)pixelData, size, pixelDataCapacity, LZ4HC_CLEVEL_OPT_MIN);
 
-			// Compression failed or ineffective, send as is
-			if (result == 0 || result == size) {
+		// Compression failed or ineffective, send as is
+		if (result == 0 || result >= size) {
 #ifdef _WIN32
-				memcpy_s(m_CompressedLineBuffer[player] + sizeof(MsgTerrainChange), c_MaxPixelLineBufferSize, m_PixelLineBuffer[player], size);
+			memcpy_s(pixelData, pixelDataCapacity, m_PixelLineBuffer[player], size);
 #else
-				memcpy(m_CompressedLineBuffer[player] + sizeof(MsgTerrainChange), m_PixelLineBuffer[player], size);
+			memcpy(pixelData, m_PixelLineBuffer[player], size);
 #endif
-			} else {
-				msg->DataSize = result;
-			}
+		} else {
+			msg->DataSize = result;
+		}
 
-			int payloadSize = sizeof(MsgTerrainChange) + msg->DataSize;
+		int payloadSize = static_cast<int>(pixelData - m_CompressedLineBuffer[player]) + msg->DataSize;
 
-			m_Server->Send((const char *)msg, payloadSize, MEDIUM_PRIORITY, RELIABLE, 0, m_ClientConnections[player].ClientId, false);
+		m_Server->Send((const char *)msg, payloadSize, MEDIUM_PRIORITY, RELIABLE, 0, m_ClientConnections[player].ClientId, false);
 
-			m_DataSentCurrent[player][STAT_CURRENT] += payloadSize;
-			m_DataSentTotal[player] += payloadSize;
+		m_DataSentCurrent[player][STAT_CURRENT] += payloadSize;
+		m_DataSentTotal[player] += payloadSize;
 
-			m_TerrainDataSentCurrent[player][STAT_CURRENT] += payloadSize;
-			m_TerrainDataSentTotal[player] += payloadSize;
+		m_TerrainDataSentCurrent[player][STAT_CURRENT] += payloadSize;
+		m_TerrainDataSentTotal[player] += payloadSize;
 
-			m_DataUncompressedCurrent[player][STAT_CURRENT] += msg->UncompressedSize;
-			m_DataUncompressedTotal[player] += msg->UncompressedSize;
-		}
+		m_DataUncompressedCurrent[player][STAT_CURRENT] += msg->UncompressedSize;
+		m_DataUncompressedTotal[player] += msg->UncompressedSize;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1088,6 +1054,8 @@ namespace RTE {
 			memset(m_PixelLineBuffersPrev[player], 0, lines * boxSize);
 			memset(m_PixelLineBuffersGUIPrev[player], 0, lines * boxSize);
 		}
+		// The previous frame no longer matches the last one sent, so the next one can't skip any boxes.
+		m_LastSentMODrawings[player].IsComplete = false;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1103,6 +1071,8 @@ namespace RTE {
 			memset(m_PixelLineBuffersPrev[player], 0, lines * boxSize);
 			memset(m_PixelLineBuffersGUIPrev[player], 0, lines * boxSize);
 		}
+		// The previous frame no longer matches the last one sent, so the next one can't skip any boxes.
+		m_LastSentMODrawings[player].IsComplete = false;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1139,6 +1109,8 @@ namespace RTE {
 		msgFrameSetup.BoxHeight = m_BoxHeight;
 		msgFrameSetup.Interlaced = m_UseInterlacing;
 		msgFrameSetup.DeltaCompressed = m_UseDeltaCompression;
+		msgFrameSetup.ShiftX = static_cast<short>(m_FrameShiftX[player]);
+		msgFrameSetup.ShiftY = static_cast<short>(m_FrameShiftY[player]);
 
 		for (int i = 0; i < c_MaxLayersStoredForNetwork; i++) {
 			msgFrameSetup.OffsetX[i] = g_FrameMan.SLOffset[player][i].m_X;
@@ -1258,6 +1230,9 @@ namespace RTE {
 		m_FrameNumbers[player]++;
 		if (m_FrameNumbers[player] >= c_FramesToRemember) { m_FrameNumbers[player] = 0; }
 
+		// Has to happen while the backbuffer still holds the last frame sent
+		UpdateChangedFrameBoxes(player, g_FrameMan.GetNetworkFrameMODrawingsReady(player));
+
 		// Save a copy of buffer to avoid tearing when the original is updated by frame man
 		blit(frameManBmp, m_BackBuffer8[player], 0, 0, 0, 0, frameManBmp->w, frameManBmp->h);
 		blit(frameManGUIBmp, m_BackBufferGUI8[player], 0, 0, 0, 0, frameManGUIBmp->w, frameManGUIBmp->h);
@@ -1276,204 +1251,49 @@ namespace RTE {
 		m_SendEven[player] = !m_SendEven[player];
 
 		if (m_TransmitAsBoxes) {
-			MsgFrameBox *frameData = (MsgFrameBox *)m_CompressedLineBuffer[player];
-
-			int boxedWidth = m_BackBuffer8[player]->w / m_BoxWidth;
-			int boxedHeight = m_BackBuffer8[player]->h / m_BoxHeight;
-			int boxMaxSize = m_BoxWidth * m_BoxHeight;
+			int boxRowCount = m_BackBuffer8[player]->h / m_BoxHeight + 1;
 
-			if (m_BackBuffer8[player]->w % m_BoxWidth != 0) { boxedWidth += 1; }
+			// Split the rows of boxes between tasks on the thread pool. Each task has its own buffers, and each box has its own slice of the previous frame buffers, so they don't need to synchronize.
+			BS::thread_pool &threadPool = g_ThreadMan.GetBackgroundThreadPool();
+			int taskCount = std::clamp(static_cast<int>(threadPool.get_thread_count()), 1, boxRowCount);
 
-			for (unsigned char layer = 0; layer < 2; layer++) {
-				const BITMAP *backBuffer = nullptr;
-				unsigned char *prevLineBuffers = 0;
-
-				if (layer == 0) {
-					backBuffer = m_BackBuffer8[player];
-					prevLineBuffers = m_PixelLineBuffersPrev[player];
-				} else if (layer == 1) {
-					backBuffer = m_BackBufferGUI8[player];
-					prevLineBuffers = m_PixelLineBuffersGUIPrev[player];
-				}
-
-				for (int by = 0; by <= boxedHeight; by++) {
-					for (int bx = 0; bx <= boxedWidth; bx++) {
-						int bpx = bx * m_BoxWidth;
-						int bpy = by * m_BoxHeight;
-
-						if (bpx >= m_BackBuffer8[player]->w || bpy >= m_BackBuffer8[player]->h) {
-							break;
-						}
-
-						frameData->BoxX = bx;
-						frameData->BoxY = by;
-
-						int maxWidth = m_BoxWidth;
-						if (bpx + m_BoxWidth >= m_BackBuffer8[player]->w) { maxWidth = m_BackBuffer8[player]->w - bpx; }
-
-						int maxHeight = m_BoxHeight;
-						if (bpy + m_BoxHeight >= m_BackBuffer8[player]->h) { maxHeight = m_BackBuffer8[player]->h - bpy; }
-
-						int lineStart = 0;
-						int lineStep = 1;
-						int lineCount = maxHeight;
-
-						if (m_UseInterlacing) {
-							lineStep = 2;
-							if (m_SendEven[player]) { lineStart = 1; }
-							maxHeight /= 2;
-						}
-						int thisBoxSize = maxWidth * maxHeight;
-
-						bool boxIsEmpty = true;
-						bool boxIsDelta = false;
-						bool sendEmptyBox = false;
-
-						unsigned char *dest = (unsigned char *)(m_PixelLineBuffer[player]);
-
-						// Copy block line by line to linear buffer
-						for (int line = lineStart; line < lineCount; line += lineStep) {
-							// Copy bitmap data
-							memcpy(dest, backBuffer->line[bpy + line] + bpx, maxWidth);
-							dest += maxWidth;
-						}
-
-						if (m_UseDeltaCompression) {
-							// Store a copy of a line buffer to calculate and store delta
-							memcpy(m_PixelLineBufferDelta[player], m_PixelLineBuffer[player], thisBoxSize);
-
-							int bytesNeededPlain = 0;
-							int bytesNeededPrev = 0;
-							int bytesNeededDelta = 0;
-
-							// Previous line to delta against
-							int interlacedOffset = 0;
-							if (m_UseInterlacing) { interlacedOffset = m_SendEven[player] ? thisBoxSize : 0; }
-
-							unsigned char *prevLineBufferStart = prevLineBuffers + by * boxedWidth * boxMaxSize + bx * boxMaxSize;
-							unsigned char *prevLineBufferWithOffset = prevLineBufferStart + interlacedOffset;
-							// Currently processed box line buffer and delta storage
-							unsigned char *currLineBuffer = (unsigned char*)(m_PixelLineBufferDelta[player]);
-
-							// Calculate delta and decide whether we use it
-							for (int i = 0; i < thisBoxSize; i++) {
-								if (currLineBuffer[i] > 0) { bytesNeededPlain++; }
-								if (prevLineBufferWithOffset[i] > 0) { bytesNeededPrev++; }
-
-								currLineBuffer[i] = currLineBuffer[i] - prevLineBufferWithOffset[i];
-
-								if (currLineBuffer[i] > 0) { bytesNeededDelta++; }
-							}
-
-							// Store current line for delta check in the next frame
-							memcpy(prevLineBufferWithOffset, m_PixelLineBuffer[player], thisBoxSize);
-
-							if (bytesNeededPlain > 0) {
-								boxIsEmpty = false;
-
-								// If delta compression provides less significant bytes then use it
-								if (bytesNeededDelta < bytesNeededPlain) {
-									boxIsDelta = true;
-
-									if (bytesNeededDelta == 0) {
-										boxIsEmpty = true;
-									} else {
-										// Copy delta compressed buffer into plain pixel line
-										memcpy(m_PixelLineBuffer[player], m_PixelLineBufferDelta[player], thisBoxSize);
-									}
-								}
-							} else {
-								// Previous non empty block is now empty, clear it
-								if (bytesNeededPrev > 0 && bytesNeededPlain == 0) { sendEmptyBox = true; }
-							}
-						} else {
-							// Check if block is empty by evaluating by 64-bit ints
-							unsigned long *pixelInt = (unsigned long *)m_PixelLineBuffer[player];
-							int counter = 0;
-
-							for (counter = 0; counter < thisBoxSize; counter += sizeof(unsigned long)) {
-								if (*pixelInt > 0) {
-									boxIsEmpty = false;
-									break;
-								}
-								pixelInt++;
-							}
-							// Box area is not divisible by 8
-							if (boxIsEmpty && counter > thisBoxSize) {
-								pixelInt--;
-								counter -= sizeof(unsigned long);
-
-								const unsigned char *pixelChr = (unsigned char*)pixelInt;
-								for (; counter < thisBoxSize; counter++) {
-									if (*pixelChr > 0) {
-										boxIsEmpty = false;
-										break;
-									}
-									pixelChr++;
-								}
-							}
-						}
-
-						// Save msg ID
-						if (boxIsDelta) {
-							frameData->Id = layer == 0 ? ID_SRV_FRAME_BOX_MO_DELTA : ID_SRV_FRAME_BOX_UI_DELTA;
-						} else {
-							frameData->Id = layer == 0 ? ID_SRV_FRAME_BOX_MO : ID_SRV_FRAME_BOX_UI;
-						}
-						frameData->DataSize = thisBoxSize;
-
-						if (boxIsEmpty) {
-							frameData->DataSize = 0;
-							if (!sendEmptyBox) { m_EmptyBlocks[player]++; }
-						} else {
-							int result = 0;
-
-							if (m_UseHighCompression) {
-								result = LZ4_compress_HC_extStateHC(m_LZ4CompressionState[player], (char *)m_PixelLineBuffer[player], (char *)(m_CompressedLineBuffer[player] + sizeof(MsgFrameBox)), thisBoxSize, thisBoxSize, compressionMethod);
-							} else if (m_UseFastCompression) {
-								result = LZ4_compress_fast_extState(m_LZ4FastCompressionState[player], (char *)m_PixelLineBuffer[player], (char *)(m_CompressedLineBuffer[player] + sizeof(MsgFrameBox)), thisBoxSize, thisBoxSize, accelerationFactor);
-							}
-
-							// Compression failed or ineffective, send as is
-							if (result == 0 || result == backBuffer->w) {
-#ifdef _WIN32
-								memcpy_s(m_CompressedLineBuffer[player] + sizeof(MsgFrameBox), c_MaxPixelLineBufferSize, m_PixelLineBuffer[player], thisBoxSize);
-#else
-								memcpy(m_CompressedLineBuffer[player] + sizeof(MsgFrameBox), m_PixelLineBuffer[player], thisBoxSize);
-#endif
-							} else {
-								frameData->DataSize = result;
-							}
+			std::vector<std::unique_ptr<FrameBoxEncoder>> &frameBoxEncoders = m_FrameBoxEncoders[player];
+			while (frameBoxEncoders.size() < static_cast<size_t>(taskCount)) {
+				frameBoxEncoders.emplace_back(std::make_unique<FrameBoxEncoder>());
+			}
 
-							m_FullBlocks[player]++;
-						}
+			std::vector<std::future<void>> encodingTasks;
+			encodingTasks.reserve(taskCount);
+			for (int task = 0; task < taskCount; task++) {
+				FrameBoxEncoder *encoder = frameBoxEncoders[task].get();
+				int firstBoxRow = boxRowCount * task / taskCount;
+				int lastBoxRow = boxRowCount * (task + 1) / taskCount;
+				encodingTasks.emplace_back(threadPool.submit([this, player, encoder, firstBoxRow, lastBoxRow]() { SendFrameBoxes(player, *encoder, firstBoxRow, lastBoxRow); }));
+			}
+			for (std::future<void> &encodingTask : encodingTasks) {
+				encodingTask.wait();
+			}
 
-						int payloadSize = frameData->DataSize + sizeof(MsgFrameBox);
+			for (int task = 0; task < taskCount; task++) {
+				FrameBoxEncoder &encoder = *frameBoxEncoders[task];
 
-						if (!boxIsEmpty || sendEmptyBox) {
-							m_Server->Send((const char *)frameData, payloadSize, MEDIUM_PRIORITY, UNRELIABLE_SEQUENCED, 0, m_ClientConnections[player].ClientId, false);
-						} else {
-							payloadSize = 0;
-						}
+				m_EmptyBlocks[player] += encoder.EmptyBlocks;
+				m_FullBlocks[player] += encoder.FullBlocks;
+				m_SkippedBlocks[player] += encoder.SkippedBlocks;
 
-						if (boxIsEmpty) {
-							m_EmptyBlocksSentCurrent[player][STAT_CURRENT] += 1;
-							m_EmptyBlocksDataSentCurrent[player][STAT_CURRENT] += payloadSize;
-						} else {
-							m_FullBlocksSentCurrent[player][STAT_CURRENT] += 1;
-							m_FullBlocksDataSentCurrent[player][STAT_CURRENT] += payloadSize;
+				m_EmptyBlocksSentCurrent[player][STAT_CURRENT] += encoder.EmptyBlocksSent;
+				m_EmptyBlocksDataSentCurrent[player][STAT_CURRENT] += encoder.EmptyBlocksDataSent;
+				m_FullBlocksSentCurrent[player][STAT_CURRENT] += encoder.FullBlocksSent;
+				m_FullBlocksDataSentCurrent[player][STAT_CURRENT] += encoder.FullBlocksDataSent;
 
-							m_DataSentCurrent[player][STAT_CURRENT] += payloadSize;
-							m_DataSentTotal[player] += payloadSize;
+				m_DataSentCurrent[player][STAT_CURRENT] += encoder.FullBlocksDataSent;
+				m_DataSentTotal[player] += encoder.FullBlocksDataSent;
 
-							m_FrameDataSentCurrent[player][STAT_CURRENT] += payloadSize;
-							m_FrameDataSentTotal[player] += payloadSize;
+				m_FrameDataSentCurrent[player][STAT_CURRENT] += encoder.FullBlocksDataSent;
+				m_FrameDataSentTotal[player] += encoder.FullBlocksDataSent;
 
-							m_DataUncompressedCurrent[player][STAT_CURRENT] += thisBoxSize;
-							m_DataUncompressedTotal[player] += thisBoxSize;
-						}
-					}
-				}
+				m_DataUncompressedCurrent[player][STAT_CURRENT] += encoder.DataUncompressed;
+				m_DataUncompressedTotal[player] += encoder.DataUncompressed;
 			}
 		} else {
 			MsgFrameLine *frameData = (MsgFrameLine *)m_CompressedLineBuffer[player];
@@ -1589,6 +1409,322 @@ namespace RTE {
 		return 0;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NetworkServer::FrameBoxEncoder::FrameBoxEncoder() {
+		LZ4CompressionState = malloc(LZ4_sizeofStateHC());
+		LZ4FastCompressionState = malloc(LZ4_sizeofState());
+		ResetStats();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NetworkServer::FrameBoxEncoder::~FrameBoxEncoder() {
+		if (LZ4CompressionState) { free(LZ4CompressionState); }
+		if (LZ4FastCompressionState) { free(LZ4FastCompressionState); }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkServer::FrameBoxEncoder::ResetStats() {
+		EmptyBlocks = 0;
+		FullBlocks = 0;
+		SkippedBlocks = 0;
+		EmptyBlocksSent = 0;
+		EmptyBlocksDataSent = 0;
+		FullBlocksSent = 0;
+		FullBlocksDataSent = 0;
+		DataUncompressed = 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkServer::UpdateChangedFrameBoxes(short player, const FrameMan::NetworkFrameMODrawings &moDrawings) {
+		FrameMan::NetworkFrameMODrawings &lastSentMODrawings = m_LastSentMODrawings[player];
+		const BITMAP *backBuffer = m_BackBuffer8[player];
+
+		m_TrackChangedFrameBoxes[player] = false;
+		m_FrameShiftX[player] = 0;
+		m_FrameShiftY[player] = 0;
+
+		// Boxes can only be skipped if the client adds the deltas to the whole previous frame, and if it's known where the MOs were drawn on both frames
+		bool canTrackChanges = m_TransmitAsBoxes && m_UseDeltaCompression && !m_UseInterlacing && moDrawings.IsComplete && lastSentMODrawings.IsComplete &&
+			moDrawings.SceneWidth == lastSentMODrawings.SceneWidth && moDrawings.SceneHeight == lastSentMODrawings.SceneHeight && moDrawings.WrapsX == lastSentMODrawings.WrapsX && moDrawings.WrapsY == lastSentMODrawings.WrapsY;
+
+		if (canTrackChanges) {
+			int shiftX = moDrawings.OriginX - lastSentMODrawings.OriginX;
+			int shiftY = moDrawings.OriginY - lastSentMODrawings.OriginY;
+
+			// Wrapped Scenes look the same shifted by a whole Scene, so take the shortest way around the seam
+			if (moDrawings.WrapsX && moDrawings.SceneWidth > 0) {
+				shiftX %= moDrawings.SceneWidth;
+				if (shiftX > moDrawings.SceneWidth / 2) {
+					shiftX -= moDrawings.SceneWidth;
+				} else if (shiftX < -moDrawings.SceneWidth / 2) {
+					shiftX += moDrawings.SceneWidth;
+				}
+			}
+			if (moDrawings.WrapsY && moDrawings.SceneHeight > 0) {
+				shiftY %= moDrawings.SceneHeight;
+				if (shiftY > moDrawings.SceneHeight / 2) {
+					shiftY -= moDrawings.SceneHeight;
+				} else if (shiftY < -moDrawings.SceneHeight / 2) {
+					shiftY += moDrawings.SceneHeight;
+				}
+			}
+
+			// If the view jumped further than the frame, nothing of the last frame is left to reuse
+			if (std::abs(shiftX) < backBuffer->w && std::abs(shiftY) < backBuffer->h) {
+				m_TrackChangedFrameBoxes[player] = true;
+				m_FrameShiftX[player] = shiftX;
+				m_FrameShiftY[player] = shiftY;
+
+				if (shiftX != 0 || shiftY != 0) { ShiftPreviousFrame(player, shiftX, shiftY); }
+
+				int boxedWidth = backBuffer->w / m_BoxWidth;
+				if (backBuffer->w % m_BoxWidth != 0) { boxedWidth += 1; }
+				int boxRowCount = backBuffer->h / m_BoxHeight + 1;
+
+				std::vector<unsigned char> &changedBoxes = m_ChangedFrameBoxes[player];
+				changedBoxes.assign(boxedWidth * boxRowCount, 0);
+
+				auto markChangedBoxes = [&](const IntRect &drawing, int offsetX, int offsetY) {
+					// Pad the drawing by a pixel so rounding of where it was drawn can't put changed pixels outside it
+					int left = std::max(drawing.m_Left + offsetX - 1, 0);
+					int top = std::max(drawing.m_Top + offsetY - 1, 0);
+					int right = std::min(drawing.m_Right + offsetX + 1, backBuffer->w - 1);
+					int bottom = std::min(drawing.m_Bottom + offsetY + 1, backBuffer->h - 1);
+					if (left > right || top > bottom) {
+						return;
+					}
+					for (int by = top / m_BoxHeight; by <= bottom / m_BoxHeight; by++) {
+						for (int bx = left / m_BoxWidth; bx <= right / m_BoxWidth; bx++) {
+							changedBoxes[by * boxedWidth + bx] = 1;
+						}
+					}
+				};
+				// The MOs on this frame are new, and the ones on the last frame sent have to be cleared from where the shifted previous frame put them
+				for (const IntRect &drawing : moDrawings.Drawings) {
+					markChangedBoxes(drawing, 0, 0);
+				}
+				for (const IntRect &drawing : lastSentMODrawings.Drawings) {
+					markChangedBoxes(drawing, shiftX, shiftY);
+				}
+			}
+		}
+		lastSentMODrawings = moDrawings;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkServer::ShiftPreviousFrame(short player, int shiftX, int shiftY) {
+		BITMAP *backBuffer = m_BackBuffer8[player];
+		int width = backBuffer->w;
+		int height = backBuffer->h;
+
+		// Allegro handles blitting within the same bitmap even if the areas overlap. This has to match what the client does with its own copy exactly.
+		blit(backBuffer, backBuffer, std::max(-shiftX, 0), std::max(-shiftY, 0), std::max(shiftX, 0), std::max(shiftY, 0), width - std::abs(shiftX), height - std::abs(shiftY));
+		if (shiftX > 0) {
+			rectfill(backBuffer, 0, 0, shiftX - 1, height - 1, ColorKeys::g_MaskColor);
+		} else if (shiftX < 0) {
+			rectfill(backBuffer, width + shiftX, 0, width - 1, height - 1, ColorKeys::g_MaskColor);
+		}
+		if (shiftY > 0) {
+			rectfill(backBuffer, 0, 0, width - 1, shiftY - 1, ColorKeys::g_MaskColor);
+		} else if (shiftY < 0) {
+			rectfill(backBuffer, 0, height + shiftY, width - 1, height - 1, ColorKeys::g_MaskColor);
+		}
+
+		// Refill the previous boxes from the shifted frame, laid out the same way SendFrameBoxes reads them
+		int boxedWidth = width / m_BoxWidth;
+		if (width % m_BoxWidth != 0) { boxedWidth += 1; }
+		int boxMaxSize = m_BoxWidth * m_BoxHeight;
+
+		for (int by = 0; by * m_BoxHeight < height; by++) {
+			for (int bx = 0; bx < boxedWidth; bx++) {
+				int bpx = bx * m_BoxWidth;
+				int bpy = by * m_BoxHeight;
+				int maxWidth = std::min(m_BoxWidth, width - bpx);
+				int maxHeight = std::min(m_BoxHeight, height - bpy);
+
+				unsigned char *prevLineBufferStart = m_PixelLineBuffersPrev[player] + by * boxedWidth * boxMaxSize + bx * boxMaxSize;
+				for (int line = 0; line < maxHeight; line++) {
+					memcpy(prevLineBufferStart + line * maxWidth, backBuffer->line[bpy + line] + bpx, maxWidth);
+				}
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkServer::SendFrameBoxes(short player, FrameBoxEncoder &encoder, int firstBoxRow, int lastBoxRow) {
+		encoder.ResetStats();
+
+		int compressionMethod = m_HighCompressionLevel;
+		int accelerationFactor = m_FastAccelerationFactor;
+
+		MsgFrameBox *frameData = (MsgFrameBox *)encoder.CompressedBuffer;
+		unsigned char *compressedData = encoder.CompressedBuffer + sizeof(MsgFrameBox);
+		frameData->FrameNumber = m_FrameNumbers[player];
+
+		int boxedWidth = m_BackBuffer8[player]->w / m_BoxWidth;
+		int boxMaxSize = m_BoxWidth * m_BoxHeight;
+
+		if (m_BackBuffer8[player]->w % m_BoxWidth != 0) { boxedWidth += 1; }
+
+		bool trackChangedBoxes = m_TrackChangedFrameBoxes[player];
+		const std::vector<unsigned char> &changedBoxes = m_ChangedFrameBoxes[player];
+
+		for (unsigned char layer = 0; layer < 2; layer++) {
+			const BITMAP *backBuffer = nullptr;
+			unsigned char *prevLineBuffers = 0;
+
+			if (layer == 0) {
+				backBuffer = m_BackBuffer8[player];
+				prevLineBuffers = m_PixelLineBuffersPrev[player];
+			} else if (layer == 1) {
+				backBuffer = m_BackBufferGUI8[player];
+				prevLineBuffers = m_PixelLineBuffersGUIPrev[player];
+			}
+
+			for (int by = firstBoxRow; by < lastBoxRow; by++) {
+				for (int bx = 0; bx <= boxedWidth; bx++) {
+					int bpx = bx * m_BoxWidth;
+					int bpy = by * m_BoxHeight;
+
+					if (bpx >= m_BackBuffer8[player]->w || bpy >= m_BackBuffer8[player]->h) {
+						break;
+					}
+
+					// Nothing was drawn in this box on this frame or the last one sent, so it's empty on both and the client and the previous frame buffer already match it
+					if (layer == 0 && trackChangedBoxes && !changedBoxes[by * boxedWidth + bx]) {
+						encoder.SkippedBlocks++;
+						continue;
+					}
+
+					frameData->BoxX = bx;
+					frameData->BoxY = by;
+
+					int maxWidth = m_BoxWidth;
+					if (bpx + m_BoxWidth >= m_BackBuffer8[player]->w) { maxWidth = m_BackBuffer8[player]->w - bpx; }
+
+					int maxHeight = m_BoxHeight;
+					if (bpy + m_BoxHeight >= m_BackBuffer8[player]->h) { maxHeight = m_BackBuffer8[player]->h - bpy; }
+
+					int lineStart = 0;
+					int lineStep = 1;
+					int lineCount = maxHeight;
+
+					if (m_UseInterlacing) {
+						lineStep = 2;
+						if (m_SendEven[player]) { lineStart = 1; }
+						maxHeight /= 2;
+					}
+					int thisBoxSize = maxWidth * maxHeight;
+
+					bool boxIsEmpty = true;
+					bool boxIsDelta = false;
+					bool sendEmptyBox = false;
+
+					unsigned char *dest = encoder.PixelBuffer;
+
+					// Copy block line by line to linear buffer
+					for (int line = lineStart; line < lineCount; line += lineStep) {
+						// Copy bitmap data
+						memcpy(dest, backBuffer->line[bpy + line] + bpx, maxWidth);
+						dest += maxWidth;
+					}
+
+					// The buffer that is compressed and sent, either the plain pixels or their delta
+					const unsigned char *boxData = encoder.PixelBuffer;
+
+					if (m_UseDeltaCompression) {
+						// Previous line to delta against
+						int interlacedOffset = 0;
+						if (m_UseInterlacing) { interlacedOffset = m_SendEven[player] ? thisBoxSize : 0; }
+
+						unsigned char *prevLineBufferStart = prevLineBuffers + by * boxedWidth * boxMaxSize + bx * boxMaxSize;
+						unsigned char *prevLineBufferWithOffset = prevLineBufferStart + interlacedOffset;
+
+						// Calculate delta and decide whether we use it. This also stores the current line for delta check in the next frame.
+						PixelDeltaCounts deltaCounts = ComputePixelDelta(encoder.PixelBuffer, prevLineBufferWithOffset, encoder.DeltaBuffer, thisBoxSize);
+
+						if (deltaCounts.CurrentNonZero > 0) {
+							boxIsEmpty = false;
+
+							// If delta compression provides less significant bytes then use it
+							if (deltaCounts.Changed < deltaCounts.CurrentNonZero) {
+								boxIsDelta = true;
+
+								if (deltaCounts.Changed == 0) {
+									boxIsEmpty = true;
+								} else {
+									boxData = encoder.DeltaBuffer;
+								}
+							}
+						} else {
+							// Previous non empty block is now empty, clear it
+							if (deltaCounts.PreviousNonZero > 0) { sendEmptyBox = true; }
+						}
+					} else {
+						boxIsEmpty = IsPixelBufferEmpty(encoder.PixelBuffer, thisBoxSize);
+					}
+
+					// Save msg ID
+					if (boxIsDelta) {
+						frameData->Id = layer == 0 ? ID_SRV_FRAME_BOX_MO_DELTA : ID_SRV_FRAME_BOX_UI_DELTA;
+					} else {
+						frameData->Id = layer == 0 ? ID_SRV_FRAME_BOX_MO : ID_SRV_FRAME_BOX_UI;
+					}
+					frameData->DataSize = thisBoxSize;
+
+					if (boxIsEmpty) {
+						frameData->DataSize = 0;
+						if (!sendEmptyBox) { encoder.EmptyBlocks++; }
+					} else {
+						int result = 0;
+
+						if (m_UseHighCompression) {
+							result = LZ4_compress_HC_extStateHC(encoder.LZ4CompressionState, (const char *)boxData, (char *)compressedData, thisBoxSize, thisBoxSize, compressionMethod);
+						} else if (m_UseFastCompression) {
+							result = LZ4_compress_fast_extState(encoder.LZ4FastCompressionState, (const char *)boxData, (char *)compressedData, thisBoxSize, thisBoxSize, accelerationFactor);
+						}
+
+						// Compression failed or ineffective, send as is
+						if (result == 0 || result == backBuffer->w) {
+#ifdef _WIN32
+							memcpy_s(compressedData, c_MaxPixelLineBufferSize, boxData, thisBoxSize);
+#else
+							memcpy(compressedData, boxData, thisBoxSize);
+#endif
+						} else {
+							frameData->DataSize = result;
+						}
+
+						encoder.FullBlocks++;
+					}
+
+					int payloadSize = frameData->DataSize + sizeof(MsgFrameBox);
+
+					if (!boxIsEmpty || sendEmptyBox) {
+						m_Server->Send((const char *)frameData, payloadSize, MEDIUM_PRIORITY, UNRELIABLE_SEQUENCED, 0, m_ClientConnections[player].ClientId, false);
+					} else {
+						payloadSize = 0;
+					}
+
+					if (boxIsEmpty) {
+						encoder.EmptyBlocksSent += 1;
+						encoder.EmptyBlocksDataSent += payloadSize;
+					} else {
+						encoder.FullBlocksSent += 1;
+						encoder.FullBlocksDataSent += payloadSize;
+						encoder.DataUncompressed += thisBoxSize;
+					}
+				}
+			}
+		}
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkServer::UpdateStats(short player) {
@@ -1686,6 +1822,7 @@ namespace RTE {
 
 		m_FullBlocks[c_MaxClients] = 0;
 		m_EmptyBlocks[c_MaxClients] = 0;
+		m_SkippedBlocks[c_MaxClients] = 0;
 
 
 		for (short i = 0; i < MAX_STAT_RECORDS; i++) {
@@ -1716,6 +1853,7 @@ namespace RTE {
 
 				m_FullBlocks[c_MaxClients] += m_FullBlocks[i];
 				m_EmptyBlocks[c_MaxClients] += m_EmptyBlocks[i];
+				m_SkippedBlocks[c_MaxClients] += m_SkippedBlocks[i];
 			}
 
 			// Update compression ratio
@@ -1743,6 +1881,7 @@ namespace RTE {
 				"Frame skipped : %uK\n"
 				"Blocks full : %uK\n"
 				"Blocks empty : %uK\n"
+				"Blocks skipped : %uK\n"
 				"Blk Ratio : % .2f\n"
 				"Frames ms : % d\n"
 				"Send ms % d\n"
@@ -1765,6 +1904,7 @@ namespace RTE {
 				m_FramesSkipped[i],
 				m_FullBlocks[i] / 1000,
 				m_EmptyBlocks[i] / 1000,
+				m_SkippedBlocks[i] / 1000,
 				emptyRatio,
 				(i < c_MaxClients) ? m_MsecPerFrame[i] : 0,
 				(i < c_MaxClients) ? m_MsecPerSendCall[i] : 0,
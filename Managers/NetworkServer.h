@@ -10,6 +10,8 @@
 
 #include "Singleton.h"
 #include "NetworkMessages.h"
+#include "TerrainChangeJournal.h"
+#include "FrameMan.h"
 
 #define g_NetworkServer NetworkServer::Instance()
 
@@ -205,6 +207,45 @@ namespace RTE {
 			std::string PlayerName; //!<
 		};
 
+		/// <summary>
+		/// The buffers and statistics of one frame box encoding task, so the boxes of a frame can be encoded by several tasks at once.
+		/// </summary>
+		struct FrameBoxEncoder {
+			unsigned char PixelBuffer[c_MaxPixelLineBufferSize]; //!< Buffer to store the pixels of the box being encoded.
+			unsigned char DeltaBuffer[c_MaxPixelLineBufferSize]; //!< Buffer to store the delta of the box being encoded against the previous frame.
+			unsigned char CompressedBuffer[sizeof(MsgFrameBox) + c_MaxPixelLineBufferSize]; //!< Buffer to store the message of the box being encoded.
+			void *LZ4CompressionState; //!< LZ4 high compression state of this encoder.
+			void *LZ4FastCompressionState; //!< LZ4 fast compression state of this encoder.
+
+			int EmptyBlocks; //!< Number of empty boxes that weren't sent since the statistics were reset.
+			int FullBlocks; //!< Number of non-empty boxes since the statistics were reset.
+			int SkippedBlocks; //!< Number of boxes that weren't encoded or sent because nothing changed in them since the statistics were reset.
+			unsigned long EmptyBlocksSent; //!< Number of empty boxes since the statistics were reset, whether sent or not.
+			unsigned long EmptyBlocksDataSent; //!< Bytes sent for empty boxes since the statistics were reset.
+			unsigned long FullBlocksSent; //!< Number of non-empty boxes sent since the statistics were reset.
+			unsigned long FullBlocksDataSent; //!< Bytes sent for non-empty boxes since the statistics were reset.
+			unsigned long DataUncompressed; //!< Uncompressed size of the non-empty boxes sent since the statistics were reset.
+
+			/// <summary>
+			/// Constructor method used to instantiate a FrameBoxEncoder object in system memory, allocating its compression states.
+			/// </summary>
+			FrameBoxEncoder();
+
+			/// <summary>
+			/// Destructor method used to free the compression states of this FrameBoxEncoder.
+			/// </summary>
+			~FrameBoxEncoder();
+
+			/// <summary>
+			/// Resets all the statistics of this FrameBoxEncoder to zero.
+			/// </summary>
+			void ResetStats();
+
+			// Disallow the use of some implicit methods.
+			FrameBoxEncoder(const FrameBoxEncoder &reference) = delete;
+			FrameBoxEncoder & operator=(const FrameBoxEncoder &rhs) = delete;
+		};
+
 		bool m_IsInServerMode = false; //!<
 
 		bool m_SleepWhenIdle; //!< If true puts thread to sleep if it didn't receive anything for 10 seconds to avoid melting the CPU at 100% even if there are no connections.
@@ -265,14 +306,21 @@ namespace RTE {
 		std::mutex m_SceneLock[c_MaxClients]; //!<
 
 		unsigned char m_PixelLineBuffer[c_MaxClients][c_MaxPixelLineBufferSize]; //!< Buffer to store currently transferred pixel data line.
-		unsigned char m_PixelLineBufferDelta[c_MaxClients][c_MaxPixelLineBufferSize]; //!< Buffer to store currently transferred pixel data line.
 		unsigned char m_CompressedLineBuffer[c_MaxClients][c_MaxPixelLineBufferSize]; //!< Buffer to store compressed pixel data line.
 
 		unsigned char *m_PixelLineBuffersPrev[c_MaxClients]; //!<
 		unsigned char *m_PixelLineBuffersGUIPrev[c_MaxClients]; //!<
 
-		std::queue<NetworkTerrainChange> m_PendingTerrainChanges[c_MaxClients]; //!<
-		std::queue<NetworkTerrainChange> m_CurrentTerrainChanges[c_MaxClients]; //!<
+		std::vector<std::unique_ptr<FrameBoxEncoder>> m_FrameBoxEncoders[c_MaxClients]; //!< The encoders each player's frame boxes are split between, one per encoding task. Created as needed.
+
+		FrameMan::NetworkFrameMODrawings m_LastSentMODrawings[c_MaxClients]; //!< Where the MOs were drawn on the last frame sent to each player, which is what the player's previous frame buffers hold.
+		bool m_TrackChangedFrameBoxes[c_MaxClients]; //!< Whether only the MO layer boxes marked in m_ChangedFrameBoxes need to be encoded for the frame being sent to each player.
+		std::vector<unsigned char> m_ChangedFrameBoxes[c_MaxClients]; //!< Whether each MO layer box of the frame being sent to each player may differ from the last frame sent, indexed by box row, then box column.
+		int m_FrameShiftX[c_MaxClients]; //!< How far the previous MO layer frame of each player was shifted horizontally to line it up with the frame being sent.
+		int m_FrameShiftY[c_MaxClients]; //!< How far the previous MO layer frame of each player was shifted vertically to line it up with the frame being sent.
+
+		TerrainChangeJournal m_TerrainChanges[c_MaxClients]; //!< The terrain changes that weren't sent to each player yet. Guarded by m_Mutex.
+		std::vector<TerrainChangeJournal::ChangedArea> m_ChangedTerrainAreas[c_MaxClients]; //!< Buffer to store the changed terrain areas currently being sent to each player.
 
 		std::mutex m_Mutex[c_MaxClients]; //!<
 
@@ -302,6 +350,7 @@ namespace RTE {
 
 		int m_EmptyBlocks[MAX_STAT_RECORDS]; //!<
 		int m_FullBlocks[MAX_STAT_RECORDS]; //!<
+		int m_SkippedBlocks[MAX_STAT_RECORDS]; //!< Number of boxes that weren't sent because nothing changed in them.
 		int m_SendBufferBytes[MAX_STAT_RECORDS]; //!<
 		int m_SendBufferMessages[MAX_STAT_RECORDS]; //!<
 		int m_DelayedFrames[c_MaxClients]; //!<
@@ -489,11 +538,12 @@ namespace RTE {
 		void ProcessTerrainChanges(short player);
 
 		/// <summary>
-		///
+		/// Sends a batch of changed terrain areas to a player in one message.
 		/// </summary>
-		/// <param name="player"></param>
-		/// <param name="terrainChange"></param>
-		void SendTerrainChangeMsg(short player, NetworkTerrainChange terrainChange);
+		/// <param name="player">The player to send the changes to.</param>
+		/// <param name="firstArea">Index of the first area of the batch in m_ChangedTerrainAreas.</param>
+		/// <param name="areaCount">The number of areas in the batch. They must all fit into one message uncompressed.</param>
+		void SendTerrainChangeMsg(short player, size_t firstArea, size_t areaCount);
 
 		/// <summary>
 		///
@@ -556,6 +606,32 @@ namespace RTE {
 		/// <param name="player"></param>
 		/// <returns></returns>
 		int SendFrame(short player);
+
+		/// <summary>
+		/// Works out which MO layer boxes of a player's frame may have changed since the last frame sent, from where the MOs were drawn on both frames.
+		/// If the Scene scrolled between the two, the previous frame buffers are shifted along with it first, so the boxes only the scrolling changed don't need to be sent again.
+		/// Must be called before the frame is copied to the player's backbuffer, which still holds the last frame sent at that point.
+		/// </summary>
+		/// <param name="player">The player whose frame is about to be sent.</param>
+		/// <param name="moDrawings">Where the MOs were drawn on the frame about to be sent.</param>
+		void UpdateChangedFrameBoxes(short player, const FrameMan::NetworkFrameMODrawings &moDrawings);
+
+		/// <summary>
+		/// Shifts the MO layer of a player's previous frame buffers by the given amount, filling the uncovered parts with the mask color.
+		/// </summary>
+		/// <param name="player">The player whose previous frame buffers to shift.</param>
+		/// <param name="shiftX">How far to shift horizontally, in pixels. Must be smaller than the width of the frame.</param>
+		/// <param name="shiftY">How far to shift vertically, in pixels. Must be smaller than the height of the frame.</param>
+		void ShiftPreviousFrame(short player, int shiftX, int shiftY);
+
+		/// <summary>
+		/// Encodes and sends the frame boxes of a range of box rows of a player's current frame, on both layers.
+		/// </summary>
+		/// <param name="player">The player to send the frame boxes to.</param>
+		/// <param name="encoder">The FrameBoxEncoder to encode the boxes with. Its statistics are reset first, then hold the statistics of these boxes.</param>
+		/// <param name="firstBoxRow">The first box row to send.</param>
+		/// <param name="lastBoxRow">The box row after the last one to send.</param>
+		void SendFrameBoxes(short player, FrameBoxEncoder &encoder, int firstBoxRow, int lastBoxRow);
 #pragma endregion
 
 #pragma region Network Stats Handling
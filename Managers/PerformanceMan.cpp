@@ -29,6 +29,7 @@ namespace RTE {
 		m_MSPDs.clear();
 		m_MSPDAverage = 0;
 		m_CurrentPing = 0;
+		ClearBenchmarkSamples();
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -69,6 +70,50 @@ namespace RTE {
 		}
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PerformanceMan::RecordBenchmarkSample() {
+		for (int counter = 0; counter < PerformanceCounters::PerfCounterCount; ++counter) {
+			m_BenchmarkSamples[counter].emplace_back(m_PerfData[counter][m_Sample]);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PerformanceMan::WriteBenchmarkReport(const std::string &reportFilePath) const {
+		std::ofstream reportFile(reportFilePath);
+		if (!reportFile.good()) {
+			return false;
+		}
+		// Nearest-rank percentile of an already sorted sample set.
+		auto percentile = [](const std::vector<uint64_t> &sortedSamples, double percent) {
+			size_t rank = static_cast<size_t>(std::ceil(percent / 100.0 * static_cast<double>(sortedSamples.size())));
+			return sortedSamples[std::clamp<size_t>(rank, 1, sortedSamples.size()) - 1];
+		};
+
+		reportFile << "{\n\t\"Samples\": " << m_BenchmarkSamples[PerformanceCounters::SimTotal].size() << ",\n\t\"Counters\": {";
+		for (int counter = 0; counter < PerformanceCounters::PerfCounterCount; ++counter) {
+			std::vector<uint64_t> sortedSamples = m_BenchmarkSamples[counter];
+			std::sort(sortedSamples.begin(), sortedSamples.end());
+
+			double mean = 0;
+			uint64_t median = 0;
+			uint64_t ninetyNinthPercentile = 0;
+			if (!sortedSamples.empty()) {
+				for (uint64_t sample : sortedSamples) {
+					mean += static_cast<double>(sample);
+				}
+				mean /= static_cast<double>(sortedSamples.size());
+				median = percentile(sortedSamples, 50.0);
+				ninetyNinthPercentile = percentile(sortedSamples, 99.0);
+			}
+			reportFile << (counter == 0 ? "" : ",") << "\n\t\t\"" << m_PerfCounterNames[counter] << "\": { \"MeanUs\": " << mean << ", \"P50Us\": " << median << ", \"P99Us\": " << ninetyNinthPercentile << " }";
+		}
+		reportFile << "\n\t}\n}\n";
+
+		return reportFile.good();
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void PerformanceMan::CalculateSamplePercentages() {
@@ -130,6 +130,25 @@ namespace RTE {
 		void SetCurrentPing(int ping) { m_CurrentPing = ping; }
 #pragma endregion
 
+#pragma region Benchmark Handling
+		/// <summary>
+		/// Discards any previously recorded benchmark samples so a new benchmark run can be recorded.
+		/// </summary>
+		void ClearBenchmarkSamples() { for (std::vector<uint64_t> &counterSamples : m_BenchmarkSamples) { counterSamples.clear(); } }
+
+		/// <summary>
+		/// Stores the values of the current performance sample of every counter so they're included in the benchmark report. Supposed to be done at the end of every benchmarked sim update.
+		/// </summary>
+		void RecordBenchmarkSample();
+
+		/// <summary>
+		/// Writes the mean, median and 99th percentile of every performance counter over all the recorded benchmark samples to a JSON file.
+		/// </summary>
+		/// <param name="reportFilePath">Path to the file the report should be written to.</param>
+		/// <returns>Whether the report was successfully written.</returns>
+		bool WriteBenchmarkReport(const std::string &reportFilePath) const;
+#pragma endregion
+
 #pragma region Concrete Methods
 		/// <summary>
 		/// Clears current performance timings.
@@ -206,6 +225,8 @@ namespace RTE {
 		std::array<std::array<int, c_MaxSamples>, PerformanceCounters::PerfCounterCount> m_PerfPercentages; //!< Array to store percentages from SimTotal.
 		std::array<std::array<std::atomic_uint64_t, c_MaxSamples>, PerformanceCounters::PerfCounterCount> m_PerfData; //!< Array to store performance measurements in microseconds.
 
+		std::array<std::vector<uint64_t>, PerformanceCounters::PerfCounterCount> m_BenchmarkSamples; //!< Every recorded sample of each performance counter during a benchmark run, in microseconds.
+
 		std::vector<std::pair<std::string, ScriptTiming>> m_SortedScriptTimings; //!< Sorted vector storing how long scripts took to execute.
 
 	private:
@@ -28,6 +28,8 @@
 #include "ConsoleMan.h"
 #include "LoadingScreen.h"
 #include "SettingsMan.h"
+#include "ThreadMan.h"
+#include "ReaderCache.h"
 
 namespace RTE {
 
@@ -52,6 +54,7 @@ void PresetMan::Clear()
     m_TotalGroupRegister.clear();
 	m_LastReloadedEntityPresetInfo.fill("");
 	m_ReloadEntityPresetCalledThisUpdate = false;
+	m_PresetIndex.clear();
 }
 
 /*
@@ -92,7 +95,7 @@ void PresetMan::Destroy()
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool PresetMan::LoadDataModule(const std::string &moduleName, bool official, bool userdata, const ProgressCallback &progressCallback) {
+bool PresetMan::LoadDataModule(const std::string &moduleName, bool official, bool userdata, const ProgressCallback &progressCallback, ReaderCache *moduleCache) {
 	if (moduleName.empty()) {
 		return false;
 	}
@@ -131,7 +134,7 @@ bool PresetMan::LoadDataModule(const std::string &moduleName, bool official, boo
 		m_DataModuleIDs.try_emplace(lowercaseName, m_pDataModules.size() - 1);
 	}
 
-	if (newModule->Create(moduleName, progressCallback) < 0) {
+	if (newModule->Create(moduleName, progressCallback, moduleCache) < 0) {
 		RTEAbort("Failed to find the " + moduleName + " Data Module!");
 		return false;
 	}
@@ -149,22 +152,17 @@ bool PresetMan::LoadAllDataModules() {
 
 	FindAndExtractZippedModules();
 
-	// Load all the official modules first!
-	for (const std::string &officialModule : c_OfficialModules) {
-		if (!LoadDataModule(officialModule, true, false, LoadingScreen::LoadingSplashProgressReport)) {
-			return false;
-		}
-	}
+	ContentFile::OpenSpriteCache();
+
+	bool loadSingleModule = !m_SingleModuleToLoad.empty() && !IsModuleOfficial(m_SingleModuleToLoad);
 
 	// If a single module is specified, skip loading all other unofficial modules and load specified module only.
-	if (!m_SingleModuleToLoad.empty() && !IsModuleOfficial(m_SingleModuleToLoad)) {
-		if (!LoadDataModule(m_SingleModuleToLoad, false, false, LoadingScreen::LoadingSplashProgressReport)) {
-			g_ConsoleMan.PrintString("ERROR: Failed to load DataModule \"" + m_SingleModuleToLoad + "\"! Only official modules were loaded!");
-			return false;
-		}
+	std::vector<std::string> modModules;
+	const std::string modDirectory = System::GetWorkingDirectory() + System::GetModDirectory();
+	if (loadSingleModule) {
+		modModules.emplace_back(m_SingleModuleToLoad);
 	} else {
 		std::vector<std::filesystem::directory_entry> modDirectoryFolders;
-		const std::string modDirectory = System::GetWorkingDirectory() + System::GetModDirectory();
 		std::copy_if(std::filesystem::directory_iterator(modDirectory), std::filesystem::directory_iterator(), std::back_inserter(modDirectoryFolders),
 			[](auto dirEntry){ return std::filesystem::is_directory(dirEntry); }
 		);
@@ -174,13 +172,57 @@ bool PresetMan::LoadAllDataModules() {
 			std::string directoryEntryPath = directoryEntry.path().generic_string();
 			if (std::regex_match(directoryEntryPath, std::regex(".*\.rte"))) {
 				std::string moduleName = directoryEntryPath.substr(directoryEntryPath.find_last_of('/') + 1, std::string::npos);
-				if (!g_SettingsMan.IsModDisabled(moduleName) && !IsModuleOfficial(moduleName) && !IsModuleUserdata(moduleName)) {
-					int moduleID = GetModuleID(moduleName);
-					// NOTE: LoadDataModule can return false (especially since it may try to load already loaded modules, which is okay) and shouldn't cause stop, so we can ignore its return value here.
-					if (moduleID < 0 || moduleID >= GetOfficialModuleCount()) { LoadDataModule(moduleName, false, false, LoadingScreen::LoadingSplashProgressReport); }
-				}
+				if (!g_SettingsMan.IsModDisabled(moduleName) && !IsModuleOfficial(moduleName) && !IsModuleUserdata(moduleName)) { modModules.emplace_back(moduleName); }
+			}
+		}
+	}
+
+	// Reading and validating each module's cache only touches the disk, so it's done on the thread pool while the modules before are being loaded.
+	// Loading the modules themselves stays on this thread, in the same order as always, as reading Entities registers them with this and creates bitmaps, sounds and scripts, none of which can be done from several threads at once.
+	bool moduleCacheEnabled = g_SettingsMan.IsDataModuleCacheEnabled();
+	auto prepareModuleCache = [moduleCacheEnabled](const std::string &moduleName) {
+		std::unique_ptr<ReaderCache> moduleCache;
+		if (moduleCacheEnabled) {
+			moduleCache = std::make_unique<ReaderCache>();
+			if (moduleCache->Create(moduleName) < 0) {
+				moduleCache.reset();
+			} else {
+				moduleCache->ValidateCachedFiles();
 			}
 		}
+		return moduleCache;
+	};
+	std::vector<std::future<std::unique_ptr<ReaderCache>>> officialModuleCaches;
+	for (const std::string &officialModule : c_OfficialModules) {
+		officialModuleCaches.emplace_back(g_ThreadMan.GetPriorityThreadPool().submit(prepareModuleCache, officialModule));
+	}
+	std::vector<std::future<std::unique_ptr<ReaderCache>>> modModuleCaches;
+	for (const std::string &modModule : modModules) {
+		modModuleCaches.emplace_back(g_ThreadMan.GetPriorityThreadPool().submit(prepareModuleCache, modModule));
+	}
+
+	// Load all the official modules first!
+	for (size_t officialModuleIndex = 0; officialModuleIndex < c_OfficialModules.size(); ++officialModuleIndex) {
+		std::unique_ptr<ReaderCache> moduleCache = officialModuleCaches[officialModuleIndex].get();
+		if (!LoadDataModule(c_OfficialModules[officialModuleIndex], true, false, LoadingScreen::LoadingSplashProgressReport, moduleCache.get())) {
+			return false;
+		}
+	}
+
+	if (loadSingleModule) {
+		std::unique_ptr<ReaderCache> moduleCache = modModuleCaches.front().get();
+		if (!LoadDataModule(m_SingleModuleToLoad, false, false, LoadingScreen::LoadingSplashProgressReport, moduleCache.get())) {
+			g_ConsoleMan.PrintString("ERROR: Failed to load DataModule \"" + m_SingleModuleToLoad + "\"! Only official modules were loaded!");
+			return false;
+		}
+	} else {
+		for (size_t modModuleIndex = 0; modModuleIndex < modModules.size(); ++modModuleIndex) {
+			const std::string &moduleName = modModules[modModuleIndex];
+			std::unique_ptr<ReaderCache> moduleCache = modModuleCaches[modModuleIndex].get();
+			int moduleID = GetModuleID(moduleName);
+			// NOTE: LoadDataModule can return false (especially since it may try to load already loaded modules, which is okay) and shouldn't cause stop, so we can ignore its return value here.
+			if (moduleID < 0 || moduleID >= GetOfficialModuleCount()) { LoadDataModule(moduleName, false, false, LoadingScreen::LoadingSplashProgressReport, moduleCache.get()); }
+		}
 
 		// Load userdata modules AFTER all other techs etc are loaded; might be referring to stuff in user mods.
 		for (const auto &[userdataModuleName, userdataModuleFriendlyName] : c_UserdataModules) {
@@ -194,6 +236,10 @@ bool PresetMan::LoadAllDataModules() {
 		}
 	}
 
+	// Anything decoded ahead of time that no module ended up using won't be needed anymore.
+	ContentFile::FreePrefetchedImages();
+	ContentFile::SaveSpriteCache();
+
 	if (g_SettingsMan.IsMeasuringModuleLoadTime()) {
 		std::chrono::milliseconds moduleLoadElapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - moduleLoadTimerStart);
 		g_ConsoleMan.PrintString("Module load duration is: " + std::to_string(moduleLoadElapsedTime.count()) + "ms");
@@ -388,9 +434,8 @@ const Entity * PresetMan::GetEntityPreset(std::string type, std::string preset,
     // All modules
     if (whichModule < 0)
     {
-        // Search all modules
-        for (int i = 0; i < m_pDataModules.size() && !pRetEntity; ++i)
-            pRetEntity = m_pDataModules[i]->GetEntityPreset(type, preset);
+        // The index holds the preset from the first module that has it, same as searching all modules in order would find
+        pRetEntity = GetIndexedPreset(type, preset).second;
     }
     // Specific module
     else
@@ -398,20 +443,37 @@ const Entity * PresetMan::GetEntityPreset(std::string type, std::string preset,
         // Try to get it from the asked for module
         pRetEntity = m_pDataModules[whichModule]->GetEntityPreset(type, preset);
 
-        // If couldn't find it in there, then try all the official modules!
+        // If couldn't find it in there, then try all the official modules! They're loaded first, so if any of them has it, the indexed one is from the first of them
         if (!pRetEntity)
         {
             RTEAssert(m_OfficialModuleCount <= m_pDataModules.size(), "More official modules than modules loaded?!");
-            for (int i = 0; i < m_OfficialModuleCount && !pRetEntity; ++i)
-            {
-                pRetEntity = m_pDataModules[i]->GetEntityPreset(type, preset);
-            }
+            if (auto [indexedModuleID, indexedPreset] = GetIndexedPreset(type, preset); indexedModuleID >= 0 && indexedModuleID < m_OfficialModuleCount)
+                pRetEntity = indexedPreset;
         }
     }
 
     return pRetEntity;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void PresetMan::AddToPresetIndex(const Entity *preset, int whichModule) {
+	auto [indexEntry, inserted] = m_PresetIndex[preset->GetClassName()].try_emplace(preset->GetPresetName(), whichModule, preset);
+	// Keep whichever comes first in load order, as that's the one a search through all modules would find.
+	if (!inserted && whichModule < indexEntry->second.first) { indexEntry->second = { whichModule, preset }; }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::pair<int, const Entity *> PresetMan::GetIndexedPreset(const std::string &exactType, const std::string &presetName) const {
+	if (auto classEntry = m_PresetIndex.find(exactType); classEntry != m_PresetIndex.end()) {
+		if (auto presetEntry = classEntry->second.find(presetName); presetEntry != classEntry->second.end()) {
+			return presetEntry->second;
+		}
+	}
+	return { -1, nullptr };
+}
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetEntityPreset
@@ -463,8 +525,8 @@ const Entity * PresetMan::GetEntityPreset(Reader &reader)
 			if (!pReturnPreset)
 			{
 				RTEAssert(m_OfficialModuleCount <= m_pDataModules.size(), "More official modules than modules loaded?!");
-				for (int i = 0; i < m_OfficialModuleCount && !pReturnPreset; ++i)
-					pReturnPreset = m_pDataModules[i]->GetEntityPreset(pNewInstance->GetClassName(), pNewInstance->GetPresetName());
+				if (auto [indexedModuleID, indexedPreset] = GetIndexedPreset(pNewInstance->GetClassName(), pNewInstance->GetPresetName()); indexedModuleID >= 0 && indexedModuleID < m_OfficialModuleCount)
+					pReturnPreset = indexedPreset;
 			}
 		}
         // Get rid of the read-in instance as its copy is now either added to the map, or discarded as there already was somehting in there of the same name.
@@ -24,6 +24,7 @@ namespace RTE
 
 class Actor;
 class DataModule;
+class ReaderCache;
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -104,8 +105,9 @@ public:
     /// <param name="official">Whether this module is 'official' or third party. If official, it has to not have any name conflicts with any other official module.</param>
 	/// <param name="userdata">Whether this module is a userdata module. If true, will be treated as an unofficial module.
     /// <param name="progressCallback">A function pointer to a function that will be called and sent a string with information about the progress of this DataModule's creation.</param>
+	/// <param name="moduleCache">A ReaderCache for the DataModule that was already created, and possibly validated, ahead of time. If nullptr, the DataModule creates its own if the DataModule cache is enabled. Ownership is NOT transferred!</param>
     /// <returns>Whether the DataModule was read and added correctly.</returns>
-    bool LoadDataModule(const std::string &moduleName, bool official, bool userdata = false, const ProgressCallback &progressCallback = nullptr);
+    bool LoadDataModule(const std::string &moduleName, bool official, bool userdata = false, const ProgressCallback &progressCallback = nullptr, ReaderCache *moduleCache = nullptr);
 
     /// <summary>
     /// Reads an entire DataModule and adds it to this. NOTE that official modules can't be loaded after any non-official ones!
@@ -116,8 +118,9 @@ public:
 
 	/// <summary>
 	/// Loads all the official data modules individually with LoadDataModule, then proceeds to look for any non-official modules and loads them as well.
+	/// The modules are loaded one at a time in their usual order. Only their ReaderCaches are read and validated ahead of time on the thread pool.
 	/// </summary>
-	/// <returns></returns>
+	/// <returns>Whether all the official and userdata modules were loaded. Mods that fail to load don't make this fail.</returns>
 	bool LoadAllDataModules();
 
 	/// <summary>
@@ -248,6 +251,13 @@ public:
     // Helper for passing in string module name instead of ID
     const Entity * GetEntityPreset(std::string type, std::string preset, std::string module) { return GetEntityPreset(type, preset, GetModuleID(module)); }
 
+    /// <summary>
+    /// Adds a preset that was just added to a DataModule to the global preset index, so GetEntityPreset can find it without searching through every module.
+    /// </summary>
+    /// <param name="preset">The preset that was added. Ownership is NOT transferred!</param>
+    /// <param name="whichModule">The ID of the module the preset was added to.</param>
+    void AddToPresetIndex(const Entity *preset, int whichModule);
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetEntityPreset
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -576,6 +586,20 @@ private:
 	std::array<std::string, 3> m_LastReloadedEntityPresetInfo; //!< Array storing the last reloaded Entity preset info (ClassName, PresetName and DataModule). Used for quick reloading via key combination.
 	bool m_ReloadEntityPresetCalledThisUpdate; //!< A flag for whether or not ReloadEntityPreset was called this update.
 
+	/// <summary>
+	/// Map of exact class names to maps of preset names and the first module, in load order, that has a preset of that exact class and name, along with that preset.
+	/// Looking a preset up here gives the same result as searching every module in order, without having to. The presets are NOT owned by this map.
+	/// </summary>
+	std::unordered_map<std::string, std::unordered_map<std::string, std::pair<int, const Entity *>>> m_PresetIndex;
+
+	/// <summary>
+	/// Gets a preset of an exact class and name from the global preset index.
+	/// </summary>
+	/// <param name="exactType">The exact class name of the preset.</param>
+	/// <param name="presetName">The name of the preset.</param>
+	/// <returns>A pair of the ID of the first module that has the preset and the preset itself, or -1 and nullptr if no module has it.</returns>
+	std::pair<int, const Entity *> GetIndexedPreset(const std::string &exactType, const std::string &presetName) const;
+
 	/// <summary>
 	/// Iterates through the working directory to find any files matching the zipped module package extension (.rte.zip) and proceeds to extract them.
 	/// </summary>
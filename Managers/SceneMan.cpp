@@ -33,6 +33,7 @@
 #include "MOPixel.h"
 #include "Atom.h"
 #include "Material.h"
+#include "ThreadMan.h"
 // Temp
 #include "Controller.h"
 
@@ -59,6 +60,7 @@ void SceneMan::Clear()
 	m_PlaceUnits = true;
     m_pCurrentScene = nullptr;
     m_pMOColorLayer = nullptr;
+    m_pPublishedMOColorLayer = nullptr;
     m_pMOIDLayer = nullptr;
     m_pDebugLayer = nullptr;
 
@@ -73,14 +75,14 @@ void SceneMan::Clear()
     m_pUnseenRevealSound = nullptr;
     m_DrawRayCastVisualizations = false;
     m_DrawPixelCheckVisualizations = false;
+    m_MOIDOccupancyMasksEnabled = true;
     m_LastUpdatedScreen = 0;
     m_SecondStructPass = false;
 //    m_CalcTimer.Reset();
     m_CleanTimer.Reset();
 
-	if (m_pOrphanSearchBitmap)
-		destroy_bitmap(m_pOrphanSearchBitmap);
-	m_pOrphanSearchBitmap = create_bitmap_ex(8, MAXORPHANRADIUS , MAXORPHANRADIUS);
+	m_OrphanSearchVisited.reset();
+	m_OrphanSearchPixels.clear();
 
 	m_ScrapCompactingHeight = 25;
 }
@@ -135,6 +137,9 @@ int SceneMan::LoadScene(Scene *pNewScene, bool placeObjects, bool placeUnits) {
 		return -1;
 	}
 
+	// A pipelined draw may still be reading the old Scene's layers.
+	g_FrameMan.WaitForPipelinedDraw();
+
 	g_MovableMan.PurgeAllMOs();
 	g_PostProcessMan.ClearScenePostEffects();
 
@@ -176,8 +181,10 @@ int SceneMan::LoadScene(Scene *pNewScene, bool placeObjects, bool placeUnits) {
 
 //    m_pCurrentScene->GetTerrain()->CleanAir();
 
-    // Re-create the MoveableObject:s color SceneLayer
+    // Re-create the MoveableObject:s color SceneLayer. The one published for pipelined drawing is re-created when it's next needed.
     delete m_pMOColorLayer;
+    delete m_pPublishedMOColorLayer;
+    m_pPublishedMOColorLayer = nullptr;
     BITMAP *pBitmap = create_bitmap_ex(8, GetSceneWidth(), GetSceneHeight());
     clear_to_color(pBitmap, g_MaskColor);
     m_pMOColorLayer = new SceneLayerTracked();
@@ -194,6 +201,7 @@ int SceneMan::LoadScene(Scene *pNewScene, bool placeObjects, bool placeUnits) {
 
 	const int cellSize = 20;
 	m_MOIDsGrid = SpatialPartitionGrid(GetSceneWidth(), GetSceneHeight(), cellSize);
+	m_MOIDsGrid.SetOccupancyMasksEnabled(m_MOIDOccupancyMasksEnabled);
 
     // Create the Debug SceneLayer
     if (m_DrawRayCastVisualizations || m_DrawPixelCheckVisualizations) {
@@ -344,6 +352,8 @@ int SceneMan::Save(Writer &writer) const {
 
 void SceneMan::Destroy()
 {
+    g_FrameMan.WaitForPipelinedDraw(false);
+
     for (int i = 0; i < c_PaletteEntriesNumber; ++i)
         delete m_apMatPalette[i];
 
@@ -351,11 +361,9 @@ void SceneMan::Destroy()
     delete m_pDebugLayer;
     delete m_pMOIDLayer;
     delete m_pMOColorLayer;
+    delete m_pPublishedMOColorLayer;
     delete m_pUnseenRevealSound;
 
-	destroy_bitmap(m_pOrphanSearchBitmap);
-	m_pOrphanSearchBitmap = 0;
-
 	for (const auto &[bitmapSize, bitmapPtr] : m_IntermediateSettlingBitmaps) {
 		destroy_bitmap(bitmapPtr);
 	}
@@ -529,7 +537,11 @@ MOID SceneMan::GetMOIDPixel(int pixelX, int pixelY, int ignoreTeam)
 	MOID moid = getpixel(m_pMOIDLayer->GetBitmap(), pixelX, pixelY);
 #else
     const std::vector<MOID> &moidList = m_MOIDsGrid.GetMOIDsAtPosition(pixelX, pixelY, ignoreTeam, true);
-    MOID moid = g_MovableMan.GetMOIDPixel(pixelX, pixelY, moidList);
+    MOID moid = g_NoMOID;
+    // Most pixels in a cell with MOs in it aren't on any of them, so if nothing was marked at this pixel and none of the MOs have moved since, there's no need to hit test them all.
+    if (!moidList.empty() && (m_MOIDsGrid.IsPixelOccupied(pixelX, pixelY) || !g_MovableMan.AreOccupancyMasksCurrent(moidList))) {
+        moid = g_MovableMan.GetMOIDPixel(pixelX, pixelY, moidList);
+    }
 #endif
 
 	if (g_SettingsMan.SimplifiedCollisionDetection()) {
@@ -659,57 +671,64 @@ int SceneMan::RemoveOrphans(int posX, int posY, int radius, int maxArea, bool re
 	if (radius > MAXORPHANRADIUS)
 		radius = MAXORPHANRADIUS;
 
-	clear_to_color(m_pOrphanSearchBitmap, g_MaterialAir);
-	int area = RemoveOrphans(posX, posY, posX, posY, 0, radius, maxArea, false);
-	if (remove && area <= maxArea)
-	{
-		clear_to_color(m_pOrphanSearchBitmap, g_MaterialAir);
-		RemoveOrphans(posX, posY, posX, posY, 0, radius, maxArea, true);
-	}
-
-	return area;
-}
+	BITMAP * mat = m_pCurrentScene->GetTerrain()->GetMaterialBitmap();
+	if (posX < 0 || posY < 0 || posX >= mat->w || posY >= mat->h)
+		return 0;
 
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// The search box is radius pixels wide with the starting pixel in its middle.
+	// Reaching its border with material pixels still there means the region is attached to more terrain, so it's not an orphaned terrain piece and the search is aborted.
+	int boxLeft = posX - radius / 2;
+	int boxTop = posY - radius / 2;
+	auto isOnSearchBorder = [boxLeft, boxTop, radius](int x, int y) {
+		int boxX = x - boxLeft;
+		int boxY = y - boxTop;
+		return boxX <= 0 || boxY <= 0 || boxX >= radius - 1 || boxY >= radius - 1;
+	};
+	const int notOrphanedArea = MAXORPHANRADIUS * MAXORPHANRADIUS + 1;
 
-int SceneMan::RemoveOrphans(int posX, int posY,
-							int centerPosX, int centerPosY,
-							int accumulatedArea, int radius, int maxArea, bool remove)
-{
-	int area = 0;
-	int bmpX = 0;
-	int bmpY = 0;
+	// The starting pixel is part of the region even if it was already knocked out.
+	if (isOnSearchBorder(posX, posY))
+		return notOrphanedArea;
 
-	BITMAP * mat = m_pCurrentScene->GetTerrain()->GetMaterialBitmap();
+	m_OrphanSearchVisited.reset();
+	m_OrphanSearchPixels.clear();
+	m_OrphanSearchVisited.set((posY - boxTop) * MAXORPHANRADIUS + (posX - boxLeft));
+	m_OrphanSearchPixels.emplace_back(posX, posY);
 
-	if (posX < 0 || posY < 0 || posX >= mat->w || posY >= mat->h) return 0;
+	int xoff[8] = { -1,  0,  1, -1,  1, -1,  0,  1};
+	int yoff[8] = { -1, -1, -1,  0,  0,  1,  1,  1};
 
-    unsigned char materialID = _getpixel(mat, posX, posY);
-    if (materialID == g_MaterialAir && (posX != centerPosX || posY != centerPosY))
-		return 0;
-	else
+	// Breadth first search of the 8-connected material pixels, using the list of found pixels as the queue.
+	for (size_t pixelIndex = 0; pixelIndex < m_OrphanSearchPixels.size() && static_cast<int>(m_OrphanSearchPixels.size()) <= maxArea; ++pixelIndex)
 	{
-		bmpX = posX - (centerPosX - radius / 2);
-		bmpY = posY - (centerPosY - radius / 2);
-
-		// We reached the border of orphan-searching area and
-		// there are still material pixels there -> the area is not an orphaned teran piece, abort search
-		if (bmpX <= 0 || bmpY <= 0 || bmpX >= radius - 1 || bmpY >= radius - 1)
-			return MAXORPHANRADIUS * MAXORPHANRADIUS + 1;
-		else
-		// Check if pixel was already checked
+		auto [pixelX, pixelY] = m_OrphanSearchPixels[pixelIndex];
+		for (int c = 0; c < 8; c++)
 		{
-			if (_getpixel(m_pOrphanSearchBitmap, bmpX, bmpY) != g_MaterialAir)
-				return 0;
+			int neighbourX = pixelX + xoff[c];
+			int neighbourY = pixelY + yoff[c];
+			if (neighbourX < 0 || neighbourY < 0 || neighbourX >= mat->w || neighbourY >= mat->h || _getpixel(mat, neighbourX, neighbourY) == g_MaterialAir)
+				continue;
+
+			if (isOnSearchBorder(neighbourX, neighbourY))
+				return notOrphanedArea;
+
+			int visitedIndex = (neighbourY - boxTop) * MAXORPHANRADIUS + (neighbourX - boxLeft);
+			if (!m_OrphanSearchVisited.test(visitedIndex))
+			{
+				m_OrphanSearchVisited.set(visitedIndex);
+				m_OrphanSearchPixels.emplace_back(neighbourX, neighbourY);
+			}
 		}
 	}
 
-	_putpixel(m_pOrphanSearchBitmap, bmpX, bmpY, materialID);
-	area++;
+	int area = static_cast<int>(m_OrphanSearchPixels.size());
+	if (!remove || area > maxArea)
+		return area;
 
-	// We're clear to remove the pixel
-	if (remove)
+	// The whole region was found in one pass, so it can be removed right away without searching it again.
+	for (const auto &[pixelX, pixelY] : m_OrphanSearchPixels)
 	{
+		unsigned char materialID = _getpixel(mat, pixelX, pixelY);
 		Material const * sceneMat = GetMaterialFromID(materialID);
 		Material const * spawnMat;
         spawnMat = sceneMat->GetSpawnMaterial() ? GetMaterialFromID(sceneMat->GetSpawnMaterial()) : sceneMat;
@@ -718,21 +737,17 @@ int SceneMan::RemoveOrphans(int posX, int posY,
         if (spawnMat->UsesOwnColor())
             spawnColor = spawnMat->GetColor();
         else
-            spawnColor.SetRGBWithIndex(m_pCurrentScene->GetTerrain()->GetFGColorPixel(posX, posY));
+            spawnColor.SetRGBWithIndex(m_pCurrentScene->GetTerrain()->GetFGColorPixel(pixelX, pixelY));
 
         // No point generating a key-colored MOPixel
         if (spawnColor.GetIndex() != g_MaskColor)
         {
-			// TEST COLOR
-			// spawnColor = 5;
-
-            // Get the new pixel from the pre-allocated pool, should be faster than dynamic allocation
             // Density is used as the mass for the new MOPixel
 			float tempMax = 2.0F * sprayScale;
 			float tempMin = tempMax / 2.0F;
             MOPixel *pixelMO = new MOPixel(spawnColor,
                                            spawnMat->GetPixelDensity(),
-                                           Vector(posX, posY),
+                                           Vector(pixelX, pixelY),
                                            Vector(-RandomNum(tempMin, tempMax),
                                                   -RandomNum(tempMin, tempMax)),
                                            new Atom(Vector(), spawnMat->GetIndex(), 0, spawnColor, 2),
@@ -743,19 +758,9 @@ int SceneMan::RemoveOrphans(int posX, int posY,
             g_MovableMan.AddParticle(pixelMO);
             pixelMO = 0;
         }
-        m_pCurrentScene->GetTerrain()->SetFGColorPixel(posX, posY, g_MaskColor);
-		RegisterTerrainChange(posX, posY, 1, 1, g_MaskColor, false);
-        m_pCurrentScene->GetTerrain()->SetMaterialPixel(posX, posY, g_MaterialAir);
-	}
-
-	int xoff[8] = { -1,  0,  1, -1,  1, -1,  0,  1};
-	int yoff[8] = { -1, -1, -1,  0,  0,  1,  1,  1};
-
-	for (int c = 0; c < 8; c++)
-	{
-		area += RemoveOrphans(posX + xoff[c], posY + yoff[c], centerPosX, centerPosY, area, radius, maxArea, remove);
-		if (accumulatedArea + area > maxArea)
-			break;
+        m_pCurrentScene->GetTerrain()->SetFGColorPixel(pixelX, pixelY, g_MaskColor);
+		RegisterTerrainChange(pixelX, pixelY, 1, 1, g_MaskColor, false);
+        m_pCurrentScene->GetTerrain()->SetMaterialPixel(pixelX, pixelY, g_MaterialAir);
 	}
 
 	return area;
@@ -1017,9 +1022,6 @@ bool SceneMan::TryPenetrate(int posX,
 		if (removeOrphansRadius && removeOrphansMaxArea && removeOrphansRate > 0 && RandomNum() < removeOrphansRate)
 		{
 			RemoveOrphans(posX, posY, removeOrphansRadius, removeOrphansMaxArea, true);
-			/*PALETTE palette;
-			get_palette(palette);
-			save_bmp("Orphan.bmp", m_pOrphanSearchBitmap, palette);*/
 		}
 
         return true;
@@ -1251,107 +1253,124 @@ void SceneMan::RestoreUnseenBox(const int posX, const int posY, const int width,
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-//TODO Every raycast should use some shared line drawing method (or maybe something more efficient if it exists, that needs looking into) instead of having a ton of duplicated code.
-bool SceneMan::CastUnseenRay(int team, const Vector &start, const Vector &ray, Vector &endPos, int strengthLimit, int skip, bool reveal)
+template <typename CheckPixelFunction, typename SkipPixelFunction>
+int SceneMan::TraceRay(const Vector &start, const Vector &ray, int skip, bool wrap, CheckPixelFunction &&checkPixel, SkipPixelFunction &&skipPixel)
 {
-    if (!m_pCurrentScene->GetUnseenLayer(team))
-        return false;
-
-    int hitCount = 0, error, dom, sub, domSteps, skipped = skip;
-    int intPos[2], delta[2], delta2[2], increment[2];
-    bool affectedAny = false;
-    unsigned char materialID;
-    Material const * foundMaterial;
-    int totalStrength = 0;
-    // Save the projected end of the ray pos
-    endPos = start + ray;
-
-    intPos[X] = std::floor(start.m_X);
-    intPos[Y] = std::floor(start.m_Y);
-    delta[X] = std::floor(start.m_X + ray.m_X) - intPos[X];
-    delta[Y] = std::floor(start.m_Y + ray.m_Y) - intPos[Y];
+    int intPos[2] = { static_cast<int>(std::floor(start.m_X)), static_cast<int>(std::floor(start.m_Y)) };
+    int delta[2] = { static_cast<int>(std::floor(start.m_X + ray.m_X)) - intPos[X], static_cast<int>(std::floor(start.m_Y + ray.m_Y)) - intPos[Y] };
 
-    if (delta[X] == 0 &&  delta[Y] == 0)
-        return false;
+    if (delta[X] == 0 && delta[Y] == 0) {
+        return 0;
+    }
 
     /////////////////////////////////////////////////////
     // Bresenham's line drawing algorithm preparation
 
-    if (delta[X] < 0)
-    {
-        increment[X] = -1;
-        delta[X] = -delta[X];
-    }
-    else
-        increment[X] = 1;
-
-    if (delta[Y] < 0)
-    {
-        increment[Y] = -1;
-        delta[Y] = -delta[Y];
-    }
-    else
-        increment[Y] = 1;
+    int increment[2] = { delta[X] < 0 ? -1 : 1, delta[Y] < 0 ? -1 : 1 };
+    delta[X] = std::abs(delta[X]);
+    delta[Y] = std::abs(delta[Y]);
 
     // Scale by 2, for better accuracy of the error at the first pixel
-    delta2[X] = delta[X] << 1;
-    delta2[Y] = delta[Y] << 1;
+    int delta2[2] = { delta[X] * 2, delta[Y] * 2 };
 
     // If X is dominant, Y is submissive, and vice versa.
-    if (delta[X] > delta[Y]) {
-        dom = X;
-        sub = Y;
-    }
-    else {
-        dom = Y;
-        sub = X;
-    }
-
-    error = delta2[sub] - delta[dom];
+    int dom = delta[X] > delta[Y] ? X : Y;
+    int sub = dom == X ? Y : X;
+
+    int error = delta2[sub] - delta[dom];
+
+    // Look the wrapping up once per ray instead of going through the Scene and its terrain for every checked pixel.
+    bool wrapX = false;
+    bool wrapY = false;
+    int sceneWidth = 0;
+    int sceneHeight = 0;
+    if (wrap) {
+        RTEAssert(m_pCurrentScene, "Trying to access scene before there is one!");
+        const SLTerrain *terrain = m_pCurrentScene->GetTerrain();
+        wrapX = terrain->WrapsX();
+        wrapY = terrain->WrapsY();
+        sceneWidth = terrain->GetWidth();
+        sceneHeight = terrain->GetHeight();
+    }
+    bool drawVisualizations = m_pDebugLayer && m_DrawRayCastVisualizations;
 
     /////////////////////////////////////////////////////
     // Bresenham's line drawing algorithm execution
 
-    for (domSteps = 0; domSteps < delta[dom]; ++domSteps)
-    {
+    int skipped = skip;
+    int domSteps = 0;
+    for (; domSteps < delta[dom]; ++domSteps) {
         intPos[dom] += increment[dom];
-        if (error >= 0)
-        {
+        if (error >= 0) {
             intPos[sub] += increment[sub];
             error -= delta2[dom];
         }
         error += delta2[sub];
 
         // Only check pixel if we're not due to skip any, or if this is the last pixel
-        if (++skipped > skip || domSteps + 1 == delta[dom])
-        {
-            // Scene wrapping
-            g_SceneMan.WrapPosition(intPos[X], intPos[Y]);
-            // Reveal if we can, save the result
-			if (reveal)
-				affectedAny = RevealUnseen(intPos[X], intPos[Y], team) || affectedAny;
-			else
-				affectedAny = RestoreUnseen(intPos[X], intPos[Y], team) || affectedAny;
-
-            // Check the strength of the terrain to see if we can penetrate further
-            materialID = GetTerrMatter(intPos[X], intPos[Y]);
-            // Get the material object
-            foundMaterial = GetMaterialFromID(materialID);
-            // Add the encountered material's strength to the tally
-            totalStrength += foundMaterial->GetIntegrity();
-            // See if we have hit the limits of our ray's strength
-            if (totalStrength >= strengthLimit)
-            {
-                // Save the position of the end of the ray where blocked
-                endPos.SetXY(intPos[X], intPos[Y]);
+        if (++skipped > skip || domSteps + 1 == delta[dom]) {
+            // Scene wrapping, if necessary
+            if (wrapX && (intPos[X] < 0 || intPos[X] >= sceneWidth)) {
+                intPos[X] %= sceneWidth;
+                if (intPos[X] < 0) { intPos[X] += sceneWidth; }
+            }
+            if (wrapY && (intPos[Y] < 0 || intPos[Y] >= sceneHeight)) {
+                intPos[Y] %= sceneHeight;
+                if (intPos[Y] < 0) { intPos[Y] += sceneHeight; }
+            }
+
+            if (checkPixel(intPos[X], intPos[Y])) {
                 break;
             }
-            // Reset skip counter
             skipped = 0;
-            if (m_pDebugLayer && m_DrawRayCastVisualizations) { m_pDebugLayer->SetPixel(intPos[X], intPos[Y], 13); }
+
+            if (drawVisualizations) { m_pDebugLayer->SetPixel(intPos[X], intPos[Y], 13); }
+        } else {
+            skipPixel(intPos[X], intPos[Y]);
         }
     }
 
+    return domSteps;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename CheckPixelFunction>
+int SceneMan::TraceRay(const Vector &start, const Vector &ray, int skip, bool wrap, CheckPixelFunction &&checkPixel)
+{
+    return TraceRay(start, ray, skip, wrap, std::forward<CheckPixelFunction>(checkPixel), [](int, int) {});
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool SceneMan::CastUnseenRay(int team, const Vector &start, const Vector &ray, Vector &endPos, int strengthLimit, int skip, bool reveal)
+{
+    if (!m_pCurrentScene->GetUnseenLayer(team))
+        return false;
+
+    bool affectedAny = false;
+    int totalStrength = 0;
+    // Save the projected end of the ray pos
+    endPos = start + ray;
+
+    TraceRay(start, ray, skip, true, [&](int posX, int posY) {
+        // Reveal if we can, save the result
+        if (reveal) {
+            affectedAny = RevealUnseen(posX, posY, team) || affectedAny;
+        } else {
+            affectedAny = RestoreUnseen(posX, posY, team) || affectedAny;
+        }
+
+        // Add the encountered material's strength to the tally, and see if we have hit the limits of our ray's strength
+        totalStrength += GetMaterialFromID(GetTerrMatter(posX, posY))->GetIntegrity();
+        if (totalStrength >= strengthLimit) {
+            // Save the position of the end of the ray where blocked
+            endPos.SetXY(posX, posY);
+            return true;
+        }
+        return false;
+    });
+
     return affectedAny;
 }
 
@@ -1373,90 +1392,20 @@ bool SceneMan::CastUnseeRay(int team, const Vector &start, const Vector &ray, Ve
 
 bool SceneMan::CastMaterialRay(const Vector &start, const Vector &ray, unsigned char material, Vector &result, int skip, bool wrap)
 {
-
-    int hitCount = 0, error, dom, sub, domSteps, skipped = skip;
-    int intPos[2], delta[2], delta2[2], increment[2];
     bool foundPixel = false;
 
-    intPos[X] = std::floor(start.m_X);
-    intPos[Y] = std::floor(start.m_Y);
-    delta[X] = std::floor(start.m_X + ray.m_X) - intPos[X];
-    delta[Y] = std::floor(start.m_Y + ray.m_Y) - intPos[Y];
-
-    if (delta[X] == 0 &&  delta[Y] == 0)
-        return false;
-
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm preparation
-
-    if (delta[X] < 0)
-    {
-        increment[X] = -1;
-        delta[X] = -delta[X];
-    }
-    else
-        increment[X] = 1;
-
-    if (delta[Y] < 0)
-    {
-        increment[Y] = -1;
-        delta[Y] = -delta[Y];
-    }
-    else
-        increment[Y] = 1;
-
-    // Scale by 2, for better accuracy of the error at the first pixel
-    delta2[X] = delta[X] << 1;
-    delta2[Y] = delta[Y] << 1;
-
-    // If X is dominant, Y is submissive, and vice versa.
-    if (delta[X] > delta[Y]) {
-        dom = X;
-        sub = Y;
-    }
-    else {
-        dom = Y;
-        sub = X;
-    }
-
-    error = delta2[sub] - delta[dom];
-
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm execution
-
-    for (domSteps = 0; domSteps < delta[dom]; ++domSteps)
-    {
-        intPos[dom] += increment[dom];
-        if (error >= 0)
-        {
-            intPos[sub] += increment[sub];
-            error -= delta2[dom];
-        }
-        error += delta2[sub];
-
-        // Only check pixel if we're not due to skip any, or if this is the last pixel
-        if (++skipped > skip || domSteps + 1 == delta[dom])
-        {
-            // Scene wrapping, if necessary
-            if (wrap)
-                g_SceneMan.WrapPosition(intPos[X], intPos[Y]);
-
-            // See if we found the looked-for pixel of the correct material
-            if (GetTerrMatter(intPos[X], intPos[Y]) == material)
-            {
-                // Save result and report success
-                foundPixel = true;
-                result.SetXY(intPos[X], intPos[Y]);
-                // Save last ray pos
-                s_LastRayHitPos.SetXY(intPos[X], intPos[Y]);
-                break;
-            }
-
-            skipped = 0;
-
-            if (m_pDebugLayer && m_DrawRayCastVisualizations) { m_pDebugLayer->SetPixel(intPos[X], intPos[Y], 13); }
+    TraceRay(start, ray, skip, wrap, [&](int posX, int posY) {
+        // See if we found the looked-for pixel of the correct material
+        if (GetTerrMatter(posX, posY) == material) {
+            // Save result and report success
+            foundPixel = true;
+            result.SetXY(posX, posY);
+            // Save last ray pos
+            s_LastRayHitPos.SetXY(posX, posY);
+            return true;
         }
-    }
+        return false;
+    });
 
     return foundPixel;
 }
@@ -1482,89 +1431,20 @@ float SceneMan::CastMaterialRay(const Vector &start, const Vector &ray, unsigned
 
 bool SceneMan::CastNotMaterialRay(const Vector &start, const Vector &ray, unsigned char material, Vector &result, int skip, bool checkMOs)
 {
-    int hitCount = 0, error, dom, sub, domSteps, skipped = skip;
-    int intPos[2], delta[2], delta2[2], increment[2];
     bool foundPixel = false;
 
-    intPos[X] = std::floor(start.m_X);
-    intPos[Y] = std::floor(start.m_Y);
-    delta[X] = std::floor(start.m_X + ray.m_X) - intPos[X];
-    delta[Y] = std::floor(start.m_Y + ray.m_Y) - intPos[Y];
-
-    if (delta[X] == 0 &&  delta[Y] == 0)
-        return false;
-
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm preparation
-
-    if (delta[X] < 0)
-    {
-        increment[X] = -1;
-        delta[X] = -delta[X];
-    }
-    else
-        increment[X] = 1;
-
-    if (delta[Y] < 0)
-    {
-        increment[Y] = -1;
-        delta[Y] = -delta[Y];
-    }
-    else
-        increment[Y] = 1;
-
-    // Scale by 2, for better accuracy of the error at the first pixel
-    delta2[X] = delta[X] << 1;
-    delta2[Y] = delta[Y] << 1;
-
-    // If X is dominant, Y is submissive, and vice versa.
-    if (delta[X] > delta[Y]) {
-        dom = X;
-        sub = Y;
-    }
-    else {
-        dom = Y;
-        sub = X;
-    }
-
-    error = delta2[sub] - delta[dom];
-
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm execution
-
-    for (domSteps = 0; domSteps < delta[dom]; ++domSteps)
-    {
-        intPos[dom] += increment[dom];
-        if (error >= 0)
-        {
-            intPos[sub] += increment[sub];
-            error -= delta2[dom];
-        }
-        error += delta2[sub];
-
-        // Only check pixel if we're not due to skip any, or if this is the last pixel
-        if (++skipped > skip || domSteps + 1 == delta[dom])
-        {
-            // Scene wrapping, if necessary
-            g_SceneMan.WrapPosition(intPos[X], intPos[Y]);
-
-            // See if we found the looked-for pixel of the correct material,
-            // Or an MO is blocking the way
-            if (GetTerrMatter(intPos[X], intPos[Y]) != material ||
-                (checkMOs && g_SceneMan.GetMOIDPixel(intPos[X], intPos[Y], Activity::NoTeam) != g_NoMOID))
-            {
-                // Save result and report success
-                foundPixel = true;
-                result.SetXY(intPos[X], intPos[Y]);
-                // Save last ray pos
-                s_LastRayHitPos.SetXY(intPos[X], intPos[Y]);
-                break;
-            }
-
-            skipped = 0;
-            if (m_pDebugLayer && m_DrawRayCastVisualizations) { m_pDebugLayer->SetPixel(intPos[X], intPos[Y], 13); }
+    TraceRay(start, ray, skip, true, [&](int posX, int posY) {
+        // See if we found the looked-for pixel of the correct material, or an MO is blocking the way
+        if (GetTerrMatter(posX, posY) != material || (checkMOs && GetMOIDPixel(posX, posY, Activity::NoTeam) != g_NoMOID)) {
+            // Save result and report success
+            foundPixel = true;
+            result.SetXY(posX, posY);
+            // Save last ray pos
+            s_LastRayHitPos.SetXY(posX, posY);
+            return true;
         }
-    }
+        return false;
+    });
 
     return foundPixel;
 }
@@ -1589,738 +1469,210 @@ float SceneMan::CastNotMaterialRay(const Vector &start, const Vector &ray, unsig
 
 float SceneMan::CastStrengthSumRay(const Vector &start, const Vector &end, int skip, unsigned char ignoreMaterial)
 {
-    Vector ray = g_SceneMan.ShortestDistance(start, end);
     float strengthSum = 0;
 
-    int error, dom, sub, domSteps, skipped = skip;
-    int intPos[2], delta[2], delta2[2], increment[2];
-    bool foundPixel = false;
-    unsigned char materialID;
-    Material foundMaterial;
-
-    intPos[X] = std::floor(start.m_X);
-    intPos[Y] = std::floor(start.m_Y);
-    delta[X] = std::floor(start.m_X + ray.m_X) - intPos[X];
-    delta[Y] = std::floor(start.m_Y + ray.m_Y) - intPos[Y];
-
-    if (delta[X] == 0 &&  delta[Y] == 0)
+    TraceRay(start, g_SceneMan.ShortestDistance(start, end), skip, true, [&](int posX, int posY) {
+        // Sum all strengths
+        unsigned char materialID = GetTerrMatter(posX, posY);
+        if (materialID != g_MaterialAir && materialID != ignoreMaterial) {
+            strengthSum += GetMaterialFromID(materialID)->GetIntegrity();
+        }
         return false;
+    });
 
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm preparation
-
-    if (delta[X] < 0)
-    {
-        increment[X] = -1;
-        delta[X] = -delta[X];
-    }
-    else
-        increment[X] = 1;
-
-    if (delta[Y] < 0)
-    {
-        increment[Y] = -1;
-        delta[Y] = -delta[Y];
-    }
-    else
-        increment[Y] = 1;
+    return strengthSum;
+}
 
-    // Scale by 2, for better accuracy of the error at the first pixel
-    delta2[X] = delta[X] << 1;
-    delta2[Y] = delta[Y] << 1;
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    // If X is dominant, Y is submissive, and vice versa.
-    if (delta[X] > delta[Y]) {
-        dom = X;
-        sub = Y;
-    }
-    else
-    {
-        dom = Y;
-        sub = X;
-    }
+float SceneMan::CastMaxStrengthRay(const Vector &start, const Vector &end, int skip, unsigned char ignoreMaterial) {
+    return CastMaxStrengthRayMaterial(start, end, skip, ignoreMaterial)->GetIntegrity();
+}
 
-    error = delta2[sub] - delta[dom];
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm execution
+const Material * SceneMan::CastMaxStrengthRayMaterial(const Vector &start, const Vector &end, int skip, unsigned char ignoreMaterial) {
+    const Material *strongestMaterial = GetMaterialFromID(MaterialColorKeys::g_MaterialAir);
 
-    for (domSteps = 0; domSteps < delta[dom]; ++domSteps)
-    {
-        intPos[dom] += increment[dom];
-        if (error >= 0)
-        {
-            intPos[sub] += increment[sub];
-            error -= delta2[dom];
+    TraceRay(start, g_SceneMan.ShortestDistance(start, end), skip, true, [&](int posX, int posY) {
+        unsigned char materialID = GetTerrMatter(posX, posY);
+        if (materialID != g_MaterialAir && materialID != ignoreMaterial) {
+            const Material *foundMaterial = GetMaterialFromID(materialID);
+            if (foundMaterial->GetIntegrity() > strongestMaterial->GetIntegrity()) {
+                strongestMaterial = foundMaterial;
+            }
         }
-        error += delta2[sub];
+        return false;
+    });
 
-        // Only check pixel if we're not due to skip any, or if this is the last pixel
-        if (++skipped > skip || domSteps + 1 == delta[dom])
-        {
-            // Scene wrapping, if necessary
-            g_SceneMan.WrapPosition(intPos[X], intPos[Y]);
+    return strongestMaterial;
+}
 
-            // Sum all strengths
-            materialID = GetTerrMatter(intPos[X], intPos[Y]);
-            if (materialID != g_MaterialAir && materialID != ignoreMaterial) {
-                strengthSum += GetMaterialFromID(materialID)->GetIntegrity();
-            }
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-            skipped = 0;
+bool SceneMan::CastStrengthRay(const Vector &start, const Vector &ray, float strength, Vector &result, int skip, unsigned char ignoreMaterial, bool wrap)
+{
+    bool foundPixel = false;
 
-            if (m_pDebugLayer && m_DrawRayCastVisualizations) { m_pDebugLayer->SetPixel(intPos[X], intPos[Y], 13); }
+    TraceRay(start, ray, skip, wrap, [&](int posX, int posY) {
+        // Ignore the ignore material, and see if we found a pixel of equal or more strength than the threshold
+        unsigned char materialID = GetTerrMatter(posX, posY);
+        if (materialID != ignoreMaterial && GetMaterialFromID(materialID)->GetIntegrity() >= strength) {
+            // Save result and report success
+            foundPixel = true;
+            result.SetXY(posX, posY);
+            // Save last ray pos
+            s_LastRayHitPos.SetXY(posX, posY);
+            return true;
         }
-    }
+        // If no pixel of sufficient strength is found, the result ends up being the final tried position
+        result.SetXY(posX, posY);
+        return false;
+    });
 
-    return strengthSum;
+    return foundPixel;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-float SceneMan::CastMaxStrengthRay(const Vector &start, const Vector &end, int skip, unsigned char ignoreMaterial) {
-    return CastMaxStrengthRayMaterial(start, end, skip, ignoreMaterial)->GetIntegrity();
-}
-
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-const Material * SceneMan::CastMaxStrengthRayMaterial(const Vector &start, const Vector &end, int skip, unsigned char ignoreMaterial) {
-    Vector ray = g_SceneMan.ShortestDistance(start, end);
-    const Material *strongestMaterial = GetMaterialFromID(MaterialColorKeys::g_MaterialAir);
-
-    int error, dom, sub, domSteps, skipped = skip;
-    int intPos[2], delta[2], delta2[2], increment[2];
-    bool foundPixel = false;
-
-    intPos[X] = std::floor(start.m_X);
-    intPos[Y] = std::floor(start.m_Y);
-    delta[X] = std::floor(start.m_X + ray.m_X) - intPos[X];
-    delta[Y] = std::floor(start.m_Y + ray.m_Y) - intPos[Y];
-
-	if (delta[X] == 0 && delta[Y] == 0) {
-		return strongestMaterial;
-	}
-
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm preparation
-
-    if (delta[X] < 0)
-    {
-        increment[X] = -1;
-        delta[X] = -delta[X];
-    }
-    else
-        increment[X] = 1;
-
-    if (delta[Y] < 0)
-    {
-        increment[Y] = -1;
-        delta[Y] = -delta[Y];
-    }
-    else
-        increment[Y] = 1;
-
-    // Scale by 2, for better accuracy of the error at the first pixel
-    delta2[X] = delta[X] << 1;
-    delta2[Y] = delta[Y] << 1;
-
-    // If X is dominant, Y is submissive, and vice versa.
-    if (delta[X] > delta[Y]) {
-        dom = X;
-        sub = Y;
-    }
-    else
-    {
-        dom = Y;
-        sub = X;
-    }
-
-    error = delta2[sub] - delta[dom];
-
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm execution
-
-    for (domSteps = 0; domSteps < delta[dom]; ++domSteps)
-    {
-        intPos[dom] += increment[dom];
-        if (error >= 0)
-        {
-            intPos[sub] += increment[sub];
-            error -= delta2[dom];
-        }
-        error += delta2[sub];
-
-        // Only check pixel if we're not due to skip any, or if this is the last pixel
-        if (++skipped > skip || domSteps + 1 == delta[dom])
-        {
-            // Scene wrapping, if necessary
-            g_SceneMan.WrapPosition(intPos[X], intPos[Y]);
-
-            // Sum all strengths
-            unsigned char materialID = GetTerrMatter(intPos[X], intPos[Y]);
-            if (materialID != g_MaterialAir && materialID != ignoreMaterial) {
-                const Material *foundMaterial = GetMaterialFromID(materialID);
-                if (foundMaterial->GetIntegrity() > strongestMaterial->GetIntegrity()) {
-                    strongestMaterial = foundMaterial;
-                }
-            }
-
-            skipped = 0;
-
-            if (m_pDebugLayer && m_DrawRayCastVisualizations) { m_pDebugLayer->SetPixel(intPos[X], intPos[Y], 13); }
-        }
-    }
-
-    return strongestMaterial;
-}
-
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-bool SceneMan::CastStrengthRay(const Vector &start, const Vector &ray, float strength, Vector &result, int skip, unsigned char ignoreMaterial, bool wrap)
-{
-    int hitCount = 0, error, dom, sub, domSteps, skipped = skip;
-    int intPos[2], delta[2], delta2[2], increment[2];
-    bool foundPixel = false;
-    unsigned char materialID;
-    Material const * foundMaterial;
-
-    intPos[X] = std::floor(start.m_X);
-    intPos[Y] = std::floor(start.m_Y);
-    delta[X] = std::floor(start.m_X + ray.m_X) - intPos[X];
-    delta[Y] = std::floor(start.m_Y + ray.m_Y) - intPos[Y];
-
-    if (delta[X] == 0 &&  delta[Y] == 0)
-        return false;
-
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm preparation
-
-    if (delta[X] < 0)
-    {
-        increment[X] = -1;
-        delta[X] = -delta[X];
-    }
-    else
-        increment[X] = 1;
-
-    if (delta[Y] < 0)
-    {
-        increment[Y] = -1;
-        delta[Y] = -delta[Y];
-    }
-    else
-        increment[Y] = 1;
-
-    // Scale by 2, for better accuracy of the error at the first pixel
-    delta2[X] = delta[X] << 1;
-    delta2[Y] = delta[Y] << 1;
-
-    // If X is dominant, Y is submissive, and vice versa.
-    if (delta[X] > delta[Y]) {
-        dom = X;
-        sub = Y;
-    }
-    else {
-        dom = Y;
-        sub = X;
-    }
-
-    error = delta2[sub] - delta[dom];
-
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm execution
-
-    for (domSteps = 0; domSteps < delta[dom]; ++domSteps)
-    {
-        intPos[dom] += increment[dom];
-        if (error >= 0)
-        {
-            intPos[sub] += increment[sub];
-            error -= delta2[dom];
-        }
-        error += delta2[sub];
-
-        // Only check pixel if we're not due to skip any, or if this is the last pixel
-        if (++skipped > skip || domSteps + 1 == delta[dom])
-        {
-            // Scene wrapping, if necessary
-            if (wrap)
-                g_SceneMan.WrapPosition(intPos[X], intPos[Y]);
-
-            materialID = GetTerrMatter(intPos[X], intPos[Y]);
-            // Ignore the ignore material
-            if (materialID != ignoreMaterial)
-            {
-                // Get the material object
-                foundMaterial = GetMaterialFromID(materialID);
-
-                // See if we found a pixel of equal or more strength than the threshold
-                if (foundMaterial->GetIntegrity() >= strength)
-                {
-                    // Save result and report success
-                    foundPixel = true;
-                    result.SetXY(intPos[X], intPos[Y]);
-                    // Save last ray pos
-                    s_LastRayHitPos.SetXY(intPos[X], intPos[Y]);
-                    break;
-                }
-            }
-            skipped = 0;
-
-            if (m_pDebugLayer && m_DrawRayCastVisualizations) { m_pDebugLayer->SetPixel(intPos[X], intPos[Y], 13); }
-        }
-    }
-
-    // If no pixel of sufficient strength was found, set the result to the final tried position
-    if (!foundPixel)
-        result.SetXY(intPos[X], intPos[Y]);
-
-    return foundPixel;
-}
-
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-bool SceneMan::CastWeaknessRay(const Vector &start, const Vector &ray, float strength, Vector &result, int skip, bool wrap)
-{
-    int hitCount = 0, error, dom, sub, domSteps, skipped = skip;
-    int intPos[2], delta[2], delta2[2], increment[2];
-    bool foundPixel = false;
-    unsigned char materialID;
-    Material const *foundMaterial;
-
-    intPos[X] = std::floor(start.m_X);
-    intPos[Y] = std::floor(start.m_Y);
-    delta[X] = std::floor(start.m_X + ray.m_X) - intPos[X];
-    delta[Y] = std::floor(start.m_Y + ray.m_Y) - intPos[Y];
-
-    if (delta[X] == 0 &&  delta[Y] == 0)
-        return false;
-
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm preparation
-
-    if (delta[X] < 0)
-    {
-        increment[X] = -1;
-        delta[X] = -delta[X];
-    }
-    else
-        increment[X] = 1;
-
-    if (delta[Y] < 0)
-    {
-        increment[Y] = -1;
-        delta[Y] = -delta[Y];
-    }
-    else
-        increment[Y] = 1;
-
-    // Scale by 2, for better accuracy of the error at the first pixel
-    delta2[X] = delta[X] << 1;
-    delta2[Y] = delta[Y] << 1;
-
-    // If X is dominant, Y is submissive, and vice versa.
-    if (delta[X] > delta[Y]) {
-        dom = X;
-        sub = Y;
-    }
-    else {
-        dom = Y;
-        sub = X;
-    }
-
-    error = delta2[sub] - delta[dom];
-
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm execution
-
-    for (domSteps = 0; domSteps < delta[dom]; ++domSteps)
-    {
-        intPos[dom] += increment[dom];
-        if (error >= 0)
-        {
-            intPos[sub] += increment[sub];
-            error -= delta2[dom];
-        }
-        error += delta2[sub];
-
-        // Only check pixel if we're not due to skip any, or if this is the last pixel
-        if (++skipped > skip || domSteps + 1 == delta[dom])
-        {
-            // Scene wrapping, if necessary
-            if (wrap)
-                g_SceneMan.WrapPosition(intPos[X], intPos[Y]);
-
-            materialID = GetTerrMatter(intPos[X], intPos[Y]);
-            foundMaterial = GetMaterialFromID(materialID);
-
-            // See if we found a pixel of equal or less strength than the threshold
-            if (foundMaterial->GetIntegrity() <= strength)
-            {
-                // Save result and report success
-                foundPixel = true;
-                result.SetXY(intPos[X], intPos[Y]);
-                // Save last ray pos
-                s_LastRayHitPos.SetXY(intPos[X], intPos[Y]);
-                break;
-            }
-
-            skipped = 0;
-
-            if (m_pDebugLayer && m_DrawRayCastVisualizations) { m_pDebugLayer->SetPixel(intPos[X], intPos[Y], 13); }
-        }
-    }
-
-    // If no pixel of sufficient strength was found, set the result to the final tried position
-    if (!foundPixel)
-        result.SetXY(intPos[X], intPos[Y]);
-
-    return foundPixel;
+bool SceneMan::CastWeaknessRay(const Vector &start, const Vector &ray, float strength, Vector &result, int skip, bool wrap)
+{
+    bool foundPixel = false;
+
+    TraceRay(start, ray, skip, wrap, [&](int posX, int posY) {
+        // See if we found a pixel of equal or less strength than the threshold
+        if (GetMaterialFromID(GetTerrMatter(posX, posY))->GetIntegrity() <= strength) {
+            // Save result and report success
+            foundPixel = true;
+            result.SetXY(posX, posY);
+            // Save last ray pos
+            s_LastRayHitPos.SetXY(posX, posY);
+            return true;
+        }
+        // If no pixel of sufficient weakness is found, the result ends up being the final tried position
+        result.SetXY(posX, posY);
+        return false;
+    });
+
+    return foundPixel;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 MOID SceneMan::CastMORay(const Vector &start, const Vector &ray, MOID ignoreMOID, int ignoreTeam, unsigned char ignoreMaterial, bool ignoreAllTerrain, int skip)
 {
-    int hitCount = 0, error, dom, sub, domSteps, skipped = skip;
-    int intPos[2], delta[2], delta2[2], increment[2];
     MOID hitMOID = g_NoMOID;
-    unsigned char hitTerrain = 0;
-
-    intPos[X] = std::floor(start.m_X);
-    intPos[Y] = std::floor(start.m_Y);
-    delta[X] = std::floor(start.m_X + ray.m_X) - intPos[X];
-    delta[Y] = std::floor(start.m_Y + ray.m_Y) - intPos[Y];
-
-    if (delta[X] == 0 && delta[Y] == 0)
-        return g_NoMOID;
-
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm preparation
 
-    if (delta[X] < 0)
-    {
-        increment[X] = -1;
-        delta[X] = -delta[X];
-    }
-    else
-        increment[X] = 1;
-
-    if (delta[Y] < 0)
-    {
-        increment[Y] = -1;
-        delta[Y] = -delta[Y];
-    }
-    else
-        increment[Y] = 1;
-
-    // Scale by 2, for better accuracy of the error at the first pixel
-    delta2[X] = delta[X] << 1;
-    delta2[Y] = delta[Y] << 1;
-
-    // If X is dominant, Y is submissive, and vice versa.
-    if (delta[X] > delta[Y]) {
-        dom = X;
-        sub = Y;
-    }
-    else {
-        dom = Y;
-        sub = X;
-    }
-
-    error = delta2[sub] - delta[dom];
-
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm execution
-
-    for (domSteps = 0; domSteps < delta[dom]; ++domSteps)
-    {
-        intPos[dom] += increment[dom];
-        if (error >= 0)
-        {
-            intPos[sub] += increment[sub];
-            error -= delta2[dom];
-        }
-        error += delta2[sub];
-
-        // Only check pixel if we're not due to skip any, or if this is the last pixel
-        if (++skipped > skip || domSteps + 1 == delta[dom])
-        {
-
-            // Scene wrapping, if necessary
-            g_SceneMan.WrapPosition(intPos[X], intPos[Y]);
-
-            // Detect MOIDs
-            hitMOID = GetMOIDPixel(intPos[X], intPos[Y], ignoreTeam);
-            if (hitMOID != g_NoMOID && hitMOID != ignoreMOID && g_MovableMan.GetRootMOID(hitMOID) != ignoreMOID)
-            {
+    TraceRay(start, ray, skip, true, [&](int posX, int posY) {
+        // Detect MOIDs
+        MOID checkMOID = GetMOIDPixel(posX, posY, ignoreTeam);
+        if (checkMOID != g_NoMOID && checkMOID != ignoreMOID && g_MovableMan.GetRootMOID(checkMOID) != ignoreMOID) {
 #ifdef DRAW_MOID_LAYER // Unnecessary with non-drawn MOIDs - they'll be culled out at the spatial partition level.
-                // Check if we're supposed to ignore the team of what we hit
-                if (ignoreTeam != Activity::NoTeam)
-                {
-                    const MovableObject *pHitMO = g_MovableMan.GetMOFromID(hitMOID);
-                    pHitMO = pHitMO ? pHitMO->GetRootParent() : 0;
-                    // Yup, we are supposed to ignore this!
-                    if (pHitMO && pHitMO->IgnoresTeamHits() && pHitMO->GetTeam() == ignoreTeam)
-                    {
-                        ;
-                    }
-                    else
-                    {
-                        // Save last ray pos
-                        s_LastRayHitPos.SetXY(intPos[X], intPos[Y]);
-                        return hitMOID;
-                    }
-                }
-                // Legit hit
-                else
+            // Check if we're supposed to ignore the team of what we hit
+            const MovableObject *hitMO = (ignoreTeam != Activity::NoTeam) ? g_MovableMan.GetMOFromID(checkMOID) : nullptr;
+            hitMO = hitMO ? hitMO->GetRootParent() : nullptr;
+            if (!hitMO || !hitMO->IgnoresTeamHits() || hitMO->GetTeam() != ignoreTeam)
 #endif
-                {
-                    // Save last ray pos
-                    s_LastRayHitPos.SetXY(intPos[X], intPos[Y]);
-                    return hitMOID;
-                }
-            }
-
-            // Detect terrain hits
-            if (!ignoreAllTerrain)
             {
-                hitTerrain = g_SceneMan.GetTerrMatter(intPos[X], intPos[Y]);
-                if (hitTerrain != g_MaterialAir && hitTerrain != ignoreMaterial)
-                {
-                    // Save last ray pos
-                    s_LastRayHitPos.SetXY(intPos[X], intPos[Y]);
-                    return g_NoMOID;
-                }
+                hitMOID = checkMOID;
+                // Save last ray pos
+                s_LastRayHitPos.SetXY(posX, posY);
+                return true;
             }
+        }
 
-            skipped = 0;
-
-            if (m_pDebugLayer && m_DrawRayCastVisualizations) { m_pDebugLayer->SetPixel(intPos[X], intPos[Y], 13); }
+        // Detect terrain hits
+        if (!ignoreAllTerrain) {
+            unsigned char hitTerrain = GetTerrMatter(posX, posY);
+            if (hitTerrain != g_MaterialAir && hitTerrain != ignoreMaterial) {
+                // Save last ray pos
+                s_LastRayHitPos.SetXY(posX, posY);
+                return true;
+            }
         }
-    }
+        return false;
+    });
 
-    // Didn't hit anything but air
-    return g_NoMOID;
+    // g_NoMOID if we didn't hit anything but air, or hit terrain first
+    return hitMOID;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool SceneMan::CastFindMORay(const Vector &start, const Vector &ray, MOID targetMOID, Vector &resultPos, unsigned char ignoreMaterial, bool ignoreAllTerrain, int skip)
 {
-    int hitCount = 0, error, dom, sub, domSteps, skipped = skip;
-    int intPos[2], delta[2], delta2[2], increment[2];
-    MOID hitMOID = g_NoMOID;
-    unsigned char hitTerrain = 0;
-
-    intPos[X] = std::floor(start.m_X);
-    intPos[Y] = std::floor(start.m_Y);
-    delta[X] = std::floor(start.m_X + ray.m_X) - intPos[X];
-    delta[Y] = std::floor(start.m_Y + ray.m_Y) - intPos[Y];
-
-    if (delta[X] == 0 && delta[Y] == 0)
-        return g_NoMOID;
-
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm preparation
-
-    if (delta[X] < 0)
-    {
-        increment[X] = -1;
-        delta[X] = -delta[X];
-    }
-    else
-        increment[X] = 1;
-
-    if (delta[Y] < 0)
-    {
-        increment[Y] = -1;
-        delta[Y] = -delta[Y];
-    }
-    else
-        increment[Y] = 1;
-
-    // Scale by 2, for better accuracy of the error at the first pixel
-    delta2[X] = delta[X] << 1;
-    delta2[Y] = delta[Y] << 1;
-
-    // If X is dominant, Y is submissive, and vice versa.
-    if (delta[X] > delta[Y]) {
-        dom = X;
-        sub = Y;
-    }
-    else {
-        dom = Y;
-        sub = X;
-    }
-
-    error = delta2[sub] - delta[dom];
-
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm execution
-
-    for (domSteps = 0; domSteps < delta[dom]; ++domSteps)
-    {
-        intPos[dom] += increment[dom];
-        if (error >= 0)
-        {
-            intPos[sub] += increment[sub];
-            error -= delta2[dom];
+    bool foundTarget = false;
+
+    TraceRay(start, ray, skip, true, [&](int posX, int posY) {
+        // Detect MOIDs
+        MOID hitMOID = GetMOIDPixel(posX, posY, Activity::NoTeam);
+        if (hitMOID == targetMOID || g_MovableMan.GetRootMOID(hitMOID) == targetMOID) {
+            // Found target MOID, so save result and report success
+            foundTarget = true;
+            resultPos.SetXY(posX, posY);
+            // Save last ray pos
+            s_LastRayHitPos.SetXY(posX, posY);
+            return true;
         }
-        error += delta2[sub];
 
-        // Only check pixel if we're not due to skip any, or if this is the last pixel
-        if (++skipped > skip || domSteps + 1 == delta[dom])
-        {
-            // Scene wrapping, if necessary
-            g_SceneMan.WrapPosition(intPos[X], intPos[Y]);
-
-            // Detect MOIDs
-            hitMOID = GetMOIDPixel(intPos[X], intPos[Y], Activity::NoTeam);
-            if (hitMOID == targetMOID || g_MovableMan.GetRootMOID(hitMOID) == targetMOID)
-            {
-                // Found target MOID, so save result and report success
-                resultPos.SetXY(intPos[X], intPos[Y]);
+        // Detect terrain hits
+        if (!ignoreAllTerrain) {
+            unsigned char hitTerrain = GetTerrMatter(posX, posY);
+            if (hitTerrain != g_MaterialAir && hitTerrain != ignoreMaterial) {
                 // Save last ray pos
-                s_LastRayHitPos.SetXY(intPos[X], intPos[Y]);
+                s_LastRayHitPos.SetXY(posX, posY);
                 return true;
             }
-
-            // Detect terrain hits
-            if (!ignoreAllTerrain)
-            {
-                hitTerrain = g_SceneMan.GetTerrMatter(intPos[X], intPos[Y]);
-                if (hitTerrain != g_MaterialAir && hitTerrain != ignoreMaterial)
-                {
-                    // Save last ray pos
-                    s_LastRayHitPos.SetXY(intPos[X], intPos[Y]);
-                    return false;
-                }
-            }
-
-            skipped = 0;
-
-            if (m_pDebugLayer && m_DrawRayCastVisualizations) { m_pDebugLayer->SetPixel(intPos[X], intPos[Y], 13); }
         }
-    }
+        return false;
+    });
 
-    // Didn't hit the target
-    return false;
+    return foundTarget;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 float SceneMan::CastObstacleRay(const Vector &start, const Vector &ray, Vector &obstaclePos, Vector &freePos, MOID ignoreMOID, int ignoreTeam, unsigned char ignoreMaterial, int skip)
 {
-    int hitCount = 0, error, dom, sub, domSteps, skipped = skip;
-    int intPos[2], delta[2], delta2[2], increment[2];
     bool hitObstacle = false;
-
-    intPos[X] = std::floor(start.m_X);
-    intPos[Y] = std::floor(start.m_Y);
-    delta[X] = std::floor(start.m_X + ray.m_X) - intPos[X];
-    delta[Y] = std::floor(start.m_Y + ray.m_Y) - intPos[Y];
     // The fraction of a pixel that we start from, to be added to the integer result positions for accuracy
-    Vector startFraction(start.m_X - intPos[X], start.m_Y - intPos[Y]);
-
-    if (delta[X] == 0 && delta[Y] == 0) {
-        return -1.0f;
-    }
-
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm preparation
-
-    if (delta[X] < 0) {
-        increment[X] = -1;
-        delta[X] = -delta[X];
-    } else {
-        increment[X] = 1;
-    }
-
-    if (delta[Y] < 0) {
-        increment[Y] = -1;
-        delta[Y] = -delta[Y];
-    } else {
-        increment[Y] = 1;
-    }
-
-    // Scale by 2, for better accuracy of the error at the first pixel
-    delta2[X] = delta[X] * 2;
-    delta2[Y] = delta[Y] * 2;
-
-    // If X is dominant, Y is submissive, and vice versa.
-    if (delta[X] > delta[Y]) {
-        dom = X;
-        sub = Y;
-    } else {
-        dom = Y;
-        sub = X;
-    }
+    Vector startFraction(start.m_X - std::floor(start.m_X), start.m_Y - std::floor(start.m_Y));
 
-    error = delta2[sub] - delta[dom];
+    int domSteps = TraceRay(start, ray, skip, true, [&](int posX, int posY) {
+        unsigned char checkMat = GetTerrMatter(posX, posY);
+        MOID checkMOID = GetMOIDPixel(posX, posY, ignoreTeam);
 
-    /////////////////////////////////////////////////////
-    // Bresenham's line drawing algorithm execution
-
-    for (domSteps = 0; domSteps < delta[dom]; ++domSteps)
-    {
-        intPos[dom] += increment[dom];
-        if (error >= 0)
-        {
-            intPos[sub] += increment[sub];
-            error -= delta2[dom];
-        }
-        error += delta2[sub];
-
-        // Only check pixel if we're not due to skip any, or if this is the last pixel
-        if (++skipped > skip || domSteps + 1 == delta[dom])
-        {
-            // Scene wrapping, if necessary
-            g_SceneMan.WrapPosition(intPos[X], intPos[Y]);
-
-            unsigned char checkMat = GetTerrMatter(intPos[X], intPos[Y]);
-            MOID checkMOID = GetMOIDPixel(intPos[X], intPos[Y], ignoreTeam);
-
-            // Translate any found MOID into the root MOID of that hit MO
-            if (checkMOID != g_NoMOID)
-            {
-                MovableObject *pHitMO = g_MovableMan.GetMOFromID(checkMOID);
-                if (pHitMO)
-                {
-                    checkMOID = pHitMO->GetRootID();
+        // Translate any found MOID into the root MOID of that hit MO
+        if (checkMOID != g_NoMOID) {
+            MovableObject *hitMO = g_MovableMan.GetMOFromID(checkMOID);
+            if (hitMO) {
+                checkMOID = hitMO->GetRootID();
 #ifdef DRAW_MOID_LAYER // Unnecessary with non-drawn MOIDs - they'll be culled out at the spatial partition level.
-                    // Check if we're supposed to ignore the team of what we hit
-                    if (ignoreTeam != Activity::NoTeam)
-                    {
-                        pHitMO = pHitMO->GetRootParent();
-                        // We are indeed supposed to ignore this object because of its ignoring of its specific team
-                        if (pHitMO && pHitMO->IgnoresTeamHits() && pHitMO->GetTeam() == ignoreTeam) {
-                            checkMOID = g_NoMOID;
-                        }
+                // Check if we're supposed to ignore the team of what we hit
+                if (ignoreTeam != Activity::NoTeam) {
+                    hitMO = hitMO->GetRootParent();
+                    // We are indeed supposed to ignore this object because of its ignoring of its specific team
+                    if (hitMO && hitMO->IgnoresTeamHits() && hitMO->GetTeam() == ignoreTeam) {
+                        checkMOID = g_NoMOID;
                     }
-#endif
                 }
+#endif
             }
+        }
 
-            // See if we found the looked-for pixel of the correct material,
-            // Or an MO is blocking the way
-            if ((checkMat != g_MaterialAir && checkMat != ignoreMaterial) || (checkMOID != g_NoMOID && checkMOID != ignoreMOID)) {
-                hitObstacle = true;
-                obstaclePos.SetXY(intPos[X], intPos[Y]);
-                // Save last ray pos
-                s_LastRayHitPos.SetXY(intPos[X], intPos[Y]);
-                break;
-            } else {
-                freePos.SetXY(intPos[X], intPos[Y]);
-            }
-
-            skipped = 0;
-
-            if (m_pDebugLayer && m_DrawRayCastVisualizations) { m_pDebugLayer->SetPixel(intPos[X], intPos[Y], 13); }
-        } else {
-            freePos.SetXY(intPos[X], intPos[Y]);
+        // See if we found the looked-for pixel of the correct material, or an MO is blocking the way
+        if ((checkMat != g_MaterialAir && checkMat != ignoreMaterial) || (checkMOID != g_NoMOID && checkMOID != ignoreMOID)) {
+            hitObstacle = true;
+            obstaclePos.SetXY(posX, posY);
+            // Save last ray pos
+            s_LastRayHitPos.SetXY(posX, posY);
+            return true;
         }
-    }
+        freePos.SetXY(posX, posY);
+        return false;
+    }, [&freePos](int posX, int posY) {
+        freePos.SetXY(posX, posY);
+    });
 
     // Add the pixel fraction to the free position if there were any free pixels
     if (domSteps != 0) {
@@ -2346,6 +1698,66 @@ float SceneMan::CastObstacleRay(const Vector &start, const Vector &ray, Vector &
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void SceneMan::CastRays(std::span<RayQuery> rayQueries)
+{
+    ZoneScoped;
+
+    // Below this many rays per block, the overhead of dispatching isn't worth it.
+    static constexpr int c_MinRaysPerBlock = 16;
+
+    const int rayCount = static_cast<int>(rayQueries.size());
+    auto castRayBlock = [this, &rayQueries](int blockStart, int blockEnd) {
+        for (int i = blockStart; i < blockEnd; ++i) {
+            CastRay(rayQueries[i]);
+        }
+    };
+
+    // Rays cast from the thread pool itself, e.g. from multithreaded scripts, are cast on the calling thread so we never end up waiting on ourselves.
+    if (rayCount < c_MinRaysPerBlock * 2 || !g_ThreadMan.IsMainThread()) {
+        castRayBlock(0, rayCount);
+        return;
+    }
+
+    BS::thread_pool &threadPool = g_ThreadMan.GetPriorityThreadPool();
+    const int blockCount = std::min(static_cast<int>(threadPool.get_thread_count()), rayCount / c_MinRaysPerBlock);
+    threadPool.parallelize_loop(rayCount, castRayBlock, blockCount).wait();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SceneMan::CastRay(RayQuery &rayQuery)
+{
+    // Reset the results, in case the same query is cast again. Positions default to the end of the ray, same as if nothing was hit.
+    rayQuery.Hit = false;
+    rayQuery.HitMOID = g_NoMOID;
+    rayQuery.HitPos = rayQuery.Start + rayQuery.Ray;
+    rayQuery.FreePos = rayQuery.HitPos;
+    rayQuery.Distance = -1.0F;
+
+    switch (rayQuery.Type) {
+        case RayQuery::MORay:
+            rayQuery.HitMOID = CastMORay(rayQuery.Start, rayQuery.Ray, rayQuery.IgnoreMOID, rayQuery.IgnoreTeam, rayQuery.Material, rayQuery.IgnoreAllTerrain, rayQuery.Skip);
+            rayQuery.Hit = rayQuery.HitMOID != g_NoMOID;
+            if (rayQuery.Hit) { rayQuery.HitPos = s_LastRayHitPos; }
+            break;
+        case RayQuery::ObstacleRay:
+            rayQuery.Distance = CastObstacleRay(rayQuery.Start, rayQuery.Ray, rayQuery.HitPos, rayQuery.FreePos, rayQuery.IgnoreMOID, rayQuery.IgnoreTeam, rayQuery.Material, rayQuery.Skip);
+            rayQuery.Hit = rayQuery.Distance >= 0;
+            break;
+        case RayQuery::StrengthRay:
+            rayQuery.Hit = CastStrengthRay(rayQuery.Start, rayQuery.Ray, rayQuery.Strength, rayQuery.HitPos, rayQuery.Skip, rayQuery.Material);
+            break;
+        case RayQuery::NotMaterialRay:
+            rayQuery.Hit = CastNotMaterialRay(rayQuery.Start, rayQuery.Ray, rayQuery.Material, rayQuery.HitPos, rayQuery.Skip, rayQuery.CheckMOs);
+            break;
+        default:
+            RTEAbort("Invalid RayQuery type!");
+            break;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 const Vector& SceneMan::GetLastRayHitPos()
 {
     // The absolute end position of the last ray cast
@@ -2774,44 +2186,62 @@ void SceneMan::Update(int screenId) {
 	m_LastUpdatedScreen = screenId;
 
     const Vector &offset = g_CameraMan.GetOffset(screenId);
-	m_pMOColorLayer->SetOffset(offset);
 	m_pMOIDLayer->SetOffset(offset);
 	if (m_pDebugLayer) {
         m_pDebugLayer->SetOffset(offset);
     }
+	UpdateLayerOffsets(offset, g_CameraMan.GetUnwrappedOffset(screenId), g_CameraMan.GetScreenTeam(screenId), m_pMOColorLayer);
+
+	UpdateCleanAir();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SceneMan::UpdateLayerOffsets(const Vector &offset, const Vector &unwrappedOffset, int team, SceneLayerTracked *moColorLayer) {
+	moColorLayer->SetOffset(offset);
 
 	SLTerrain *terrain = m_pCurrentScene->GetTerrain();
 	terrain->SetOffset(offset);
 	terrain->Update();
 
 	// Background layers may scroll in fractions of the real offset and need special care to avoid jumping after having traversed wrapped edges, so they need the total offset without taking wrapping into account.
-    const Vector &unwrappedOffset = g_CameraMan.GetUnwrappedOffset(screenId);
 	for (SLBackground *backgroundLayer : m_pCurrentScene->GetBackLayers()) {
 		backgroundLayer->SetOffset(unwrappedOffset);
 		backgroundLayer->Update();
 	}
 
 	// Update the unseen obstruction layer for this team's screen view, if there is one.
-    const int teamId = g_CameraMan.GetScreenTeam(screenId);
-	if (SceneLayer *unseenLayer = (teamId != Activity::NoTeam) ? m_pCurrentScene->GetUnseenLayer(teamId) : nullptr) {
+	if (SceneLayer *unseenLayer = (team != Activity::NoTeam) ? m_pCurrentScene->GetUnseenLayer(team) : nullptr) {
         unseenLayer->SetOffset(offset);
     }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	if (m_CleanTimer.GetElapsedSimTimeMS() > CLEANAIRINTERVAL) {
-		terrain->CleanAir();
+void SceneMan::UpdateCleanAir() {
+	if (m_pCurrentScene && m_CleanTimer.GetElapsedSimTimeMS() > CLEANAIRINTERVAL) {
+		m_pCurrentScene->GetTerrain()->CleanAir();
 		m_CleanTimer.Reset();
 	}
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void SceneMan::Draw(BITMAP *targetBitmap, BITMAP *targetGUIBitmap, const Vector &targetPos, bool skipBackgroundLayers, bool skipTerrain) {
-	ZoneScoped;
-    
-    if (!m_pCurrentScene) {
-		return;
+SceneLayerTracked * SceneMan::PublishMOColorLayer() {
+	if (!m_pPublishedMOColorLayer) {
+		BITMAP *bitmap = create_bitmap_ex(8, GetSceneWidth(), GetSceneHeight());
+		clear_to_color(bitmap, g_MaskColor);
+		m_pPublishedMOColorLayer = new SceneLayerTracked();
+		m_pPublishedMOColorLayer->Create(bitmap, true, Vector(), m_pCurrentScene->WrapsX(), m_pCurrentScene->WrapsY(), Vector(1.0, 1.0));
 	}
-	SLTerrain *terrain = m_pCurrentScene->GetTerrain();
+	std::swap(m_pMOColorLayer, m_pPublishedMOColorLayer);
+	return m_pPublishedMOColorLayer;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Box SceneMan::GetDrawTargetBox(const BITMAP *targetBitmap) const {
+	const SLTerrain *terrain = m_pCurrentScene->GetTerrain();
 	// Set up the target box to draw to on the target bitmap, if it is larger than the scene in either dimension.
 	Box targetBox(Vector(), static_cast<float>(targetBitmap->w), static_cast<float>(targetBitmap->h));
 
@@ -2823,6 +2253,19 @@ void SceneMan::Draw(BITMAP *targetBitmap, BITMAP *targetGUIBitmap, const Vector
 		targetBox.SetCorner(Vector(targetBox.GetCorner().GetX(), static_cast<float>((targetBitmap->h - GetSceneHeight()) / 2)));
 		targetBox.SetHeight(static_cast<float>(GetSceneHeight()));
 	}
+	return targetBox;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SceneMan::Draw(BITMAP *targetBitmap, BITMAP *targetGUIBitmap, const Vector &targetPos, bool skipBackgroundLayers, bool skipTerrain) {
+	ZoneScoped;
+    
+    if (!m_pCurrentScene) {
+		return;
+	}
+	SLTerrain *terrain = m_pCurrentScene->GetTerrain();
+	Box targetBox = GetDrawTargetBox(targetBitmap);
 
 	switch (m_LayerDrawMode) {
 		case LayerDrawMode::g_LayerTerrainMatter:
@@ -2835,27 +2278,7 @@ void SceneMan::Draw(BITMAP *targetBitmap, BITMAP *targetGUIBitmap, const Vector
 			break;
 #endif
 		default:
-			if (!skipBackgroundLayers) {
-				for (std::list<SLBackground *>::reverse_iterator backgroundLayer = m_pCurrentScene->GetBackLayers().rbegin(); backgroundLayer != m_pCurrentScene->GetBackLayers().rend(); ++backgroundLayer) {
-					(*backgroundLayer)->Draw(targetBitmap, targetBox);
-				}
-			}
-			if (!skipTerrain) {
-				terrain->SetLayerToDraw(SLTerrain::LayerType::BackgroundLayer);
-				terrain->Draw(targetBitmap, targetBox);
-			}
-			m_pMOColorLayer->Draw(targetBitmap, targetBox);
-
-			if (!skipTerrain) {
-				terrain->SetLayerToDraw(SLTerrain::LayerType::ForegroundLayer);
-				terrain->Draw(targetBitmap, targetBox);
-			}
-            if (!g_FrameMan.IsInMultiplayerMode()) {
-                int teamId = g_CameraMan.GetScreenTeam(m_LastUpdatedScreen);
-				if (SceneLayer *unseenLayer = (teamId != Activity::NoTeam) ? m_pCurrentScene->GetUnseenLayer(teamId) : nullptr) {
-                    unseenLayer->Draw(targetBitmap, targetBox);
-                }
-			}
+			DrawWorldLayers(targetBitmap, targetBox, g_FrameMan.IsInMultiplayerMode() ? Activity::NoTeam : g_CameraMan.GetScreenTeam(m_LastUpdatedScreen), m_pMOColorLayer, skipBackgroundLayers, skipTerrain);
 
 			g_MovableMan.DrawHUD(targetGUIBitmap, targetPos, m_LastUpdatedScreen);
 			g_PrimitiveMan.DrawPrimitives(m_LastUpdatedScreen, targetGUIBitmap, targetPos);
@@ -2892,6 +2315,88 @@ void SceneMan::Draw(BITMAP *targetBitmap, BITMAP *targetGUIBitmap, const Vector
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+bool SceneMan::GetMOColorLayerDrawingsOnTarget(const BITMAP *targetBitmap, std::vector<IntRect> &targetDrawings, int &originX, int &originY) const {
+	originX = 0;
+	originY = 0;
+	if (!m_pCurrentScene || m_LayerDrawMode != LayerDrawMode::g_LayerNormal || m_pDebugLayer || m_pMOColorLayer->GetScaleFactor() != Vector(1.0F, 1.0F)) {
+		return false;
+	}
+	m_pMOColorLayer->GetDrawingsOnTarget(GetDrawTargetBox(targetBitmap), targetDrawings, originX, originY);
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SceneMan::UpdatePipelinedLayers(const Vector &offset, const Vector &unwrappedOffset, std::vector<Vector> &backgroundLayerOffsets) {
+	backgroundLayerOffsets.clear();
+	if (!m_pCurrentScene) {
+		return;
+	}
+	SLTerrain *terrain = m_pCurrentScene->GetTerrain();
+	terrain->SetOffset(offset);
+	terrain->Update();
+
+	for (SLBackground *backgroundLayer : m_pCurrentScene->GetBackLayers()) {
+		backgroundLayer->SetOffset(unwrappedOffset);
+		backgroundLayer->Update();
+		backgroundLayerOffsets.emplace_back(backgroundLayer->GetOffset());
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SceneMan::DrawPipelined(BITMAP *targetBitmap, const Vector &offset, const std::vector<Vector> &backgroundLayerOffsets, int team, SceneLayerTracked *moColorLayer) {
+	ZoneScoped;
+
+	if (!m_pCurrentScene || m_pCurrentScene->GetBackLayers().size() != backgroundLayerOffsets.size()) {
+		return;
+	}
+	Box targetBox = GetDrawTargetBox(targetBitmap);
+
+	// The layers are shared with the main thread, which is already setting their offsets for the next frame, so they're drawn at the offsets recorded for this frame without changing their own.
+	std::vector<Vector>::const_reverse_iterator backgroundLayerOffset = backgroundLayerOffsets.rbegin();
+	for (std::list<SLBackground *>::reverse_iterator backgroundLayer = m_pCurrentScene->GetBackLayers().rbegin(); backgroundLayer != m_pCurrentScene->GetBackLayers().rend(); ++backgroundLayer, ++backgroundLayerOffset) {
+		(*backgroundLayer)->DrawAtOffset(targetBitmap, targetBox, *backgroundLayerOffset);
+	}
+
+	// The terrain's color layers are drawn directly, so the layer the terrain itself is set to draw is left alone.
+	const SLTerrain *terrain = m_pCurrentScene->GetTerrain();
+	terrain->GetBGColorLayer()->DrawAtOffset(targetBitmap, targetBox, offset);
+	moColorLayer->DrawAtOffset(targetBitmap, targetBox, offset);
+	terrain->GetFGColorLayer()->DrawAtOffset(targetBitmap, targetBox, offset);
+
+	if (const SceneLayer *unseenLayer = (team != Activity::NoTeam) ? m_pCurrentScene->GetUnseenLayer(team) : nullptr) {
+		unseenLayer->DrawAtOffset(targetBitmap, targetBox, offset);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SceneMan::DrawWorldLayers(BITMAP *targetBitmap, Box &targetBox, int team, SceneLayerTracked *moColorLayer, bool skipBackgroundLayers, bool skipTerrain) {
+	SLTerrain *terrain = m_pCurrentScene->GetTerrain();
+
+	if (!skipBackgroundLayers) {
+		for (std::list<SLBackground *>::reverse_iterator backgroundLayer = m_pCurrentScene->GetBackLayers().rbegin(); backgroundLayer != m_pCurrentScene->GetBackLayers().rend(); ++backgroundLayer) {
+			(*backgroundLayer)->Draw(targetBitmap, targetBox);
+		}
+	}
+	if (!skipTerrain) {
+		terrain->SetLayerToDraw(SLTerrain::LayerType::BackgroundLayer);
+		terrain->Draw(targetBitmap, targetBox);
+	}
+	moColorLayer->Draw(targetBitmap, targetBox);
+
+	if (!skipTerrain) {
+		terrain->SetLayerToDraw(SLTerrain::LayerType::ForegroundLayer);
+		terrain->Draw(targetBitmap, targetBox);
+	}
+	if (SceneLayer *unseenLayer = (team != Activity::NoTeam) ? m_pCurrentScene->GetUnseenLayer(team) : nullptr) {
+		unseenLayer->Draw(targetBitmap, targetBox);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void SceneMan::ClearMOColorLayer()
 {
     m_pMOColorLayer->ClearBitmap(g_MaskColor);
@@ -2912,6 +2417,7 @@ void SceneMan::ClearSeenPixels()
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void SceneMan::ClearCurrentScene() {
+    g_FrameMan.WaitForPipelinedDraw();
     m_pCurrentScene = nullptr;
 }
 
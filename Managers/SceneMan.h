@@ -49,6 +49,33 @@ enum LayerDrawMode
 #endif
 };
 
+/// <summary>
+/// A single ray cast to be performed as part of a batch by SceneMan::CastRays, along with its results.
+/// </summary>
+struct RayQuery {
+	/// <summary>
+	/// The kinds of ray casts that can be batched, each matching the SceneMan method of the same name.
+	/// </summary>
+	enum RayType { MORay, ObstacleRay, StrengthRay, NotMaterialRay };
+
+	RayType Type = MORay; //!< The kind of ray cast to perform.
+	Vector Start; //!< The starting position of the ray.
+	Vector Ray; //!< The vector to trace along.
+	int Skip = 0; //!< For every pixel checked along the ray, how many to skip between them. 0 means every pixel is checked.
+	MOID IgnoreMOID = g_NoMOID; //!< An MOID to ignore, along with any of its children. Used by MORay and ObstacleRay.
+	int IgnoreTeam = Activity::NoTeam; //!< The team whose team-ignoring MOs should be ignored. Used by MORay and ObstacleRay.
+	unsigned char Material = g_MaterialAir; //!< The material to ignore hits with, or for NotMaterialRay, the material to look for anything but.
+	bool IgnoreAllTerrain = false; //!< Whether to ignore all terrain hits. Used by MORay.
+	bool CheckMOs = false; //!< Whether MOs block the ray. Used by NotMaterialRay.
+	float Strength = 0; //!< The material strength threshold to look for. Used by StrengthRay.
+
+	bool Hit = false; //!< Whether the ray hit what it was looking for.
+	MOID HitMOID = g_NoMOID; //!< The MOID of the hit MO. Set by MORay.
+	Vector HitPos; //!< Where the ray hit, or the end of the ray if it didn't.
+	Vector FreePos; //!< The last free position before the ray hit an obstacle. Set by ObstacleRay.
+	float Distance = -1.0F; //!< How far along the ray the obstacle was hit, or < 0 if none was. Set by ObstacleRay.
+};
+
 #define SCENEGRIDSIZE 24
 #define SCENESNAPSIZE 12
 #define MAXORPHANRADIUS 11
@@ -80,7 +107,7 @@ public:
 //                  memory. Create() should be called before using the object.
 // Arguments:       None.
 
-    SceneMan() { m_pOrphanSearchBitmap = 0; Clear(); }
+    SceneMan() { Clear(); }
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -642,38 +669,17 @@ public:
 // Method:          RemoveOrphans
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Returns the area of an orphaned region at specified coordinates.
+//                  The region is found with a single breadth first search, which stops as
+//                  soon as it's known the region isn't orphaned or is too large.
 // Arguments:       Coordinates to check for region, whether the orphaned region should be converted into MOPixels and region removed.
-//					Area of orphaned object calculated during recursve function call to check if we're out of limits
 //					Size of the are to look for orphaned objects
 //					Max area of orphaned object to remove
 //					Whether to actually remove orphaned pixels or not
-//					Whether to clear internal terrain tracking bitmap or not
-// Return value:    The area of orphaned region at posX,posY
+// Return value:    The area of orphaned region at posX,posY. Anything above maxArea means
+//                  the region isn't orphaned, or is too large to remove.
 
     int RemoveOrphans(int posX, int posY, int radius, int maxArea, bool remove = false);
 
-//////////////////////////////////////////////////////////////////////////////////////////
-// Method:          RemoveOrphans
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Returns the area of an orphaned region at specified coordinates.
-// Arguments:       Coordinates to check for region, whether the orphaned region should be converted into MOPixels and region removed.
-//					Coordinates of initial terrain penetration to check, which serves as a center of orphaned object detection.
-//					Area of orphaned object calculated during recursve function call to check if we're out of limits
-//					Size of the are to look for orphaned objects
-//					Max area of orphaned object to remove
-//					Whether to actually remove orphaned pixels or not
-//					Whether to clear internal terrain tracking bitmap or not
-// Return value:    The area of orphaned region at posX,posY
-
-    int RemoveOrphans(int posX,
-					  int posY,
-					  int centerPosX,
-					  int centerPosY,
-					  int accumulatedArea,
-					  int radius,
-					  int maxArea,
-					  bool remove = false);
-
 	/// <summary>
 	/// Removes a pixel from the terrain and adds it to MovableMan.
 	/// </summary>
@@ -1078,6 +1084,19 @@ public:
     float CastObstacleRay(const Vector &start, const Vector &ray, Vector &obstaclePos, Vector &freePos, MOID ignoreMOID = g_NoMOID, int ignoreTeam = Activity::NoTeam, unsigned char ignoreMaterial = 0, int skip = 0);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          CastRays
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Performs a batch of ray casts, spread over the priority thread pool
+//                  when there are enough of them and this is called from the main
+//                  thread. Each query works the same as the matching single ray cast
+//                  method, and its results are written back to it.
+// Arguments:       The ray queries to perform.
+// Return value:    None.
+
+    void CastRays(std::span<RayQuery> rayQueries);
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetLastRayHitPos
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1345,6 +1364,32 @@ public:
     void Update(int screenId = 0);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          UpdateCleanAir
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Cleans the air pixels out of the terrain color layer, if it's been long
+//                  enough since that was last done. Update does this on its own, so this
+//                  is only needed when the layers are drawn with DrawPipelined instead.
+// Arguments:       None.
+// Return value:    None.
+
+    void UpdateCleanAir();
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          PublishMOColorLayer
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Swaps the color MO layer MOs are drawn to with a second one, so what
+//                  was drawn until now can be read by a pipelined draw while the next
+//                  frame's MOs are drawn to the other. The second layer is created the
+//                  first time this is called for a Scene.
+// Arguments:       None.
+// Return value:    The color MO layer holding everything drawn until now. It won't be
+//                  touched again until the next call.
+
+    SceneLayerTracked * PublishMOColorLayer();
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          Draw
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1359,6 +1404,57 @@ public:
 	void Draw(BITMAP *targetBitmap, BITMAP *targetGUIBitmap,  const Vector &targetPos = Vector(), bool skipBackgroundLayers = false, bool skipTerrain = false);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetMOColorLayerDrawingsOnTarget
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets where everything drawn on the color MO layer ended up on a bitmap
+//                  the last Draw drew to. Must be called right after that Draw.
+// Arguments:       The BITMAP that was drawn to.
+//                  Vector to add the drawn areas to, in target bitmap pixels, with
+//                  inclusive bounds.
+//                  Set to where the layer's top left corner was drawn on the target,
+//                  before wrapping.
+// Return value:    Whether the areas cover everything drawn on the target's world part,
+//                  provided Draw skipped the background layers and terrain. False if
+//                  the debug layer or a special layer draw mode was drawn too.
+
+	bool GetMOColorLayerDrawingsOnTarget(const BITMAP *targetBitmap, std::vector<IntRect> &targetDrawings, int &originX, int &originY) const;
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          UpdatePipelinedLayers
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Lines the terrain up with a screen and updates the background layers
+//                  for it, the same as Update does, and gets the offsets the background
+//                  layers need to be drawn at by DrawPipelined. Must be called from the
+//                  main thread, as animating the background layers uses the simulation's
+//                  random number generator.
+// Arguments:       The camera offset of the screen, and the same without wrapping applied.
+//                  The vector to fill with the offset of each background layer.
+// Return value:    None.
+
+	void UpdatePipelinedLayers(const Vector &offset, const Vector &unwrappedOffset, std::vector<Vector> &backgroundLayerOffsets);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          DrawPipelined
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Draws the world part of what Draw draws for a screen: the background
+//                  layers, the terrain, the passed in color MO layer and the unseen layer of
+//                  a team. Nothing is updated and nothing the simulation reads or writes is
+//                  touched apart from the drawn layers' offsets, so this can be called from
+//                  a render thread while the next frame is simulated.
+// Arguments:       A pointer to a BITMAP to draw on, appropriately sized for the split
+//                  screen segment.
+//                  The camera offset of the screen.
+//                  The offset of each background layer, as gotten from UpdatePipelinedLayers.
+//                  The team whose unseen layer to draw, if any.
+//                  The color MO layer to draw, as returned by PublishMOColorLayer.
+// Return value:    None.
+
+	void DrawPipelined(BITMAP *targetBitmap, const Vector &offset, const std::vector<Vector> &backgroundLayerOffsets, int team, SceneLayerTracked *moColorLayer);
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          ClearMOColorLayer
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1446,6 +1542,8 @@ public:
     Scene *m_pCurrentScene;
     // Color MO layer
     SceneLayerTracked *m_pMOColorLayer;
+    // The other color MO layer, holding the last frame published for pipelined drawing
+    SceneLayerTracked *m_pPublishedMOColorLayer;
     // MovableObject ID layer
     SceneLayerTracked *m_pMOIDLayer;
     // A spatial partitioning grid of MOIDs, used to optimize collision and distance queries
@@ -1472,6 +1570,7 @@ public:
 
     bool m_DrawRayCastVisualizations; //!< Whether to visibly draw RayCasts to the Scene debug Bitmap.
     bool m_DrawPixelCheckVisualizations; //!< Whether to visibly draw pixel checks (GetTerrMatter and GetMOIDPixel) to the Scene debug Bitmap.
+    bool m_MOIDOccupancyMasksEnabled; //!< Whether the MOID grid keeps per-pixel occupancy masks, so GetMOIDPixel can skip hit testing MOs at pixels none of them occupy.
 
     // The last screen everything has been updated to
     int m_LastUpdatedScreen;
@@ -1486,8 +1585,10 @@ public:
 
     // The Timer to measure time between cleanings of the color layer of the Terrain.
     Timer m_CleanTimer;
-	// Bitmap to look for orphaned regions
-	BITMAP * m_pOrphanSearchBitmap;
+	// Which pixels of the orphan search box were already found by the current search, one bit per pixel
+	std::bitset<MAXORPHANRADIUS * MAXORPHANRADIUS> m_OrphanSearchVisited;
+	// The pixels found by the current orphan search, in the order they were found. Also serves as the search queue
+	std::vector<std::pair<int, int>> m_OrphanSearchPixels;
 
 	int m_ScrapCompactingHeight; //!< The maximum height of a column of scrap terrain to collapse, when the bottom pixel is knocked loose.
 
@@ -1509,6 +1610,64 @@ private:
 
     void Clear();
 
+	/// <summary>
+	/// Gets the box on a bitmap the Scene should be drawn to, which is centered on it in any dimension it's larger than a non-wrapping Scene.
+	/// </summary>
+	/// <param name="targetBitmap">The bitmap the Scene will be drawn to.</param>
+	/// <returns>The box on the target bitmap to draw the Scene to.</returns>
+	Box GetDrawTargetBox(const BITMAP *targetBitmap) const;
+
+	/// <summary>
+	/// Sets the offsets of the layers drawn by DrawWorldLayers to line them up with a screen.
+	/// </summary>
+	/// <param name="offset">The camera offset of the screen.</param>
+	/// <param name="unwrappedOffset">The camera offset of the screen without wrapping applied, which background layers need to scroll in fractions of it.</param>
+	/// <param name="team">The team whose unseen layer to line up, if any.</param>
+	/// <param name="moColorLayer">The color MO layer to line up.</param>
+	void UpdateLayerOffsets(const Vector &offset, const Vector &unwrappedOffset, int team, SceneLayerTracked *moColorLayer);
+
+	/// <summary>
+	/// Draws the background layers, the terrain, a color MO layer and the unseen layer of a team to a bitmap.
+	/// </summary>
+	/// <param name="targetBitmap">A pointer to a BITMAP to draw on.</param>
+	/// <param name="targetBox">The box on the target bitmap to draw to.</param>
+	/// <param name="team">The team whose unseen layer to draw, or Activity::NoTeam to not draw any.</param>
+	/// <param name="moColorLayer">The color MO layer to draw.</param>
+	/// <param name="skipBackgroundLayers">Whether to skip drawing the background layers.</param>
+	/// <param name="skipTerrain">Whether to skip drawing the terrain.</param>
+	void DrawWorldLayers(BITMAP *targetBitmap, Box &targetBox, int team, SceneLayerTracked *moColorLayer, bool skipBackgroundLayers, bool skipTerrain);
+
+	/// <summary>
+	/// Steps along a ray with Bresenham's line algorithm. All the ray casting methods go through this.
+	/// </summary>
+	/// <param name="start">The starting position of the ray.</param>
+	/// <param name="ray">The vector to trace along.</param>
+	/// <param name="skip">For every pixel checked along the ray, how many to skip between them. The last pixel of the ray is always checked.</param>
+	/// <param name="wrap">Whether to wrap checked pixels around the Scene, if it wraps.</param>
+	/// <param name="checkPixel">Function taking the X and Y of each checked pixel, and returning whether the ray should stop there.</param>
+	/// <param name="skipPixel">Function taking the X and Y of each skipped pixel.</param>
+	/// <returns>How many pixels were stepped before the ray ended or stopped, not counting the pixel it stopped at.</returns>
+	template <typename CheckPixelFunction, typename SkipPixelFunction>
+	int TraceRay(const Vector &start, const Vector &ray, int skip, bool wrap, CheckPixelFunction &&checkPixel, SkipPixelFunction &&skipPixel);
+
+	/// <summary>
+	/// Steps along a ray with Bresenham's line algorithm, without doing anything for skipped pixels.
+	/// </summary>
+	/// <param name="start">The starting position of the ray.</param>
+	/// <param name="ray">The vector to trace along.</param>
+	/// <param name="skip">For every pixel checked along the ray, how many to skip between them. The last pixel of the ray is always checked.</param>
+	/// <param name="wrap">Whether to wrap checked pixels around the Scene, if it wraps.</param>
+	/// <param name="checkPixel">Function taking the X and Y of each checked pixel, and returning whether the ray should stop there.</param>
+	/// <returns>How many pixels were stepped before the ray ended or stopped, not counting the pixel it stopped at.</returns>
+	template <typename CheckPixelFunction>
+	int TraceRay(const Vector &start, const Vector &ray, int skip, bool wrap, CheckPixelFunction &&checkPixel);
+
+	/// <summary>
+	/// Performs a single ray query from a batch, by calling the matching ray cast method.
+	/// </summary>
+	/// <param name="rayQuery">The ray query to perform and write the results to.</param>
+	void CastRay(RayQuery &rayQuery);
+
     // Disallow the use of some implicit methods.
 	SceneMan(const SceneMan &reference) = delete;
 	SceneMan & operator=(const SceneMan &rhs) = delete;
@@ -51,12 +51,15 @@ namespace RTE {
 		m_DisableFactionBuyMenuThemes = false;
 		m_DisableFactionBuyMenuThemeCursors = false;
 		m_PathFinderGridNodeSize = c_PPM;
+		m_PathFinderClusterSize = 8;
 		m_AIUpdateInterval = 2;
 
 		m_SkipIntro = false;
 		m_ShowToolTips = true;
 		m_DisableLoadingScreenProgressReport = true;
 		m_LoadingScreenProgressReportPrecision = 100;
+		m_EnableDataModuleCache = true;
+		m_EnableSpriteCache = true;
 		m_MenuTransitionDurationMultiplier = 1.0F;
 
 		m_DrawAtomGroupVisualizations = false;
@@ -120,6 +123,7 @@ namespace RTE {
 		MatchProperty("Fullscreen", { reader >> g_WindowMan.m_Fullscreen; });
 		MatchProperty("UseMultiDisplays", { reader >> g_WindowMan.m_UseMultiDisplays; });
 		MatchProperty("TwoPlayerSplitscreenVertSplit", { reader >> g_FrameMan.m_TwoPlayerVSplit; });
+		MatchProperty("EnablePipelinedDrawing", { reader >> g_FrameMan.m_PipelinedDrawingEnabled; });
 		MatchProperty("MasterVolume", { g_AudioMan.SetMasterVolume(std::stof(reader.ReadPropValue()) / 100.0F); });
 		MatchProperty("MuteMaster", { reader >> g_AudioMan.m_MuteMaster; });
 		MatchProperty("MusicVolume", { g_AudioMan.SetMusicVolume(std::stof(reader.ReadPropValue()) / 100.0F); });
@@ -169,9 +173,13 @@ namespace RTE {
 		MatchProperty("DisableFactionBuyMenuThemes", { reader >> m_DisableFactionBuyMenuThemes; });
 		MatchProperty("DisableFactionBuyMenuThemeCursors", { reader >> m_DisableFactionBuyMenuThemeCursors; });
 		MatchProperty("PathFinderGridNodeSize", { reader >> m_PathFinderGridNodeSize; });
+		MatchProperty("PathFinderClusterSize", { reader >> m_PathFinderClusterSize; });
 		MatchProperty("AIUpdateInterval", { reader >> m_AIUpdateInterval; });
 		MatchProperty("EnableParticleSettling", { reader >> g_MovableMan.m_SettlingEnabled; });
 		MatchProperty("EnableMOSubtraction", { reader >> g_MovableMan.m_MOSubtractionEnabled; });
+		MatchProperty("EnableParallelParticleTravel", { reader >> g_MovableMan.m_ParallelParticleTravelEnabled; });
+		MatchProperty("EnablePixelParticleSystem", { reader >> g_MovableMan.m_PixelParticleSystemEnabled; });
+		MatchProperty("EnableMOIDOccupancyMasks", { reader >> g_SceneMan.m_MOIDOccupancyMasksEnabled; });
 		MatchProperty("DeltaTime", { g_TimerMan.SetDeltaTimeSecs(std::stof(reader.ReadPropValue())); });
 		MatchProperty("AllowSavingToBase", { reader >> m_AllowSavingToBase; });
 		MatchProperty("ShowMetaScenes", { reader >> m_ShowMetaScenes; });
@@ -180,6 +188,8 @@ namespace RTE {
 		MatchProperty("CaseSensitiveFilePaths", { System::EnableFilePathCaseSensitivity(std::stoi(reader.ReadPropValue())); });
 		MatchProperty("DisableLoadingScreenProgressReport", { reader >> m_DisableLoadingScreenProgressReport; });
 		MatchProperty("LoadingScreenProgressReportPrecision", { reader >> m_LoadingScreenProgressReportPrecision; });
+		MatchProperty("EnableDataModuleCache", { reader >> m_EnableDataModuleCache; });
+		MatchProperty("EnableSpriteCache", { reader >> m_EnableSpriteCache; });
 		MatchProperty("ConsoleScreenRatio", { g_ConsoleMan.SetConsoleScreenSize(std::stof(reader.ReadPropValue())); });
 		MatchProperty("ConsoleUseMonospaceFont", { reader >> g_ConsoleMan.m_ConsoleUseMonospaceFont; });
 		MatchProperty("AdvancedPerformanceStats", { reader >> g_PerformanceMan.m_AdvancedPerfStats; });
@@ -245,6 +255,7 @@ namespace RTE {
 		writer.NewPropertyWithValue("EnableVSync", g_WindowMan.m_EnableVSync);
 		writer.NewPropertyWithValue("UseMultiDisplays", g_WindowMan.m_UseMultiDisplays);
 		writer.NewPropertyWithValue("TwoPlayerSplitscreenVertSplit", g_FrameMan.m_TwoPlayerVSplit);
+		writer.NewPropertyWithValue("EnablePipelinedDrawing", g_FrameMan.m_PipelinedDrawingEnabled);
 
 		writer.NewLine(false, 2);
 		writer.NewDivider(false);
@@ -314,9 +325,13 @@ namespace RTE {
 		writer.NewPropertyWithValue("DisableFactionBuyMenuThemes", m_DisableFactionBuyMenuThemes);
 		writer.NewPropertyWithValue("DisableFactionBuyMenuThemeCursors", m_DisableFactionBuyMenuThemeCursors);
 		writer.NewPropertyWithValue("PathFinderGridNodeSize", m_PathFinderGridNodeSize);
+		writer.NewPropertyWithValue("PathFinderClusterSize", m_PathFinderClusterSize);
 		writer.NewPropertyWithValue("AIUpdateInterval", m_AIUpdateInterval);
 		writer.NewPropertyWithValue("EnableParticleSettling", g_MovableMan.m_SettlingEnabled);
 		writer.NewPropertyWithValue("EnableMOSubtraction", g_MovableMan.m_MOSubtractionEnabled);
+		writer.NewPropertyWithValue("EnableParallelParticleTravel", g_MovableMan.m_ParallelParticleTravelEnabled);
+		writer.NewPropertyWithValue("EnablePixelParticleSystem", g_MovableMan.m_PixelParticleSystemEnabled);
+		writer.NewPropertyWithValue("EnableMOIDOccupancyMasks", g_SceneMan.m_MOIDOccupancyMasksEnabled);
 		writer.NewPropertyWithValue("DeltaTime", g_TimerMan.GetDeltaTimeSecs());
 		
 		// No experimental settings right now :)
@@ -342,6 +357,8 @@ namespace RTE {
 		writer.NewPropertyWithValue("CaseSensitiveFilePaths", System::FilePathsCaseSensitive());
 		writer.NewPropertyWithValue("DisableLoadingScreenProgressReport", m_DisableLoadingScreenProgressReport);
 		writer.NewPropertyWithValue("LoadingScreenProgressReportPrecision", m_LoadingScreenProgressReportPrecision);
+		writer.NewPropertyWithValue("EnableDataModuleCache", m_EnableDataModuleCache);
+		writer.NewPropertyWithValue("EnableSpriteCache", m_EnableSpriteCache);
 		writer.NewPropertyWithValue("ConsoleScreenRatio", g_ConsoleMan.m_ConsoleScreenRatio);
 		writer.NewPropertyWithValue("ConsoleUseMonospaceFont", g_ConsoleMan.m_ConsoleUseMonospaceFont);
 		writer.NewPropertyWithValue("AdvancedPerformanceStats", g_PerformanceMan.m_AdvancedPerfStats);
@@ -117,6 +117,12 @@ namespace RTE {
 		/// <returns>The PathFinder grid node size.</returns>
 		int GetPathFinderGridNodeSize() const { return m_PathFinderGridNodeSize; }
 
+		/// <summary>
+		/// Gets the PathFinder cluster size, which long paths are planned on before being refined on the PathFinder grid.
+		/// </summary>
+		/// <returns>The PathFinder cluster size, in PathFinder grid nodes. 0 means hierarchical pathfinding is disabled.</returns>
+		int GetPathFinderClusterSize() const { return m_PathFinderClusterSize; }
+
 		/// <summary>
 		/// Returns whether or not any experimental settings are used.
 		/// </summary>
@@ -489,6 +495,18 @@ namespace RTE {
 		/// <returns>How accurately the reader progress report tells what line it's reading during module loading.</returns>
 		int LoadingScreenProgressReportPrecision() const { return m_LoadingScreenProgressReportPrecision; }
 
+		/// <summary>
+		/// Gets whether DataModules are loaded through their binary cache of previously read data files.
+		/// </summary>
+		/// <returns>Whether the DataModule cache is enabled or not.</returns>
+		bool IsDataModuleCacheEnabled() const { return m_EnableDataModuleCache; }
+
+		/// <summary>
+		/// Gets whether sprites are loaded through the binary cache of previously decoded sprites.
+		/// </summary>
+		/// <returns>Whether the sprite cache is enabled or not.</returns>
+		bool IsSpriteCacheEnabled() const { return m_EnableSpriteCache; }
+
 		/// <summary>
 		/// Gets the multiplier value for the transition durations between different menus.
 		/// </summary>
@@ -548,12 +566,15 @@ namespace RTE {
 		bool m_DisableFactionBuyMenuThemes; //!< Whether faction BuyMenu theme support is disabled.
 		bool m_DisableFactionBuyMenuThemeCursors; //!< Whether custom cursor support in faction BuyMenu themes is disabled.
 		int m_PathFinderGridNodeSize; //!< The grid size used by the PathFinder, in pixels.
+		int m_PathFinderClusterSize; //!< The cluster size long paths are planned on by the PathFinder, in grid nodes. 0 disables hierarchical pathfinding.
 		int m_AIUpdateInterval; //!< How often actor's AI should be updated, i.e. every n simulation updates.
 
 		bool m_SkipIntro; //!< Whether to play the intro of the game or skip directly to the main menu.
 		bool m_ShowToolTips; //!< Whether ToolTips are enabled or not.
 		bool m_DisableLoadingScreenProgressReport; //!< Whether to display the reader progress report during module loading or not. Greatly increases loading speeds when disabled.
 		int m_LoadingScreenProgressReportPrecision; //!< How accurately the reader progress report tells what line it's reading during module loading. Lower values equal more precision at the cost of loading speed.
+		bool m_EnableDataModuleCache; //!< Whether DataModules are loaded through their binary cache of previously read data files, which is rewritten whenever any of them changed.
+		bool m_EnableSpriteCache; //!< Whether sprites are loaded through the binary cache of previously decoded sprites, which is rewritten whenever any of their image files changed.
 		float m_MenuTransitionDurationMultiplier; //!< Multiplier value for the transition durations between different menus. Lower values equal faster transitions.
 
 		bool m_DrawAtomGroupVisualizations; //!< Whether to draw MOSRotating AtomGroups to the Scene MO color Bitmap.
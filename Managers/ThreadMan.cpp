@@ -39,6 +39,7 @@ void ThreadMan::Clear()
 
 int ThreadMan::Create()
 {
+	m_MainThreadID = std::this_thread::get_id();
 	return 0;
 }
 
@@ -102,6 +102,12 @@ public:
 
     BS::thread_pool& GetBackgroundThreadPool() { return m_BackgroundThreadPool; }
 
+    /// <summary>
+    /// Gets whether the calling thread is the main thread, i.e. the one ThreadMan was created on.
+    /// </summary>
+    /// <returns>Whether the calling thread is the main thread.</returns>
+    bool IsMainThread() const { return std::this_thread::get_id() == m_MainThreadID; }
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Protected member variable and method declarations
 
@@ -133,6 +139,9 @@ private:
 
     // For background tasks that we can just let happen whenever over multiple frames
     BS::thread_pool m_BackgroundThreadPool;
+
+    // The thread ThreadMan was created on, which is the one running the main loop
+    std::thread::id m_MainThreadID;
 };
 
 } // namespace RTE
@@ -175,6 +175,12 @@ namespace RTE {
 		/// </summary>
 		void UpdateSim();
 
+		/// <summary>
+		/// Feeds exactly one DeltaTime into the simulation time accumulator and updates the simulation time with it, regardless of how much real time has passed.
+		/// Used to step the simulation deterministically when it isn't being paced by the real clock, e.g. in benchmark runs.
+		/// </summary>
+		void UpdateSimFixedStep() { m_SimAccumulator += m_DeltaTime; UpdateSim(); }
+
 		/// <summary>
 		/// Updates the real time ticks based on the actual clock time and adds it to the accumulator which the simulation ticks will draw from in whole DeltaTime-sized chunks.
 		/// </summary>
@@ -11,6 +11,7 @@
 #include "GUI.h"
 #include "AllegroScreen.h"
 #include "GAScripted.h"
+#include "SaveGameArchive.h"
 #include "GUIInputWrapper.h"
 #include "GUICollectionBox.h"
 #include "GUILabel.h"
@@ -84,7 +85,13 @@ namespace RTE {
 
 		std::string saveFilePath = g_PresetMan.GetFullModulePath(c_UserScriptedSavesModuleName) + "/";
 		for (const auto &entry : std::filesystem::directory_iterator(saveFilePath)) {
-			if (entry.is_directory()) {
+			if (entry.is_regular_file() && entry.path().extension() == SaveGameArchive::c_FileExtension) {
+				SaveRecord record;
+				record.SavePath = entry.path();
+				record.SaveDate = std::filesystem::last_write_time(entry.path());
+				m_SaveGames.push_back(record);
+			} else if (entry.is_directory() && std::filesystem::exists(entry.path() / "Save.ini")) {
+				// Saves from before they were archived are directories holding the data file and the layer bitmaps as separate files.
 				SaveRecord record;
 				record.SavePath = entry.path();
 				record.SaveDate = std::filesystem::last_write_time(entry.path() / "Save.ini");
@@ -95,7 +102,14 @@ namespace RTE {
 		std::for_each(std::execution::par_unseq,
 			m_SaveGames.begin(), m_SaveGames.end(),
 			[](SaveRecord &record) {
-				Reader reader(record.SavePath.string() + "/Save.ini", true, nullptr, true);
+				Reader reader;
+				if (record.SavePath.extension() == SaveGameArchive::c_FileExtension) {
+					std::string saveData;
+					SaveGameArchive::ReadTextEntry(record.SavePath.generic_string(), SaveGameArchive::c_SaveDataEntryName, saveData);
+					reader.Create(std::make_unique<ReaderStream>(std::make_shared<const std::string>(std::move(saveData))), SaveGameArchive::GetEntryPath(record.SavePath.generic_string(), SaveGameArchive::c_SaveDataEntryName), true, nullptr, true);
+				} else {
+					reader.Create(record.SavePath.string() + "/Save.ini", true, nullptr, true);
+				}
 
 				bool readActivity = false;
 				bool readSceneName = false;
@@ -204,6 +218,7 @@ namespace RTE {
 	void SaveLoadMenuGUI::DeleteSave() {
 		std::string saveFilePath = g_PresetMan.GetFullModulePath(c_UserScriptedSavesModuleName) + "/" + m_SaveGameName->GetText();
 
+		std::filesystem::remove(saveFilePath + SaveGameArchive::c_FileExtension);
 		std::filesystem::remove_all(saveFilePath);
 		g_GUISound.ConfirmSound()->Play();
 
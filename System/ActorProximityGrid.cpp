@@ -0,0 +1,238 @@
+#include "ActorProximityGrid.h"
+
+#include "Actor.h"
+#include "SceneMan.h"
+
+namespace RTE {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ActorProximityGrid::Clear() {
+		m_SceneWidth = 0;
+		m_SceneHeight = 0;
+		m_WrapsX = false;
+		m_WrapsY = false;
+		m_Width = 0;
+		m_Height = 0;
+		m_CellWidth = 0;
+		m_CellHeight = 0;
+		m_MaxDisplacement = 0;
+		for (int team = Activity::NoTeam; team < Activity::MaxTeamCount; ++team) {
+			m_CellStarts[team + 1].clear();
+			m_CellActors[team + 1].clear();
+			m_CellActorPositions[team + 1].clear();
+		}
+		m_ActorCells.clear();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ActorProximityGrid::Create() {
+		Clear();
+		m_SceneWidth = g_SceneMan.GetSceneWidth();
+		m_SceneHeight = g_SceneMan.GetSceneHeight();
+		m_WrapsX = g_SceneMan.SceneWrapsX();
+		m_WrapsY = g_SceneMan.SceneWrapsY();
+		if (m_SceneWidth <= 0 || m_SceneHeight <= 0) {
+			return;
+		}
+		m_Width = std::max(1, (m_SceneWidth + c_TargetCellSize / 2) / c_TargetCellSize);
+		m_Height = std::max(1, (m_SceneHeight + c_TargetCellSize / 2) / c_TargetCellSize);
+		m_CellWidth = static_cast<float>(m_SceneWidth) / static_cast<float>(m_Width);
+		m_CellHeight = static_cast<float>(m_SceneHeight) / static_cast<float>(m_Height);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ActorProximityGrid::Rebuild(const std::deque<Actor *> &actors) {
+		if (m_SceneWidth != g_SceneMan.GetSceneWidth() || m_SceneHeight != g_SceneMan.GetSceneHeight() || m_WrapsX != g_SceneMan.SceneWrapsX() || m_WrapsY != g_SceneMan.SceneWrapsY()) {
+			Create();
+		}
+		m_MaxDisplacement = 0;
+		if (m_Width == 0 || m_Height == 0) {
+			return;
+		}
+		int cellCount = m_Width * m_Height;
+
+		// Counting sort the Actors by team and cell, so each team's Actors end up in one contiguous vector with every cell being a slice of it.
+		m_ActorCells.clear();
+		m_ActorCells.reserve(actors.size());
+		for (int team = Activity::NoTeam; team < Activity::MaxTeamCount; ++team) {
+			m_CellStarts[team + 1].assign(cellCount + 1, 0);
+		}
+		for (const Actor *actor : actors) {
+			int team = actor->GetTeam();
+			int teamIndex = (team >= Activity::NoTeam && team < Activity::MaxTeamCount) ? team + 1 : 0;
+			const Vector &actorPos = actor->GetPos();
+			int cellId = GetCellCoord(actorPos.GetY(), m_CellHeight, m_Height, m_WrapsY) * m_Width + GetCellCoord(actorPos.GetX(), m_CellWidth, m_Width, m_WrapsX);
+			m_ActorCells.emplace_back(teamIndex, cellId);
+			++m_CellStarts[teamIndex][cellId + 1];
+		}
+		for (int team = Activity::NoTeam; team < Activity::MaxTeamCount; ++team) {
+			std::vector<int> &cellStarts = m_CellStarts[team + 1];
+			std::partial_sum(cellStarts.begin(), cellStarts.end(), cellStarts.begin());
+			m_CellActors[team + 1].resize(cellStarts[cellCount]);
+			m_CellActorPositions[team + 1].resize(cellStarts[cellCount]);
+		}
+		// Use each cell's start as its write cursor, which leaves it at the next cell's start once all its Actors are placed. Shifting everything back by one cell then restores the starts.
+		for (size_t actorIndex = 0; actorIndex < actors.size(); ++actorIndex) {
+			const auto &[teamIndex, cellId] = m_ActorCells[actorIndex];
+			int cellActorIndex = m_CellStarts[teamIndex][cellId]++;
+			m_CellActors[teamIndex][cellActorIndex] = actors[actorIndex];
+			m_CellActorPositions[teamIndex][cellActorIndex] = actors[actorIndex]->GetPos();
+		}
+		for (int team = Activity::NoTeam; team < Activity::MaxTeamCount; ++team) {
+			std::vector<int> &cellStarts = m_CellStarts[team + 1];
+			std::copy_backward(cellStarts.begin(), cellStarts.end() - 1, cellStarts.end());
+			cellStarts[0] = 0;
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ActorProximityGrid::Refresh(const std::deque<Actor *> &actors) {
+		float maxDisplacement = GetMaxDisplacement();
+		if (maxDisplacement > std::min(m_CellWidth, m_CellHeight)) {
+			Rebuild(actors);
+		} else {
+			m_MaxDisplacement = maxDisplacement;
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::vector<ActorProximityGrid::ActorDistance> ActorProximityGrid::GetNearestActors(const Vector &center, int count, float maxRadius, int teamMask, const ActorFilter &filter) const {
+		std::vector<ActorDistance> nearestActors;
+		if (count <= 0 || maxRadius <= 0 || m_Width == 0 || m_Height == 0) {
+			return nearestActors;
+		}
+		float sqrMaxRadius = maxRadius * maxRadius;
+		int centerCellX = GetCellCoord(center.GetX(), m_CellWidth, m_Width, m_WrapsX);
+		int centerCellY = GetCellCoord(center.GetY(), m_CellHeight, m_Height, m_WrapsY);
+		auto [minOffsetX, maxOffsetX] = GetCellOffsetRange(centerCellX, m_Width, m_WrapsX);
+		auto [minOffsetY, maxOffsetY] = GetCellOffsetRange(centerCellY, m_Height, m_WrapsY);
+		int lastRing = std::max({ -minOffsetX, maxOffsetX, -minOffsetY, maxOffsetY });
+		float smallestCellSize = std::min(m_CellWidth, m_CellHeight);
+		
+		std::vector<ActorDistance> ringActors;
+		auto closerThan = [](const ActorDistance &lhs, const ActorDistance &rhs) { return lhs.SqrDistance < rhs.SqrDistance; };
+
+		// Search rings of cells outwards from the center cell. Any cell in a ring has at least one whole ring of cells between it and the center, less however far its Actors may have moved out of it, so once the furthest Actor found so far is closer than that, no further ring can improve on it.
+		for (int ring = 0; ring <= lastRing; ++ring) {
+			float ringDistance = static_cast<float>(ring - 1) * smallestCellSize - m_MaxDisplacement;
+			if (ringDistance > 0) {
+				float sqrRingDistance = ringDistance * ringDistance;
+				if (sqrRingDistance >= sqrMaxRadius || (nearestActors.size() == static_cast<size_t>(count) && sqrRingDistance >= nearestActors.back().SqrDistance)) {
+					break;
+				}
+			}
+			ringActors.clear();
+			for (int offsetY = std::max(-ring, minOffsetY); offsetY <= std::min(ring, maxOffsetY); ++offsetY) {
+				// The top and bottom rows of a ring are whole, the rows in between only have their two ends in it.
+				int offsetXStep = (offsetY == -ring || offsetY == ring) ? 1 : ring * 2;
+				for (int offsetX = -ring; offsetX <= ring; offsetX += offsetXStep) {
+					if (offsetX >= minOffsetX && offsetX <= maxOffsetX) { GatherCell(centerCellX + offsetX, centerCellY + offsetY, center, sqrMaxRadius, teamMask, filter, ringActors); }
+				}
+			}
+			for (const ActorDistance &ringActor : ringActors) {
+				if (nearestActors.size() == static_cast<size_t>(count)) {
+					if (!closerThan(ringActor, nearestActors.back())) {
+						continue;
+					}
+					nearestActors.pop_back();
+				}
+				nearestActors.insert(std::upper_bound(nearestActors.begin(), nearestActors.end(), ringActor, closerThan), ringActor);
+			}
+		}
+		return nearestActors;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::vector<ActorProximityGrid::ActorDistance> ActorProximityGrid::GetActorsInRadius(const Vector &center, float radius, int teamMask, const ActorFilter &filter) const {
+		std::vector<ActorDistance> actorsInRadius;
+		if (radius <= 0 || m_Width == 0 || m_Height == 0) {
+			return actorsInRadius;
+		}
+		int centerCellX = GetCellCoord(center.GetX(), m_CellWidth, m_Width, m_WrapsX);
+		int centerCellY = GetCellCoord(center.GetY(), m_CellHeight, m_Height, m_WrapsY);
+		auto [minOffsetX, maxOffsetX] = GetCellOffsetRange(centerCellX, m_Width, m_WrapsX);
+		auto [minOffsetY, maxOffsetY] = GetCellOffsetRange(centerCellY, m_Height, m_WrapsY);
+
+		// The center can be anywhere in its cell, so round the radius up to whole cells on both sides. It also has to reach however far Actors may have moved out of their cells.
+		float searchRadius = radius + m_MaxDisplacement;
+		int radiusCellsX = static_cast<int>(std::ceil(std::min(searchRadius / m_CellWidth, static_cast<float>(m_Width))));
+		int radiusCellsY = static_cast<int>(std::ceil(std::min(searchRadius / m_CellHeight, static_cast<float>(m_Height))));
+		for (int offsetY = std::max(-radiusCellsY, minOffsetY); offsetY <= std::min(radiusCellsY, maxOffsetY); ++offsetY) {
+			for (int offsetX = std::max(-radiusCellsX, minOffsetX); offsetX <= std::min(radiusCellsX, maxOffsetX); ++offsetX) {
+				GatherCell(centerCellX + offsetX, centerCellY + offsetY, center, radius * radius, teamMask, filter, actorsInRadius);
+			}
+		}
+		return actorsInRadius;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int ActorProximityGrid::GetCellCoord(float position, float cellSize, int cellCount, bool wraps) {
+		if (wraps) {
+			float axisSize = cellSize * static_cast<float>(cellCount);
+			position = std::fmod(position, axisSize);
+			if (position < 0) { position += axisSize; }
+		}
+		return std::clamp(static_cast<int>(std::floor(position / cellSize)), 0, cellCount - 1);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::pair<int, int> ActorProximityGrid::GetCellOffsetRange(int cellCoord, int cellCount, bool wraps) {
+		return wraps ? std::make_pair(-((cellCount - 1) / 2), cellCount / 2) : std::make_pair(-cellCoord, cellCount - 1 - cellCoord);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	float ActorProximityGrid::GetMaxDisplacement() const {
+		float sceneWidth = static_cast<float>(m_SceneWidth);
+		float sceneHeight = static_cast<float>(m_SceneHeight);
+		float maxSqrDisplacement = 0;
+
+		for (int team = Activity::NoTeam; team < Activity::MaxTeamCount; ++team) {
+			const std::vector<Actor *> &cellActors = m_CellActors[team + 1];
+			const std::vector<Vector> &cellActorPositions = m_CellActorPositions[team + 1];
+			for (size_t actorIndex = 0; actorIndex < cellActors.size(); ++actorIndex) {
+				const Vector &actorPos = cellActors[actorIndex]->GetPos();
+				float displacementX = std::abs(actorPos.GetX() - cellActorPositions[actorIndex].GetX());
+				float displacementY = std::abs(actorPos.GetY() - cellActorPositions[actorIndex].GetY());
+				// Going the other way around a wrapping Scene may be shorter.
+				if (m_WrapsX) { displacementX = std::min(displacementX, std::abs(sceneWidth - displacementX)); }
+				if (m_WrapsY) { displacementY = std::min(displacementY, std::abs(sceneHeight - displacementY)); }
+				maxSqrDisplacement = std::max(maxSqrDisplacement, displacementX * displacementX + displacementY * displacementY);
+			}
+		}
+		return std::sqrt(maxSqrDisplacement);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ActorProximityGrid::GatherCell(int cellX, int cellY, const Vector &center, float sqrMaxRadius, int teamMask, const ActorFilter &filter, std::vector<ActorDistance> &foundActors) const {
+		if (m_WrapsX) { cellX = ((cellX % m_Width) + m_Width) % m_Width; }
+		if (m_WrapsY) { cellY = ((cellY % m_Height) + m_Height) % m_Height; }
+		int cellId = cellY * m_Width + cellX;
+		bool checkBounds = g_SceneMan.SceneWrapsX() || g_SceneMan.SceneWrapsY();
+
+		for (int team = Activity::NoTeam; team < Activity::MaxTeamCount; ++team) {
+			if (!(teamMask & GetTeamMask(team))) {
+				continue;
+			}
+			const std::vector<int> &cellStarts = m_CellStarts[team + 1];
+			for (int actorIndex = cellStarts[cellId]; actorIndex < cellStarts[cellId + 1]; ++actorIndex) {
+				Actor *actor = m_CellActors[team + 1][actorIndex];
+				if (filter && !filter(actor)) {
+					continue;
+				}
+				Vector distance = g_SceneMan.ShortestDistance(actor->GetPos(), center, checkBounds);
+				float sqrDistance = distance.GetSqrMagnitude();
+				if (sqrDistance < sqrMaxRadius) { foundActors.push_back({ sqrDistance, distance, actor }); }
+			}
+		}
+	}
+}
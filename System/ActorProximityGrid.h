@@ -0,0 +1,164 @@
+#ifndef _RTEACTORPROXIMITYGRID_
+#define _RTEACTORPROXIMITYGRID_
+
+//TODO Move Team enum into Constants so we can avoid including Activity here.
+#include "Activity.h"
+
+#include "Vector.h"
+
+namespace RTE {
+
+	class Actor;
+
+	/// <summary>
+	/// A wrap-aware uniform grid of Actors split by team, used to answer closest, k-nearest and radius queries without going through every Actor in the Scene.
+	/// It holds the Actors as they were when it was last rebuilt. Queries always measure distances with the Actors' current positions, and widen their search by the furthest any Actor had moved from its cell when this was last refreshed.
+	/// Refreshing once between update phases keeps Actors that moved since the rebuild findable without every query going through all of them, and rebuilds instead once any Actor, e.g. a teleported one, moved far enough to widen every search.
+	/// </summary>
+	class ActorProximityGrid {
+
+	public:
+
+		/// <summary>
+		/// A filter Actors have to pass to be included in the results of a query.
+		/// </summary>
+		using ActorFilter = std::function<bool(Actor *)>;
+
+		/// <summary>
+		/// An Actor found by a query, along with its distance from the query point.
+		/// </summary>
+		struct ActorDistance {
+			float SqrDistance; //!< The squared length of Distance.
+			Vector Distance; //!< The shortest distance from the Actor to the query point.
+			Actor *FoundActor; //!< The Actor that was found. Not owned.
+		};
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate an ActorProximityGrid object. It's created for the current Scene's dimensions the first time it's rebuilt.
+		/// </summary>
+		ActorProximityGrid() { Clear(); }
+#pragma endregion
+
+#pragma region Grid Management
+		/// <summary>
+		/// Rebuilds this ActorProximityGrid from the given Actors' current positions and teams, recreating it first if the Scene's dimensions changed.
+		/// </summary>
+		/// <param name="actors">The Actors to put into this ActorProximityGrid. Ownership is NOT transferred!</param>
+		void Rebuild(const std::deque<Actor *> &actors);
+
+		/// <summary>
+		/// Updates how far queries have to widen their search to find the Actors that moved since this ActorProximityGrid was rebuilt, or rebuilds it from the given Actors if any moved further than a cell.
+		/// </summary>
+		/// <param name="actors">The Actors this ActorProximityGrid was last rebuilt from. Ownership is NOT transferred!</param>
+		void Refresh(const std::deque<Actor *> &actors);
+
+		/// <summary>
+		/// Gets the mask that makes queries only include Actors of the given team.
+		/// </summary>
+		/// <param name="team">The team to include. NoTeam is a team like any other here.</param>
+		/// <returns>The team mask including only the given team.</returns>
+		static int GetTeamMask(int team) { return (team >= Activity::NoTeam && team < Activity::MaxTeamCount) ? 1 << (team + 1) : 0; }
+
+		/// <summary>
+		/// Gets the mask that makes queries include Actors of all teams.
+		/// </summary>
+		/// <returns>The team mask including all teams.</returns>
+		static int GetAllTeamsMask() { return (1 << (Activity::MaxTeamCount + 1)) - 1; }
+#pragma endregion
+
+#pragma region Queries
+		/// <summary>
+		/// Gets the Actors closest to a point, ordered from the closest to the furthest.
+		/// </summary>
+		/// <param name="center">The Scene point to search around.</param>
+		/// <param name="count">The maximum number of Actors to find.</param>
+		/// <param name="maxRadius">The radius to search within. Actors exactly at this distance aren't included.</param>
+		/// <param name="teamMask">Mask of the teams whose Actors to include, made with GetTeamMask() or GetAllTeamsMask().</param>
+		/// <param name="filter">A filter Actors have to pass to be included, or an empty one to include all of them.</param>
+		/// <returns>The closest Actors with their distances, at most count of them.</returns>
+		std::vector<ActorDistance> GetNearestActors(const Vector &center, int count, float maxRadius, int teamMask, const ActorFilter &filter) const;
+
+		/// <summary>
+		/// Gets all the Actors within a radius of a point, in no particular order.
+		/// </summary>
+		/// <param name="center">The Scene point to search around.</param>
+		/// <param name="radius">The radius to search within. Actors exactly at this distance aren't included.</param>
+		/// <param name="teamMask">Mask of the teams whose Actors to include, made with GetTeamMask() or GetAllTeamsMask().</param>
+		/// <param name="filter">A filter Actors have to pass to be included, or an empty one to include all of them.</param>
+		/// <returns>The Actors within the radius with their distances.</returns>
+		std::vector<ActorDistance> GetActorsInRadius(const Vector &center, float radius, int teamMask, const ActorFilter &filter) const;
+#pragma endregion
+
+	private:
+
+		static constexpr int c_TargetCellSize = 128; //!< The size of the cells this tries to use, in pixels. Cells are stretched a little so a whole number of them covers the Scene exactly, which keeps distances across the wrap seam correct.
+
+		int m_SceneWidth; //!< The width of the Scene this ActorProximityGrid was created for, in pixels.
+		int m_SceneHeight; //!< The height of the Scene this ActorProximityGrid was created for, in pixels.
+		bool m_WrapsX; //!< Whether the Scene this ActorProximityGrid was created for wraps horizontally.
+		bool m_WrapsY; //!< Whether the Scene this ActorProximityGrid was created for wraps vertically.
+		int m_Width; //!< The width of this ActorProximityGrid, in cells.
+		int m_Height; //!< The height of this ActorProximityGrid, in cells.
+		float m_CellWidth; //!< The width of each cell, in pixels.
+		float m_CellHeight; //!< The height of each cell, in pixels.
+		float m_MaxDisplacement; //!< The furthest any Actor had moved from the cell it was put in when this ActorProximityGrid was last refreshed, in pixels.
+
+		std::array<std::vector<int>, Activity::MaxTeamCount + 1> m_CellStarts; //!< For each team, the index in m_CellActors of the first Actor in each cell, with one extra entry at the end. Actors of cell N are in [m_CellStarts[N], m_CellStarts[N + 1]).
+		std::array<std::vector<Actor *>, Activity::MaxTeamCount + 1> m_CellActors; //!< For each team, the Actors in this ActorProximityGrid, grouped by cell. Not owned.
+		std::array<std::vector<Vector>, Activity::MaxTeamCount + 1> m_CellActorPositions; //!< For each team, the position each Actor in m_CellActors was at when it was put in its cell.
+		std::vector<std::pair<int, int>> m_ActorCells; //!< Scratch buffer holding the team index and cell of each Actor while rebuilding.
+
+		/// <summary>
+		/// Makes this ActorProximityGrid ready for use with the current Scene's dimensions.
+		/// </summary>
+		void Create();
+
+		/// <summary>
+		/// Gets the cell along one axis that a position falls in, wrapping or clamping it as needed.
+		/// </summary>
+		/// <param name="position">The position along the axis, in pixels.</param>
+		/// <param name="cellSize">The size of the cells along the axis, in pixels.</param>
+		/// <param name="cellCount">The number of cells along the axis.</param>
+		/// <param name="wraps">Whether the Scene wraps along the axis.</param>
+		/// <returns>The cell the position falls in.</returns>
+		static int GetCellCoord(float position, float cellSize, int cellCount, bool wraps);
+
+		/// <summary>
+		/// Gets the range of cell offsets from a cell that reach every cell along one axis exactly once, going the short way around if the axis wraps.
+		/// </summary>
+		/// <param name="cellCoord">The cell to get the offsets from.</param>
+		/// <param name="cellCount">The number of cells along the axis.</param>
+		/// <param name="wraps">Whether the Scene wraps along the axis.</param>
+		/// <returns>The lowest and highest offset.</returns>
+		static std::pair<int, int> GetCellOffsetRange(int cellCoord, int cellCount, bool wraps);
+
+		/// <summary>
+		/// Gets the furthest any Actor in this ActorProximityGrid has moved from the cell it was put in. This goes through all of them, so it's only done when refreshing.
+		/// </summary>
+		/// <returns>The furthest distance any Actor has moved since this ActorProximityGrid was rebuilt, in pixels.</returns>
+		float GetMaxDisplacement() const;
+
+		/// <summary>
+		/// Checks all the Actors in a cell against a query and passes the ones that are within range on.
+		/// </summary>
+		/// <param name="cellX">The X coordinate of the cell, not yet wrapped.</param>
+		/// <param name="cellY">The Y coordinate of the cell, not yet wrapped.</param>
+		/// <param name="center">The Scene point of the query.</param>
+		/// <param name="sqrMaxRadius">The squared radius of the query.</param>
+		/// <param name="teamMask">Mask of the teams whose Actors to include.</param>
+		/// <param name="filter">The filter of the query.</param>
+		/// <param name="foundActors">The container found Actors are added to.</param>
+		void GatherCell(int cellX, int cellY, const Vector &center, float sqrMaxRadius, int teamMask, const ActorFilter &filter, std::vector<ActorDistance> &foundActors) const;
+
+		/// <summary>
+		/// Clears all the member variables of this ActorProximityGrid.
+		/// </summary>
+		void Clear();
+
+		// Disallow the use of some implicit methods.
+		ActorProximityGrid(const ActorProximityGrid &reference) = delete;
+		ActorProximityGrid & operator=(const ActorProximityGrid &rhs) = delete;
+	};
+}
+#endif
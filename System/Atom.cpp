@@ -17,6 +17,7 @@ namespace RTE {
 	std::vector<void *> Atom::s_AllocatedPool;
 	int Atom::s_PoolAllocBlockCount = 200;
 	int Atom::s_InstancesInUse = 0;
+	thread_local std::vector<Atom::DeferredTrail> *Atom::s_DeferredTrailBuffer = nullptr;
 
 	// This forms a circle around the Atom's offset center, to check for mask color pixels in order to determine the normal at the Atom's position.
 	const int Atom::s_NormalChecks[c_NormalCheckCount][2] = { {0, -3}, {1, -3}, {2, -2}, {3, -1}, {3, 0}, {3, 1}, {2, 2}, {1, 3}, {0, 3}, {-1, 3}, {-2, 2}, {-3, 1}, {-3, 0}, {-3, -1}, {-2, -2}, {-1, -3} };
@@ -617,10 +618,7 @@ namespace RTE {
 		bool &didWrap = m_OwnerMO->m_DidWrap;
 		m_LastHit.Reset();
 
-		BITMAP *trailBitmap = 0;
-
 		int hitCount = 0;
-		int error = 0;
 		int dom = 0;
 		int sub = 0;
 		int domSteps = 0;
@@ -629,8 +627,7 @@ namespace RTE {
 		int intPos[2];
 		int hitPos[2];
 		int delta[2];
-		int delta2[2];
-		int increment[2];
+		BresenhamLine line;
 
 		float timeLeft = travelTime;
 		float segProgress = 0.0F;
@@ -674,11 +671,8 @@ namespace RTE {
 			intPos[X] = std::floor(position.m_X);
 			intPos[Y] = std::floor(position.m_Y);
 
-			// Get trail bitmap and put first pixel.
-			if (m_TrailLength) {
-				trailBitmap = g_SceneMan.GetMOColorBitmap();
-				trailPoints.push_back({ intPos[X], intPos[Y] });
-			}
+			// Put first trail pixel.
+			if (m_TrailLength) { trailPoints.push_back({ intPos[X], intPos[Y] }); }
 			// Compute and scale the actual on-screen travel trajectory for this segment, based on the velocity, the travel time and the pixels-per-meter constant.
 			segTraj = velocity * timeLeft * c_PPM;
 
@@ -708,35 +702,13 @@ namespace RTE {
 			//subMaterial->Reset();
 
 			// Bresenham's line drawing algorithm preparation
-			if (delta[X] < 0) {
-				increment[X] = -1;
-				delta[X] = -delta[X];
-			} else {
-				increment[X] = 1;
-			}
-			if (delta[Y] < 0) {
-				increment[Y] = -1;
-				delta[Y] = -delta[Y];
-			} else {
-				increment[Y] = 1;
-			}
-			// Scale by 2, for better accuracy of the error at the first pixel
-			delta2[X] = delta[X] << 1;
-			delta2[Y] = delta[Y] << 1;
-
-			// If X is dominant, Y is submissive, and vice versa.
-			if (delta[X] > delta[Y]) {
-				dom = X;
-				sub = Y;
-			} else {
-				dom = Y;
-				sub = X;
-			}
-
-			error = m_ChangedDir ? delta2[sub] - delta[dom] : m_PrevError;
+			line.Start(delta[X], delta[Y]);
+			if (!m_ChangedDir) { line.Error = m_PrevError; }
+			dom = line.Dom;
+			sub = line.Sub;
 
 			// Bresenham's line drawing algorithm execution
-			for (domSteps = 0; domSteps < delta[dom] && !(hit[X] || hit[Y]); ++domSteps) {
+			for (domSteps = 0; domSteps < line.Delta[dom] && !(hit[X] || hit[Y]); ++domSteps) {
 				// Check for the special case if the Atom is starting out embedded in terrain. This can happen if something large gets copied to the terrain and embeds some Atoms.
 				if (domSteps == 0 && g_SceneMan.GetTerrMatter(intPos[X], intPos[Y]) != g_MaterialAir) {
 					++hitCount;
@@ -754,15 +726,8 @@ namespace RTE {
 				}
 
 				if (subStepped) { ++subSteps; }
-				subStepped = false;
 
-				intPos[dom] += increment[dom];
-				if (error >= 0) {
-					intPos[sub] += increment[sub];
-					subStepped = true;
-					error -= delta2[dom];
-				}
-				error += delta2[sub];
+				subStepped = line.Step(intPos);
 
 				g_SceneMan.WrapPosition(intPos[X], intPos[Y]);
 
@@ -779,8 +744,7 @@ namespace RTE {
 					hitPos[Y] = intPos[Y];
 
 					// Back up so the Atom is not inside the MO.
-					intPos[dom] -= increment[dom];
-					if (subStepped) { intPos[sub] -= increment[sub]; }
+					line.StepBack(intPos, subStepped);
 
 					m_LastHit.Reset();
 					m_LastHit.TotalMass[HITOR] = mass;
@@ -821,21 +785,21 @@ namespace RTE {
 					}
 
 					// Check for the collision point in the dominant direction of travel.
-					if (delta[dom] && ((dom == X && g_SceneMan.GetMOIDPixel(hitPos[X], intPos[Y], m_OwnerMO->GetTeam()) != g_NoMOID) || (dom == Y && g_SceneMan.GetMOIDPixel(intPos[X], hitPos[Y], m_OwnerMO->GetTeam()) != g_NoMOID))) {
+					if (line.Delta[dom] && ((dom == X && g_SceneMan.GetMOIDPixel(hitPos[X], intPos[Y], m_OwnerMO->GetTeam()) != g_NoMOID) || (dom == Y && g_SceneMan.GetMOIDPixel(intPos[X], hitPos[Y], m_OwnerMO->GetTeam()) != g_NoMOID))) {
 						hit[dom] = true;
 						m_LastHit.HitPoint = (dom == X) ? Vector(hitPos[X], intPos[Y]) : Vector(intPos[X], hitPos[Y]);
-						m_LastHit.BitmapNormal[dom] = -increment[dom];
+						m_LastHit.BitmapNormal[dom] = -line.Increment[dom];
 					}
 
 					// Check for the collision point in the submissive direction of travel.
-					if (subStepped && delta[sub] && ((sub == X && g_SceneMan.GetMOIDPixel(hitPos[X], intPos[Y], m_OwnerMO->GetTeam()) != g_NoMOID) || (sub == Y && g_SceneMan.GetMOIDPixel(intPos[X], hitPos[Y], m_OwnerMO->GetTeam()) != g_NoMOID))) {
+					if (subStepped && line.Delta[sub] && ((sub == X && g_SceneMan.GetMOIDPixel(hitPos[X], intPos[Y], m_OwnerMO->GetTeam()) != g_NoMOID) || (sub == Y && g_SceneMan.GetMOIDPixel(intPos[X], hitPos[Y], m_OwnerMO->GetTeam()) != g_NoMOID))) {
 						hit[sub] = true;
 						if (m_LastHit.HitPoint.IsZero()) {
 							m_LastHit.HitPoint = (sub == X) ? Vector(hitPos[X], intPos[Y]) : Vector(intPos[X], hitPos[Y]);
 						} else {
 							// We hit pixels in both sub and dom directions on the other MO, a corner hit.
 							m_LastHit.HitPoint.SetXY(hitPos[X], hitPos[Y]);
-							m_LastHit.BitmapNormal[sub] = -increment[sub];
+							m_LastHit.BitmapNormal[sub] = -line.Increment[sub];
 						}
 					}
 
@@ -843,7 +807,7 @@ namespace RTE {
 					if (!hit[dom] && !hit[sub]) {
 						hit[dom] = hit[sub] = true;
 						m_LastHit.HitPoint.SetXY(hitPos[X], hitPos[Y]);
-						m_LastHit.BitmapNormal.SetXY(-increment[X], -increment[Y]);
+						m_LastHit.BitmapNormal.SetXY(-line.Increment[X], -line.Increment[Y]);
 					}
 
 					// Now normalize the normal in case it's diagonal due to hit in both directions
@@ -877,14 +841,14 @@ namespace RTE {
 					++hitCount;
 
 #ifdef DEBUG_BUILD
-					if (m_TrailLength) { putpixel(trailBitmap, intPos[X], intPos[Y], 199); }
+					if (m_TrailLength && !s_DeferredTrailBuffer) { putpixel(g_SceneMan.GetMOColorBitmap(), intPos[X], intPos[Y], 199); }
 #endif
 					// Try penetration of the terrain.
 					if (hitMaterial->GetIndex() != g_MaterialOutOfBounds && g_SceneMan.TryPenetrate(intPos[X], intPos[Y], velocity * mass * sharpness, velocity, retardation, 0.65F, m_NumPenetrations, removeOrphansRadius, removeOrphansMaxArea, removeOrphansRate)) {
 						hit[dom] = hit[sub] = sinkHit = true;
 						++m_NumPenetrations;
 						m_ChangedDir = false;
-						m_PrevError = error;
+						m_PrevError = line.Error;
 
 						// Calculate the penetration/sink response effects.
 						hitAccel = velocity * retardation;
@@ -892,11 +856,10 @@ namespace RTE {
 						// Penetration failed, bounce.
 						m_NumPenetrations = 0;
 						m_ChangedDir = true;
-						m_PrevError = error;
+						m_PrevError = line.Error;
 
 						// Back up so the Atom is not inside the terrain.
-						intPos[dom] -= increment[dom];
-						if (subStepped) { intPos[sub] -= increment[sub]; }
+						line.StepBack(intPos, subStepped);
 
 						// Undo scene wrapping, if necessary
 						g_SceneMan.WrapPosition(intPos[X], intPos[Y]);
@@ -931,7 +894,7 @@ namespace RTE {
 						}
 
 						// Check for and react upon a collision in the dominant direction of travel.
-						if (delta[dom] && ((dom == X && g_SceneMan.GetTerrMatter(hitPos[X], intPos[Y])) || (dom == Y && g_SceneMan.GetTerrMatter(intPos[X], hitPos[Y])))) {
+						if (line.Delta[dom] && ((dom == X && g_SceneMan.GetTerrMatter(hitPos[X], intPos[Y])) || (dom == Y && g_SceneMan.GetTerrMatter(intPos[X], hitPos[Y])))) {
 							hit[dom] = true;
 							domMaterialID = (dom == X) ? g_SceneMan.GetTerrMatter(hitPos[X], intPos[Y]) : g_SceneMan.GetTerrMatter(intPos[X], hitPos[Y]);
 							domMaterial = g_SceneMan.GetMaterialFromID(domMaterialID);
@@ -941,7 +904,7 @@ namespace RTE {
 						}
 
 						// Check for and react upon a collision in the submissive direction of travel.
-						if (subStepped && delta[sub] && ((sub == X && g_SceneMan.GetTerrMatter(hitPos[X], intPos[Y])) || (sub == Y && g_SceneMan.GetTerrMatter(intPos[X], hitPos[Y])))) {
+						if (subStepped && line.Delta[sub] && ((sub == X && g_SceneMan.GetTerrMatter(hitPos[X], intPos[Y])) || (sub == Y && g_SceneMan.GetTerrMatter(intPos[X], hitPos[Y])))) {
 							hit[sub] = true;
 							subMaterialID = (sub == X) ? g_SceneMan.GetTerrMatter(hitPos[X], intPos[Y]) : g_SceneMan.GetTerrMatter(intPos[X], hitPos[Y]);
 							subMaterial = g_SceneMan.GetMaterialFromID(subMaterialID);
@@ -974,8 +937,8 @@ namespace RTE {
 				if ((hit[X] || hit[Y]) && !m_LastHit.Terminate[HITOR]) {
 					// Calculate the progress made on this segment before hitting something.
 					// We count the hitting step made if it resulted in a terrain sink, because the Atoms weren't stepped back out of intersection.
-					//segProgress = static_cast<float>(domSteps + sinkHit) / static_cast<float>(delta[dom]);
-					segProgress = (static_cast<float>(domSteps + static_cast<int>(sinkHit)) < delta[dom]) ? (static_cast<float>(domSteps + static_cast<int>(sinkHit)) / std::fabs(static_cast<float>(segTraj[dom]))) : 1.0F;
+					//segProgress = static_cast<float>(domSteps + sinkHit) / static_cast<float>(line.Delta[dom]);
+					segProgress = (static_cast<float>(domSteps + static_cast<int>(sinkHit)) < line.Delta[dom]) ? (static_cast<float>(domSteps + static_cast<int>(sinkHit)) / std::fabs(static_cast<float>(segTraj[dom]))) : 1.0F;
 
 					// Now calculate the total time left to travel, according to the progress made.
 					timeLeft -= timeLeft * segProgress;
@@ -983,11 +946,11 @@ namespace RTE {
 					// Move position forward to the hit position.
 					//position += segTraj * segProgress;
 					// Only move the dom forward by int domSteps, so we don't cross into a pixel too far
-					position[dom] += (domSteps + static_cast<int>(sinkHit)) * increment[dom];
+					position[dom] += (domSteps + static_cast<int>(sinkHit)) * line.Increment[dom];
 
 					// Move the submissive direction forward by as many int steps, or the full float segTraj if all sub-steps are clear
-					if ((subSteps + static_cast<int>(subStepped && sinkHit)) < delta[sub]) {
-						position[sub] += (subSteps + static_cast<int>(subStepped && sinkHit)) * increment[sub];
+					if ((subSteps + static_cast<int>(subStepped && sinkHit)) < line.Delta[sub]) {
+						position[sub] += (subSteps + static_cast<int>(subStepped && sinkHit)) * line.Increment[sub];
 					} else {
 						position[sub] += segTraj[sub];
 					}
@@ -1004,26 +967,16 @@ namespace RTE {
 
 		//RTEAssert(hitCount < 100, "Atom travel resulted in more than 100 segments!!");
 
-		// Draw the trail
+		// Draw the trail, or record it to be drawn later if this is traveling concurrently.
 		if (g_TimerMan.DrawnSimUpdate() && m_TrailLength && trailPoints.size() > 0) {
-			Vector topLeftExtent = Vector(trailPoints[0].first, trailPoints[0].second);
-			Vector bottomRightExtent = topLeftExtent + Vector(1.0F, 1.0F);
-
-			int length = static_cast<int>(static_cast<float>(m_TrailLength) * RandomNum(1.0F - m_TrailLengthVariation, 1.0F));
-			for (int i = trailPoints.size() - std::min(length, static_cast<int>(trailPoints.size())); i < trailPoints.size(); ++i) {
-				putpixel(trailBitmap, trailPoints[i].first, trailPoints[i].second, m_TrailColor.GetIndex());
-
-				topLeftExtent.m_X = std::min(topLeftExtent.m_X, static_cast<float>(trailPoints[i].first));
-				topLeftExtent.m_Y = std::min(topLeftExtent.m_Y, static_cast<float>(trailPoints[i].second));
-				bottomRightExtent.m_X = std::max(bottomRightExtent.m_X, static_cast<float>(trailPoints[i].first));
-				bottomRightExtent.m_Y = std::max(bottomRightExtent.m_Y, static_cast<float>(trailPoints[i].second));
+			if (s_DeferredTrailBuffer) {
+				s_DeferredTrailBuffer->push_back({ trailPoints, m_TrailLength, m_TrailLengthVariation, m_TrailColor.GetIndex() });
+			} else {
+				DrawTrail(trailPoints, m_TrailLength, m_TrailLengthVariation, m_TrailColor.GetIndex());
 			}
-
-			g_SceneMan.RegisterDrawing(trailBitmap, g_NoMOID, topLeftExtent.m_X, topLeftExtent.m_Y, bottomRightExtent.m_X + 1.0F, bottomRightExtent.m_Y + 1.0F);
 		}
 
 		// Unlock all bitmaps involved.
-		//if (m_TrailLength) { trailBitmap->UnLock(); }
 		if (!scenePreLocked) { g_SceneMan.UnlockScene(); }
 
 		// Extract Atom offset.
@@ -1092,4 +1045,73 @@ namespace RTE {
 		}
 		return *this;
 	}
-}
\ No newline at end of file
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool Atom::IsTravelPathClear(float travelTime) const {
+		if (!m_OwnerMO) {
+			return false;
+		}
+		Vector position = m_OwnerMO->m_Pos + m_Offset;
+		Vector segTraj = m_OwnerMO->m_Vel * travelTime * c_PPM;
+
+		int intPos[2] = { static_cast<int>(std::floor(position.m_X)), static_cast<int>(std::floor(position.m_Y)) };
+		int delta[2] = { static_cast<int>(std::floor(position.m_X + segTraj.m_X)) - intPos[X], static_cast<int>(std::floor(position.m_Y + segTraj.m_Y)) - intPos[Y] };
+
+		// Travel doesn't step at all in this case, so there's nothing to hit.
+		if (delta[X] == 0 && delta[Y] == 0) {
+			return true;
+		}
+		// Starting out embedded in terrain means Travel will try to penetrate it.
+		if (g_SceneMan.GetTerrMatter(intPos[X], intPos[Y]) != g_MaterialAir) {
+			return false;
+		}
+
+		// This steps the same as Travel does for the first segment, which is the only one traveled if nothing is hit.
+		BresenhamLine line;
+		line.Start(delta[X], delta[Y]);
+		if (!m_ChangedDir) { line.Error = m_PrevError; }
+
+		bool checkMOs = m_OwnerMO->m_HitsMOs;
+		int team = m_OwnerMO->GetTeam();
+
+		for (int domSteps = 0; domSteps < line.Delta[line.Dom]; ++domSteps) {
+			line.Step(intPos);
+			g_SceneMan.WrapPosition(intPos[X], intPos[Y]);
+
+			if ((checkMOs && g_SceneMan.GetMOIDPixel(intPos[X], intPos[Y], team) != g_NoMOID) || g_SceneMan.GetTerrMatter(intPos[X], intPos[Y]) != g_MaterialAir) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Atom::DrawDeferredTrails(const std::vector<DeferredTrail> &deferredTrails) {
+		for (const DeferredTrail &deferredTrail : deferredTrails) {
+			DrawTrail(deferredTrail.Points, deferredTrail.TrailLength, deferredTrail.TrailLengthVariation, deferredTrail.TrailColorIndex);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Atom::DrawTrail(const std::vector<std::pair<int, int>> &trailPoints, int trailLength, float trailLengthVariation, int trailColorIndex) {
+		BITMAP *trailBitmap = g_SceneMan.GetMOColorBitmap();
+
+		Vector topLeftExtent = Vector(trailPoints[0].first, trailPoints[0].second);
+		Vector bottomRightExtent = topLeftExtent + Vector(1.0F, 1.0F);
+
+		int length = static_cast<int>(static_cast<float>(trailLength) * RandomNum(1.0F - trailLengthVariation, 1.0F));
+		for (int i = trailPoints.size() - std::min(length, static_cast<int>(trailPoints.size())); i < trailPoints.size(); ++i) {
+			putpixel(trailBitmap, trailPoints[i].first, trailPoints[i].second, trailColorIndex);
+
+			topLeftExtent.m_X = std::min(topLeftExtent.m_X, static_cast<float>(trailPoints[i].first));
+			topLeftExtent.m_Y = std::min(topLeftExtent.m_Y, static_cast<float>(trailPoints[i].second));
+			bottomRightExtent.m_X = std::max(bottomRightExtent.m_X, static_cast<float>(trailPoints[i].first));
+			bottomRightExtent.m_Y = std::max(bottomRightExtent.m_Y, static_cast<float>(trailPoints[i].second));
+		}
+
+		g_SceneMan.RegisterDrawing(trailBitmap, g_NoMOID, topLeftExtent.m_X, topLeftExtent.m_Y, bottomRightExtent.m_X + 1.0F, bottomRightExtent.m_Y + 1.0F);
+	}
+}
@@ -65,6 +65,66 @@ namespace RTE {
 	};
 #pragma endregion
 
+#pragma region BresenhamLine
+	/// <summary>
+	/// The state of Bresenham's line drawing algorithm, used to step a pixel position along a straight line one pixel at a time, the way Atoms travel.
+	/// </summary>
+	struct BresenhamLine {
+
+		int Delta[2]; //!< The absolute length of the line on each axis, in pixels.
+		int Delta2[2]; //!< Delta scaled by 2, for better accuracy of the error at the first pixel.
+		int Increment[2]; //!< The direction the line steps in on each axis, either 1 or -1.
+		int Dom; //!< The dominant axis, which is stepped on every step.
+		int Sub; //!< The submissive axis, which is only stepped when the error calls for it.
+		int Error; //!< The accumulated error of the submissive axis.
+
+		/// <summary>
+		/// Prepares this BresenhamLine to step along a line with the given length on each axis.
+		/// </summary>
+		/// <param name="deltaX">The length of the line on the X axis, in pixels. Negative for lines going left.</param>
+		/// <param name="deltaY">The length of the line on the Y axis, in pixels. Negative for lines going up.</param>
+		void Start(int deltaX, int deltaY) {
+			Increment[X] = deltaX < 0 ? -1 : 1;
+			Increment[Y] = deltaY < 0 ? -1 : 1;
+			Delta[X] = std::abs(deltaX);
+			Delta[Y] = std::abs(deltaY);
+			Delta2[X] = Delta[X] << 1;
+			Delta2[Y] = Delta[Y] << 1;
+			// If X is dominant, Y is submissive, and vice versa.
+			Dom = Delta[X] > Delta[Y] ? X : Y;
+			Sub = Dom == X ? Y : X;
+			Error = Delta2[Sub] - Delta[Dom];
+		}
+
+		/// <summary>
+		/// Steps a pixel position one pixel along this BresenhamLine. Doesn't wrap the position.
+		/// </summary>
+		/// <param name="intPos">The pixel position to step.</param>
+		/// <returns>Whether the submissive axis was stepped as well.</returns>
+		bool Step(int (&intPos)[2]) {
+			bool subStepped = false;
+			intPos[Dom] += Increment[Dom];
+			if (Error >= 0) {
+				intPos[Sub] += Increment[Sub];
+				subStepped = true;
+				Error -= Delta2[Dom];
+			}
+			Error += Delta2[Sub];
+			return subStepped;
+		}
+
+		/// <summary>
+		/// Undoes the last Step of a pixel position, without undoing the error. Doesn't wrap the position.
+		/// </summary>
+		/// <param name="intPos">The pixel position to step back.</param>
+		/// <param name="subStepped">Whether the last Step stepped the submissive axis as well.</param>
+		void StepBack(int (&intPos)[2], bool subStepped) const {
+			intPos[Dom] -= Increment[Dom];
+			if (subStepped) { intPos[Sub] -= Increment[Sub]; }
+		}
+	};
+#pragma endregion
+
 	/// <summary>
 	/// A point (pixel) that tests for collisions with a BITMAP's drawn pixels, ie not the mask color. Owned and operated by other objects.
 	/// </summary>
@@ -75,6 +135,16 @@ namespace RTE {
 		SerializableClassNameGetter;
 		SerializableOverrideMethods;
 
+		/// <summary>
+		/// A trail that was traveled while trail drawing was deferred, so it can be drawn later from the main thread in a deterministic order.
+		/// </summary>
+		struct DeferredTrail {
+			std::vector<std::pair<int, int>> Points; //!< The pixel positions the Atom traveled through.
+			int TrailLength; //!< The trail length of the Atom at the time of travel.
+			float TrailLengthVariation; //!< The trail length variation of the Atom at the time of travel.
+			int TrailColorIndex; //!< The palette index of the trail color of the Atom at the time of travel.
+		};
+
 #pragma region Creation
 		/// <summary>
 		/// Constructor method used to instantiate an Atom object in system memory. Create() should be called before using the object.
@@ -431,6 +501,12 @@ namespace RTE {
 		/// </summary>
 		void ChangedDir() { m_ChangedDir = true; }
 
+		/// <summary>
+		/// Gets whether the previous travel move's fractional error is invalid for consecutive travel moves, meaning the next travel move starts a fresh trajectory.
+		/// </summary>
+		/// <returns>Whether the next travel move starts a fresh trajectory.</returns>
+		bool HasChangedDir() const { return m_ChangedDir; }
+
 		/// <summary>
 		/// Uses the current state of the owning MovableObject to determine if there are any collisions in the path of its travel during this frame, and if so, apply all collision responses to the MO.
 		/// </summary>
@@ -439,6 +515,35 @@ namespace RTE {
 		/// <param name="scenePreLocked">Whether the Scene has been pre-locked or not.</param>
 		/// <returns>The number of hits against terrain that were made during the travel.</returns>
 		int Travel(float travelTime, bool autoTravel = true, bool scenePreLocked = false);
+
+		/// <summary>
+		/// Checks whether Travel() would step this Atom along its owning MovableObject's trajectory this frame without hitting the terrain or any MO.
+		/// This is read-only and conservative, any non-air terrain pixel or any MO pixel on the path makes it fail, regardless of ignored MOIDs or terrain.
+		/// </summary>
+		/// <param name="travelTime">The amount of time in s that this Atom is allowed to travel.</param>
+		/// <returns>Whether the travel path of this Atom is clear of anything it could collide with.</returns>
+		bool IsTravelPathClear(float travelTime) const;
+
+		/// <summary>
+		/// Sets the buffer that trails traveled on the calling thread are recorded to, instead of being drawn right away. This lets Atoms travel concurrently without touching the MO color layer.
+		/// </summary>
+		/// <param name="deferredTrailBuffer">The buffer to record trails to, or nullptr to draw trails right away again. Ownership is NOT transferred!</param>
+		static void SetDeferredTrailBuffer(std::vector<DeferredTrail> *deferredTrailBuffer) { s_DeferredTrailBuffer = deferredTrailBuffer; }
+
+		/// <summary>
+		/// Draws previously recorded trails to the MO color layer, in the order they were recorded. Must only be called from the main thread.
+		/// </summary>
+		/// <param name="deferredTrails">The recorded trails to draw.</param>
+		static void DrawDeferredTrails(const std::vector<DeferredTrail> &deferredTrails);
+
+		/// <summary>
+		/// Draws a traveled trail to the MO color layer and registers the drawing, with its length randomized according to the variation. Must only be called from the main thread.
+		/// </summary>
+		/// <param name="trailPoints">The pixel positions the Atom traveled through.</param>
+		/// <param name="trailLength">The longest the trail can get drawn.</param>
+		/// <param name="trailLengthVariation">What percentage the trail length can vary.</param>
+		/// <param name="trailColorIndex">The palette index of the color to draw the trail with.</param>
+		static void DrawTrail(const std::vector<std::pair<int, int>> &trailPoints, int trailLength, float trailLengthVariation, int trailColorIndex);
 #pragma endregion
 
 #pragma region Operator Overloads
@@ -472,6 +577,7 @@ namespace RTE {
 		static int s_PoolAllocBlockCount; //!< The number of instances to fill up the pool of Atoms with each time it runs dry.
 		static int s_InstancesInUse; //!< The number of allocated instances passed out from the pool.
 		static const int s_NormalChecks[c_NormalCheckCount][2]; //!< This forms a circle around the Atom's offset center, to check for key color pixels in order to determine the normal at the Atom's position.
+		static thread_local std::vector<DeferredTrail> *s_DeferredTrailBuffer; //!< The buffer trails traveled on this thread are recorded to instead of being drawn right away. Not owned.
 
 		Vector m_Offset; //!< The offset of this Atom for collision calculations.
 		Vector m_OriginalOffset; //!< This offset is before altering the m_Offset for use in composite groups.
@@ -160,6 +160,7 @@ namespace RTE {
 	static constexpr unsigned short c_FramesToRemember = 2;
 	static constexpr unsigned short c_MaxLayersStoredForNetwork = 5;
 	static constexpr unsigned short c_MaxPixelLineBufferSize = 8192;
+	static constexpr int c_MaxTerrainChangeAreaSize = 4096; //!< The maximum number of pixels a merged terrain change area can have, so any single one fits into a terrain change message even uncompressed.
 
 	// Defaults are picked so that if the box can't be compressed it should somewhat fit into one UDP packet.
 	// Reducing box area introduces slight overhead due to more messages and hence more headers being sent.
@@ -4,8 +4,12 @@
 #include "PresetMan.h"
 #include "ConsoleMan.h"
 #include "RTETools.h"
+#include "ThreadMan.h"
+#include "SettingsMan.h"
+#include "SpriteCache.h"
 
 #include "png.h"
+#include "allegro/internal/aintern.h"
 #include "fmod/fmod.hpp"
 #include "fmod/fmod_errors.h"
 
@@ -14,9 +18,32 @@ namespace RTE {
 	const std::string ContentFile::c_ClassName = "ContentFile";
 
 	std::array<std::unordered_map<std::string, BITMAP *>, ContentFile::BitDepths::BitDepthCount> ContentFile::s_LoadedBitmaps;
+	std::unordered_map<std::string, BITMAP *> ContentFile::s_PreloadedBitmaps;
 	std::unordered_map<std::string, FMOD::Sound *> ContentFile::s_LoadedSamples;
 	std::unordered_map<size_t, std::string> ContentFile::s_PathHashes;
 
+	struct ContentFile::DecodedImage {
+		int Width; //!< Width of the image, in pixels.
+		int Height; //!< Height of the image, in pixels.
+		int ColorDepth; //!< Color depth of the decoded pixels, in bits per pixel, before any conversion to the depth the BITMAP is loaded at.
+		size_t RowSize; //!< Size of each row of decoded pixels, in bytes.
+		std::vector<unsigned char> Pixels; //!< The decoded pixels, row after row.
+		std::array<RGB, PAL_SIZE> Palette; //!< The image's palette, or a 332 palette if it doesn't have one, used when converting an 8 bit image to another depth.
+	};
+
+	struct ContentFile::ImageDecode {
+		std::string DataPath; //!< The data path the decode was queued for.
+		std::string DataPathWithoutExtension; //!< The data path the decode was queued for, without the file's extension, to find any animation frames with.
+		std::array<bool, 2> SwapRedAndBlue; //!< Whether 24 and 32 bit images need their red and blue channels swapped, for each of the two depths. Worked out when queued, as it depends on the graphics mode.
+		std::atomic<bool> Started; //!< Whether decoding was started, either by the thread pool or by whoever needed the images before the thread pool got to them.
+		std::future<void> Task; //!< The thread pool task decoding the images.
+		std::vector<std::pair<std::string, std::unique_ptr<DecodedImage>>> DecodedFrames; //!< The decoded images and their data paths, once decoding is done.
+	};
+
+	std::unordered_map<std::string, std::shared_ptr<ContentFile::ImageDecode>> ContentFile::s_ImageDecodes;
+	std::unordered_map<std::string, std::unique_ptr<ContentFile::DecodedImage>> ContentFile::s_DecodedImages;
+	std::unique_ptr<SpriteCache> ContentFile::s_SpriteCache;
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void ContentFile::Clear() {
@@ -58,6 +85,9 @@ namespace RTE {
 				destroy_bitmap(bitmapPtr);
 			}
 		}
+		FreePreloadedBitmaps();
+		FreePrefetchedImages();
+		s_SpriteCache.reset();
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -65,7 +95,9 @@ namespace RTE {
 	int ContentFile::ReadProperty(const std::string_view &propName, Reader &reader) {
 		StartPropertyList(return Serializable::ReadProperty(propName, reader));
 		
-		MatchForwards("FilePath") MatchProperty("Path", { SetDataPath(reader.ReadPropValue()); });
+		MatchForwards("FilePath") MatchProperty("Path", {
+			SetDataPath(reader.ReadPropValue());
+		});
 		
 		
 		EndPropertyList;
@@ -213,6 +245,238 @@ namespace RTE {
 		g_ConsoleMan.PrintString("SYSTEM: Sprites reloaded");
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ContentFile::AddPreloadedBitmap(const std::string &dataPath, BITMAP *bitmap) {
+		auto [preloadedBitmap, inserted] = s_PreloadedBitmaps.try_emplace(g_PresetMan.GetFullModulePath(dataPath), bitmap);
+		if (!inserted) {
+			destroy_bitmap((*preloadedBitmap).second);
+			(*preloadedBitmap).second = bitmap;
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ContentFile::FreePreloadedBitmaps() {
+		for (const auto &[bitmapPath, bitmapPtr] : s_PreloadedBitmaps) {
+			destroy_bitmap(bitmapPtr);
+		}
+		s_PreloadedBitmaps.clear();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ContentFile::FreePrefetchedImages() {
+		for (const auto &[dataPath, imageDecode] : s_ImageDecodes) {
+			// Claiming decodes the thread pool didn't get to yet means they'll never be started, so only the running ones need waiting for.
+			if (imageDecode->Started.exchange(true)) { imageDecode->Task.wait(); }
+		}
+		s_ImageDecodes.clear();
+		s_DecodedImages.clear();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ContentFile::OpenSpriteCache() {
+		if (s_SpriteCache || !g_SettingsMan.IsSpriteCacheEnabled()) {
+			return;
+		}
+		s_SpriteCache = std::make_unique<SpriteCache>();
+		if (s_SpriteCache->Create() < 0) { s_SpriteCache.reset(); }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ContentFile::SaveSpriteCache() {
+		if (s_SpriteCache) { s_SpriteCache->Save(); }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ContentFile::QueueImageDecode() const {
+		if (m_DataPathExtension != ".png" || s_ImageDecodes.contains(m_DataPath)) {
+			return;
+		}
+		for (const std::string &dataPath : { m_DataPath, m_DataPathWithoutExtension + "000" + m_DataPathExtension }) {
+			// Sprites in the sprite cache are copied out of it rather than decoded, so there's nothing to decode ahead of time for them.
+			if (s_DecodedImages.contains(dataPath) || (s_SpriteCache && s_SpriteCache->HasSprite(dataPath)) || std::any_of(s_LoadedBitmaps.begin(), s_LoadedBitmaps.end(), [&dataPath](const auto &loadedBitmaps) { return loadedBitmaps.contains(dataPath); })) {
+				return;
+			}
+		}
+		// Allegro's PNG loader swaps red and blue whenever the BITMAP pixel format has blue in the lowest byte.
+		auto isRedAndBlueSwapped = [](int colorDepth) {
+			int blueColor = makecol_depth(colorDepth, 0, 0, 255);
+			return reinterpret_cast<const unsigned char *>(&blueColor)[0] == 255;
+		};
+
+		std::shared_ptr<ImageDecode> imageDecode = std::make_shared<ImageDecode>();
+		imageDecode->DataPath = m_DataPath;
+		imageDecode->DataPathWithoutExtension = m_DataPathWithoutExtension;
+		imageDecode->SwapRedAndBlue = { isRedAndBlueSwapped(24), isRedAndBlueSwapped(32) };
+		imageDecode->Started = false;
+		imageDecode->Task = g_ThreadMan.GetPriorityThreadPool().submit([imageDecode]() {
+			if (!imageDecode->Started.exchange(true)) { DecodeImageFrames(*imageDecode); }
+		});
+		s_ImageDecodes.try_emplace(m_DataPath, std::move(imageDecode));
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	BITMAP * ContentFile::TakeDecodedImage(const std::string &dataPath) {
+		auto decodedImageEntry = s_DecodedImages.find(dataPath);
+		if (decodedImageEntry == s_DecodedImages.end()) {
+			auto imageDecodeEntry = s_ImageDecodes.find(dataPath);
+			if (imageDecodeEntry == s_ImageDecodes.end()) {
+				// Animation frames are decoded along with the path the decode was queued for, e.g. "Sprite003.png" along with "Sprite.png".
+				std::string dataPathExtension = std::filesystem::path(dataPath).extension().string();
+				std::string dataPathWithoutExtension = dataPath.substr(0, dataPath.length() - dataPathExtension.length());
+				if (dataPathWithoutExtension.length() > 3 && std::all_of(dataPathWithoutExtension.end() - 3, dataPathWithoutExtension.end(), ::isdigit)) {
+					imageDecodeEntry = s_ImageDecodes.find(dataPathWithoutExtension.substr(0, dataPathWithoutExtension.length() - 3) + dataPathExtension);
+				}
+			}
+			if (imageDecodeEntry == s_ImageDecodes.end()) {
+				return nullptr;
+			}
+			std::shared_ptr<ImageDecode> imageDecode = imageDecodeEntry->second;
+			s_ImageDecodes.erase(imageDecodeEntry);
+
+			// If the thread pool didn't get to it yet, decode it right here rather than wait for the tasks queued before it.
+			if (!imageDecode->Started.exchange(true)) {
+				DecodeImageFrames(*imageDecode);
+			} else {
+				imageDecode->Task.wait();
+			}
+			for (auto &[framePath, decodedFrame] : imageDecode->DecodedFrames) {
+				s_DecodedImages.insert_or_assign(framePath, std::move(decodedFrame));
+			}
+			decodedImageEntry = s_DecodedImages.find(dataPath);
+			if (decodedImageEntry == s_DecodedImages.end()) {
+				return nullptr;
+			}
+		}
+		std::unique_ptr<DecodedImage> decodedImage = std::move(decodedImageEntry->second);
+		s_DecodedImages.erase(decodedImageEntry);
+
+		// Creating the BITMAP and converting it to the depth it's loaded at is what Allegro's PNG loader does after decoding, and neither can be done on the thread pool.
+		BITMAP *returnBitmap = create_bitmap_ex(decodedImage->ColorDepth, decodedImage->Width, decodedImage->Height);
+		if (!returnBitmap) {
+			return nullptr;
+		}
+		for (int y = 0; y < decodedImage->Height; ++y) {
+			std::memcpy(returnBitmap->line[y], decodedImage->Pixels.data() + y * decodedImage->RowSize, decodedImage->RowSize);
+		}
+		if (int loadedColorDepth = _color_load_depth(decodedImage->ColorDepth, decodedImage->ColorDepth == 32); loadedColorDepth != decodedImage->ColorDepth) {
+			returnBitmap = _fixup_loaded_bitmap(returnBitmap, decodedImage->Palette.data(), loadedColorDepth);
+		}
+		return returnBitmap;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ContentFile::DecodeImageFrames(ImageDecode &imageDecode) {
+		auto decodeFrame = [&imageDecode](const std::string &framePath) {
+			std::error_code errorCode;
+			if (!std::filesystem::is_regular_file(framePath, errorCode)) {
+				return false;
+			}
+			// Frames that fail to decode are left out, so loading them from disk reports the error as usual.
+			std::unique_ptr<DecodedImage> decodedImage = std::make_unique<DecodedImage>();
+			if (DecodePNGFile(framePath, imageDecode.SwapRedAndBlue, *decodedImage)) { imageDecode.DecodedFrames.emplace_back(framePath, std::move(decodedImage)); }
+			return true;
+		};
+		decodeFrame(imageDecode.DataPath);
+
+		char framePath[1024];
+		for (int frameNum = 0; frameNum < 1000; ++frameNum) {
+			std::snprintf(framePath, sizeof(framePath), "%s%03i%s", imageDecode.DataPathWithoutExtension.c_str(), frameNum, ".png");
+			if (!decodeFrame(framePath)) {
+				break;
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool ContentFile::DecodePNGFile(const std::string &filePath, const std::array<bool, 2> &swapRedAndBlue, DecodedImage &decodedImage) {
+		FILE *imageFile = fopen(filePath.c_str(), "rb");
+		if (!imageFile) {
+			return false;
+		}
+		png_structp pngReadStruct = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+		png_infop pngInfo = pngReadStruct ? png_create_info_struct(pngReadStruct) : nullptr;
+		if (!pngInfo) {
+			png_destroy_read_struct(&pngReadStruct, nullptr, nullptr);
+			fclose(imageFile);
+			return false;
+		}
+		// libpng reports errors by jumping back here, so nothing that needs destroying can be created on the stack from here on.
+		if (setjmp(png_jmpbuf(pngReadStruct))) {
+			png_destroy_read_struct(&pngReadStruct, &pngInfo, nullptr);
+			fclose(imageFile);
+			return false;
+		}
+		png_init_io(pngReadStruct, imageFile);
+		png_read_info(pngReadStruct, pngInfo);
+
+		png_uint_32 width = 0;
+		png_uint_32 height = 0;
+		int bitDepth = 0;
+		int colorType = 0;
+		png_get_IHDR(pngReadStruct, pngInfo, &width, &height, &bitDepth, &colorType, nullptr, nullptr, nullptr);
+
+		// These are the same transformations Allegro's PNG loader applies, so the decoded pixels are exactly what it would have loaded.
+		png_set_packing(pngReadStruct);
+		if (colorType == PNG_COLOR_TYPE_GRAY && bitDepth < 8) { png_set_expand(pngReadStruct); }
+		if (png_get_valid(pngReadStruct, pngInfo, PNG_INFO_tRNS)) { png_set_tRNS_to_alpha(pngReadStruct); }
+		if (bitDepth == 16) { png_set_strip_16(pngReadStruct); }
+		if (colorType == PNG_COLOR_TYPE_GRAY || colorType == PNG_COLOR_TYPE_GRAY_ALPHA) { png_set_gray_to_rgb(pngReadStruct); }
+		if (_png_screen_gamma != 0.0) {
+			const char *screenGammaString = (_png_screen_gamma == -1.0) ? std::getenv("SCREEN_GAMMA") : nullptr;
+			double screenGamma = (_png_screen_gamma == -1.0) ? (screenGammaString ? std::atof(screenGammaString) : 2.2) : _png_screen_gamma;
+			int renderingIntent = 0;
+			double imageGamma = 0.45455;
+			if (!png_get_sRGB(pngReadStruct, pngInfo, &renderingIntent)) { png_get_gAMA(pngReadStruct, pngInfo, &imageGamma); }
+			png_set_gamma(pngReadStruct, screenGamma, imageGamma);
+		}
+		int passCount = png_set_interlace_handling(pngReadStruct);
+		png_read_update_info(pngReadStruct, pngInfo);
+
+		png_colorp palette = nullptr;
+		int paletteSize = 0;
+		if (!(colorType & PNG_COLOR_MASK_PALETTE)) {
+			generate_332_palette(decodedImage.Palette.data());
+		} else if (png_get_PLTE(pngReadStruct, pngInfo, &palette, &paletteSize)) {
+			for (int i = 0; i < PAL_SIZE; ++i) {
+				decodedImage.Palette[i].r = (i < paletteSize) ? palette[i].red >> 2 : 0;
+				decodedImage.Palette[i].g = (i < paletteSize) ? palette[i].green >> 2 : 0;
+				decodedImage.Palette[i].b = (i < paletteSize) ? palette[i].blue >> 2 : 0;
+				decodedImage.Palette[i].filler = 0;
+			}
+		}
+
+		decodedImage.Width = static_cast<int>(width);
+		decodedImage.Height = static_cast<int>(height);
+		decodedImage.RowSize = png_get_rowbytes(pngReadStruct, pngInfo);
+		decodedImage.ColorDepth = std::max(static_cast<int>(decodedImage.RowSize * 8 / width), 8);
+		if (decodedImage.ColorDepth == 24 || decodedImage.ColorDepth == 32) {
+			if (swapRedAndBlue[decodedImage.ColorDepth == 32 ? 1 : 0]) { png_set_bgr(pngReadStruct); }
+#ifdef ALLEGRO_BIG_ENDIAN
+			png_set_swap_alpha(pngReadStruct);
+#endif
+		}
+		decodedImage.Pixels.resize(decodedImage.RowSize * height);
+		for (int pass = 0; pass < passCount; ++pass) {
+			for (png_uint_32 y = 0; y < height; ++y) {
+				png_read_row(pngReadStruct, decodedImage.Pixels.data() + y * decodedImage.RowSize, nullptr);
+			}
+		}
+		png_read_end(pngReadStruct, pngInfo);
+
+		png_destroy_read_struct(&pngReadStruct, &pngInfo, nullptr);
+		fclose(imageFile);
+		return true;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	BITMAP * ContentFile::GetAsBitmap(int conversionMode, bool storeBitmap, const std::string &dataPathToSpecificFrame) {
@@ -229,8 +493,15 @@ namespace RTE {
 
 		// Check if the file has already been read and loaded from the disk and, if so, use that data.
 		std::unordered_map<std::string, BITMAP *>::iterator foundBitmap = s_LoadedBitmaps[bitDepth].find(dataPathToLoad);
+		std::unordered_map<std::string, BITMAP *>::iterator preloadedBitmap = s_PreloadedBitmaps.find(dataPathToLoad);
 		if (storeBitmap && foundBitmap != s_LoadedBitmaps[bitDepth].end()) {
 			returnBitmap = (*foundBitmap).second;
+		} else if (preloadedBitmap != s_PreloadedBitmaps.end()) {
+			// Preloaded bitmaps are handed out once and as they are, so they keep their own color depth regardless of the conversion mode.
+			returnBitmap = (*preloadedBitmap).second;
+			s_PreloadedBitmaps.erase(preloadedBitmap);
+
+			if (storeBitmap) { s_LoadedBitmaps[bitDepth].try_emplace(dataPathToLoad, returnBitmap); }
 		} else {
 			if (!System::PathExistsCaseSensitive(dataPathToLoad)) {
 				const std::string dataPathWithoutExtension = dataPathToLoad.substr(0, dataPathToLoad.length() - m_DataPathExtension.length());
@@ -296,9 +567,17 @@ namespace RTE {
 		get_palette(currentPalette);
 
 		set_color_conversion((conversionMode == COLORCONV_NONE) ? COLORCONV_MOST : conversionMode);
-		returnBitmap = load_bitmap(dataPathToLoad.c_str(), currentPalette);
-		RTEAssert(returnBitmap, "Failed to load image file with following path and name:\n\n" + m_DataPathAndReaderPosition + "\nThe file may be corrupt, incorrectly converted or saved with unsupported parameters.");
-		AddAlphaChannel(returnBitmap);
+
+		// Cached sprites were stored after their alpha channel was added, so they're handed out as they are.
+		returnBitmap = s_SpriteCache ? s_SpriteCache->CreateBitmap(dataPathToLoad, conversionMode) : nullptr;
+		if (!returnBitmap) {
+			returnBitmap = TakeDecodedImage(dataPathToLoad);
+			if (!returnBitmap) { returnBitmap = load_bitmap(dataPathToLoad.c_str(), currentPalette); }
+			RTEAssert(returnBitmap, "Failed to load image file with following path and name:\n\n" + m_DataPathAndReaderPosition + "\nThe file may be corrupt, incorrectly converted or saved with unsupported parameters.");
+			AddAlphaChannel(returnBitmap);
+
+			if (s_SpriteCache) { s_SpriteCache->AddBitmap(dataPathToLoad, conversionMode, returnBitmap); }
+		}
 
 		return returnBitmap;
 	}
@@ -8,6 +8,8 @@ struct BITMAP;
 
 namespace RTE {
 
+	class SpriteCache;
+
 	/// <summary>
 	/// A representation of a content file that is stored directly on disk.
 	/// </summary>
@@ -147,6 +149,39 @@ namespace RTE {
 		/// </summary>
 		static void ReloadAllBitmaps();
 
+		/// <summary>
+		/// Adds a BITMAP that was read from somewhere other than a file of its own, e.g. a save game archive, so the next time a BITMAP is gotten from its data path this one is handed out instead of loading the path from disk. Ownership IS transferred!
+		/// </summary>
+		/// <param name="dataPath">The data path the BITMAP is gotten from.</param>
+		/// <param name="bitmap">The BITMAP to hand out.</param>
+		static void AddPreloadedBitmap(const std::string &dataPath, BITMAP *bitmap);
+
+		/// <summary>
+		/// Destroys all the preloaded BITMAPs that weren't handed out.
+		/// </summary>
+		static void FreePreloadedBitmaps();
+
+		/// <summary>
+		/// Drops all the images that were decoded ahead of time but never gotten as BITMAPs, waiting for any that are still being decoded first.
+		/// </summary>
+		static void FreePrefetchedImages();
+
+		/// <summary>
+		/// Maps the sprite cache file into memory, so sprites that were loaded on previous launches are copied out of it instead of being decoded from their image files again. Does nothing if the sprite cache is disabled or already open.
+		/// </summary>
+		static void OpenSpriteCache();
+
+		/// <summary>
+		/// Writes the sprite cache file if any sprite was added to or dropped from it since it was mapped.
+		/// </summary>
+		static void SaveSpriteCache();
+
+		/// <summary>
+		/// Queues the image at this ContentFile's path to be decoded on the thread pool, along with all the frames of the animation it may be, unless they're already loaded or queued.
+		/// Owners that get their image as BITMAPs while the data modules are being loaded call this as soon as they read the path, so the images are decoded while the rest of the data files are being read, and getting them later only has to wait for whatever is left of the decoding.
+		/// </summary>
+		void QueueImageDecode() const;
+
 		/// <summary>
 		/// Gets the data represented by this ContentFile object as an Allegro BITMAP, loading it into the static maps if it's not already loaded. Note that ownership of the BITMAP is NOT transferred!
 		/// </summary>
@@ -200,6 +235,21 @@ namespace RTE {
 		static std::unordered_map<size_t, std::string> s_PathHashes; //!< Static map containing the hash values of paths of all loaded data files.
 		static std::array<std::unordered_map<std::string, BITMAP *>, BitDepths::BitDepthCount> s_LoadedBitmaps; //!< Static map containing all the already loaded BITMAPs and their paths for each bit depth.
 		static std::unordered_map<std::string, FMOD::Sound *> s_LoadedSamples; //!< Static map containing all the already loaded FSOUND_SAMPLEs and their paths.
+		static std::unordered_map<std::string, BITMAP *> s_PreloadedBitmaps; //!< Static map containing the preloaded BITMAPs that weren't handed out yet and their data paths. Owned until handed out.
+
+		/// <summary>
+		/// The pixels and palette of an image decoded on the thread pool, ready to be put into a BITMAP.
+		/// </summary>
+		struct DecodedImage;
+
+		/// <summary>
+		/// An image, or all the frames of an animation, queued to be decoded on the thread pool.
+		/// </summary>
+		struct ImageDecode;
+
+		static std::unordered_map<std::string, std::shared_ptr<ImageDecode>> s_ImageDecodes; //!< Static map containing the image decodes that were queued but not yet collected, and the data paths they were queued for.
+		static std::unordered_map<std::string, std::unique_ptr<DecodedImage>> s_DecodedImages; //!< Static map containing the collected decoded images that weren't gotten as BITMAPs yet, and their data paths.
+		static std::unique_ptr<SpriteCache> s_SpriteCache; //!< The sprite cache BITMAPs are loaded through, or nullptr if it's disabled or not open.
 
 		std::string m_DataPath; //!< The path to this ContentFile's data file. In the case of an animation, this filename/name will be appended with 000, 001, 002 etc.
 		std::string m_DataPathExtension; //!< The extension of the data file of this ContentFile's path.
@@ -234,6 +284,30 @@ namespace RTE {
 		void ReadAndStoreBMPFileInfo(FILE *imageFile);
 #pragma endregion
 
+#pragma region Image Decoding
+		/// <summary>
+		/// Takes an image decoded ahead of time and puts it into a new BITMAP, the same way Allegro would have loaded it from disk, using the color conversion mode that is currently set. Ownership of the BITMAP IS transferred!
+		/// </summary>
+		/// <param name="dataPath">The data path of the image, or of the specific animation frame, to take.</param>
+		/// <returns>Pointer to the new BITMAP, or nullptr if the image wasn't decoded ahead of time and needs to be loaded from disk.</returns>
+		static BITMAP * TakeDecodedImage(const std::string &dataPath);
+
+		/// <summary>
+		/// Decodes the image an ImageDecode was queued for, along with all the frames of the animation it may be. Only uses libpng and the disk, so it can be done on any thread.
+		/// </summary>
+		/// <param name="imageDecode">The ImageDecode to decode the images of.</param>
+		static void DecodeImageFrames(ImageDecode &imageDecode);
+
+		/// <summary>
+		/// Decodes a PNG file into pixels and a palette, applying the same transformations Allegro's PNG loader does. Only uses libpng and the disk, so it can be done on any thread.
+		/// </summary>
+		/// <param name="filePath">Path to the PNG file to decode.</param>
+		/// <param name="swapRedAndBlue">Whether 24 and 32 bit images should have their red and blue channels swapped to match the pixel format of BITMAPs at those depths, for each of the two depths.</param>
+		/// <param name="decodedImage">Reference to the DecodedImage to fill.</param>
+		/// <returns>Whether the file was decoded successfully.</returns>
+		static bool DecodePNGFile(const std::string &filePath, const std::array<bool, 2> &swapRedAndBlue, DecodedImage &decodedImage);
+#pragma endregion
+
 #pragma region Data Handling
 		/// <summary>
 		/// Loads and transfers the data represented by this ContentFile object as an Allegro BITMAP. Ownership of the BITMAP IS transferred!
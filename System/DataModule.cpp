@@ -1,5 +1,7 @@
 #include "DataModule.h"
+#include "ReaderCache.h"
 #include "PresetMan.h"
+#include "SettingsMan.h"
 #include "SceneMan.h"
 #include "LuaMan.h"
 #include "GameVersion.h"
@@ -26,6 +28,7 @@ namespace RTE {
 		m_PresetList.clear();
 		m_EntityList.clear();
 		m_TypeMap.clear();
+		m_ExactTypePresets.clear();
 		m_MaterialMappings.fill(0);
 		m_ScanFolderContents = false;
 		m_IgnoreMissingItems = false;
@@ -37,7 +40,7 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	int DataModule::Create(const std::string &moduleName, const ProgressCallback &progressCallback) {
+	int DataModule::Create(const std::string &moduleName, const ProgressCallback &progressCallback, ReaderCache *moduleCache) {
 		m_FileName = std::filesystem::path(moduleName).generic_string();
 		m_ModuleID = g_PresetMan.GetModuleID(moduleName);
 		m_CrabToHumanSpawnRatio = 0;
@@ -57,17 +60,29 @@ namespace RTE {
 			CheckSupportedGameVersion();
 		}
 
+		// Every data file this module reads is opened through its cache, which is only written back once the whole module was read successfully.
+		std::unique_ptr<ReaderCache> ownModuleCache;
+		if (!moduleCache && g_SettingsMan.IsDataModuleCacheEnabled()) {
+			ownModuleCache = std::make_unique<ReaderCache>();
+			if (ownModuleCache->Create(m_FileName) >= 0) { moduleCache = ownModuleCache.get(); }
+		}
+		bool useModuleCache = moduleCache != nullptr;
+		if (useModuleCache) { ReaderCache::SetActiveCache(moduleCache); }
+
+		int result = -1;
 		if (reader.Create(indexPath, true, progressCallback) >= 0) {
-			int result = Serializable::Create(reader);
+			result = Serializable::Create(reader);
 
 			// Print an empty line to separate the end of a module from the beginning of the next one in the loading progress log.
 			if (progressCallback) { progressCallback(" ", true); }
 
 			if (m_ScanFolderContents) { result = FindAndRead(progressCallback); }
-
-			return result;
 		}
-		return -1;
+		if (useModuleCache) {
+			ReaderCache::SetActiveCache(nullptr);
+			if (result >= 0) { moduleCache->Save(); }
+		}
+		return result;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -250,18 +265,7 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	const Entity * DataModule::GetEntityPreset(const std::string &exactType, const std::string &instance) {
-		if (exactType.empty() || instance == "None" || instance.empty()) {
-			return nullptr;
-		}
-		if (auto classItr = m_TypeMap.find(exactType); classItr != m_TypeMap.end()) {
-			// Find an instance of that EXACT type and name; derived types are not matched
-			for (const auto &[instanceName, entity] : classItr->second) {
-				if (instanceName == instance && entity->GetClassName() == exactType) {
-					return entity;
-				}
-			}
-		}
-		return nullptr;
+		return GetEntityIfExactType(exactType, instance);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -357,31 +361,25 @@ namespace RTE {
 		}
 		bool foundAny = false;
 
+		// Match groups by their interned IDs, so each Entity is checked with a single bitset AND instead of a string lookup per group. Same as Entity::IsInGroup, "All" and "Any" match everything and "None" matches nothing.
+		bool matchAllGroups = false;
+		Entity::GroupMask groupMask;
+		for (const std::string &group : groups) {
+			if (group == "All" || group == "Any") {
+				matchAllGroups = true;
+			} else if (int groupID = Entity::FindGroupID(group); group != "None" && groupID >= 0) {
+				Entity::AddToGroupMask(groupMask, groupID);
+			}
+		}
+
 		// Find either the Entity typelist that contains all entities in this DataModule, or the specific class' typelist (which will get all derived classes too).
 		if (auto classItr = m_TypeMap.find((type.empty() || type == "All") ? "Entity" : type); classItr != m_TypeMap.end()) {
 			RTEAssert(!classItr->second.empty(), "DataModule has class entry without instances in its map!?");
 
 			for (const auto &[instanceName, entity] : classItr->second) {
-				if (excludeGroups) {
-					bool excludeEntity = false;
-					for (const std::string &group : groups) {
-						if (entity->IsInGroup(group)) {
-							excludeEntity = true;
-							break;
-						}
-					}
-					if (!excludeEntity) {
-						entityList.emplace_back(entity);
-						foundAny = true;
-					}
-				} else {
-					for (const std::string &group : groups) {
-						if (entity->IsInGroup(group)) {
-							entityList.emplace_back(entity);
-							foundAny = true;
-							break;
-						}
-					}
+				if ((matchAllGroups || entity->IsInAnyGroup(groupMask)) != excludeGroups) {
+					entityList.emplace_back(entity);
+					foundAny = true;
 				}
 			}
 		}
@@ -460,19 +458,17 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	// TODO: This method is almost identical to GetEntityPreset, except it doesn't return a const Entity *.
+	// TODO: GetEntityPreset just forwards to this method, except it returns a const Entity *.
 	// Investigate if the latter needs to return const (based on what's using it) and if not, get rid of this and replace its uses. At the very least, consider renaming this
 	// See https://github.com/cortex-command-community/Cortex-Command-Community-Project-Source/issues/87
 	Entity * DataModule::GetEntityIfExactType(const std::string &exactType, const std::string &presetName) {
 		if (exactType.empty() || presetName == "None" || presetName.empty()) {
 			return nullptr;
 		}
-		if (auto classItr = m_TypeMap.find(exactType); classItr != m_TypeMap.end()) {
-			// Find an instance of that EXACT type and name; derived types are not matched
-			for (const auto &[instanceName, entity] : classItr->second) {
-				if (instanceName == presetName && entity->GetClassName() == exactType) {
-					return entity;
-				}
+		// Only instances of that EXACT type and name are indexed; derived types are not matched
+		if (auto classItr = m_ExactTypePresets.find(exactType); classItr != m_ExactTypePresets.end()) {
+			if (auto presetItr = classItr->second.find(presetName); presetItr != classItr->second.end()) {
+				return presetItr->second;
 			}
 		}
 		return nullptr;
@@ -491,12 +487,14 @@ namespace RTE {
 
 			// No instances of this entity have been added yet so add a class category for it
 			if (classItr == m_TypeMap.end()) {
-				classItr = (m_TypeMap.insert(std::pair<std::string, std::list<std::pair<std::string, Entity *>>>(pClass->GetName(), std::list<std::pair<std::string, Entity *>>()))).first;
+				classItr = m_TypeMap.try_emplace(pClass->GetName()).first;
 			}
 
 			// NOTE We're adding the entity to the class category list but not transferring ownership. Also, we're not checking for collisions as they're assumed to have been checked for already
 			(*classItr).second.push_back(std::pair<std::string, Entity *>(entityToAdd->GetPresetName(), entityToAdd));
 		}
+		m_ExactTypePresets[entityToAdd->GetClassName()].try_emplace(entityToAdd->GetPresetName(), entityToAdd);
+		g_PresetMan.AddToPresetIndex(entityToAdd, m_ModuleID);
 		return true;
 	}
 
@@ -14,6 +14,7 @@ namespace version {
 namespace RTE {
 
 	class Entity;
+	class ReaderCache;
 
 	/// <summary>
 	/// A representation of a DataModule containing zero or many Material, Effect, Ammo, Device, Actor, or Scene definitions.
@@ -57,8 +58,9 @@ namespace RTE {
 		/// </summary>
 		/// <param name="moduleName">A string defining the name of this DataModule, e.g. "MyModule.rte".</param>
 		/// <param name="progressCallback">A function pointer to a function that will be called and sent a string with information about the progress of this DataModule's creation.</param>
+		/// <param name="moduleCache">A ReaderCache for this DataModule that was already created, and possibly validated, ahead of time. If nullptr, one is created here if the DataModule cache is enabled. Ownership is NOT transferred!</param>
 		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
-		int Create(const std::string &moduleName, const ProgressCallback &progressCallback = nullptr);
+		int Create(const std::string &moduleName, const ProgressCallback &progressCallback = nullptr, ReaderCache *moduleCache = nullptr);
 
 		/// <summary>
 		/// Creates a new DataModule directory with "Index.ini" on disk to be used for userdata. Does NOT instantiate the newly created DataModule.
@@ -350,9 +352,15 @@ namespace RTE {
 		/// Map of class names and map of instance template names and actual Entity instances that were read for this DataModule.
 		/// An Entity instance of a derived type will be placed in EACH of EVERY of its parent class' maps here.
 		/// There can be multiple entries of the same instance name in any of the type sub-maps, but only ONE whose exact class is that of the type-list!
+		/// The type-lists are contiguous so group and type queries over them don't have to chase list nodes. The Entity instances are NOT owned by this map.
+		/// </summary>
+		std::unordered_map<std::string, std::vector<std::pair<std::string, Entity *>>> m_TypeMap;
+
+		/// <summary>
+		/// Map of exact class names to maps of preset names and the one Entity instance of that exact class and name in this DataModule, so presets can be looked up without walking the type-lists.
 		/// The Entity instances are NOT owned by this map.
 		/// </summary>
-		std::unordered_map<std::string, std::list<std::pair<std::string, Entity *>>> m_TypeMap;
+		std::unordered_map<std::string, std::unordered_map<std::string, Entity *>> m_ExactTypePresets;
 
 	private:
 
@@ -8,6 +8,13 @@ namespace RTE {
 
 	Entity::ClassInfo Entity::m_sClass("Entity");
 	Entity::ClassInfo * Entity::ClassInfo::s_ClassHead = 0;
+	int Entity::ClassInfo::s_ConcreteClassCount = 0;
+	thread_local Entity::ClassInfo::ThreadMagazines Entity::ClassInfo::s_ThreadMagazines;
+	thread_local bool Entity::ClassInfo::s_ThreadMagazinesDestroyed = false;
+
+	// Groups can be added from Lua on any thread, so the interned group IDs are shared behind a lock. Lookups of groups that already exist only need a shared one.
+	std::unordered_map<std::string, int> s_GroupIDs;
+	std::shared_mutex s_GroupIDsMutex;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -17,6 +24,7 @@ namespace RTE {
 		m_DefinedInModule = -1;
 		m_PresetDescription.clear();
 		m_Groups.clear();
+		m_GroupMask.clear();
 		m_RandomWeight = 100;
 	}
 
@@ -37,6 +45,10 @@ namespace RTE {
 		for (const std::string &group : reference.m_Groups) {
 			m_Groups.emplace(group);
 		}
+		if (m_GroupMask.size() < reference.m_GroupMask.size()) { m_GroupMask.resize(reference.m_GroupMask.size(), 0); }
+		for (size_t maskWord = 0; maskWord < reference.m_GroupMask.size(); ++maskWord) {
+			m_GroupMask[maskWord] |= reference.m_GroupMask[maskWord];
+		}
 		m_RandomWeight = reference.m_RandomWeight;
 		return 0;
 	}
@@ -101,6 +113,54 @@ namespace RTE {
 		EndPropertyList;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int Entity::GetGroupID(const std::string &group) {
+		if (int groupID = FindGroupID(group); groupID >= 0) {
+			return groupID;
+		}
+		std::unique_lock groupIDsLock(s_GroupIDsMutex);
+		return s_GroupIDs.try_emplace(group, static_cast<int>(s_GroupIDs.size())).first->second;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int Entity::FindGroupID(const std::string &group) {
+		std::shared_lock groupIDsLock(s_GroupIDsMutex);
+		auto groupIDEntry = s_GroupIDs.find(group);
+		return groupIDEntry != s_GroupIDs.end() ? groupIDEntry->second : -1;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Entity::AddToGroupMask(GroupMask &groupMask, int groupID) {
+		size_t maskWord = static_cast<size_t>(groupID) / 64;
+		if (groupMask.size() <= maskWord) { groupMask.resize(maskWord + 1, 0); }
+		groupMask[maskWord] |= uint64_t(1) << (groupID % 64);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Entity::RemoveFromGroup(const std::string &groupToRemoveFrom) {
+		if (m_Groups.erase(groupToRemoveFrom) > 0) {
+			if (int groupID = FindGroupID(groupToRemoveFrom); groupID >= 0 && static_cast<size_t>(groupID) / 64 < m_GroupMask.size()) {
+				m_GroupMask[static_cast<size_t>(groupID) / 64] &= ~(uint64_t(1) << (groupID % 64));
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool Entity::IsInAnyGroup(const GroupMask &groupMask) const {
+		size_t sharedWords = std::min(m_GroupMask.size(), groupMask.size());
+		for (size_t maskWord = 0; maskWord < sharedWords; ++maskWord) {
+			if (m_GroupMask[maskWord] & groupMask[maskWord]) {
+				return true;
+			}
+		}
+		return false;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	int Entity::Save(Writer &writer) const {
@@ -213,19 +273,41 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	Entity::ClassInfo::ClassInfo(const std::string &name, ClassInfo *parentInfo, MemoryAllocate allocFunc, MemoryDeallocate deallocFunc, Entity * (*newFunc)(), int allocBlockCount) :
+	Entity::ClassInfo::ClassInfo(const std::string &name, ClassInfo *parentInfo, MemoryAllocate allocFunc, MemoryDeallocate deallocFunc, Entity * (*newFunc)(), int allocBlockCount, size_t instanceSize) :
 		m_Name(name),
 		m_ParentInfo(parentInfo),
 		m_Allocate(allocFunc),
 		m_Deallocate(deallocFunc),
 		m_NewInstance(newFunc),
-		m_NextClass(s_ClassHead) {
+		m_NextClass(s_ClassHead),
+		m_SharedFreeList(nullptr),
+		m_InstancesInUse(0),
+		m_SlabCount(0),
+		m_ChunksReserved(0),
+		m_SharedListRefills(0),
+		m_MagazineSpills(0) {
 			s_ClassHead = this;
 
-			m_AllocatedPool.clear();
+			m_PoolIndex = IsConcrete() ? s_ConcreteClassCount++ : -1;
+			// Round chunks up to the strictest fundamental alignment, same as what malloc guarantees for each instance, so every chunk carved out of a slab is properly aligned.
+			constexpr size_t chunkAlignment = alignof(std::max_align_t);
+			m_BlockSize = (instanceSize > 0) ? ((std::max(instanceSize, sizeof(FreeBlock)) + chunkAlignment - 1) / chunkAlignment) * chunkAlignment : 0;
 			m_PoolAllocBlockCount = (allocBlockCount > 0) ? allocBlockCount : 10;
 		}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	Entity::ClassInfo::ThreadMagazines::~ThreadMagazines() {
+		for (ClassInfo *itr = s_ClassHead; itr != nullptr; itr = itr->m_NextClass) {
+			if (itr->m_PoolIndex >= 0 && itr->m_PoolIndex < static_cast<int>(Magazines.size())) {
+				const std::vector<void *> &magazine = Magazines[itr->m_PoolIndex];
+				itr->PushToSharedFreeList(magazine.data(), magazine.size());
+			}
+		}
+		Magazines.clear();
+		s_ThreadMagazinesDestroyed = true;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	std::list<std::string> Entity::ClassInfo::GetClassNames() {
@@ -266,10 +348,58 @@ namespace RTE {
 
 		// If concrete class, fill up the pool with pre-allocated memory blocks the size of the type
 		if (m_Allocate && fillAmount > 0) {
-			for (int i = 0; i < fillAmount; ++i) {
-				m_AllocatedPool.push_back(m_Allocate());
+			std::vector<void *> newChunks;
+			AllocateSlab(fillAmount, newChunks);
+			PushToSharedFreeList(newChunks.data(), newChunks.size());
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::vector<void *> & Entity::ClassInfo::GetThreadMagazine() {
+		std::vector<std::vector<void *>> &magazines = s_ThreadMagazines.Magazines;
+		if (magazines.size() <= static_cast<size_t>(m_PoolIndex)) { magazines.resize(s_ConcreteClassCount); }
+		return magazines[m_PoolIndex];
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Entity::ClassInfo::AllocateSlab(int chunkCount, std::vector<void *> &chunks) {
+		chunks.reserve(chunks.size() + chunkCount);
+		if (m_BlockSize > 0) {
+			// Slabs are never freed, same as the individually allocated instances of old, since their chunks can end up scattered over any number of threads' magazines.
+			char *slab = static_cast<char *>(malloc(m_BlockSize * chunkCount));
+			RTEAssert(slab, "Failed to allocate a pool memory slab for " + m_Name + "!");
+			for (int i = 0; i < chunkCount; ++i) {
+				chunks.push_back(slab + (i * m_BlockSize));
+			}
+			m_SlabCount.fetch_add(1, std::memory_order_relaxed);
+		} else {
+			for (int i = 0; i < chunkCount; ++i) {
+				chunks.push_back(m_Allocate());
 			}
 		}
+		m_ChunksReserved.fetch_add(chunkCount, std::memory_order_relaxed);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Entity::ClassInfo::PushToSharedFreeList(void * const *chunks, size_t chunkCount) {
+		if (chunkCount == 0) {
+			return;
+		}
+		FreeBlock *firstBlock = static_cast<FreeBlock *>(chunks[0]);
+		FreeBlock *lastBlock = firstBlock;
+		for (size_t i = 1; i < chunkCount; ++i) {
+			FreeBlock *block = static_cast<FreeBlock *>(chunks[i]);
+			lastBlock->Next = block;
+			lastBlock = block;
+		}
+
+		FreeBlock *sharedHead = m_SharedFreeList.load(std::memory_order_relaxed);
+		do {
+			lastBlock->Next = sharedHead;
+		} while (!m_SharedFreeList.compare_exchange_weak(sharedHead, firstBlock, std::memory_order_release, std::memory_order_relaxed));
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -286,45 +416,107 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void * Entity::ClassInfo::GetPoolMemory() {
-		std::lock_guard<std::mutex> guard(m_Mutex);
-
 		RTEAssert(IsConcrete(), "Trying to get pool memory of an abstract Entity class!");
 
-		// If the pool is empty, then fill it up again with as many instances as we are set to
-		if (m_AllocatedPool.empty()) { FillPool((m_PoolAllocBlockCount > 0) ? m_PoolAllocBlockCount : 10); }
+		void *foundMemory = nullptr;
+		if (!s_ThreadMagazinesDestroyed) {
+			std::vector<void *> &magazine = GetThreadMagazine();
+			if (magazine.empty()) {
+				// Take everything other threads have handed over before resorting to allocating a new slab.
+				FreeBlock *sharedBlock = m_SharedFreeList.exchange(nullptr, std::memory_order_acquire);
+				if (sharedBlock) {
+					while (sharedBlock) {
+						magazine.push_back(sharedBlock);
+						sharedBlock = sharedBlock->Next;
+					}
+					m_SharedListRefills.fetch_add(1, std::memory_order_relaxed);
+				} else {
+					AllocateSlab(m_PoolAllocBlockCount, magazine);
+				}
+			}
 
-		// Get the instance in the top of the pool and pop it off
-		void *foundMemory = m_AllocatedPool.back();
-		m_AllocatedPool.pop_back();
+			// Get the instance in the top of the magazine and pop it off
+			foundMemory = magazine.back();
+			magazine.pop_back();
+		} else {
+			std::vector<void *> newChunk;
+			AllocateSlab(1, newChunk);
+			foundMemory = newChunk.front();
+		}
 
 		RTEAssert(foundMemory, "Could not find an available instance in the pool, even after increasing its size!");
 
 		// Keep track of the number of instances passed out
-		m_InstancesInUse++;
+		m_InstancesInUse.fetch_add(1, std::memory_order_relaxed);
 
 		return foundMemory;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Entity::ClassInfo::GetPoolMemory(int chunkCount, std::vector<void *> &chunks) {
+		RTEAssert(IsConcrete(), "Trying to get pool memory of an abstract Entity class!");
+		if (chunkCount <= 0) {
+			return;
+		}
+		size_t requiredChunks = static_cast<size_t>(chunkCount);
+
+		if (!s_ThreadMagazinesDestroyed) {
+			std::vector<void *> &magazine = GetThreadMagazine();
+			if (magazine.size() < requiredChunks) {
+				FreeBlock *sharedBlock = m_SharedFreeList.exchange(nullptr, std::memory_order_acquire);
+				if (sharedBlock) {
+					while (sharedBlock) {
+						magazine.push_back(sharedBlock);
+						sharedBlock = sharedBlock->Next;
+					}
+					m_SharedListRefills.fetch_add(1, std::memory_order_relaxed);
+				}
+				// Allocate whatever is still missing as one slab, rounded up to the usual refill amount so the next few single grabs don't need another one.
+				if (magazine.size() < requiredChunks) { AllocateSlab(std::max(m_PoolAllocBlockCount, static_cast<int>(requiredChunks - magazine.size())), magazine); }
+			}
+			chunks.insert(chunks.end(), magazine.end() - chunkCount, magazine.end());
+			magazine.resize(magazine.size() - requiredChunks);
+		} else {
+			AllocateSlab(chunkCount, chunks);
+		}
+
+		m_InstancesInUse.fetch_add(chunkCount, std::memory_order_relaxed);
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	int Entity::ClassInfo::ReturnPoolMemory(void *returnedMemory) {
 		if (!returnedMemory) {
 			return 0;
 		}
-		std::lock_guard<std::mutex> guard(m_Mutex);
-		m_AllocatedPool.push_back(returnedMemory);
+		if (!s_ThreadMagazinesDestroyed) {
+			std::vector<void *> &magazine = GetThreadMagazine();
+			magazine.push_back(returnedMemory);
+
+			// Threads that delete more than they create (e.g. the main thread deleting MOs created by scripts on other threads) would otherwise keep hoarding chunks nobody else can use.
+			if (magazine.size() > static_cast<size_t>(m_PoolAllocBlockCount) * 2) {
+				size_t spillCount = static_cast<size_t>(m_PoolAllocBlockCount);
+				PushToSharedFreeList(magazine.data() + (magazine.size() - spillCount), spillCount);
+				magazine.resize(magazine.size() - spillCount);
+				m_MagazineSpills.fetch_add(1, std::memory_order_relaxed);
+			}
+		} else {
+			PushToSharedFreeList(&returnedMemory, 1);
+		}
 
 		// Keep track of the number of instances passed in
-		m_InstancesInUse--;
-
-		return m_InstancesInUse;
+		return m_InstancesInUse.fetch_sub(1, std::memory_order_relaxed) - 1;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void Entity::ClassInfo::DumpPoolMemoryInfo(const Writer &fileWriter) {
 		for (const ClassInfo *itr = s_ClassHead; itr != nullptr; itr = itr->m_NextClass) {
-			if (itr->IsConcrete()) { fileWriter.NewLineString(itr->GetName() + ": " + std::to_string(itr->m_InstancesInUse), false); }
+			if (itr->IsConcrete()) {
+				fileWriter.NewLineString(itr->GetName() + ": " + std::to_string(itr->m_InstancesInUse.load()) + " in use, " + std::to_string(itr->m_ChunksReserved.load()) + " reserved (" + std::to_string(itr->m_ChunksReserved.load() * itr->m_BlockSize) + " bytes in " + std::to_string(itr->m_SlabCount.load()) + " slabs), " +
+					std::to_string(itr->m_SharedListRefills.load()) + " shared list refills, " + std::to_string(itr->m_MagazineSpills.load()) + " magazine spills", false);
+			}
 		}
 	}
 }
\ No newline at end of file
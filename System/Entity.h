@@ -14,10 +14,10 @@ namespace RTE {
 		Entity::ClassInfo TYPE::m_sClass(#TYPE, &PARENT::m_sClass);
 
 	#define ConcreteClassInfo(TYPE, PARENT, BLOCKCOUNT) \
-		Entity::ClassInfo TYPE::m_sClass(#TYPE, &PARENT::m_sClass, TYPE::Allocate, TYPE::Deallocate, TYPE::NewInstance, BLOCKCOUNT);
+		Entity::ClassInfo TYPE::m_sClass(#TYPE, &PARENT::m_sClass, TYPE::Allocate, TYPE::Deallocate, TYPE::NewInstance, BLOCKCOUNT, sizeof(TYPE));
 
 	#define ConcreteSubClassInfo(TYPE, SUPER, PARENT, BLOCKCOUNT) \
-		Entity::ClassInfo SUPER::TYPE::m_sClass(#TYPE, &PARENT::m_sClass, SUPER::TYPE::Allocate, SUPER::TYPE::Deallocate, SUPER::TYPE::NewInstance, BLOCKCOUNT);
+		Entity::ClassInfo SUPER::TYPE::m_sClass(#TYPE, &PARENT::m_sClass, SUPER::TYPE::Allocate, SUPER::TYPE::Deallocate, SUPER::TYPE::NewInstance, BLOCKCOUNT, sizeof(SUPER::TYPE));
 
 	/// <summary>
 	/// Convenience macro to cut down on duplicate ClassInfo methods in classes that extend Entity.
@@ -45,6 +45,16 @@ namespace RTE {
 			if (cloneTo) { ent->Destroy(); }															\
 			ent->Create(*this);																			\
 			return ent;																					\
+		}																								\
+		void CloneBatch(std::vector<Entity *> &clones, int count) const override {						\
+			std::vector<void *> poolMemory;																\
+			TYPE::m_sClass.GetPoolMemory(count, poolMemory);											\
+			clones.reserve(clones.size() + poolMemory.size());											\
+			for (void *chunk : poolMemory) {															\
+				TYPE *ent = new (chunk) TYPE();															\
+				ent->Create(*this);																		\
+				clones.push_back(ent);																	\
+			}																							\
 		}
 #pragma endregion
 
@@ -91,7 +101,8 @@ namespace RTE {
 			/// <param name="deallocFunc">Function pointer to the raw deallocation function of memory. If the represented Entity subclass isn't concrete, pass in 0.</param>
 			/// <param name="newFunc">Function pointer to the new instance factory. If the represented Entity subclass isn't concrete, pass in 0.</param>
 			/// <param name="allocBlockCount">The number of new instances to fill the pre-allocated pool with when it runs out.</param>
-			ClassInfo(const std::string &name, ClassInfo *parentInfo = 0, MemoryAllocate allocFunc = 0, MemoryDeallocate deallocFunc = 0, Entity * (*newFunc)() = 0, int allocBlockCount = 10);
+			/// <param name="instanceSize">The size of the represented Entity subclass, in bytes. If 0, pool memory is allocated one instance at a time with allocFunc instead of in slabs.</param>
+			ClassInfo(const std::string &name, ClassInfo *parentInfo = 0, MemoryAllocate allocFunc = 0, MemoryDeallocate deallocFunc = 0, Entity * (*newFunc)() = 0, int allocBlockCount = 10, size_t instanceSize = 0);
 #pragma endregion
 
 #pragma region Getters
@@ -152,25 +163,34 @@ namespace RTE {
 #pragma region Memory Management
 			/// <summary>
 			/// Grabs from the pre-allocated pool, an available chunk of memory the exact size of the Entity this ClassInfo represents. OWNERSHIP IS TRANSFERRED!
+			/// Chunks are taken from the calling thread's own magazine without locking. When it runs dry, it's refilled with everything other threads have returned to the shared free list, or with a newly allocated slab if that's empty too.
 			/// </summary>
 			/// <returns>A pointer to the pre-allocated pool memory. OWNERSHIP IS TRANSFERRED!</returns>
 			void * GetPoolMemory();
 
+			/// <summary>
+			/// Grabs a number of available chunks from the pre-allocated pool at once, refilling the calling thread's magazine at most once to do so. OWNERSHIP IS TRANSFERRED!
+			/// </summary>
+			/// <param name="chunkCount">The number of chunks to grab.</param>
+			/// <param name="chunks">The container the chunks will be appended to. OWNERSHIP IS TRANSFERRED!</param>
+			void GetPoolMemory(int chunkCount, std::vector<void *> &chunks);
+
 			/// <summary>
 			/// Returns a raw chunk of memory back to the pre-allocated available pool.
+			/// The chunk goes to the calling thread's own magazine, regardless of which thread it came from. If the magazine grows too big, part of it is handed over to the shared free list for other threads to take.
 			/// </summary>
 			/// <param name="returnedMemory">The raw chunk of memory that is being returned. Needs to be the same size as the type this ClassInfo describes. OWNERSHIP IS TRANSFERRED!</param>
 			/// <returns>The count of outstanding memory chunks after this was returned.</returns>
 			int ReturnPoolMemory(void *returnedMemory);
 
 			/// <summary>
-			/// Writes a bunch of useful debug info about the memory pools to a file.
+			/// Writes a bunch of useful debug info about the memory pools to a file, such as how many instances of each type are in use, how much memory is reserved for them and how often threads had to share memory.
 			/// </summary>
 			/// <param name="fileWriter">The writer to write info to.</param>
 			static void DumpPoolMemoryInfo(const Writer &fileWriter);
 
 			/// <summary>
-			/// Adds a certain number of newly allocated instances to this' pool.
+			/// Adds a certain number of newly allocated instances to this' pool. They're allocated as one slab and put on the shared free list, so any thread can take them.
 			/// </summary>
 			/// <param name="fillAmount">The number of instances to fill the pool with. If 0 is specified, the set refill amount will be used.</param>
 			void FillPool(int fillAmount = 0);
@@ -210,11 +230,59 @@ namespace RTE {
 
 			ClassInfo *m_NextClass; //!< Next ClassInfo after this one on aforementioned unordered linked list.
 
-			std::vector<void *> m_AllocatedPool; //!< Pool of pre-allocated objects of the type described by this ClassInfo.
+			/// <summary>
+			/// A chunk of pool memory that isn't in use, linked to the next one through its own memory.
+			/// </summary>
+			struct FreeBlock {
+				FreeBlock *Next; //!< The next free chunk in the list, or nullptr if this is the last one.
+			};
+
+			/// <summary>
+			/// The free chunks of pool memory held by a single thread, with one magazine per concrete ClassInfo, so most allocations and deallocations don't touch anything other threads use.
+			/// </summary>
+			struct ThreadMagazines {
+				std::vector<std::vector<void *>> Magazines; //!< The free chunks this thread holds for each concrete ClassInfo, indexed by their pool index.
+
+				/// <summary>
+				/// Destructor method used to hand all the chunks held by an exiting thread over to the shared free lists, so they aren't lost.
+				/// </summary>
+				~ThreadMagazines();
+			};
+
+			static int s_ConcreteClassCount; //!< The number of concrete ClassInfos in existence, used to give each of them a pool index.
+			static thread_local ThreadMagazines s_ThreadMagazines; //!< The magazines of the current thread.
+			static thread_local bool s_ThreadMagazinesDestroyed; //!< Whether the magazines of the current thread were already destroyed because it's exiting, so anything still being returned has to go straight to the shared free lists.
+
+			int m_PoolIndex; //!< The index of this ClassInfo's magazine in each thread's ThreadMagazines. -1 if this isn't concrete.
+			size_t m_BlockSize; //!< The size of each chunk of pool memory, in bytes, rounded up so all chunks in a slab stay aligned. 0 if chunks are allocated one at a time.
 			int m_PoolAllocBlockCount; //!< The number of instances to fill up the pool of this type with each time it runs dry.
-			int m_InstancesInUse; //!< The number of allocated instances passed out from the pool.
+			std::atomic<FreeBlock *> m_SharedFreeList; //!< Chunks handed over by threads with overfull magazines or pre-allocated by FillPool. Only ever pushed to, or taken from as a whole, so it can be lock-free without running into the ABA problem.
+
+			std::atomic<int> m_InstancesInUse; //!< The number of allocated instances passed out from the pool.
+			std::atomic<int> m_SlabCount; //!< The number of slabs allocated for this pool.
+			std::atomic<int> m_ChunksReserved; //!< The number of chunks allocated for this pool, whether they're in use or not.
+			std::atomic<int> m_SharedListRefills; //!< The number of times a thread refilled its magazine from the shared free list.
+			std::atomic<int> m_MagazineSpills; //!< The number of times a thread's magazine overflowed into the shared free list.
+
+			/// <summary>
+			/// Gets the calling thread's magazine for this ClassInfo, creating it if needed.
+			/// </summary>
+			/// <returns>The calling thread's magazine for this ClassInfo.</returns>
+			std::vector<void *> & GetThreadMagazine();
+
+			/// <summary>
+			/// Allocates a slab with room for a number of instances, and adds its chunks to a container.
+			/// </summary>
+			/// <param name="chunkCount">The number of instances to make room for.</param>
+			/// <param name="chunks">The container to add the new chunks to.</param>
+			void AllocateSlab(int chunkCount, std::vector<void *> &chunks);
 
-			std::mutex m_Mutex; //!< Mutex to ensure multiple things aren't grabbing/deallocating memory at the same time
+			/// <summary>
+			/// Links a number of free chunks together and pushes them onto the shared free list in one go.
+			/// </summary>
+			/// <param name="chunks">Pointer to the first of the chunks to push.</param>
+			/// <param name="chunkCount">The number of chunks to push.</param>
+			void PushToSharedFreeList(void * const *chunks, size_t chunkCount);
 
 			// Forbidding copying
 			ClassInfo(const ClassInfo &reference) = delete;
@@ -256,6 +324,13 @@ namespace RTE {
 		/// <param name="cloneTo">A pointer to an instance to make identical to this. If 0 is passed in, a new instance is made inside here, and ownership of it IS returned!</param>
 		/// <returns>An Entity pointer to the newly cloned-to instance. Ownership IS transferred!</returns>
 		virtual Entity * Clone(Entity *cloneTo = nullptr) const { RTEAbort("Attempt to clone an abstract or unclonable type!"); return nullptr; }
+
+		/// <summary>
+		/// Makes a number of clones of this at once, e.g. for the particles of a gib. Memory for all of them is taken from the pool in one go. Ownership of the clones IS transferred!
+		/// </summary>
+		/// <param name="clones">The container the clones will be appended to. Ownership IS transferred!</param>
+		/// <param name="count">The number of clones to make.</param>
+		virtual void CloneBatch(std::vector<Entity *> &clones, int count) const { RTEAbort("Attempt to clone an abstract or unclonable type!"); }
 #pragma endregion
 
 #pragma region Destruction
@@ -380,6 +455,29 @@ namespace RTE {
 #pragma endregion
 
 #pragma region Groups
+		using GroupMask = std::vector<uint64_t>; //!< A bitset of interned group IDs, as given by GetGroupID.
+
+		/// <summary>
+		/// Gets the ID a group name is interned as, interning it if it wasn't yet. Group IDs are small consecutive integers shared by all Entities.
+		/// </summary>
+		/// <param name="group">The name of the group.</param>
+		/// <returns>The ID of the group.</returns>
+		static int GetGroupID(const std::string &group);
+
+		/// <summary>
+		/// Gets the ID a group name is interned as, without interning it.
+		/// </summary>
+		/// <param name="group">The name of the group.</param>
+		/// <returns>The ID of the group, or -1 if no Entity was ever added to it, in which case no Entity can be in it either.</returns>
+		static int FindGroupID(const std::string &group);
+
+		/// <summary>
+		/// Sets the bit of a group in a GroupMask, growing it as needed.
+		/// </summary>
+		/// <param name="groupMask">The GroupMask to set the bit in.</param>
+		/// <param name="groupID">The ID of the group.</param>
+		static void AddToGroupMask(GroupMask &groupMask, int groupID);
+
 		/// <summary>
 		/// Gets the set of groups this is member of.
 		/// </summary>
@@ -397,13 +495,20 @@ namespace RTE {
 		/// Adds this Entity to a new grouping.
 		/// </summary>
 		/// <param name="newGroup">A string which describes the group to add this to. Duplicates will be ignored.</param>
-		void AddToGroup(const std::string &newGroup) { m_Groups.emplace(newGroup); }
+		void AddToGroup(const std::string &newGroup) { if (m_Groups.emplace(newGroup).second) { AddToGroupMask(m_GroupMask, GetGroupID(newGroup)); } }
 
 		/// <summary>
 		/// Removes this Entity from the specified grouping.
 		/// </summary>
 		/// <param name="groupToRemoveFrom">A string which describes the group to remove this from.</param>
-		void RemoveFromGroup(const std::string &groupToRemoveFrom) { m_Groups.erase(groupToRemoveFrom); }
+		void RemoveFromGroup(const std::string &groupToRemoveFrom);
+
+		/// <summary>
+		/// Gets whether this is part of any of the groups in a GroupMask. Unlike IsInGroup, there are no special "All", "Any" or "None" groups here.
+		/// </summary>
+		/// <param name="groupMask">The GroupMask with the groups to check for.</param>
+		/// <returns>Whether this Entity is in any of the groups in the GroupMask.</returns>
+		bool IsInAnyGroup(const GroupMask &groupMask) const;
 
 		/// <summary>
 		/// Returns random weight used in PresetMan::GetRandomBuyableOfGroupFromTech.
@@ -473,6 +578,7 @@ namespace RTE {
 		int m_DefinedInModule; //!< The DataModule ID that this was successfully added to at some point. -1 if not added to anything yet.
 
 		std::unordered_set<std::string> m_Groups; //!< List of all tags associated with this. The groups are used to categorize and organize Entities.
+		GroupMask m_GroupMask; //!< The interned IDs of all groups in m_Groups, so group queries over many Entities don't need any string lookups.
 
 		int m_RandomWeight; //!< Random weight used when picking item using PresetMan::GetRandomBuyableOfGroupFromTech. From 0 to 100. 0 means item won't be ever picked.
 
@@ -0,0 +1,87 @@
+#include "FrameBoxKernels.h"
+
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define RTE_FRAMEBOX_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RTE_FRAMEBOX_SSE2
+#endif
+
+namespace RTE {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool IsPixelBufferEmpty(const unsigned char *buffer, int size) {
+		int i = 0;
+#if defined(RTE_FRAMEBOX_AVX2)
+		for (; i + 32 <= size; i += 32) {
+			__m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(buffer + i));
+			if (!_mm256_testz_si256(pixels, pixels)) {
+				return false;
+			}
+		}
+#elif defined(RTE_FRAMEBOX_SSE2)
+		const __m128i zero = _mm_setzero_si128();
+		for (; i + 16 <= size; i += 16) {
+			__m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buffer + i));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(pixels, zero)) != 0xFFFF) {
+				return false;
+			}
+		}
+#endif
+		for (; i < size; ++i) {
+			if (buffer[i] != 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	PixelDeltaCounts ComputePixelDelta(const unsigned char *current, unsigned char *previous, unsigned char *delta, int size) {
+		PixelDeltaCounts counts = { 0, 0, 0 };
+		int i = 0;
+		// The vector loops count zero bytes with a compare and a movemask, then take those away from the number of bytes checked.
+#if defined(RTE_FRAMEBOX_AVX2)
+		const __m256i zero = _mm256_setzero_si256();
+		for (; i + 32 <= size; i += 32) {
+			__m256i currentPixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(current + i));
+			__m256i previousPixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(previous + i));
+			__m256i deltaPixels = _mm256_sub_epi8(currentPixels, previousPixels);
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(delta + i), deltaPixels);
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(previous + i), currentPixels);
+
+			counts.CurrentNonZero += 32 - std::popcount(static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(currentPixels, zero))));
+			counts.PreviousNonZero += 32 - std::popcount(static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(previousPixels, zero))));
+			counts.Changed += 32 - std::popcount(static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(deltaPixels, zero))));
+		}
+#elif defined(RTE_FRAMEBOX_SSE2)
+		const __m128i zero = _mm_setzero_si128();
+		for (; i + 16 <= size; i += 16) {
+			__m128i currentPixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(current + i));
+			__m128i previousPixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(previous + i));
+			__m128i deltaPixels = _mm_sub_epi8(currentPixels, previousPixels);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(delta + i), deltaPixels);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(previous + i), currentPixels);
+
+			counts.CurrentNonZero += 16 - std::popcount(static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(currentPixels, zero))));
+			counts.PreviousNonZero += 16 - std::popcount(static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(previousPixels, zero))));
+			counts.Changed += 16 - std::popcount(static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(deltaPixels, zero))));
+		}
+#endif
+		for (; i < size; ++i) {
+			unsigned char currentPixel = current[i];
+			unsigned char previousPixel = previous[i];
+			if (currentPixel != 0) { counts.CurrentNonZero++; }
+			if (previousPixel != 0) { counts.PreviousNonZero++; }
+			if (currentPixel != previousPixel) { counts.Changed++; }
+			delta[i] = static_cast<unsigned char>(currentPixel - previousPixel);
+			previous[i] = currentPixel;
+		}
+		return counts;
+	}
+}
@@ -0,0 +1,38 @@
+#ifndef _RTEFRAMEBOXKERNELS_
+#define _RTEFRAMEBOXKERNELS_
+
+/// <summary>
+/// Pixel buffer scans used to encode the frame boxes NetworkServer streams to clients.
+/// These are vectorized with AVX2 or SSE2 when the build targets them, and fall back to plain loops otherwise. All of them give the same results either way.
+/// </summary>
+namespace RTE {
+
+	/// <summary>
+	/// The numbers of significant pixels found while computing a frame box delta.
+	/// </summary>
+	struct PixelDeltaCounts {
+		int CurrentNonZero; //!< The number of non-zero pixels in the current box.
+		int PreviousNonZero; //!< The number of non-zero pixels in the previous box.
+		int Changed; //!< The number of pixels that differ between the two, i.e. the number of non-zero pixels in the delta.
+	};
+
+	/// <summary>
+	/// Checks whether every pixel of a buffer is zero.
+	/// </summary>
+	/// <param name="buffer">The pixel buffer to check.</param>
+	/// <param name="size">The size of the buffer, in bytes.</param>
+	/// <returns>Whether all the pixels are zero.</returns>
+	bool IsPixelBufferEmpty(const unsigned char *buffer, int size);
+
+	/// <summary>
+	/// Computes the delta of a box against the same box in the previous frame, then replaces the previous box with the current one for the next frame to delta against.
+	/// The delta is the byte-wise wrapping difference current - previous, so adding it to the previous box gives back the current one.
+	/// </summary>
+	/// <param name="current">The current box's pixels.</param>
+	/// <param name="previous">The previous box's pixels. Overwritten with the current ones.</param>
+	/// <param name="delta">The buffer to write the delta to. Must not overlap the other two.</param>
+	/// <param name="size">The size of the box, in bytes.</param>
+	/// <returns>The numbers of significant pixels in the current box, the previous box and the delta.</returns>
+	PixelDeltaCounts ComputePixelDelta(const unsigned char *current, unsigned char *previous, unsigned char *delta, int size);
+}
+#endif
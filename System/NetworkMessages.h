@@ -116,6 +116,9 @@ namespace RTE {
 
 		float OffsetX[c_MaxLayersStoredForNetwork];
 		float OffsetY[c_MaxLayersStoredForNetwork];
+
+		short int ShiftX;
+		short int ShiftY;
 	};
 
 	/// <summary>
@@ -136,6 +139,7 @@ namespace RTE {
 	/// </summary>
 	struct MsgFrameBox {
 		unsigned char Id;
+		unsigned char FrameNumber;
 
 		unsigned char BoxX;
 		unsigned char BoxY;
@@ -228,20 +232,26 @@ namespace RTE {
 	};
 
 	/// <summary>
-	///
+	/// Header of a batch of terrain changes. It's followed by ChangeCount TerrainChangeNetworkData entries, then by the pixel data of all the changed areas one after another, which is LZ4 compressed unless DataSize equals UncompressedSize.
 	/// </summary>
 	struct MsgTerrainChange {
 		unsigned char Id;
 
+		unsigned char SceneId;
+		unsigned short int ChangeCount;
+		unsigned short int DataSize;
+		unsigned short int UncompressedSize;
+	};
+
+	/// <summary>
+	/// One changed area of a terrain change batch.
+	/// </summary>
+	struct TerrainChangeNetworkData {
 		unsigned short int X;
 		unsigned short int Y;
 		unsigned short int W;
 		unsigned short int H;
 		bool Back;
-		unsigned char Color;
-		unsigned char SceneId;
-		unsigned short int DataSize;
-		unsigned short int UncompressedSize;
 	};
 
 	/// <summary>
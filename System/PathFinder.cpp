@@ -29,9 +29,15 @@ namespace RTE {
 	// TODO: Enhance MicroPather to add that capability (or write our own pather)!
 	thread_local float s_DigStrength = 0.0F;
 
+	thread_local const PathFinder::NodeCostSnapshot *PathFinder::s_ReadSnapshot = nullptr;
+
+	// Which clusters the PathNode search on this thread is confined to, if it's refining a path planned on clusters.
+	thread_local std::vector<unsigned char> s_ClusterCorridor;
+	thread_local bool s_RestrictToClusterCorridor = false;
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	PathNode::PathNode(const Vector &pos) : Pos(pos) {
+	PathNode::PathNode(const Vector &pos) : Pos(pos), m_Navigatable(true) {
 		const Material *outOfBounds = g_SceneMan.GetMaterialFromID(MaterialColorKeys::g_MaterialOutOfBounds);
 		for (int i = 0; i < c_MaxAdjacentNodeCount; i++) {
 			AdjacentNodes[i] = nullptr;
@@ -44,11 +50,16 @@ namespace RTE {
 	void PathFinder::Clear() {
 		m_NodeGrid.clear();
 		m_NodeDimension = SCENEGRIDSIZE;
+		m_ClusterSize = 0;
+		m_ClusterGridWidth = 0;
+		m_ClusterGridHeight = 0;
+		m_CostSnapshot.reset();
+		m_CostEpoch = 0;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	int PathFinder::Create(int nodeDimension) {
+	int PathFinder::Create(int nodeDimension, int clusterSize) {
 		RTEAssert(g_SceneMan.GetScene(), "Scene doesn't exist or isn't loaded when creating PathFinder!");
 
 		m_NodeDimension = nodeDimension;
@@ -62,6 +73,12 @@ namespace RTE {
 		m_WrapsX = g_SceneMan.SceneWrapsX();
 		m_WrapsY = g_SceneMan.SceneWrapsY();
 
+		m_ClusterSize = std::max(clusterSize, 0);
+		if (m_ClusterSize > 0) {
+			m_ClusterGridWidth = (m_GridWidth + m_ClusterSize - 1) / m_ClusterSize;
+			m_ClusterGridHeight = (m_GridHeight + m_ClusterSize - 1) / m_ClusterSize;
+		}
+
 		// Create and assign scene coordinate positions for all nodes.
 		Vector nodePos = Vector(static_cast<float>(nodeDimension) / 2.0F, static_cast<float>(nodeDimension) / 2.0F);
 		m_NodeGrid.reserve(m_GridWidth * m_GridHeight);
@@ -106,6 +123,7 @@ namespace RTE {
 			}
 		}
 
+		PublishCostSnapshot(nullptr);
 		RecalculateAllCosts();
 
 		return 0;
@@ -137,7 +155,7 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	int PathFinder::CalculatePath(Vector start, Vector end, std::list<Vector> &pathResult, float &totalCostResult, float digStrength) {
+	int PathFinder::CalculatePath(Vector start, Vector end, std::list<Vector> &pathResult, float &totalCostResult, float digStrength, unsigned int *costEpochResult) {
 		ZoneScoped;
 		
 		++m_CurrentPathingRequests;
@@ -161,14 +179,38 @@ namespace RTE {
 		// Actors capable of digging can use s_DigStrength to modify the node adjacency cost.
 		s_DigStrength = digStrength;
 
+		// Hold on to the current node costs for the whole search, so cost updates published meanwhile don't affect it.
+		std::shared_ptr<const NodeCostSnapshot> costSnapshot = GetCostSnapshot();
+		s_ReadSnapshot = costSnapshot.get();
+		if (costEpochResult) { *costEpochResult = costSnapshot->Epoch; }
+
 		// Do the actual pathfinding, fetch out the list of states that comprise the best path.
 		int result = MicroPather::NO_SOLUTION;
 		std::vector<void *> statePath;
 
 		// If end node is invalid, there's no path
+		PathNode *startNode = GetPathNodeAtGridCoords(startNodeX, startNodeY);
 		PathNode* endNode = GetPathNodeAtGridCoords(endNodeX, endNodeY);
-		if (endNode && endNode->m_Navigatable) {
-			result = GetPather()->Solve(static_cast<void*>(GetPathNodeAtGridCoords(startNodeX, startNodeY)), static_cast<void*>(endNode), &statePath, &totalCostResult);
+		if (endNode && costSnapshot->GetNodeCosts(GetNodeId(endNode)).Navigatable) {
+			// Long paths are planned on clusters first, and only the clusters along the way are searched on the PathNode grid.
+			if (m_ClusterSize > 0 && startNode) {
+				int startClusterId = GetClusterId(GetNodeId(startNode));
+				int endClusterId = GetClusterId(GetNodeId(endNode));
+				if (IsLongClusterPath(startClusterId, endClusterId) && FindClusterCorridor(*costSnapshot, startClusterId, endClusterId, s_ClusterCorridor)) {
+					s_RestrictToClusterCorridor = true;
+					result = GetPather()->Solve(static_cast<void *>(startNode), static_cast<void *>(endNode), &statePath, &totalCostResult);
+					s_RestrictToClusterCorridor = false;
+
+					// The cluster plan only approximates what's inside each cluster, so fall back to searching everything if the corridor turned out to be blocked.
+					if (result == MicroPather::NO_SOLUTION) {
+						GetPather()->Reset();
+						statePath.clear();
+					}
+				}
+			}
+			if (result == MicroPather::NO_SOLUTION) {
+				result = GetPather()->Solve(static_cast<void*>(startNode), static_cast<void*>(endNode), &statePath, &totalCostResult);
+			}
 		}
 
 		if (result == MicroPather::NO_SOLUTION) {
@@ -198,6 +240,7 @@ namespace RTE {
 			pathResult.push_back(end);
 		}
 
+		s_ReadSnapshot = nullptr;
 		--m_CurrentPathingRequests;
 
 		// TODO: Clean up the path, remove series of nodes in the same direction etc?
@@ -216,7 +259,7 @@ namespace RTE {
 			// Cast away the volatile-ness - only matters outside (and complicates the API otherwise)
 			PathRequest &request = const_cast<PathRequest &>(*volRequest);
 
-			int status = this->CalculatePath(start, end, request.path, request.totalCost, digStrength);
+			int status = this->CalculatePath(start, end, request.path, request.totalCost, digStrength, &request.costEpoch);
 			
 			request.status = status;
 			request.pathLength = request.path.size();
@@ -238,9 +281,6 @@ namespace RTE {
     void PathFinder::RecalculateAllCosts() {
         RTEAssert(g_SceneMan.GetScene(), "Scene doesn't exist or isn't loaded when recalculating PathFinder!");
 
-		// Deadlock until all path requests are complete
-		while (m_CurrentPathingRequests.load() != 0) { };
-
 		// I hate this copy, but fuck it.
 		std::vector<int> pathNodesIdsVec;
 		pathNodesIdsVec.reserve(m_NodeGrid.size());
@@ -293,56 +333,65 @@ namespace RTE {
 
 	void PathFinder::AdjacentCost(void *state, std::vector<micropather::StateCost> *adjacentList) {
 		const PathNode *node = static_cast<PathNode *>(state);
+		const PathNodeCosts &nodeCosts = s_ReadSnapshot->GetNodeCosts(GetNodeId(node));
 		micropather::StateCost adjCost;
 
+		auto isNavigatable = [this](const PathNode *adjacentNode) {
+			if (!adjacentNode) {
+				return false;
+			}
+			int adjacentNodeId = GetNodeId(adjacentNode);
+			return s_ReadSnapshot->GetNodeCosts(adjacentNodeId).Navigatable && (!s_RestrictToClusterCorridor || s_ClusterCorridor[GetClusterId(adjacentNodeId)]);
+		};
+
 		// We do a little trick here, where we radiate out a little percentage of our average cost in all directions.
 		// This encourages the AI to generally try to give hard surfaces some berth when pathing, so we don't get too close and get stuck.
 		const float costRadiationMultiplier = 0.2F;
-		float radiatedCost = GetNodeAverageTransitionCost(*node) * costRadiationMultiplier;
+		float radiatedCost = GetNodeAverageTransitionCost(nodeCosts) * costRadiationMultiplier;
 
 		// Cost to discourage us from going up. Until we have jetpack-aware pathing, this it the best we can do!
 		const float extraUpCost = 3.0F;
 
 		// Add cost for digging upwards.
-		if (node->Up && node->Up->m_Navigatable) {
-			adjCost.cost = 1.0F + extraUpCost + (GetMaterialTransitionCost(*node->UpMaterial) * 4.0F) + radiatedCost; // Four times more expensive when digging.
+		if (isNavigatable(node->Up)) {
+			adjCost.cost = 1.0F + extraUpCost + (GetMaterialTransitionCost(*nodeCosts.AdjacentNodeBlockingMaterials[0]) * 4.0F) + radiatedCost; // Four times more expensive when digging.
 			adjCost.state = static_cast<void *>(node->Up);
 			adjacentList->push_back(adjCost);
 		}
-		if (node->Right && node->Right->m_Navigatable) {
-			adjCost.cost = 1.0F + GetMaterialTransitionCost(*node->RightMaterial) + radiatedCost;
+		if (isNavigatable(node->Right)) {
+			adjCost.cost = 1.0F + GetMaterialTransitionCost(*nodeCosts.AdjacentNodeBlockingMaterials[2]) + radiatedCost;
 			adjCost.state = static_cast<void *>(node->Right);
 			adjacentList->push_back(adjCost);
 		}
-		if (node->Down && node->Down->m_Navigatable) {
-			adjCost.cost = 1.0F + GetMaterialTransitionCost(*node->DownMaterial) + radiatedCost;
+		if (isNavigatable(node->Down)) {
+			adjCost.cost = 1.0F + GetMaterialTransitionCost(*nodeCosts.AdjacentNodeBlockingMaterials[4]) + radiatedCost;
 			adjCost.state = static_cast<void *>(node->Down);
 			adjacentList->push_back(adjCost);
 		}
-		if (node->Left && node->Left->m_Navigatable) {
-			adjCost.cost = 1.0F + GetMaterialTransitionCost(*node->LeftMaterial) + radiatedCost;
+		if (isNavigatable(node->Left)) {
+			adjCost.cost = 1.0F + GetMaterialTransitionCost(*nodeCosts.AdjacentNodeBlockingMaterials[6]) + radiatedCost;
 			adjCost.state = static_cast<void *>(node->Left);
 			adjacentList->push_back(adjCost);
 		}
 
 		// Add cost for digging at 45 degrees and for digging upwards.
-		if (node->UpRight && node->UpRight->m_Navigatable) {
-			adjCost.cost = 1.4F + extraUpCost + (GetMaterialTransitionCost(*node->UpRightMaterial) * 1.4F * 3.0F) + radiatedCost;  // Three times more expensive when digging.
+		if (isNavigatable(node->UpRight)) {
+			adjCost.cost = 1.4F + extraUpCost + (GetMaterialTransitionCost(*nodeCosts.AdjacentNodeBlockingMaterials[1]) * 1.4F * 3.0F) + radiatedCost;  // Three times more expensive when digging.
 			adjCost.state = static_cast<void *>(node->UpRight);
 			adjacentList->push_back(adjCost);
 		}
-		if (node->RightDown && node->RightDown->m_Navigatable) {
-			adjCost.cost = 1.4F + (GetMaterialTransitionCost(*node->RightDownMaterial) * 1.4F) + radiatedCost;
+		if (isNavigatable(node->RightDown)) {
+			adjCost.cost = 1.4F + (GetMaterialTransitionCost(*nodeCosts.AdjacentNodeBlockingMaterials[3]) * 1.4F) + radiatedCost;
 			adjCost.state = static_cast<void *>(node->RightDown);
 			adjacentList->push_back(adjCost);
 		}
-		if (node->DownLeft && node->DownLeft->m_Navigatable) {
-			adjCost.cost = 1.4F + (GetMaterialTransitionCost(*node->DownLeftMaterial) * 1.4F) + radiatedCost;
+		if (isNavigatable(node->DownLeft)) {
+			adjCost.cost = 1.4F + (GetMaterialTransitionCost(*nodeCosts.AdjacentNodeBlockingMaterials[5]) * 1.4F) + radiatedCost;
 			adjCost.state = static_cast<void *>(node->DownLeft);
 			adjacentList->push_back(adjCost);
 		}
-		if (node->LeftUp && node->LeftUp->m_Navigatable) {
-			adjCost.cost = 1.4F + extraUpCost + (GetMaterialTransitionCost(*node->LeftUpMaterial) * 1.4F * 3.0F) + radiatedCost;  // Three times more expensive when digging.
+		if (isNavigatable(node->LeftUp)) {
+			adjCost.cost = 1.4F + extraUpCost + (GetMaterialTransitionCost(*nodeCosts.AdjacentNodeBlockingMaterials[7]) * 1.4F * 3.0F) + radiatedCost;  // Three times more expensive when digging.
 			adjCost.state = static_cast<void *>(node->LeftUp);
 			adjacentList->push_back(adjCost);
 		}
@@ -452,10 +501,10 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	float PathFinder::GetNodeAverageTransitionCost(const PathNode &node) const {
+	float PathFinder::GetNodeAverageTransitionCost(const PathNodeCosts &nodeCosts) const {
 		float totalCostOfAdjacentNodes = 0.0F;
 		int count = 0;
-		for (const Material *material : node.AdjacentNodeBlockingMaterials) {
+		for (const Material *material : nodeCosts.AdjacentNodeBlockingMaterials) {
 			// Don't use node transition cost, because we don't care about digging.
 			float cost = material->GetIntegrity();
 			if (cost < std::numeric_limits<float>::max()) {
@@ -500,6 +549,8 @@ namespace RTE {
 					if (node->RightDown) { node->RightDown->LeftUpMaterial = node->RightDownMaterial; }
 				}
 			);
+
+			PublishCostSnapshot(&nodeVec);
 		}
 
 		return anyChange;
@@ -518,6 +569,8 @@ namespace RTE {
 				node->m_Navigatable = navigatable;
 			}
 		);
+
+		PublishCostSnapshot(&pathNodesInBox);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -538,6 +591,202 @@ namespace RTE {
 				node->m_Navigatable = navigatable;
 			}
 		);
+
+		PublishCostSnapshot(nullptr);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::shared_ptr<const PathFinder::NodeCostSnapshot> PathFinder::GetCostSnapshot() {
+		std::lock_guard<std::mutex> lock(m_CostSnapshotMutex);
+		return m_CostSnapshot;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::PublishCostSnapshot(const std::vector<int> *changedNodeIds) {
+		ZoneScoped;
+
+		int pageCount = (static_cast<int>(m_NodeGrid.size()) + c_NodeCostPageSize - 1) / c_NodeCostPageSize;
+
+		// Only this thread publishes snapshots, so the latest one can be read without locking. Unchanged pages are shared with it.
+		std::shared_ptr<NodeCostSnapshot> newSnapshot = m_CostSnapshot ? std::make_shared<NodeCostSnapshot>(*m_CostSnapshot) : std::make_shared<NodeCostSnapshot>();
+		newSnapshot->Pages.resize(pageCount);
+
+		std::vector<bool> pagesToCopy(pageCount, changedNodeIds == nullptr);
+		if (changedNodeIds) {
+			for (int nodeId : *changedNodeIds) {
+				pagesToCopy[nodeId / c_NodeCostPageSize] = true;
+				for (const PathNode *adjacentNode : m_NodeGrid[nodeId].AdjacentNodes) {
+					if (adjacentNode) { pagesToCopy[GetNodeId(adjacentNode) / c_NodeCostPageSize] = true; }
+				}
+			}
+		}
+		for (int page = 0; page < pageCount; ++page) {
+			if (pagesToCopy[page] || !newSnapshot->Pages[page]) {
+				std::shared_ptr<std::array<PathNodeCosts, c_NodeCostPageSize>> pageCosts = std::make_shared<std::array<PathNodeCosts, c_NodeCostPageSize>>();
+				int pageEnd = std::min(static_cast<int>(m_NodeGrid.size()), (page + 1) * c_NodeCostPageSize);
+				for (int nodeId = page * c_NodeCostPageSize; nodeId < pageEnd; ++nodeId) {
+					const PathNode &node = m_NodeGrid[nodeId];
+					(*pageCosts)[nodeId % c_NodeCostPageSize] = { node.AdjacentNodeBlockingMaterials, node.m_Navigatable };
+				}
+				newSnapshot->Pages[page] = std::move(pageCosts);
+			}
+		}
+
+		if (m_ClusterSize > 0) {
+			int clusterCount = m_ClusterGridWidth * m_ClusterGridHeight;
+			std::vector<bool> clustersToUpdate(clusterCount, changedNodeIds == nullptr || newSnapshot->Clusters.size() != clusterCount);
+			newSnapshot->Clusters.resize(clusterCount);
+			if (changedNodeIds) {
+				for (int nodeId : *changedNodeIds) {
+					clustersToUpdate[GetClusterId(nodeId)] = true;
+					for (const PathNode *adjacentNode : m_NodeGrid[nodeId].AdjacentNodes) {
+						if (adjacentNode) { clustersToUpdate[GetClusterId(GetNodeId(adjacentNode))] = true; }
+					}
+				}
+			}
+			for (int clusterId = 0; clusterId < clusterCount; ++clusterId) {
+				if (clustersToUpdate[clusterId]) { UpdateClusterCosts(clusterId, newSnapshot->Clusters[clusterId]); }
+			}
+		}
+		newSnapshot->Epoch = m_CostEpoch.load() + 1;
+
+		std::lock_guard<std::mutex> lock(m_CostSnapshotMutex);
+		m_CostSnapshot = std::move(newSnapshot);
+		m_CostEpoch = m_CostSnapshot->Epoch;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::UpdateClusterCosts(int clusterId, ClusterCosts &clusterCosts) const {
+		int firstX = (clusterId % m_ClusterGridWidth) * m_ClusterSize;
+		int firstY = (clusterId / m_ClusterGridWidth) * m_ClusterSize;
+		int lastX = std::min(firstX + m_ClusterSize, m_GridWidth) - 1;
+		int lastY = std::min(firstY + m_ClusterSize, m_GridHeight) - 1;
+
+		// The PathNodes along each edge of the cluster, and the direction from them into the adjacent cluster, in the same order as ClusterCosts.
+		const std::array<std::array<int, 4>, 4> edges = {{
+			{ firstX, firstY, lastX, firstY },
+			{ lastX, firstY, lastX, lastY },
+			{ firstX, lastY, lastX, lastY },
+			{ firstX, firstY, firstX, lastY }
+		}};
+		const std::array<int, 4> edgeDirections = { 0, 2, 4, 6 };
+
+		for (int edge = 0; edge < edges.size(); ++edge) {
+			const Material *weakestMaterial = nullptr;
+			for (int y = edges[edge][1]; y <= edges[edge][3]; ++y) {
+				for (int x = edges[edge][0]; x <= edges[edge][2]; ++x) {
+					const PathNode &node = m_NodeGrid[y * m_GridWidth + x];
+					const PathNode *adjacentNode = node.AdjacentNodes[edgeDirections[edge]];
+					if (node.m_Navigatable && adjacentNode && adjacentNode->m_Navigatable) {
+						const Material *material = node.AdjacentNodeBlockingMaterials[edgeDirections[edge]];
+						if (!weakestMaterial || material->GetIntegrity() < weakestMaterial->GetIntegrity()) { weakestMaterial = material; }
+					}
+				}
+			}
+			clusterCosts.WeakestCrossingMaterials[edge] = weakestMaterial;
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int PathFinder::ConvertClusterCoordsToClusterId(int x, int y) const {
+		if (m_WrapsX) {
+			x = x % m_ClusterGridWidth;
+			x = x < 0 ? x + m_ClusterGridWidth : x;
+		}
+		if (m_WrapsY) {
+			y = y % m_ClusterGridHeight;
+			y = y < 0 ? y + m_ClusterGridHeight : y;
+		}
+		if (x < 0 || x >= m_ClusterGridWidth || y < 0 || y >= m_ClusterGridHeight) {
+			return -1;
+		}
+		return (y * m_ClusterGridWidth) + x;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PathFinder::IsLongClusterPath(int startClusterId, int endClusterId) const {
+		int distanceX = std::abs((startClusterId % m_ClusterGridWidth) - (endClusterId % m_ClusterGridWidth));
+		int distanceY = std::abs((startClusterId / m_ClusterGridWidth) - (endClusterId / m_ClusterGridWidth));
+		if (m_WrapsX) { distanceX = std::min(distanceX, m_ClusterGridWidth - distanceX); }
+		if (m_WrapsY) { distanceY = std::min(distanceY, m_ClusterGridHeight - distanceY); }
+
+		// Paths to neighboring clusters are short enough that planning them on clusters wouldn't save anything.
+		return std::max(distanceX, distanceY) > 1;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PathFinder::FindClusterCorridor(const NodeCostSnapshot &costSnapshot, int startClusterId, int endClusterId, std::vector<unsigned char> &corridor) const {
+		ZoneScoped;
+
+		int clusterCount = m_ClusterGridWidth * m_ClusterGridHeight;
+		std::vector<float> costsSoFar(clusterCount, std::numeric_limits<float>::max());
+		std::vector<int> previousClusters(clusterCount, -1);
+
+		auto estimateCost = [this, endClusterId](int clusterId) {
+			float distanceX = static_cast<float>(std::abs((clusterId % m_ClusterGridWidth) - (endClusterId % m_ClusterGridWidth)));
+			float distanceY = static_cast<float>(std::abs((clusterId / m_ClusterGridWidth) - (endClusterId / m_ClusterGridWidth)));
+			if (m_WrapsX) { distanceX = std::min(distanceX, static_cast<float>(m_ClusterGridWidth) - distanceX); }
+			if (m_WrapsY) { distanceY = std::min(distanceY, static_cast<float>(m_ClusterGridHeight) - distanceY); }
+			return std::sqrt(distanceX * distanceX + distanceY * distanceY) * static_cast<float>(m_ClusterSize);
+		};
+
+		using OpenCluster = std::pair<float, int>;
+		std::priority_queue<OpenCluster, std::vector<OpenCluster>, std::greater<OpenCluster>> openClusters;
+		costsSoFar[startClusterId] = 0.0F;
+		openClusters.emplace(estimateCost(startClusterId), startClusterId);
+
+		// Crossing a cluster costs at least as much as walking across it through air, plus whatever blocks the way into the next one.
+		const std::array<std::array<int, 2>, 4> crossingOffsets = {{ { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 } }};
+		bool foundPath = false;
+		while (!openClusters.empty()) {
+			auto [estimatedCost, clusterId] = openClusters.top();
+			openClusters.pop();
+			if (clusterId == endClusterId) {
+				foundPath = true;
+				break;
+			}
+			if (estimatedCost - estimateCost(clusterId) > costsSoFar[clusterId]) {
+				continue;
+			}
+			int clusterX = clusterId % m_ClusterGridWidth;
+			int clusterY = clusterId / m_ClusterGridWidth;
+			for (int crossing = 0; crossing < crossingOffsets.size(); ++crossing) {
+				const Material *crossingMaterial = costSnapshot.Clusters[clusterId].WeakestCrossingMaterials[crossing];
+				int adjacentClusterId = ConvertClusterCoordsToClusterId(clusterX + crossingOffsets[crossing][0], clusterY + crossingOffsets[crossing][1]);
+				if (!crossingMaterial || adjacentClusterId == -1) {
+					continue;
+				}
+				float adjacentCost = costsSoFar[clusterId] + static_cast<float>(m_ClusterSize) + GetMaterialTransitionCost(*crossingMaterial);
+				if (adjacentCost < costsSoFar[adjacentClusterId]) {
+					costsSoFar[adjacentClusterId] = adjacentCost;
+					previousClusters[adjacentClusterId] = clusterId;
+					openClusters.emplace(adjacentCost + estimateCost(adjacentClusterId), adjacentClusterId);
+				}
+			}
+		}
+		if (!foundPath) {
+			return false;
+		}
+
+		// Let the PathNode search stray into the clusters around the planned ones, so it can cut corners and get around whatever the cluster costs didn't capture.
+		corridor.assign(clusterCount, 0);
+		for (int clusterId = endClusterId; clusterId != -1; clusterId = previousClusters[clusterId]) {
+			int clusterX = clusterId % m_ClusterGridWidth;
+			int clusterY = clusterId / m_ClusterGridWidth;
+			for (int offsetY = -1; offsetY <= 1; ++offsetY) {
+				for (int offsetX = -1; offsetX <= 1; ++offsetX) {
+					int neighborClusterId = ConvertClusterCoordsToClusterId(clusterX + offsetX, clusterY + offsetY);
+					if (neighborClusterId != -1) { corridor[neighborClusterId] = 1; }
+				}
+			}
+		}
+		return true;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -20,6 +20,7 @@ namespace RTE {
 		std::list<Vector> path;
 		float pathLength = 0.0f;
 		float totalCost = 0.0f;
+		unsigned int costEpoch = 0;
 		Vector startPos;
 		Vector targetPos;
 	};
@@ -28,6 +29,7 @@ namespace RTE {
 
 	/// <summary>
 	/// Contains everything related to a PathNode on the path grid used by PathFinder.
+	/// Its costs and navigatability are the working copy that cost updates write to. Path requests read them from the PathFinder's node cost snapshots instead.
 	/// </summary>
 	struct PathNode {
 
@@ -70,6 +72,14 @@ namespace RTE {
 		explicit PathNode(const Vector &pos);
 	};
 
+	/// <summary>
+	/// The parts of a PathNode that change when the terrain or navigatable areas change, as seen by path requests through a PathFinder's node cost snapshot.
+	/// </summary>
+	struct PathNodeCosts {
+		std::array<const Material *, PathNode::c_MaxAdjacentNodeCount> AdjacentNodeBlockingMaterials; //!< The strongest material between the PathNode and its adjacent PathNodes, in clockwise order with top first.
+		bool Navigatable; //!< Whether the PathNode can be navigated through.
+	};
+
 	/// <summary>
 	/// A class encapsulating and implementing the MicroPather A* pathfinding library.
 	/// </summary>
@@ -82,15 +92,16 @@ namespace RTE {
 		/// Constructor method used to instantiate a PathFinder object.
 		/// </summary>
 		/// <param name="nodeDimension">The width and height in scene pixels that of each PathNode should represent.</param>
-		/// <param name="allocate">The block size that the PathNode cache is allocated from. Should be about a fourth of the total number of PathNodes.</param>
-		PathFinder(int nodeDimension) { Clear(); Create(nodeDimension); }
+		/// <param name="clusterSize">The width and height in PathNodes of each cluster long paths are planned on before being refined on the PathNode grid. 0 disables hierarchical pathfinding.</param>
+		PathFinder(int nodeDimension, int clusterSize = 0) { Clear(); Create(nodeDimension, clusterSize); }
 
 		/// <summary>
 		/// Makes the PathFinder object ready for use.
 		/// </summary>
 		/// <param name="nodeDimension">The width and height in scene pixels that of each PathNode should represent.</param>
+		/// <param name="clusterSize">The width and height in PathNodes of each cluster long paths are planned on before being refined on the PathNode grid. 0 disables hierarchical pathfinding.</param>
 		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
-		int Create(int nodeDimension);
+		int Create(int nodeDimension, int clusterSize = 0);
 #pragma endregion
 
 #pragma region Destruction
@@ -113,15 +124,17 @@ namespace RTE {
 #pragma region PathFinding
 		/// <summary>
 		/// Calculates and returns the least difficult path between two points on the current scene.
-		/// This is synchronous, and will block the current thread!
+		/// This is synchronous, and will block the current thread! The path is solved against the node cost snapshot that was current when this was called, regardless of any cost updates that happen meanwhile.
+		/// If hierarchical pathfinding is enabled and the points are far apart, the path is first planned on clusters, and the PathNode search is confined to the clusters along and around that plan. Should that fail, the whole grid is searched as usual.
 		/// </summary>
 		/// <param name="start">Start positions on the scene to find the path between.</param>
 		/// <param name="end">End positions on the scene to find the path between.</param>
 		/// <param name="pathResult">A list which will be filled out with waypoints between the start and end.</param>
 		/// <param name="totalCostResult">The total minimum difficulty cost calculated between the two points on the scene.</param>
 		/// <param name="digStrength">What material strength the search is capable of digging through.</param>
+		/// <param name="costEpochResult">Optional output for the epoch of the node cost snapshot the path was solved against.</param>
 		/// <returns>Success or failure, expressed as SOLVED, NO_SOLUTION, or START_END_SAME.</returns>
-		int CalculatePath(Vector start, Vector end, std::list<Vector> &pathResult, float &totalCostResult, float digStrength);
+		int CalculatePath(Vector start, Vector end, std::list<Vector> &pathResult, float &totalCostResult, float digStrength, unsigned int *costEpochResult = nullptr);
 
 		/// <summary>
 		/// Calculates and returns the least difficult path between two points on the current scene.
@@ -140,8 +153,15 @@ namespace RTE {
 		/// <returns>How many pathfinding requests are currently active.</returns>
 		int GetCurrentPathingRequests() const { return m_CurrentPathingRequests.load(); }
 
+		/// <summary>
+		/// Gets the epoch of the current node cost snapshot, which goes up by one every time updated PathNode costs or navigatability are published to path requests.
+		/// </summary>
+		/// <returns>The epoch of the current node cost snapshot.</returns>
+		unsigned int GetCostEpoch() const { return m_CostEpoch.load(); }
+
 		/// <summary>
 		/// Recalculates all the costs between all the PathNodes by tracing lines in the material layer and summing all the material strengths for each encountered pixel. Also resets the pather itself.
+		/// Path requests in flight keep using the node cost snapshot they started with, so this doesn't need to wait for them.
 		/// </summary>
 		void RecalculateAllCosts();
 
@@ -154,7 +174,7 @@ namespace RTE {
 		std::vector<int> RecalculateAreaCosts(std::deque<Box> &boxList, int nodeUpdateLimit);
 
 		/// <summary>
-		/// Updates a set of PathNodes, adjusting their transitions.
+		/// Updates a set of PathNodes, adjusting their transitions, and publishes a new node cost snapshot if any of their costs changed.
 		/// This does NOT update the pather, which is required if PathNode costs changed.
 		/// </summary>
 		/// <param name="nodeVec">The set of PathNode IDs to update.</param>
@@ -212,6 +232,37 @@ namespace RTE {
 
 	private:
 
+		static constexpr int c_NodeCostPageSize = 256; //!< How many PathNodes' costs are stored in each page of a node cost snapshot. Only the pages of changed PathNodes are copied when a new snapshot is published.
+
+		/// <summary>
+		/// The costs of crossing from one cluster of PathNodes into its orthogonally adjacent clusters, used to plan long paths before refining them on the PathNode grid.
+		/// </summary>
+		struct ClusterCosts {
+			/// <summary>
+			/// The weakest material blocking any crossing between navigatable PathNodes into the adjacent cluster above, to the right, below and to the left, in that order. nullptr if there's no such crossing.
+			/// </summary>
+			std::array<const Material *, 4> WeakestCrossingMaterials;
+		};
+
+		/// <summary>
+		/// An immutable version of all PathNodes' costs and navigatability, that path requests read while newer versions are published.
+		/// Unchanged pages are shared between versions.
+		/// </summary>
+		struct NodeCostSnapshot {
+			unsigned int Epoch = 0; //!< The epoch this snapshot was published at.
+			std::vector<std::shared_ptr<const std::array<PathNodeCosts, c_NodeCostPageSize>>> Pages; //!< The pages of PathNode costs, indexed by PathNode id divided by the page size.
+			std::vector<ClusterCosts> Clusters; //!< The crossing costs of each cluster, if hierarchical pathfinding is enabled.
+
+			/// <summary>
+			/// Gets the costs of a PathNode in this snapshot.
+			/// </summary>
+			/// <param name="nodeId">The id of the PathNode.</param>
+			/// <returns>The costs of the PathNode.</returns>
+			const PathNodeCosts & GetNodeCosts(int nodeId) const { return (*Pages[nodeId / c_NodeCostPageSize])[nodeId % c_NodeCostPageSize]; }
+		};
+
+		static thread_local const NodeCostSnapshot *s_ReadSnapshot; //!< The node cost snapshot the path being solved on this thread reads from.
+
 		static constexpr float c_NodeCostChangeEpsilon = 5.0F; //!< The minimum change in a PathNodes's cost for the pathfinder to recognize a change and reset itself. This is so minor changes (e.g. blood particles) don't force constant pathfinder resets.
 
 		MicroPather *m_Pather; //!< The actual pathing object that does the pathfinding work. Owned.
@@ -221,8 +272,15 @@ namespace RTE {
 		int m_GridHeight; //!< The height of the pathing grid, in PathNodes.
 		bool m_WrapsX; //!< Whether the pathing grid wraps on the X axis.
 		bool m_WrapsY; //!< Whether the pathing grid wraps on the Y axis.
+		int m_ClusterSize; //!< The width and height of each cluster, in PathNodes. 0 if hierarchical pathfinding is disabled.
+		int m_ClusterGridWidth; //!< The width of the cluster grid, in clusters.
+		int m_ClusterGridHeight; //!< The height of the cluster grid, in clusters.
 		std::atomic<int> m_CurrentPathingRequests; //!< The number of active async pathing requests.
 
+		std::shared_ptr<const NodeCostSnapshot> m_CostSnapshot; //!< The latest published node cost snapshot, which new path requests read from.
+		std::mutex m_CostSnapshotMutex; //!< Mutex guarding swaps and copies of the latest published node cost snapshot.
+		std::atomic<unsigned int> m_CostEpoch; //!< The epoch of the latest published node cost snapshot.
+
 		/// <summary>
 		/// Gets the pather for this thread. Lazily-initialized for each new thread that needs a pather.
 		/// </summary>
@@ -261,11 +319,74 @@ namespace RTE {
 		float GetMaterialTransitionCost(const Material &material) const;
 
 		/// <summary>
-		/// Gets the average cost for all transitions out of this PathNode, ignoring infinities/unpathable transitions.
+		/// Gets the average cost for all transitions out of a PathNode, ignoring infinities/unpathable transitions.
 		/// </summary>
-		/// <param name="node">The PathNode to get the average transition cost for.</param>
+		/// <param name="nodeCosts">The costs of the PathNode to get the average transition cost for.</param>
 		/// <returns>The average transition cost.</returns>
-		float GetNodeAverageTransitionCost(const PathNode &node) const;
+		float GetNodeAverageTransitionCost(const PathNodeCosts &nodeCosts) const;
+#pragma endregion
+
+#pragma region Node Cost Snapshots
+		/// <summary>
+		/// Gets the latest published node cost snapshot, which stays valid for as long as the returned pointer is held.
+		/// </summary>
+		/// <returns>The latest published node cost snapshot.</returns>
+		std::shared_ptr<const NodeCostSnapshot> GetCostSnapshot();
+
+		/// <summary>
+		/// Publishes the current costs and navigatability of PathNodes as a new node cost snapshot, for path requests made from now on.
+		/// </summary>
+		/// <param name="changedNodeIds">The ids of the PathNodes that changed since the last snapshot. Their adjacent PathNodes are republished too, since their costs are derived from each other. If nullptr, all PathNodes are republished.</param>
+		void PublishCostSnapshot(const std::vector<int> *changedNodeIds);
+
+		/// <summary>
+		/// Recalculates the crossing costs of a cluster from the current PathNode costs.
+		/// </summary>
+		/// <param name="clusterId">The id of the cluster.</param>
+		/// <param name="clusterCosts">The ClusterCosts to fill out.</param>
+		void UpdateClusterCosts(int clusterId, ClusterCosts &clusterCosts) const;
+
+		/// <summary>
+		/// Gets the id of a PathNode on the grid.
+		/// </summary>
+		/// <param name="node">The PathNode to get the id of. OWNERSHIP IS NOT TRANSFERRED!</param>
+		/// <returns>The id of the PathNode.</returns>
+		int GetNodeId(const PathNode *node) const { return static_cast<int>(node - m_NodeGrid.data()); }
+#pragma endregion
+
+#pragma region Hierarchical PathFinding
+		/// <summary>
+		/// Gets the id of the cluster a PathNode is in.
+		/// </summary>
+		/// <param name="nodeId">The id of the PathNode.</param>
+		/// <returns>The id of the cluster the PathNode is in.</returns>
+		int GetClusterId(int nodeId) const { return ((nodeId / m_GridWidth) / m_ClusterSize) * m_ClusterGridWidth + (nodeId % m_GridWidth) / m_ClusterSize; }
+
+		/// <summary>
+		/// Gets the cluster id at the given coordinates, wrapping them if the grid wraps.
+		/// </summary>
+		/// <param name="x">The X coordinate, in clusters.</param>
+		/// <param name="y">The Y coordinate, in clusters.</param>
+		/// <returns>The cluster id at the given coordinates, or -1 if they're off a non-wrapping edge.</returns>
+		int ConvertClusterCoordsToClusterId(int x, int y) const;
+
+		/// <summary>
+		/// Gets whether two clusters are far enough apart that a path between them is worth planning on clusters first.
+		/// </summary>
+		/// <param name="startClusterId">The id of the first cluster.</param>
+		/// <param name="endClusterId">The id of the second cluster.</param>
+		/// <returns>Whether the path between the clusters should be planned on clusters first.</returns>
+		bool IsLongClusterPath(int startClusterId, int endClusterId) const;
+
+		/// <summary>
+		/// Plans a path between two clusters on the cluster graph of a node cost snapshot, and marks the clusters along it and their neighbors as the corridor the PathNode search is confined to.
+		/// </summary>
+		/// <param name="costSnapshot">The node cost snapshot to plan on.</param>
+		/// <param name="startClusterId">The id of the cluster the path starts in.</param>
+		/// <param name="endClusterId">The id of the cluster the path ends in.</param>
+		/// <param name="corridor">A vector that will be filled out with whether each cluster is part of the corridor.</param>
+		/// <returns>Whether a path between the clusters was found.</returns>
+		bool FindClusterCorridor(const NodeCostSnapshot &costSnapshot, int startClusterId, int endClusterId, std::vector<unsigned char> &corridor) const;
 #pragma endregion
 
 		/// <summary>
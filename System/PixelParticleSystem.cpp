@@ -0,0 +1,282 @@
+#include "PixelParticleSystem.h"
+
+#include "MOPixel.h"
+#include "Atom.h"
+#include "SceneMan.h"
+
+#include "tracy/Tracy.hpp"
+
+namespace RTE {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PixelParticleSystem::CanSimulate(const MovableObject *movableObject) {
+		// Only plain MOPixels, derived types may do anything in their overrides.
+		if (!movableObject || &movableObject->GetClass() != &MOPixel::m_sClass) {
+			return false;
+		}
+		const MOPixel *pixel = static_cast<const MOPixel *>(movableObject);
+
+		// Anything that makes a MOPixel interact with more than gravity and air needs the full simulation.
+		if (!pixel->m_BulkSimulationAllowed || pixel->HasAnyScripts() || pixel->m_GetsHitByMOs || pixel->m_MissionCritical || pixel->m_PinStrength > 0 || pixel->m_IgnoreTerrain || pixel->m_pScreenEffect || pixel->m_RandomizeEffectRotAngleEveryFrame) {
+			return false;
+		}
+		if (pixel->m_ToDelete || pixel->m_ToSettle || !pixel->m_Forces.empty() || !pixel->m_ImpulseForces.empty() || pixel->GetParent() || pixel->IsTooFast()) {
+			return false;
+		}
+		// The path stepping assumes the Atom sits right on the MOPixel and starts a fresh trajectory, which is always true until it bounces off something.
+		return pixel->m_Atom && pixel->m_Atom->GetOffset().IsZero() && pixel->m_Atom->HasChangedDir();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleSystem::Add(MOPixel *pixel) {
+		const Atom *atom = pixel->m_Atom;
+
+		long long expirySimTicks = std::numeric_limits<long long>::max();
+		if (pixel->m_Lifetime) {
+			double ticksPerMS = static_cast<double>(g_TimerMan.GetTicksPerSecond()) * 0.001;
+			expirySimTicks = g_TimerMan.GetSimTickCount() + static_cast<long long>((static_cast<double>(pixel->m_Lifetime) - pixel->m_AgeTimer.GetElapsedSimTimeMS()) * ticksPerMS);
+		}
+
+		m_ParticleIndices[pixel->GetUniqueID()] = m_Particles.size();
+		m_Particles.emplace_back(pixel);
+		m_PosX.emplace_back(pixel->m_Pos.m_X);
+		m_PosY.emplace_back(pixel->m_Pos.m_Y);
+		m_VelX.emplace_back(pixel->m_Vel.m_X);
+		m_VelY.emplace_back(pixel->m_Vel.m_Y);
+		m_GlobalAccScalars.emplace_back(pixel->m_GlobalAccScalar);
+		m_AirResistances.emplace_back(pixel->m_AirResistance);
+		m_AirThresholds.emplace_back(pixel->m_AirThreshold);
+		m_DistancesTravelled.emplace_back(pixel->m_DistanceTravelled);
+		m_LethalRanges.emplace_back((pixel->m_HitsMOs && pixel->m_Sharpness > 0) ? pixel->m_LethalRange : std::numeric_limits<float>::infinity());
+		m_ExpirySimTicks.emplace_back(expirySimTicks);
+		m_HitsMOs.emplace_back(pixel->m_HitsMOs);
+		m_Teams.emplace_back(pixel->GetTeam());
+		m_Colors.emplace_back(pixel->m_Color.GetIndex());
+		m_SettleMaterials.emplace_back(atom->GetMaterial()->GetSettleMaterial());
+		m_TrailLengths.emplace_back(atom->GetTrailLength());
+		m_TrailLengthVariations.emplace_back(atom->GetTrailLengthVariation());
+		m_TrailColors.emplace_back(atom->GetTrailColor().GetIndex());
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PixelParticleSystem::Release(const MovableObject *movableObject) {
+		if (!movableObject) {
+			return false;
+		}
+		auto particleIndexEntry = m_ParticleIndices.find(movableObject->GetUniqueID());
+		if (particleIndexEntry == m_ParticleIndices.end() || m_Particles[particleIndexEntry->second] != movableObject) {
+			return false;
+		}
+		size_t index = particleIndexEntry->second;
+		SyncToObject(index);
+		RemoveAt(index);
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleSystem::ReleaseAll(std::deque<MovableObject *> &releasedParticles) {
+		SyncAllToObjects();
+		releasedParticles.insert(releasedParticles.end(), m_Particles.begin(), m_Particles.end());
+
+		for (std::vector<float> *floatArray : { &m_PosX, &m_PosY, &m_VelX, &m_VelY, &m_GlobalAccScalars, &m_AirResistances, &m_AirThresholds, &m_DistancesTravelled, &m_LethalRanges, &m_TrailLengthVariations }) {
+			floatArray->clear();
+		}
+		for (std::vector<int> *intArray : { &m_Teams, &m_Colors, &m_SettleMaterials, &m_TrailLengths, &m_TrailColors }) {
+			intArray->clear();
+		}
+		m_Particles.clear();
+		m_ParticleIndices.clear();
+		m_ExpirySimTicks.clear();
+		m_HitsMOs.clear();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleSystem::SyncAllToObjects() const {
+		for (size_t i = 0; i < m_Particles.size(); ++i) {
+			SyncToObject(i);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleSystem::Travel(std::deque<MovableObject *> &promotedParticles, std::vector<MOPixel *> &expiredParticles) {
+		ZoneScoped;
+
+		size_t particleCount = m_Particles.size();
+		if (particleCount == 0) {
+			return;
+		}
+		const float deltaTime = g_TimerMan.GetDeltaTimeSecs();
+		const float pixelsPerStep = c_PPM * deltaTime;
+		const Vector globalAccStep = g_SceneMan.GetGlobalAcc() * deltaTime;
+		const long long simTicks = g_TimerMan.GetSimTickCount();
+		const bool drawTrails = g_TimerMan.DrawnSimUpdate();
+
+		// Apply gravity and air resistance the same way MovableObject::ApplyForces does, in one pass over contiguous arrays so it can be vectorized.
+		// Nothing is committed yet, because particles that turn out to need the full simulation are handed back with their velocities untouched.
+		m_NextVelX.resize(particleCount);
+		m_NextVelY.resize(particleCount);
+		for (size_t i = 0; i < particleCount; ++i) {
+			float velX = m_VelX[i] + globalAccStep.m_X * m_GlobalAccScalars[i];
+			float velY = m_VelY[i] + globalAccStep.m_Y * m_GlobalAccScalars[i];
+			float airFactor = (m_AirResistances[i] > 0 && std::max(std::abs(velX), std::abs(velY)) >= m_AirThresholds[i]) ? 1.0F - m_AirResistances[i] * deltaTime : 1.0F;
+			m_NextVelX[i] = velX * airFactor;
+			m_NextVelY[i] = velY * airFactor;
+		}
+
+		bool scenePreLocked = g_SceneMan.SceneIsLocked();
+		if (!scenePreLocked) { g_SceneMan.LockScene(); }
+
+		// Iterate backwards so removing a particle, which moves the last one into its place, never skips one that hasn't been traveled yet.
+		for (size_t i = particleCount; i-- > 0;) {
+			float velX = m_NextVelX[i];
+			float velY = m_NextVelY[i];
+			float stepX = velX * pixelsPerStep;
+			float stepY = velY * pixelsPerStep;
+			float speed = std::sqrt(velX * velX + velY * velY);
+
+			// Too fast needs fixing, moving a pixel or less means it may be about to settle and crossing the lethal range starts the lethality drop-off in MOPixel::Update. All of these are left to the full simulation.
+			bool needsFullSimulation = speed > 500.0F || stepX * stepX + stepY * stepY <= 1.0F || m_DistancesTravelled[i] + speed * pixelsPerStep > m_LethalRanges[i];
+
+			int startX = static_cast<int>(std::floor(m_PosX[i]));
+			int startY = static_cast<int>(std::floor(m_PosY[i]));
+			bool recordTrail = drawTrails && m_TrailLengths[i] > 0;
+			if (!needsFullSimulation) {
+				int deltaX = static_cast<int>(std::floor(m_PosX[i] + stepX)) - startX;
+				int deltaY = static_cast<int>(std::floor(m_PosY[i] + stepY)) - startY;
+				needsFullSimulation = !IsPathClear(startX, startY, deltaX, deltaY, m_HitsMOs[i], m_Teams[i], recordTrail);
+			}
+			if (needsFullSimulation) {
+				SyncToObject(i);
+				promotedParticles.emplace_back(m_Particles[i]);
+				RemoveAt(i);
+				continue;
+			}
+			if (recordTrail) { Atom::DrawTrail(m_TrailPoints, m_TrailLengths[i], m_TrailLengthVariations[i], m_TrailColors[i]); }
+
+			Vector newPos(m_PosX[i] + stepX, m_PosY[i] + stepY);
+			g_SceneMan.WrapPosition(newPos);
+			m_PosX[i] = newPos.m_X;
+			m_PosY[i] = newPos.m_Y;
+			m_VelX[i] = velX;
+			m_VelY[i] = velY;
+			m_DistancesTravelled[i] += speed * pixelsPerStep;
+
+			if (simTicks > m_ExpirySimTicks[i] || !g_SceneMan.IsWithinBounds(static_cast<int>(newPos.m_X), static_cast<int>(newPos.m_Y), 1000)) {
+				SyncToObject(i);
+				expiredParticles.emplace_back(m_Particles[i]);
+				RemoveAt(i);
+			}
+		}
+
+		if (!scenePreLocked) { g_SceneMan.UnlockScene(); }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleSystem::Draw(BITMAP *targetBitmap, const Vector &targetPos, DrawMode mode) const {
+		// Same as MOPixel::Draw, don't draw color if this isn't a drawing frame.
+		if ((mode == g_DrawColor && !g_TimerMan.DrawnSimUpdate()) || (mode != g_DrawColor && mode != g_DrawMaterial)) {
+			return;
+		}
+		const std::vector<int> &drawColors = (mode == g_DrawMaterial) ? m_SettleMaterials : m_Colors;
+
+		for (size_t i = 0; i < m_Particles.size(); ++i) {
+			Vector pixelPos(m_PosX[i] - targetPos.m_X, m_PosY[i] - targetPos.m_Y);
+			putpixel(targetBitmap, pixelPos.GetFloorIntX(), pixelPos.GetFloorIntY(), drawColors[i]);
+			g_SceneMan.RegisterDrawing(targetBitmap, g_NoMOID, pixelPos, 1.0F);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleSystem::DrawMOIDs(BITMAP *targetBitmap, std::vector<MovableObject *> &moidIndex) const {
+		for (size_t i = 0; i < m_Particles.size(); ++i) {
+			MOPixel *pixel = m_Particles[i];
+			pixel->UpdateMOID(moidIndex);
+
+			Vector pixelPos(m_PosX[i], m_PosY[i]);
+#ifdef DRAW_MOID_LAYER
+			putpixel(targetBitmap, pixelPos.GetFloorIntX(), pixelPos.GetFloorIntY(), pixel->GetID());
+#endif
+			g_SceneMan.RegisterDrawing(targetBitmap, pixel->GetID(), pixelPos, 1.0F);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleSystem::SyncToObject(size_t index) const {
+		MOPixel *pixel = m_Particles[index];
+		pixel->m_Pos.SetXY(m_PosX[index], m_PosY[index]);
+		pixel->m_Vel.SetXY(m_VelX[index], m_VelY[index]);
+		pixel->m_DistanceTravelled = m_DistancesTravelled[index];
+		// It was moving more than a pixel per frame the whole time it was in here, so rest detection would have kept resetting.
+		pixel->NotResting();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleSystem::RemoveAt(size_t index) {
+		m_ParticleIndices.erase(m_Particles[index]->GetUniqueID());
+		if (index != m_Particles.size() - 1) { m_ParticleIndices[m_Particles.back()->GetUniqueID()] = index; }
+
+		auto removeFromArray = [index](auto &particleArray) {
+			particleArray[index] = particleArray.back();
+			particleArray.pop_back();
+		};
+		removeFromArray(m_Particles);
+		removeFromArray(m_PosX);
+		removeFromArray(m_PosY);
+		removeFromArray(m_VelX);
+		removeFromArray(m_VelY);
+		removeFromArray(m_GlobalAccScalars);
+		removeFromArray(m_AirResistances);
+		removeFromArray(m_AirThresholds);
+		removeFromArray(m_DistancesTravelled);
+		removeFromArray(m_LethalRanges);
+		removeFromArray(m_ExpirySimTicks);
+		removeFromArray(m_HitsMOs);
+		removeFromArray(m_Teams);
+		removeFromArray(m_Colors);
+		removeFromArray(m_SettleMaterials);
+		removeFromArray(m_TrailLengths);
+		removeFromArray(m_TrailLengthVariations);
+		removeFromArray(m_TrailColors);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PixelParticleSystem::IsPathClear(int startX, int startY, int deltaX, int deltaY, bool checkMOs, int team, bool recordTrail) {
+		m_TrailPoints.clear();
+		if (recordTrail) { m_TrailPoints.emplace_back(startX, startY); }
+
+		// Atom::Travel doesn't step at all in this case, so there's nothing to hit.
+		if (deltaX == 0 && deltaY == 0) {
+			return true;
+		}
+		// Starting out embedded in terrain means Atom::Travel will try to penetrate it.
+		if (g_SceneMan.GetTerrMatter(startX, startY) != g_MaterialAir) {
+			return false;
+		}
+
+		int intPos[2] = { startX, startY };
+		BresenhamLine line;
+		line.Start(deltaX, deltaY);
+
+		for (int domSteps = 0; domSteps < line.Delta[line.Dom]; ++domSteps) {
+			line.Step(intPos);
+			g_SceneMan.WrapPosition(intPos[X], intPos[Y]);
+
+			if ((checkMOs && g_SceneMan.GetMOIDPixel(intPos[X], intPos[Y], team) != g_NoMOID) || g_SceneMan.GetTerrMatter(intPos[X], intPos[Y]) != g_MaterialAir) {
+				return false;
+			}
+			if (recordTrail) { m_TrailPoints.emplace_back(intPos[X], intPos[Y]); }
+		}
+		return true;
+	}
+}
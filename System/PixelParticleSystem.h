@@ -0,0 +1,157 @@
+#ifndef _RTEPIXELPARTICLESYSTEM_
+#define _RTEPIXELPARTICLESYSTEM_
+
+#include "Entity.h"
+#include "Vector.h"
+
+namespace RTE {
+
+	class MovableObject;
+	class MOPixel;
+
+	/// <summary>
+	/// Structure-of-arrays storage and simulation for MOPixels that are flying freely through the air, such as most gibs, sparks and bullet sprays.
+	/// While in here, a MOPixel's hot data (position, velocity, lifetime, trail and so on) lives in contiguous arrays that are integrated in tight loops, instead of going through the virtual update and travel chain of each MOPixel object.
+	/// As soon as a particle needs anything more than that (it's about to hit the terrain or an MO, it's slowing down enough to settle, or a script wants it), its state is written back and it's promoted to a regular MOPixel again.
+	/// </summary>
+	class PixelParticleSystem {
+
+	public:
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate a PixelParticleSystem object in system memory.
+		/// </summary>
+		PixelParticleSystem() = default;
+#pragma endregion
+
+#pragma region Getters
+		/// <summary>
+		/// Gets the number of particles currently simulated by this PixelParticleSystem.
+		/// </summary>
+		/// <returns>The number of particles currently simulated by this PixelParticleSystem.</returns>
+		size_t GetParticleCount() const { return m_Particles.size(); }
+
+		/// <summary>
+		/// Gets whether the given MovableObject is a plain MOPixel that can be simulated by a PixelParticleSystem in its current state.
+		/// </summary>
+		/// <param name="movableObject">The MovableObject to check.</param>
+		/// <returns>Whether the MovableObject can be added to a PixelParticleSystem.</returns>
+		static bool CanSimulate(const MovableObject *movableObject);
+#pragma endregion
+
+#pragma region Particle Management
+		/// <summary>
+		/// Adds a MOPixel to this PixelParticleSystem. CanSimulate() must have been checked first. Ownership is NOT transferred, but the MOPixel's state won't be kept up to date until it's released again.
+		/// </summary>
+		/// <param name="pixel">The MOPixel to add.</param>
+		void Add(MOPixel *pixel);
+
+		/// <summary>
+		/// Writes the current state of the given particle back to its MOPixel and removes it from this PixelParticleSystem.
+		/// </summary>
+		/// <param name="movableObject">The MovableObject to release.</param>
+		/// <returns>Whether the MovableObject was found in, and released from, this PixelParticleSystem.</returns>
+		bool Release(const MovableObject *movableObject);
+
+		/// <summary>
+		/// Writes the current state of all particles back to their MOPixels and removes them from this PixelParticleSystem.
+		/// </summary>
+		/// <param name="releasedParticles">The container the released MOPixels will be appended to.</param>
+		void ReleaseAll(std::deque<MovableObject *> &releasedParticles);
+
+		/// <summary>
+		/// Writes the current state of all particles back to their MOPixels without removing them, e.g. so they can be saved.
+		/// </summary>
+		void SyncAllToObjects() const;
+
+		/// <summary>
+		/// Gets the MOPixels of all particles currently simulated by this PixelParticleSystem. Their state is only current after a call to SyncAllToObjects().
+		/// </summary>
+		/// <returns>The MOPixels of all particles currently simulated by this PixelParticleSystem.</returns>
+		const std::vector<MOPixel *> & GetParticleObjects() const { return m_Particles; }
+#pragma endregion
+
+#pragma region Concrete Methods
+		/// <summary>
+		/// Applies forces to and travels all particles for this frame, drawing their trails if it's a drawn update.
+		/// Particles that would collide with anything or otherwise need a full simulation this frame are released, untraveled, so they can be traveled as regular MOPixels.
+		/// </summary>
+		/// <param name="promotedParticles">The container the released MOPixels will be appended to.</param>
+		/// <param name="expiredParticles">The container MOPixels that ran out of lifetime or left the Scene will be appended to. They are removed from this PixelParticleSystem but not deleted.</param>
+		void Travel(std::deque<MovableObject *> &promotedParticles, std::vector<MOPixel *> &expiredParticles);
+
+		/// <summary>
+		/// Draws all particles to a BITMAP of choice.
+		/// </summary>
+		/// <param name="targetBitmap">A pointer to a BITMAP to draw on.</param>
+		/// <param name="targetPos">The absolute position of the target bitmap's upper left corner in the Scene.</param>
+		/// <param name="mode">In which mode to draw in. Only g_DrawColor and g_DrawMaterial are meaningful, MOIDs are drawn by DrawMOIDs.</param>
+		void Draw(BITMAP *targetBitmap, const Vector &targetPos, DrawMode mode) const;
+
+		/// <summary>
+		/// Gives every particle's MOPixel a new MOID and draws it to the MOID layer, the same as MovableMan::UpdateDrawMOIDs does for regular MOPixels, so the particles can be found by spatial queries.
+		/// </summary>
+		/// <param name="targetBitmap">The MOID layer's BITMAP.</param>
+		/// <param name="moidIndex">The MOID index to register the MOPixels in.</param>
+		void DrawMOIDs(BITMAP *targetBitmap, std::vector<MovableObject *> &moidIndex) const;
+#pragma endregion
+
+	private:
+
+		std::vector<MOPixel *> m_Particles; //!< The MOPixels each particle belongs to. Only touched when a particle is added, released or removed.
+		std::unordered_map<long, size_t> m_ParticleIndices; //!< The index of each particle, mapped by the UniqueID of its MOPixel, so a particle can be released without searching for it.
+
+		std::vector<float> m_PosX; //!< The X position of each particle.
+		std::vector<float> m_PosY; //!< The Y position of each particle.
+		std::vector<float> m_VelX; //!< The X velocity of each particle.
+		std::vector<float> m_VelY; //!< The Y velocity of each particle.
+		std::vector<float> m_GlobalAccScalars; //!< How much each particle is affected by the global acceleration.
+		std::vector<float> m_AirResistances; //!< The air resistance of each particle.
+		std::vector<float> m_AirThresholds; //!< The velocity each particle has to exceed for air resistance to apply.
+		std::vector<float> m_DistancesTravelled; //!< How far each particle has travelled since its creation, in pixels.
+		std::vector<float> m_LethalRanges; //!< How far each particle can travel before its lethality starts dropping off, or infinity if it doesn't need to.
+		std::vector<long long> m_ExpirySimTicks; //!< The sim tick count after which each particle's lifetime runs out, or the maximum value if it never does.
+		std::vector<unsigned char> m_HitsMOs; //!< Whether each particle hits MOs.
+		std::vector<int> m_Teams; //!< The team of each particle, whose MOs it doesn't hit.
+		std::vector<int> m_Colors; //!< The palette color index each particle is drawn with.
+		std::vector<int> m_SettleMaterials; //!< The material index each particle is drawn with to the material layer.
+		std::vector<int> m_TrailLengths; //!< The longest trail each particle can draw, in pixels.
+		std::vector<float> m_TrailLengthVariations; //!< What percentage the trail length of each particle can vary.
+		std::vector<int> m_TrailColors; //!< The palette color index each particle's trail is drawn with.
+
+		std::vector<float> m_NextVelX; //!< Scratch buffer holding each particle's X velocity after this frame's forces are applied.
+		std::vector<float> m_NextVelY; //!< Scratch buffer holding each particle's Y velocity after this frame's forces are applied.
+		std::vector<std::pair<int, int>> m_TrailPoints; //!< Scratch buffer holding the trail points of the particle being traveled.
+
+		/// <summary>
+		/// Writes the current state of a particle back to its MOPixel.
+		/// </summary>
+		/// <param name="index">The index of the particle.</param>
+		void SyncToObject(size_t index) const;
+
+		/// <summary>
+		/// Removes a particle, moving the last particle into its place and updating its index.
+		/// </summary>
+		/// <param name="index">The index of the particle to remove.</param>
+		void RemoveAt(size_t index);
+
+		/// <summary>
+		/// Steps along the pixels a particle would cross this frame, in the same order Atom::Travel does, and checks them for anything it could hit.
+		/// </summary>
+		/// <param name="startX">The X pixel the particle starts at.</param>
+		/// <param name="startY">The Y pixel the particle starts at.</param>
+		/// <param name="deltaX">How many pixels the particle moves along the X axis.</param>
+		/// <param name="deltaY">How many pixels the particle moves along the Y axis.</param>
+		/// <param name="checkMOs">Whether MOs block the path.</param>
+		/// <param name="team">The team whose MOs are ignored.</param>
+		/// <param name="recordTrail">Whether to record the crossed pixels to m_TrailPoints.</param>
+		/// <returns>Whether the whole path is clear.</returns>
+		bool IsPathClear(int startX, int startY, int deltaX, int deltaY, bool checkMOs, int team, bool recordTrail);
+
+		// Disallow the use of some implicit methods.
+		PixelParticleSystem(const PixelParticleSystem &reference) = delete;
+		PixelParticleSystem & operator=(const PixelParticleSystem &rhs) = delete;
+	};
+}
+#endif
\ No newline at end of file
@@ -1,10 +1,50 @@
 #include "Reader.h"
+#include "ReaderCache.h"
 #include "ConsoleMan.h"
 #include "PresetMan.h"
 #include "SettingsMan.h"
 
 namespace RTE {
 
+	/// <summary>
+	/// Finds the first occurrence of a character in a range with memchr, which the standard libraries vectorize, instead of checking one character at a time.
+	/// </summary>
+	/// <param name="begin">A pointer to the start of the range to search.</param>
+	/// <param name="end">A pointer to one past the end of the range to search.</param>
+	/// <param name="character">The character to search for.</param>
+	/// <returns>A pointer to the first occurrence of the character, or end if there isn't one.</returns>
+	static const char * FindCharacter(const char *begin, const char *end, char character) {
+		if (begin == end) {
+			return end;
+		}
+		const char *found = static_cast<const char *>(std::memchr(begin, character, static_cast<size_t>(end - begin)));
+		return found ? found : end;
+	}
+
+	/// <summary>
+	/// Finds where a line ends, which is at the first '\n' or '\r' since the Reader treats either as a line break.
+	/// </summary>
+	/// <param name="begin">A pointer to the start of the line.</param>
+	/// <param name="end">A pointer to the end of the contents the line is in.</param>
+	/// <returns>A pointer to the first line break, or end if there isn't one.</returns>
+	static const char * FindLineEnd(const char *begin, const char *end) {
+		const char *lineEnd = FindCharacter(begin, end, '\n');
+		return FindCharacter(begin, lineEnd, '\r');
+	}
+
+	/// <summary>
+	/// Takes out spaces from the beginning and the end of a string, without copying it.
+	/// </summary>
+	/// <param name="stringToTrim">String to remove spaces from.</param>
+	/// <returns>The part of the passed in string without spaces in the front and end.</returns>
+	static std::string_view TrimSpaces(std::string_view stringToTrim) {
+		size_t start = stringToTrim.find_first_not_of(' ');
+		if (start == std::string_view::npos) {
+			return {};
+		}
+		return stringToTrim.substr(start, stringToTrim.find_last_not_of(' ') - start + 1);
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void Reader::Clear() {
@@ -24,6 +64,7 @@ namespace RTE {
 		m_SkipIncludes = false;
 		m_CanFail = false;
 		m_NonModulePath = false;
+		m_OpenedFromCache = false;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -41,6 +82,16 @@ namespace RTE {
 		Create(std::move(stream), overwrites, progressCallback, failOK);
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	Reader::~Reader() {
+		// Streams of files that were still being included own mapped files too, so let go of them along with the current one.
+		while (!m_StreamStack.empty()) {
+			delete m_StreamStack.top().Stream;
+			m_StreamStack.pop();
+		}
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	int Reader::Create(const std::string &fileName, bool overwrites, const ProgressCallback &progressCallback, bool failOK) {
@@ -62,7 +113,7 @@ namespace RTE {
 			m_DataModuleID = g_PresetMan.GetModuleID(m_DataModuleName);
 		}
 
-		return Create(std::make_unique<std::ifstream>(m_FilePath), overwrites, progressCallback, failOK);
+		return Create(OpenFileStream(m_FilePath, m_NonModulePath), overwrites, progressCallback, failOK);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -70,10 +121,21 @@ namespace RTE {
 	int Reader::Create(std::unique_ptr<std::istream> &&stream, bool overwrites, const ProgressCallback &progressCallback, bool failOK) {
 		m_CanFail = failOK;
 
-		m_Stream = std::move(stream);
+		if (ReaderStream *readerStream = dynamic_cast<ReaderStream *>(stream.get())) {
+			stream.release();
+			m_Stream.reset(readerStream);
+		} else {
+			// Any other stream is read whole up front, so it can be tokenized the same as a file.
+			m_Stream = std::make_unique<ReaderStream>();
+			if (stream && stream->good()) {
+				m_Stream->Create(std::make_shared<const std::string>(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>()));
+			} else {
+				m_Stream->setstate(std::ios_base::failbit);
+			}
+		}
 
 		if (!m_CanFail) { 
-			RTEAssert(System::PathExistsCaseSensitive(m_FilePath) && m_Stream->good(), "Failed to open data file \"" + m_FilePath + "\"!"); 
+			RTEAssert((m_OpenedFromCache || System::PathExistsCaseSensitive(m_FilePath)) && m_Stream->good(), "Failed to open data file \"" + m_FilePath + "\"!"); 
 		}
 
 		m_OverwriteExisting = overwrites;
@@ -87,6 +149,20 @@ namespace RTE {
 		return m_Stream->good() ? 0 : -1;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int Reader::Create(std::unique_ptr<std::istream> &&stream, const std::string &fileName, bool overwrites, const ProgressCallback &progressCallback, bool failOK) {
+		m_FilePath = g_PresetMan.GetFullModulePath(fileName);
+		m_FileName = m_FilePath.substr(m_FilePath.find_last_of("/\\") + 1);
+		m_DataModuleName = g_PresetMan.GetModuleNameFromPath(m_FilePath);
+		m_DataModuleID = g_PresetMan.GetModuleID(m_DataModuleName);
+
+		// The file isn't on disk to check for, whoever handed in its contents already found it.
+		m_OpenedFromCache = true;
+
+		return Create(std::move(stream), overwrites, progressCallback, failOK);
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	int Reader::GetReadModuleID() const {
@@ -106,26 +182,21 @@ namespace RTE {
 	std::string Reader::ReadLine() {
 		DiscardEmptySpace();
 
-		std::string retString;
-		char temp;
-		char peek = static_cast<char>(m_Stream->peek());
-
-		while (peek != '\n' && peek != '\r' && peek != '\t') {
-			temp = static_cast<char>(m_Stream->get());
+		const char *lineStart = m_Stream->GetCursor();
+		const char *contentsEnd = m_Stream->GetEnd();
 
-			// Check for line comment "//"
-			if (peek == '/' && m_Stream->peek() == '/') {
-				m_Stream->unget();
+		// The line's contents end at a line break or tab, or where a line comment "//" starts.
+		const char *lineEnd = FindCharacter(lineStart, FindLineEnd(lineStart, contentsEnd), '\t');
+		for (const char *slash = FindCharacter(lineStart, lineEnd, '/'); slash != lineEnd; slash = FindCharacter(slash + 1, lineEnd, '/')) {
+			if (slash + 1 != lineEnd && slash[1] == '/') {
+				lineEnd = slash;
 				break;
 			}
-
-			if (m_Stream->eof()) { break; }
-			if (!m_Stream->good()) { ReportError("Stream failed for some reason"); }
-
-			retString.append(1, temp);
-			peek = static_cast<char>(m_Stream->peek());
 		}
-		return TrimString(retString);
+		m_Stream->SetCursor(lineEnd);
+		if (lineEnd == contentsEnd) { m_Stream->setstate(std::ios_base::eofbit); }
+
+		return std::string(TrimSpaces(std::string_view(lineStart, static_cast<size_t>(lineEnd - lineStart))));
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -133,34 +204,31 @@ namespace RTE {
 	std::string Reader::ReadPropName() {
 		DiscardEmptySpace();
 
-		std::string retString;
-		char temp;
-		char peek;
+		const char *nameStart = m_Stream->GetCursor();
+		const char *contentsEnd = m_Stream->GetEnd();
+		const char *nameEnd = nameStart;
 
 		while (true) {
-			peek = static_cast<char>(m_Stream->peek());
-			if (peek == '=') {
-				m_Stream->ignore(1);
+			// The name ends at the '=', anything that ends the line before it means the value is missing.
+			const char *tab = FindCharacter(nameEnd, FindLineEnd(nameEnd, contentsEnd), '\t');
+			nameEnd = FindCharacter(nameEnd, tab, '=');
+			if (nameEnd == contentsEnd || *nameEnd == '=') {
 				break;
 			}
-			if (peek == '\n' || peek == '\r' || peek == '\t') {
-				ReportError("Property name wasn't followed by a value");
-			}
+			ReportError("Property name wasn't followed by a value");
+			++nameEnd;
+		}
+		// The name has to be copied out before the end of an included file is handled, as that lets go of its contents.
+		std::string retString(TrimSpaces(std::string_view(nameStart, static_cast<size_t>(nameEnd - nameStart))));
 
-			temp = static_cast<char>(m_Stream->get());
-			if (m_Stream->eof()) {
-				EndIncludeFile();
-				break;
-			}
-			if (!m_Stream->good() || temp == -1) { 
-				ReportError("Stream failed for some reason");
-				EndIncludeFile(); 
-				break; 
-			}
-			retString.append(1, temp);
+		if (nameEnd == contentsEnd) {
+			m_Stream->SetCursor(contentsEnd);
+			m_Stream->setstate(std::ios_base::eofbit);
+			EndIncludeFile();
+		} else {
+			// Skip past the '='.
+			m_Stream->SetCursor(nameEnd + 1);
 		}
-		// Trim the string of whitespace
-		retString = TrimString(retString);
 
 		// If the property name turns out to be the special IncludeFile,and we're not skipping include files then open that file and read the first property from it instead.
 		if (retString == "IncludeFile") {
@@ -218,29 +286,33 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	bool Reader::DiscardEmptySpace() {
-		char peek;
 		int indent = 0;
 		int leadingSpaceCount = 0;
 		bool discardedLine = false;
 
-		while (true) {
-			peek = static_cast<char>(m_Stream->peek());
+		// Not end-of-file but the stream failed anyway, meaning the last value read through it didn't parse... something went to shit
+		if (m_Stream->fail() && !m_Stream->eof()) { ReportError("Something went wrong reading the line; make sure it is providing the expected type"); }
 
+		const char *cursor = m_Stream->GetCursor();
+		const char *contentsEnd = m_Stream->GetEnd();
+
+		while (true) {
 			// If we have hit the end and don't have any files to resume, then quit and indicate that
-			if (m_Stream->eof()) {
+			if (cursor == contentsEnd) {
+				m_Stream->SetCursor(cursor);
+				m_Stream->setstate(std::ios_base::eofbit);
 				return EndIncludeFile();
 			}
-			// Not end-of-file but still got junk back... something went to shit
-			if (peek == -1) { ReportError("Something went wrong reading the line; make sure it is providing the expected type"); }
+			char peek = *cursor;
 
 			// Discard spaces
 			if (peek == ' ') {
 				leadingSpaceCount++;
-				m_Stream->ignore(1);
+				++cursor;
 			// Discard tabs, and count them
 			} else if (peek == '\t') {
 				indent++;
-				m_Stream->ignore(1);
+				++cursor;
 			// Discard newlines and reset the tab count for the new line, also count the lines
 			} else if (peek == '\n' || peek == '\r') {
 				// So we don't count lines twice when there are both newline and carriage return at the end of lines
@@ -254,53 +326,48 @@ namespace RTE {
 				indent = 0;
 				leadingSpaceCount = 0;
 				discardedLine = true;
-				m_Stream->ignore(1);
-
-			// Comment line?
-			} else if (m_Stream->peek() == '/') {
-				char temp = static_cast<char>(m_Stream->get());
-
-				// Confirm that it's a comment line, if so discard it and continue
-				if (m_Stream->peek() == '/') {
-					while (m_Stream->peek() != '\n' && m_Stream->peek() != '\r' && !m_Stream->eof()) { m_Stream->ignore(1); }
-				// Block comment
-				} else if (m_Stream->peek() == '*') {
-					int openBlockComments = 1;
-					m_BlockCommentOpenTagLines.emplace(m_CurrentLine);
-
-					char temp2 = 0;
-					while (openBlockComments > 0 && !m_Stream->eof()) {
-						temp2 = static_cast<char>(m_Stream->get());
-						if (temp2 == '\n') { ++m_CurrentLine; }
-
-						// Find the matching close tag.
-						if (!(temp2 == '*' && m_Stream->peek() == '/')) {
-							// Check if a nested block comment open tag.
-							if (temp2 == '/' && m_Stream->peek() == '*') {
-								openBlockComments++;
-								m_BlockCommentOpenTagLines.emplace(m_CurrentLine);
-							}
-						} else {
-							openBlockComments--;
-							m_BlockCommentOpenTagLines.pop();
+				++cursor;
+
+			// Comment line? Confirm that it's a comment line, if so discard it and continue
+			} else if (peek == '/' && cursor + 1 != contentsEnd && cursor[1] == '/') {
+				cursor = FindLineEnd(cursor + 2, contentsEnd);
+			// Block comment
+			} else if (peek == '/' && cursor + 1 != contentsEnd && cursor[1] == '*') {
+				int openBlockComments = 1;
+				m_BlockCommentOpenTagLines.emplace(m_CurrentLine);
+
+				// Scanning starts on the '*' of the open tag, so "/*/" opens and closes a comment right away.
+				++cursor;
+				while (openBlockComments > 0 && cursor != contentsEnd) {
+					char commentChar = *cursor++;
+					if (commentChar == '\n') { ++m_CurrentLine; }
+
+					// Find the matching close tag.
+					if (!(commentChar == '*' && cursor != contentsEnd && *cursor == '/')) {
+						// Check if a nested block comment open tag.
+						if (commentChar == '/' && cursor != contentsEnd && *cursor == '*') {
+							openBlockComments++;
+							m_BlockCommentOpenTagLines.emplace(m_CurrentLine);
 						}
+					} else {
+						openBlockComments--;
+						m_BlockCommentOpenTagLines.pop();
 					}
-					// Discard that final '/'.
-					if (!m_Stream->eof()) {
-						m_Stream->ignore(1);
-					} else if (openBlockComments > 0) {
-						ReportError("File stream ended with an open block comment!\nCouldn't find closing tag for block comment opened on line " + std::to_string(m_BlockCommentOpenTagLines.top()) + ".\n");
-					}
-
-				// Not a comment, so it's data, so quit.
-				} else {
-					m_Stream->putback(temp);
-					break;
 				}
+				// Discard that final '/'.
+				if (cursor != contentsEnd) {
+					++cursor;
+				} else if (openBlockComments > 0) {
+					m_Stream->SetCursor(cursor);
+					ReportError("File stream ended with an open block comment!\nCouldn't find closing tag for block comment opened on line " + std::to_string(m_BlockCommentOpenTagLines.top()) + ".\n");
+				}
+
+			// Not a comment, so it's data, so quit.
 			} else {
 				break;
 			}
 		}
+		m_Stream->SetCursor(cursor);
 
 		// This precaution enables us to use DiscardEmptySpace repeatedly without messing up the indentation tracking logic
 		if (discardedLine) {
@@ -324,6 +391,19 @@ namespace RTE {
 		}
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::unique_ptr<ReaderStream> Reader::OpenFileStream(const std::string &filePath, bool bypassCache) {
+		ReaderCache *activeCache = bypassCache ? nullptr : ReaderCache::GetActiveCache();
+		std::unique_ptr<ReaderStream> fileStream = activeCache ? activeCache->OpenFile(filePath) : nullptr;
+		m_OpenedFromCache = fileStream != nullptr;
+		if (!m_OpenedFromCache) {
+			fileStream = std::make_unique<ReaderStream>();
+			fileStream->Create(filePath);
+		}
+		return fileStream;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	bool Reader::StartIncludeFile() {
@@ -337,9 +417,9 @@ namespace RTE {
 		m_StreamStack.push(StreamInfo(m_Stream.release(), m_FilePath, m_CurrentLine, m_PreviousIndent));
 
 		m_FilePath = includeFilePath;
-		m_Stream = std::make_unique<std::ifstream>(m_FilePath);
+		m_Stream = OpenFileStream(m_FilePath, false);
 
-		if (m_Stream->fail() || !System::PathExistsCaseSensitive(includeFilePath)) {
+		if (m_Stream->fail() || (!m_OpenedFromCache && !System::PathExistsCaseSensitive(includeFilePath))) {
 			// Backpedal and set up to read the next property in the old stream
 			m_Stream.reset(m_StreamStack.top().Stream); // Destructs the current m_Stream and takes back ownership and management of the raw StreamInfo std::istream pointer.
 			m_FilePath = m_StreamStack.top().FilePath;
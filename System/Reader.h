@@ -1,12 +1,15 @@
 #ifndef _RTEREADER_
 #define _RTEREADER_
 
+#include "ReaderStream.h"
+
 namespace RTE {
 
 	using ProgressCallback = std::function<void(std::string, bool)>; //!< Convenient name definition for the progress report callback function.
 
 	/// <summary>
 	/// Reads RTE objects from std::istreams.
+	/// Everything is read through ReaderStreams, which hold the whole file in memory, so property names and values are tokenized by scanning the contents directly instead of going through the stream one character at a time.
 	/// </summary>
 	class Reader {
 
@@ -50,12 +53,30 @@ namespace RTE {
 		/// <summary>
 		/// Makes the Reader object ready for use.
 		/// </summary>
-		/// <param name="stream">Stream to read from.</param>
+		/// <param name="stream">Stream to read from. Anything other than a ReaderStream is read whole up front.</param>
 		/// <param name="overwrites"> Whether object definitions read here overwrite existing ones with the same names.</param>
 		/// <param name="progressCallback">A function pointer to a function that will be called and sent a string with information about the progress of this Reader's reading.</param>
 		/// <param name="failOK">Whether it's ok for the file to not be there, ie we're only trying to open, and if it's not there, then fail silently.</param>
 		/// <returns>An error return value signaling success or any particular failure.  Anything below 0 is an error signal.</returns>
 		int Create(std::unique_ptr<std::istream> &&stream, bool overwrites = false, const ProgressCallback &progressCallback = nullptr, bool failOK = false);
+
+		/// <summary>
+		/// Makes the Reader object ready for use, reading the contents of a file that isn't on disk by itself, e.g. one inside an archive, from a stream.
+		/// </summary>
+		/// <param name="stream">Stream to read the file's contents from.</param>
+		/// <param name="fileName">Path of the file the contents are from. It's never opened, only used to tell which DataModule the file belongs to and to report errors with.</param>
+		/// <param name="overwrites"> Whether object definitions read here overwrite existing ones with the same names.</param>
+		/// <param name="progressCallback">A function pointer to a function that will be called and sent a string with information about the progress of this Reader's reading.</param>
+		/// <param name="failOK">Whether it's ok for the stream to be bad, ie we're only trying to read, and if it's bad, then fail silently.</param>
+		/// <returns>An error return value signaling success or any particular failure.  Anything below 0 is an error signal.</returns>
+		int Create(std::unique_ptr<std::istream> &&stream, const std::string &fileName, bool overwrites = false, const ProgressCallback &progressCallback = nullptr, bool failOK = false);
+#pragma endregion
+
+#pragma region Destruction
+		/// <summary>
+		/// Destructor method used to clean up a Reader object before deletion from system memory.
+		/// </summary>
+		~Reader();
 #pragma endregion
 
 #pragma region Getters and Setters
@@ -211,16 +232,16 @@ namespace RTE {
 			/// <summary>
 			/// Constructor method used to instantiate a StreamInfo object in system memory.
 			/// </summary>
-			StreamInfo(std::istream *stream, const std::string &filePath, int currentLine, int prevIndent) : Stream(stream), FilePath(filePath), CurrentLine(currentLine), PreviousIndent(prevIndent) {}
+			StreamInfo(ReaderStream *stream, const std::string &filePath, int currentLine, int prevIndent) : Stream(stream), FilePath(filePath), CurrentLine(currentLine), PreviousIndent(prevIndent) {}
 
 			// NOTE: These members are owned by the reader that owns this struct, so are not deleted when this is destroyed.
-			std::istream *Stream; //!< Currently used stream, is not on the StreamStack until a new stream is opened.
+			ReaderStream *Stream; //!< Currently used stream, is not on the StreamStack until a new stream is opened.
 			std::string FilePath; //!< Currently used stream's filepath.
 			int CurrentLine; //!< The line number the stream is on.
 			int PreviousIndent; //!< Count of tabs encountered on the last line DiscardEmptySpace() discarded.
 		};
 
-		std::unique_ptr<std::istream> m_Stream; //!< Currently used stream, is not on the StreamStack until a new stream is opened.
+		std::unique_ptr<ReaderStream> m_Stream; //!< Currently used stream, is not on the StreamStack until a new stream is opened.
 		std::stack<StreamInfo> m_StreamStack; //!< Stack of open streams in this Reader, each one representing a file opened to read from within another.
 		bool m_EndOfStreams; //!< All streams have been depleted.
 
@@ -241,6 +262,7 @@ namespace RTE {
 		bool m_SkipIncludes; //!< Indicates whether reader should skip included files.
 		bool m_CanFail; //!< Whether it's ok for the Reader to fail reading a file and fail silently instead of aborting.
 		bool m_NonModulePath; //!< Whether this Reader is reading from path that is not a DataModule and should just read it as provided.
+		bool m_OpenedFromCache; //!< Whether the current stream was opened through the active ReaderCache or handed in with the contents of a file that isn't on disk, meaning the file's existence was already verified.
 
 		std::stack<int> m_BlockCommentOpenTagLines; //<! Stores lines on which block comment open tags are encountered. Used for error reporting when a file stream ends with an open block comment.
 
@@ -253,6 +275,14 @@ namespace RTE {
 	private:
 
 #pragma region Reading Operations
+		/// <summary>
+		/// Opens a stream to a file, through the ReaderCache active on this thread if there is one. Sets m_OpenedFromCache accordingly.
+		/// </summary>
+		/// <param name="filePath">Path to the file to open.</param>
+		/// <param name="bypassCache">Whether to read the file straight from disk even if there is an active ReaderCache.</param>
+		/// <returns>A stream to the file, which has failed if it couldn't be opened.</returns>
+		std::unique_ptr<ReaderStream> OpenFileStream(const std::string &filePath, bool bypassCache);
+
 		/// <summary>
 		/// When ReadPropName encounters the property name "IncludeFile", it will automatically call this function to get started reading on that file.
 		/// This will create a new stream to the include file.
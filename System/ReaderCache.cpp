@@ -0,0 +1,229 @@
+#include "ReaderCache.h"
+#include "ReaderStream.h"
+#include "System.h"
+
+namespace RTE {
+
+	const std::string ReaderCache::c_CacheDirectory = "Cache/";
+
+	thread_local ReaderCache *ReaderCache::s_ActiveCache = nullptr;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ReaderCache::Clear() {
+		m_CacheFilePath.clear();
+		m_CachedFiles.clear();
+		m_CacheChanged = false;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int ReaderCache::Create(const std::string &moduleName) {
+		m_CacheFilePath = System::GetWorkingDirectory() + System::GetUserdataDirectory() + c_CacheDirectory + std::filesystem::path(moduleName).filename().generic_string() + ".cache";
+
+		std::ifstream cacheFile(m_CacheFilePath, std::ios::binary | std::ios::ate);
+		if (!cacheFile.good()) {
+			// No cache yet, it'll be written once the module is loaded.
+			m_CacheChanged = true;
+			return 0;
+		}
+		std::string cacheData(static_cast<size_t>(cacheFile.tellg()), '\0');
+		cacheFile.seekg(0);
+		cacheFile.read(cacheData.data(), static_cast<std::streamsize>(cacheData.size()));
+
+		size_t readPos = 0;
+		auto readBytes = [&cacheData, &readPos](void *destination, size_t byteCount) {
+			if (cacheData.size() - readPos < byteCount) {
+				return false;
+			}
+			std::memcpy(destination, cacheData.data() + readPos, byteCount);
+			readPos += byteCount;
+			return true;
+		};
+		auto readString = [&cacheData, &readPos, &readBytes](std::string &destination) {
+			uint32_t stringLength = 0;
+			if (!readBytes(&stringLength, sizeof(stringLength)) || cacheData.size() - readPos < stringLength) {
+				return false;
+			}
+			destination.assign(cacheData, readPos, stringLength);
+			readPos += stringLength;
+			return true;
+		};
+
+		uint32_t signature = 0;
+		uint32_t formatVersion = 0;
+		uint32_t fileCount = 0;
+		bool cacheValid = cacheFile.good() && readBytes(&signature, sizeof(signature)) && readBytes(&formatVersion, sizeof(formatVersion)) && readBytes(&fileCount, sizeof(fileCount));
+		cacheValid = cacheValid && signature == c_CacheFileSignature && formatVersion == c_CacheFormatVersion;
+
+		for (uint32_t fileIndex = 0; cacheValid && fileIndex < fileCount; ++fileIndex) {
+			std::string filePath;
+			std::string fileContents;
+			CachedFile cachedFile;
+			cacheValid = readString(filePath) && readBytes(&cachedFile.ModificationTime, sizeof(cachedFile.ModificationTime)) && readBytes(&cachedFile.FileSize, sizeof(cachedFile.FileSize)) && readString(fileContents);
+			cachedFile.Contents = std::make_shared<const std::string>(std::move(fileContents));
+			cachedFile.Used = false;
+			cachedFile.Validated = false;
+			if (cacheValid) { m_CachedFiles.try_emplace(std::move(filePath), std::move(cachedFile)); }
+		}
+		if (!cacheValid) {
+			// Stale format or a truncated write, throw it all away and rebuild it from the text files.
+			m_CachedFiles.clear();
+			m_CacheChanged = true;
+		}
+		return 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::unique_ptr<ReaderStream> ReaderCache::OpenFile(const std::string &filePath) {
+		auto cachedFileEntry = m_CachedFiles.find(filePath);
+		if (cachedFileEntry != m_CachedFiles.end() && cachedFileEntry->second.Validated) {
+			cachedFileEntry->second.Used = true;
+			return std::make_unique<ReaderStream>(cachedFileEntry->second.Contents);
+		}
+
+		long long modificationTime = 0;
+		uintmax_t fileSize = 0;
+		if (!GetFileStamp(filePath, modificationTime, fileSize)) {
+			return nullptr;
+		}
+		if (cachedFileEntry != m_CachedFiles.end()) {
+			CachedFile &cachedFile = cachedFileEntry->second;
+			if (cachedFile.ModificationTime == modificationTime && cachedFile.FileSize == fileSize) {
+				cachedFile.Used = true;
+				return std::make_unique<ReaderStream>(cachedFile.Contents);
+			}
+		}
+
+		// Cache miss or stale entry. The case sensitive check is only needed here, cached paths already passed it when they were first read.
+		if (!System::PathExistsCaseSensitive(filePath)) {
+			return nullptr;
+		}
+		ReaderStream fileStream;
+		if (fileStream.Create(filePath) < 0) {
+			return nullptr;
+		}
+
+		CachedFile &cachedFile = m_CachedFiles[filePath];
+		cachedFile.ModificationTime = modificationTime;
+		cachedFile.FileSize = fileSize;
+		cachedFile.Contents = std::make_shared<const std::string>(StripFileContents(std::string(fileStream.GetCursor(), fileStream.GetEnd())));
+		cachedFile.Used = true;
+		cachedFile.Validated = true;
+		m_CacheChanged = true;
+
+		return std::make_unique<ReaderStream>(cachedFile.Contents);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ReaderCache::ValidateCachedFiles() {
+		for (auto cachedFileEntry = m_CachedFiles.begin(); cachedFileEntry != m_CachedFiles.end();) {
+			long long modificationTime = 0;
+			uintmax_t fileSize = 0;
+			CachedFile &cachedFile = cachedFileEntry->second;
+			cachedFile.Validated = GetFileStamp(cachedFileEntry->first, modificationTime, fileSize) && cachedFile.ModificationTime == modificationTime && cachedFile.FileSize == fileSize;
+			if (cachedFile.Validated) {
+				++cachedFileEntry;
+			} else {
+				// Stale files are dropped rather than kept around for OpenFile to find, so the cache file needs to be written again without them.
+				cachedFileEntry = m_CachedFiles.erase(cachedFileEntry);
+				m_CacheChanged = true;
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool ReaderCache::Save() {
+		if (std::erase_if(m_CachedFiles, [](const auto &cachedFileEntry) { return !cachedFileEntry.second.Used; }) > 0) {
+			m_CacheChanged = true;
+		}
+		if (!m_CacheChanged || m_CacheFilePath.empty()) {
+			return true;
+		}
+		const std::string cacheDirectory = System::GetWorkingDirectory() + System::GetUserdataDirectory() + c_CacheDirectory;
+		if (!std::filesystem::exists(cacheDirectory)) { System::MakeDirectory(cacheDirectory); }
+
+		// Write to a temporary file first so a crash mid-write can't leave a truncated cache that looks valid.
+		const std::string tempCacheFilePath = m_CacheFilePath + ".tmp";
+		std::ofstream cacheFile(tempCacheFilePath, std::ios::binary | std::ios::trunc);
+		if (!cacheFile.good()) {
+			return false;
+		}
+		auto writeBytes = [&cacheFile](const void *source, size_t byteCount) { cacheFile.write(static_cast<const char *>(source), static_cast<std::streamsize>(byteCount)); };
+		auto writeString = [&writeBytes](const std::string &source) {
+			uint32_t stringLength = static_cast<uint32_t>(source.size());
+			writeBytes(&stringLength, sizeof(stringLength));
+			writeBytes(source.data(), source.size());
+		};
+
+		uint32_t fileCount = static_cast<uint32_t>(m_CachedFiles.size());
+		writeBytes(&c_CacheFileSignature, sizeof(c_CacheFileSignature));
+		writeBytes(&c_CacheFormatVersion, sizeof(c_CacheFormatVersion));
+		writeBytes(&fileCount, sizeof(fileCount));
+		for (const auto &[filePath, cachedFile] : m_CachedFiles) {
+			writeString(filePath);
+			writeBytes(&cachedFile.ModificationTime, sizeof(cachedFile.ModificationTime));
+			writeBytes(&cachedFile.FileSize, sizeof(cachedFile.FileSize));
+			writeString(*cachedFile.Contents);
+		}
+		cacheFile.close();
+
+		std::error_code errorCode;
+		if (cacheFile.fail()) {
+			std::filesystem::remove(tempCacheFilePath, errorCode);
+			return false;
+		}
+		std::filesystem::rename(tempCacheFilePath, m_CacheFilePath, errorCode);
+		if (errorCode) {
+			return false;
+		}
+		m_CacheChanged = false;
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool ReaderCache::GetFileStamp(const std::string &filePath, long long &modificationTime, uintmax_t &fileSize) {
+		std::error_code errorCode;
+		std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(filePath, errorCode);
+		if (errorCode) {
+			return false;
+		}
+		fileSize = std::filesystem::file_size(filePath, errorCode);
+		if (errorCode) {
+			return false;
+		}
+		modificationTime = static_cast<long long>(lastWriteTime.time_since_epoch().count());
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::string ReaderCache::StripFileContents(const std::string &contents) {
+		if (contents.find("/*") != std::string::npos || contents.find("*/") != std::string::npos) {
+			return contents;
+		}
+		std::string strippedContents;
+		strippedContents.reserve(contents.size());
+
+		// Line breaks are copied as they are, both '\n' and '\r' end a line as far as the Reader is concerned.
+		size_t lineStart = 0;
+		while (lineStart <= contents.size()) {
+			size_t lineEnd = contents.find_first_of("\r\n", lineStart);
+			if (lineEnd == std::string::npos) { lineEnd = contents.size(); }
+
+			std::string_view line(contents.data() + lineStart, lineEnd - lineStart);
+			size_t firstDataChar = line.find_first_not_of(" \t");
+			// The Reader discards whole lines starting with "//" and only ever trims whitespace off the end of values, so neither affects what it reads.
+			if (firstDataChar != std::string_view::npos && !line.substr(firstDataChar).starts_with("//")) {
+				strippedContents.append(line.substr(0, line.find_last_not_of(" \t") + 1));
+			}
+			if (lineEnd < contents.size()) { strippedContents.push_back(contents[lineEnd]); }
+			lineStart = lineEnd + 1;
+		}
+		return strippedContents;
+	}
+}
@@ -0,0 +1,115 @@
+#ifndef _RTEREADERCACHE_
+#define _RTEREADERCACHE_
+
+namespace RTE {
+
+	class ReaderStream;
+
+	/// <summary>
+	/// A versioned binary cache of all the data files read while loading a DataModule, so the next launch can read the whole module from one file instead of opening, checking and scanning each of its .ini files separately.
+	/// Files are stored with their full-line comments and trailing whitespace stripped, and each is keyed on its path, size and modification time, so any file that changed since is transparently read from disk again and the cache rewritten.
+	/// </summary>
+	class ReaderCache {
+
+	public:
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate a ReaderCache object in system memory. Create() should be called before using the object.
+		/// </summary>
+		ReaderCache() { Clear(); }
+
+		/// <summary>
+		/// Makes the ReaderCache object ready for use, reading the cache file of the given DataModule if there is a valid one.
+		/// </summary>
+		/// <param name="moduleName">The name of the DataModule this ReaderCache is for, including the .rte extension.</param>
+		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
+		int Create(const std::string &moduleName);
+#pragma endregion
+
+#pragma region Getters and Setters
+		/// <summary>
+		/// Gets the ReaderCache that Readers on this thread open their files through, if any.
+		/// </summary>
+		/// <returns>A pointer to the ReaderCache that is active on this thread. Ownership is NOT transferred!</returns>
+		static ReaderCache * GetActiveCache() { return s_ActiveCache; }
+
+		/// <summary>
+		/// Sets the ReaderCache that Readers on this thread open their files through.
+		/// </summary>
+		/// <param name="activeCache">A pointer to the ReaderCache to make active on this thread, or nullptr to read straight from disk. Ownership is NOT transferred!</param>
+		static void SetActiveCache(ReaderCache *activeCache) { s_ActiveCache = activeCache; }
+
+		/// <summary>
+		/// Gets the size and modification time of a file on disk.
+		/// </summary>
+		/// <param name="filePath">Path to the file.</param>
+		/// <param name="modificationTime">Reference to fill with the file's modification time, in file clock ticks.</param>
+		/// <param name="fileSize">Reference to fill with the file's size, in bytes.</param>
+		/// <returns>Whether the file exists and both could be read.</returns>
+		static bool GetFileStamp(const std::string &filePath, long long &modificationTime, uintmax_t &fileSize);
+#pragma endregion
+
+#pragma region Concrete Methods
+		/// <summary>
+		/// Opens a stream to the contents of a data file. If the file isn't cached, or has changed since it was, it's read from disk and cached.
+		/// </summary>
+		/// <param name="filePath">Path to the file to open, as the Reader would open it.</param>
+		/// <returns>A stream to the file's contents, or nullptr if the file doesn't exist or couldn't be read, in which case the Reader should handle it as usual. The contents are shared with this ReaderCache, not copied.</returns>
+		std::unique_ptr<ReaderStream> OpenFile(const std::string &filePath);
+
+		/// <summary>
+		/// Checks every cached file against the file on disk up front, dropping the ones that changed or no longer exist, so OpenFile can hand out the rest without checking them again.
+		/// Only touches the disk and this ReaderCache, so it can be done on another thread while other DataModules are being loaded, as long as nothing else uses this ReaderCache meanwhile.
+		/// </summary>
+		void ValidateCachedFiles();
+
+		/// <summary>
+		/// Writes this ReaderCache to its cache file if any file was read from disk or is no longer used. Should only be called after the DataModule was loaded successfully.
+		/// </summary>
+		/// <returns>Whether the cache file is up to date.</returns>
+		bool Save();
+#pragma endregion
+
+	private:
+
+		/// <summary>
+		/// A data file's stripped contents along with what they were read from.
+		/// </summary>
+		struct CachedFile {
+			long long ModificationTime; //!< The modification time of the file when it was read, in file clock ticks.
+			uintmax_t FileSize; //!< The size of the file on disk when it was read, in bytes.
+			std::shared_ptr<const std::string> Contents; //!< The file's contents, with full-line comments and trailing whitespace stripped. Shared with the ReaderStreams reading them, so they stay valid even if the file is read again.
+			bool Used; //!< Whether this file was opened during this load. Files that weren't are dropped when saving.
+			bool Validated; //!< Whether this file was already checked against the file on disk by ValidateCachedFiles, so opening it doesn't need to check it again.
+		};
+
+		static constexpr uint32_t c_CacheFileSignature = 0x43455452; //!< Signature at the start of every cache file, "RTEC" in little-endian.
+		static constexpr uint32_t c_CacheFormatVersion = 1; //!< Version of the cache file layout and stripping rules. Cache files with any other version are discarded.
+		static const std::string c_CacheDirectory; //!< The folder cache files are kept in, inside the userdata directory.
+
+		static thread_local ReaderCache *s_ActiveCache; //!< The ReaderCache Readers on this thread open their files through. Not owned.
+
+		std::string m_CacheFilePath; //!< Path to the cache file of the DataModule this is for.
+		std::unordered_map<std::string, CachedFile> m_CachedFiles; //!< The cached files, mapped by the path the Reader opens them with.
+		bool m_CacheChanged; //!< Whether any file was read from disk since the cache file was read, meaning it needs to be written again.
+
+		/// <summary>
+		/// Strips full-line comments and trailing whitespace from a data file's contents, keeping all line breaks so line numbers in error reports stay the same.
+		/// Files with block comments are left untouched, as whether "/*" starts a comment depends on where the Reader is when it reaches it.
+		/// </summary>
+		/// <param name="contents">The data file's contents.</param>
+		/// <returns>The stripped contents, which the Reader reads exactly the same as the original ones.</returns>
+		static std::string StripFileContents(const std::string &contents);
+
+		/// <summary>
+		/// Clears all the member variables of this ReaderCache, effectively resetting the members of this abstraction level only.
+		/// </summary>
+		void Clear();
+
+		// Disallow the use of some implicit methods.
+		ReaderCache(const ReaderCache &reference) = delete;
+		ReaderCache & operator=(const ReaderCache &rhs) = delete;
+	};
+}
+#endif
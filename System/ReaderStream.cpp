@@ -0,0 +1,148 @@
+#include "ReaderStream.h"
+
+#ifdef _WIN32
+#include "Windows.h"
+#elif defined _LINUX_OR_MACOSX_
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace RTE {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ReaderStream::Clear() {
+		m_Buffer.SetContents(nullptr, nullptr);
+		m_SharedContents.reset();
+		m_MappedData = nullptr;
+		m_MappedSize = 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	ReaderStream::ReaderStream() : std::istream(nullptr) {
+		Clear();
+		rdbuf(&m_Buffer);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	ReaderStream::ReaderStream(std::shared_ptr<const std::string> contents) : std::istream(nullptr) {
+		Clear();
+		rdbuf(&m_Buffer);
+		Create(std::move(contents));
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int ReaderStream::Create(const std::string &filePath) {
+		Destroy();
+		clear();
+
+		bool fileRead = false;
+#ifdef _WIN32
+		HANDLE fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		LARGE_INTEGER fileSize;
+		if (fileHandle != INVALID_HANDLE_VALUE && GetFileSizeEx(fileHandle, &fileSize)) {
+			// Empty files can't be mapped, but there's nothing to read from them anyway.
+			fileRead = fileSize.QuadPart == 0;
+			if (!fileRead) {
+				HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if (mappingHandle) {
+					// The view keeps the mapping alive on its own, so the handle can be closed right away.
+					m_MappedData = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+					CloseHandle(mappingHandle);
+				}
+				fileRead = m_MappedData != nullptr;
+				m_MappedSize = fileRead ? static_cast<size_t>(fileSize.QuadPart) : 0;
+			}
+		}
+		if (fileHandle != INVALID_HANDLE_VALUE) { CloseHandle(fileHandle); }
+#elif defined _LINUX_OR_MACOSX_
+		int fileDescriptor = open(filePath.c_str(), O_RDONLY);
+		struct stat fileStatus;
+		if (fileDescriptor != -1 && fstat(fileDescriptor, &fileStatus) == 0 && S_ISREG(fileStatus.st_mode)) {
+			// Empty files can't be mapped, but there's nothing to read from them anyway.
+			fileRead = fileStatus.st_size == 0;
+			if (!fileRead) {
+				void *mappedData = mmap(nullptr, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+				if (mappedData != MAP_FAILED) {
+					m_MappedData = mappedData;
+					m_MappedSize = static_cast<size_t>(fileStatus.st_size);
+					madvise(m_MappedData, m_MappedSize, MADV_SEQUENTIAL);
+					fileRead = true;
+				}
+			}
+		}
+		// The mapping keeps the file open on its own, so the descriptor can be closed right away.
+		if (fileDescriptor != -1) { close(fileDescriptor); }
+#else
+		std::ifstream fileStream(filePath, std::ios::binary);
+		if (fileStream.good()) {
+			m_SharedContents = std::make_shared<const std::string>(std::istreambuf_iterator<char>(fileStream), std::istreambuf_iterator<char>());
+			fileRead = !fileStream.bad();
+		}
+#endif
+		if (!fileRead) {
+			Destroy();
+			setstate(std::ios_base::failbit);
+			return -1;
+		}
+		if (m_MappedData) {
+			m_Buffer.SetContents(static_cast<const char *>(m_MappedData), static_cast<const char *>(m_MappedData) + m_MappedSize);
+		} else if (m_SharedContents) {
+			m_Buffer.SetContents(m_SharedContents->data(), m_SharedContents->data() + m_SharedContents->size());
+		}
+		return 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int ReaderStream::Create(std::shared_ptr<const std::string> contents) {
+		Destroy();
+		clear();
+
+		if (!contents) {
+			setstate(std::ios_base::failbit);
+			return -1;
+		}
+		m_SharedContents = std::move(contents);
+		m_Buffer.SetContents(m_SharedContents->data(), m_SharedContents->data() + m_SharedContents->size());
+		return 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ReaderStream::Destroy() {
+		if (m_MappedData) {
+#ifdef _WIN32
+			UnmapViewOfFile(m_MappedData);
+#elif defined _LINUX_OR_MACOSX_
+			munmap(m_MappedData, m_MappedSize);
+#endif
+		}
+		Clear();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	ReaderStream::ContentsBuffer::pos_type ReaderStream::ContentsBuffer::seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) {
+		if (!(which & std::ios_base::in)) {
+			return pos_type(off_type(-1));
+		}
+		off_type basePosition = 0;
+		if (direction == std::ios_base::cur) {
+			basePosition = gptr() - eback();
+		} else if (direction == std::ios_base::end) {
+			basePosition = egptr() - eback();
+		}
+		off_type newPosition = basePosition + offset;
+		if (newPosition < 0 || newPosition > egptr() - eback()) {
+			return pos_type(off_type(-1));
+		}
+		setg(eback(), eback() + newPosition, egptr());
+		return pos_type(newPosition);
+	}
+}
@@ -0,0 +1,114 @@
+#ifndef _RTEREADERSTREAM_
+#define _RTEREADERSTREAM_
+
+namespace RTE {
+
+	/// <summary>
+	/// An input stream over the whole contents of a data file held in memory, either mapped straight from the file on disk or shared with whatever read them, like the ReaderCache or a save game archive.
+	/// Besides being read as a regular std::istream, the contents can be scanned directly through a cursor. This is how the Reader tokenizes data files without going through the stream one character at a time.
+	/// </summary>
+	class ReaderStream : public std::istream {
+
+	public:
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate a ReaderStream object in system memory. Create() should be called before using the object.
+		/// </summary>
+		ReaderStream();
+
+		/// <summary>
+		/// Constructor method used to instantiate a ReaderStream object in system memory and make it ready for reading the passed in contents.
+		/// </summary>
+		/// <param name="contents">The contents to read. Shared with whatever else holds on to them, they are not copied.</param>
+		explicit ReaderStream(std::shared_ptr<const std::string> contents);
+
+		/// <summary>
+		/// Makes the ReaderStream object ready for reading a file, by mapping the file into memory. If the file can't be mapped, the stream fails.
+		/// </summary>
+		/// <param name="filePath">Path to the file to read.</param>
+		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
+		int Create(const std::string &filePath);
+
+		/// <summary>
+		/// Makes the ReaderStream object ready for reading the passed in contents.
+		/// </summary>
+		/// <param name="contents">The contents to read. Shared with whatever else holds on to them, they are not copied.</param>
+		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
+		int Create(std::shared_ptr<const std::string> contents);
+#pragma endregion
+
+#pragma region Destruction
+		/// <summary>
+		/// Destructor method used to clean up a ReaderStream object before deletion from system memory.
+		/// </summary>
+		~ReaderStream() override { Destroy(); }
+
+		/// <summary>
+		/// Unmaps or lets go of the contents of this ReaderStream, leaving it empty.
+		/// </summary>
+		void Destroy();
+#pragma endregion
+
+#pragma region Cursor Handling
+		/// <summary>
+		/// Gets the position in the contents the stream will read from next.
+		/// </summary>
+		/// <returns>A pointer to the next character to be read.</returns>
+		const char * GetCursor() const { return m_Buffer.GetCursor(); }
+
+		/// <summary>
+		/// Gets the end of the contents.
+		/// </summary>
+		/// <returns>A pointer to one past the last character of the contents.</returns>
+		const char * GetEnd() const { return m_Buffer.GetEnd(); }
+
+		/// <summary>
+		/// Moves the position in the contents the stream will read from next, e.g. past characters that were scanned directly.
+		/// </summary>
+		/// <param name="cursor">A pointer to the next character to be read. Must be between the current start of the contents and GetEnd().</param>
+		void SetCursor(const char *cursor) { m_Buffer.SetCursor(cursor); }
+#pragma endregion
+
+	private:
+
+		/// <summary>
+		/// A read-only stream buffer whose get area covers the whole contents, so reading never has to refill it and the cursor can be moved freely.
+		/// </summary>
+		class ContentsBuffer : public std::streambuf {
+
+		public:
+
+			/// <summary>
+			/// Sets the contents this ContentsBuffer reads, and moves the cursor to their start.
+			/// </summary>
+			/// <param name="begin">A pointer to the first character of the contents.</param>
+			/// <param name="end">A pointer to one past the last character of the contents.</param>
+			void SetContents(const char *begin, const char *end) { setg(const_cast<char *>(begin), const_cast<char *>(begin), const_cast<char *>(end)); }
+
+			const char * GetCursor() const { return gptr(); }
+			const char * GetEnd() const { return egptr(); }
+			void SetCursor(const char *cursor) { setg(eback(), const_cast<char *>(cursor), egptr()); }
+
+		protected:
+
+			pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override;
+			pos_type seekpos(pos_type position, std::ios_base::openmode which) override { return seekoff(static_cast<off_type>(position), std::ios_base::beg, which); }
+		};
+
+		ContentsBuffer m_Buffer; //!< The stream buffer over the contents.
+		std::shared_ptr<const std::string> m_SharedContents; //!< The contents, if they were handed in rather than mapped from a file.
+		void *m_MappedData; //!< The start of the mapped file, if the contents were mapped from one.
+		size_t m_MappedSize; //!< The size of the mapped file, in bytes.
+
+		/// <summary>
+		/// Clears all the member variables of this ReaderStream, effectively resetting the members of this abstraction level only.
+		/// </summary>
+		void Clear();
+
+		// Disallow the use of some implicit methods.
+		ReaderStream(const ReaderStream &reference) = delete;
+		ReaderStream & operator=(const ReaderStream &rhs) = delete;
+	};
+}
+#endif
@@ -0,0 +1,250 @@
+#include "SaveGameArchive.h"
+#include "ContentFile.h"
+#include "ThreadMan.h"
+
+#include "zip.h"
+#include "unzip.h"
+#include "lz4.h"
+
+namespace RTE {
+
+	const std::string SaveGameArchive::c_FileExtension = ".ccsave";
+	const std::string SaveGameArchive::c_SaveDataEntryName = "Save.ini";
+	const std::string SaveGameArchive::c_BitmapEntryExtension = ".lz4";
+
+	/// <summary>
+	/// The header at the start of every bitmap entry, followed by the LZ4 compressed rows of pixels.
+	/// </summary>
+	struct BitmapEntryHeader {
+		uint32_t Signature; //!< Signature identifying the entry as a bitmap, "RTEB" in little-endian.
+		int32_t Width; //!< Width of the bitmap, in pixels.
+		int32_t Height; //!< Height of the bitmap, in pixels.
+		int32_t ColorDepth; //!< Color depth of the bitmap, in bits per pixel.
+	};
+
+	static constexpr uint32_t c_BitmapEntrySignature = 0x42455452;
+	static constexpr int c_TextEntryCompressionLevel = 1; //!< Text entries are small, so a quick deflate pass is all they need.
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SaveGameArchive::Clear() {
+		m_ArchivePath.clear();
+		m_TemporaryArchivePath.clear();
+		m_ReplacedDirectoryPath.clear();
+		m_ZipFile = nullptr;
+		m_WriteFailed = false;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int SaveGameArchive::Create(const std::string &archivePath, const std::string &replacedDirectoryPath) {
+		m_ArchivePath = archivePath;
+		m_TemporaryArchivePath = archivePath + ".tmp";
+		m_ReplacedDirectoryPath = replacedDirectoryPath;
+
+		m_ZipFile = zipOpen64(m_TemporaryArchivePath.c_str(), APPEND_STATUS_CREATE);
+		return m_ZipFile ? 0 : -1;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SaveGameArchive::Destroy() {
+		if (m_ZipFile) {
+			bool closed = zipClose(m_ZipFile, nullptr) == ZIP_OK;
+			std::error_code errorCode;
+			if (closed && !m_WriteFailed) {
+				std::filesystem::rename(m_TemporaryArchivePath, m_ArchivePath, errorCode);
+				if (!errorCode && !m_ReplacedDirectoryPath.empty() && std::filesystem::is_directory(m_ReplacedDirectoryPath, errorCode)) { std::filesystem::remove_all(m_ReplacedDirectoryPath, errorCode); }
+			} else {
+				std::filesystem::remove(m_TemporaryArchivePath, errorCode);
+			}
+		}
+		Clear();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool SaveGameArchive::WriteBitmapEntry(const std::string &entryName, const BITMAP *bitmap) {
+		int rowSize = bitmap->w * ((bitmap_color_depth(const_cast<BITMAP *>(bitmap)) + 7) / 8);
+		int pixelDataSize = rowSize * bitmap->h;
+
+		std::vector<char> pixelData(pixelDataSize);
+		for (int y = 0; y < bitmap->h; ++y) {
+			std::memcpy(pixelData.data() + y * rowSize, bitmap->line[y], rowSize);
+		}
+
+		// Compress before taking the lock, so bitmaps being written from several threads are compressed in parallel.
+		std::vector<char> entryData(sizeof(BitmapEntryHeader) + LZ4_compressBound(pixelDataSize));
+		BitmapEntryHeader header = { c_BitmapEntrySignature, bitmap->w, bitmap->h, bitmap_color_depth(const_cast<BITMAP *>(bitmap)) };
+		std::memcpy(entryData.data(), &header, sizeof(header));
+
+		int compressedSize = LZ4_compress_default(pixelData.data(), entryData.data() + sizeof(header), pixelDataSize, static_cast<int>(entryData.size() - sizeof(header)));
+		if (compressedSize <= 0 && pixelDataSize > 0) {
+			std::lock_guard<std::mutex> zipFileLock(m_ZipFileMutex);
+			m_WriteFailed = true;
+			return false;
+		}
+
+		// The LZ4 data hardly deflates any further, so store it as is.
+		std::lock_guard<std::mutex> zipFileLock(m_ZipFileMutex);
+		return WriteEntry(entryName, entryData.data(), sizeof(header) + compressedSize, 0);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool SaveGameArchive::WriteTextEntry(const std::string &entryName, const std::string &text) {
+		std::lock_guard<std::mutex> zipFileLock(m_ZipFileMutex);
+		return WriteEntry(entryName, text.data(), text.size(), c_TextEntryCompressionLevel);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool SaveGameArchive::WriteEntry(const std::string &entryName, const char *data, size_t dataSize, int compressionLevel) {
+		if (!m_ZipFile || m_WriteFailed) {
+			m_WriteFailed = true;
+			return false;
+		}
+		zip_fileinfo entryInfo = {};
+		std::time_t currentTime = std::time(nullptr);
+		entryInfo.tmz_date = *std::localtime(&currentTime);
+
+		bool entryWritten = zipOpenNewFileInZip_64(m_ZipFile, entryName.c_str(), &entryInfo, nullptr, 0, nullptr, 0, nullptr, compressionLevel > 0 ? Z_DEFLATED : 0, compressionLevel, 1) == ZIP_OK;
+		if (entryWritten) {
+			// zipWriteInFileInZip takes 32 bit lengths, so write large entries in chunks.
+			size_t bytesWritten = 0;
+			while (entryWritten && bytesWritten < dataSize) {
+				uint32_t chunkSize = static_cast<uint32_t>(std::min<size_t>(dataSize - bytesWritten, std::numeric_limits<int32_t>::max()));
+				entryWritten = zipWriteInFileInZip(m_ZipFile, data + bytesWritten, chunkSize) == ZIP_OK;
+				bytesWritten += chunkSize;
+			}
+			entryWritten = zipCloseFileInZip(m_ZipFile) == ZIP_OK && entryWritten;
+		}
+		if (!entryWritten) { m_WriteFailed = true; }
+		return entryWritten;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// <summary>
+	/// Reads the whole entry the archive is currently at.
+	/// </summary>
+	/// <param name="archive">The archive to read from.</param>
+	/// <param name="entrySize">The uncompressed size of the entry, in bytes.</param>
+	/// <param name="entryData">Buffer to fill with the entry's data.</param>
+	/// <returns>Whether the entry was read successfully.</returns>
+	static bool ReadCurrentEntry(unzFile archive, uint64_t entrySize, std::vector<char> &entryData) {
+		if (unzOpenCurrentFile(archive) != UNZ_OK) {
+			return false;
+		}
+		entryData.resize(static_cast<size_t>(entrySize));
+		size_t bytesRead = 0;
+		bool entryRead = true;
+		while (entryRead && bytesRead < entryData.size()) {
+			uint32_t chunkSize = static_cast<uint32_t>(std::min<size_t>(entryData.size() - bytesRead, std::numeric_limits<int32_t>::max()));
+			int chunkBytesRead = unzReadCurrentFile(archive, entryData.data() + bytesRead, chunkSize);
+			entryRead = chunkBytesRead > 0;
+			bytesRead += entryRead ? static_cast<size_t>(chunkBytesRead) : 0;
+		}
+		// Closing checks the CRC of the entry once it was read to the end.
+		return unzCloseCurrentFile(archive) == UNZ_OK && entryRead;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool SaveGameArchive::ReadTextEntry(const std::string &archivePath, const std::string &entryName, std::string &text) {
+		unzFile archive = unzOpen64(archivePath.c_str());
+		if (!archive) {
+			return false;
+		}
+		bool entryRead = false;
+		unz_file_info64 entryInfo;
+		if (unzLocateFile(archive, entryName.c_str(), nullptr) == UNZ_OK && unzGetCurrentFileInfo64(archive, &entryInfo, nullptr, 0, nullptr, 0, nullptr, 0) == UNZ_OK) {
+			std::vector<char> entryData;
+			entryRead = ReadCurrentEntry(archive, entryInfo.uncompressed_size, entryData);
+			text.assign(entryData.begin(), entryData.end());
+		}
+		unzClose(archive);
+		return entryRead;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool SaveGameArchive::PreloadBitmapEntries(const std::string &archivePath) {
+		unzFile archive = unzOpen64(archivePath.c_str());
+		if (!archive) {
+			return false;
+		}
+
+		struct BitmapEntry {
+			std::string Name;
+			std::vector<char> Data;
+			BITMAP *Bitmap;
+		};
+		std::vector<BitmapEntry> bitmapEntries;
+
+		// Reading from the archive has to be done in order, but decompressing the entries after can be done in parallel.
+		bool entriesRead = true;
+		for (int result = unzGoToFirstFile(archive); result == UNZ_OK && entriesRead; result = unzGoToNextFile(archive)) {
+			std::array<char, 256> entryName;
+			unz_file_info64 entryInfo;
+			if (unzGetCurrentFileInfo64(archive, &entryInfo, entryName.data(), entryName.size(), nullptr, 0, nullptr, 0) != UNZ_OK) {
+				entriesRead = false;
+			} else if (std::filesystem::path(entryName.data()).extension() == c_BitmapEntryExtension) {
+				BitmapEntry &bitmapEntry = bitmapEntries.emplace_back(BitmapEntry{ entryName.data(), {}, nullptr });
+				entriesRead = ReadCurrentEntry(archive, entryInfo.uncompressed_size, bitmapEntry.Data) && bitmapEntry.Data.size() >= sizeof(BitmapEntryHeader);
+			}
+		}
+		unzClose(archive);
+
+		// The bitmaps are created up front because creating them isn't thread safe, only filling them is.
+		for (BitmapEntry &bitmapEntry : bitmapEntries) {
+			BitmapEntryHeader header;
+			if (entriesRead) {
+				std::memcpy(&header, bitmapEntry.Data.data(), sizeof(header));
+				bool validColorDepth = header.ColorDepth == 8 || header.ColorDepth == 15 || header.ColorDepth == 16 || header.ColorDepth == 24 || header.ColorDepth == 32;
+				entriesRead = header.Signature == c_BitmapEntrySignature && header.Width > 0 && header.Height > 0 && validColorDepth;
+			}
+			if (entriesRead) {
+				bitmapEntry.Bitmap = create_bitmap_ex(header.ColorDepth, header.Width, header.Height);
+				entriesRead = bitmapEntry.Bitmap != nullptr;
+			}
+		}
+
+		if (entriesRead) {
+			std::vector<std::future<bool>> decompressionTasks;
+			decompressionTasks.reserve(bitmapEntries.size());
+			for (BitmapEntry &bitmapEntry : bitmapEntries) {
+				decompressionTasks.emplace_back(g_ThreadMan.GetPriorityThreadPool().submit([&bitmapEntry]() {
+					BITMAP *bitmap = bitmapEntry.Bitmap;
+					int rowSize = bitmap->w * ((bitmap_color_depth(bitmap) + 7) / 8);
+					int pixelDataSize = rowSize * bitmap->h;
+
+					std::vector<char> pixelData(pixelDataSize);
+					int compressedSize = static_cast<int>(bitmapEntry.Data.size() - sizeof(BitmapEntryHeader));
+					if (LZ4_decompress_safe(bitmapEntry.Data.data() + sizeof(BitmapEntryHeader), pixelData.data(), compressedSize, pixelDataSize) != pixelDataSize) {
+						return false;
+					}
+					for (int y = 0; y < bitmap->h; ++y) {
+						std::memcpy(bitmap->line[y], pixelData.data() + y * rowSize, rowSize);
+					}
+					return true;
+				}));
+			}
+			for (std::future<bool> &decompressionTask : decompressionTasks) {
+				entriesRead = decompressionTask.get() && entriesRead;
+			}
+		}
+
+		for (BitmapEntry &bitmapEntry : bitmapEntries) {
+			if (!bitmapEntry.Bitmap) {
+				continue;
+			}
+			if (entriesRead) {
+				ContentFile::AddPreloadedBitmap(GetEntryPath(archivePath, bitmapEntry.Name), bitmapEntry.Bitmap);
+			} else {
+				destroy_bitmap(bitmapEntry.Bitmap);
+			}
+		}
+		return entriesRead;
+	}
+}
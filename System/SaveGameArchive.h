@@ -0,0 +1,132 @@
+#ifndef _RTESAVEGAMEARCHIVE_
+#define _RTESAVEGAMEARCHIVE_
+
+struct BITMAP;
+
+namespace RTE {
+
+	/// <summary>
+	/// A save game written as a single zip archive, holding the save's data file and the bitmaps of its Scene's layers as entries.
+	/// Bitmaps are stored as LZ4 compressed raw pixels instead of PNGs, which is many times faster to write and read back than PNG's deflate, and they can be written from several threads at once.
+	/// </summary>
+	class SaveGameArchive {
+
+	public:
+
+		static const std::string c_FileExtension; //!< The file extension of save game archives.
+		static const std::string c_SaveDataEntryName; //!< The name of the entry holding the save's data file.
+		static const std::string c_BitmapEntryExtension; //!< The file extension of entries holding bitmaps.
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate a SaveGameArchive object in system memory. Create() should be called before using the object.
+		/// </summary>
+		SaveGameArchive() { Clear(); }
+
+		/// <summary>
+		/// Makes the SaveGameArchive object ready for writing entries to.
+		/// The entries are written to a temporary file next to the archive, which only replaces the archive once this SaveGameArchive is destroyed, so an interrupted save can't leave a broken one behind.
+		/// </summary>
+		/// <param name="archivePath">Path to the archive to write.</param>
+		/// <param name="replacedDirectoryPath">Path to a directory the archive supersedes, e.g. a save from before saves were archives, which is removed once the archive is moved into place. Nothing is removed if empty.</param>
+		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
+		int Create(const std::string &archivePath, const std::string &replacedDirectoryPath = "");
+#pragma endregion
+
+#pragma region Destruction
+		/// <summary>
+		/// Destructor method used to clean up a SaveGameArchive object before deletion from system memory.
+		/// </summary>
+		~SaveGameArchive() { Destroy(); }
+
+		/// <summary>
+		/// Finishes writing the archive and moves it into place, replacing any existing archive at its path, then removes the directory it supersedes if there is one.
+		/// </summary>
+		void Destroy();
+#pragma endregion
+
+#pragma region Getters
+		/// <summary>
+		/// Gets the path an entry of this SaveGameArchive is referred to by, e.g. as the data path of the ContentFile of the bitmap it holds.
+		/// </summary>
+		/// <param name="entryName">The name of the entry.</param>
+		/// <returns>The path of the entry.</returns>
+		std::string GetEntryPath(const std::string &entryName) const { return GetEntryPath(m_ArchivePath, entryName); }
+
+		/// <summary>
+		/// Gets the path an entry of a save game archive is referred to by, e.g. as the data path of the ContentFile of the bitmap it holds.
+		/// </summary>
+		/// <param name="archivePath">Path to the archive.</param>
+		/// <param name="entryName">The name of the entry.</param>
+		/// <returns>The path of the entry.</returns>
+		static std::string GetEntryPath(const std::string &archivePath, const std::string &entryName) { return archivePath + "/" + entryName; }
+#pragma endregion
+
+#pragma region Writing
+		/// <summary>
+		/// Compresses a bitmap and writes it to this SaveGameArchive as an entry.
+		/// Can be called from several threads at once. The bitmaps are compressed in parallel, and each entry is written once the archive is free.
+		/// </summary>
+		/// <param name="entryName">The name of the entry to write.</param>
+		/// <param name="bitmap">The bitmap to write. Ownership is NOT transferred!</param>
+		/// <returns>Whether the entry was written successfully.</returns>
+		bool WriteBitmapEntry(const std::string &entryName, const BITMAP *bitmap);
+
+		/// <summary>
+		/// Writes text to this SaveGameArchive as an entry. Can be called from several threads at once.
+		/// </summary>
+		/// <param name="entryName">The name of the entry to write.</param>
+		/// <param name="text">The text to write.</param>
+		/// <returns>Whether the entry was written successfully.</returns>
+		bool WriteTextEntry(const std::string &entryName, const std::string &text);
+#pragma endregion
+
+#pragma region Reading
+		/// <summary>
+		/// Reads a text entry of a save game archive, without extracting anything to disk.
+		/// </summary>
+		/// <param name="archivePath">Path to the archive to read from.</param>
+		/// <param name="entryName">The name of the entry to read.</param>
+		/// <param name="text">String to fill with the entry's text.</param>
+		/// <returns>Whether the entry was found and read successfully.</returns>
+		static bool ReadTextEntry(const std::string &archivePath, const std::string &entryName, std::string &text);
+
+		/// <summary>
+		/// Reads and decompresses all the bitmap entries of a save game archive, without extracting anything to disk, and hands them to ContentFile as preloaded bitmaps under their entry paths.
+		/// The bitmaps are decompressed in parallel on the thread pool.
+		/// </summary>
+		/// <param name="archivePath">Path to the archive to read from.</param>
+		/// <returns>Whether all the bitmap entries were read successfully.</returns>
+		static bool PreloadBitmapEntries(const std::string &archivePath);
+#pragma endregion
+
+	private:
+
+		std::string m_ArchivePath; //!< Path to the archive this SaveGameArchive writes.
+		std::string m_TemporaryArchivePath; //!< Path to the temporary file the entries are written to until the archive is finished.
+		std::string m_ReplacedDirectoryPath; //!< Path to the directory the archive supersedes, removed only once the archive was moved into place so a failed save doesn't lose it.
+		void *m_ZipFile; //!< The zipFile handle of the temporary file, while it's open.
+		std::mutex m_ZipFileMutex; //!< Mutex guarding m_ZipFile, so entries are written one at a time.
+		bool m_WriteFailed; //!< Whether writing any entry failed, in which case the archive is discarded instead of replacing the existing one.
+
+		/// <summary>
+		/// Writes an entry to the temporary file. m_ZipFileMutex must be held.
+		/// </summary>
+		/// <param name="entryName">The name of the entry to write.</param>
+		/// <param name="data">The data to write.</param>
+		/// <param name="dataSize">The size of the data, in bytes.</param>
+		/// <param name="compressionLevel">The deflate compression level to write the entry with, or 0 to store it as is.</param>
+		/// <returns>Whether the entry was written successfully.</returns>
+		bool WriteEntry(const std::string &entryName, const char *data, size_t dataSize, int compressionLevel);
+
+		/// <summary>
+		/// Clears all the member variables of this SaveGameArchive, effectively resetting the members of this abstraction level only.
+		/// </summary>
+		void Clear();
+
+		// Disallow the use of some implicit methods.
+		SaveGameArchive(const SaveGameArchive &reference) = delete;
+		SaveGameArchive & operator=(const SaveGameArchive &rhs) = delete;
+	};
+}
+#endif
@@ -12,11 +12,17 @@ namespace RTE {
 		m_Width = 0;
 		m_Height = 0;
 		m_CellSize = 0;
+		m_SceneWidth = 0;
+		m_SceneHeight = 0;
 		for (int team = Activity::NoTeam; team < Activity::MaxTeamCount; ++team) {
 			m_Cells[team + 1].clear();
 			m_PhysicsCells[team + 1].clear();
 		}
 		m_UsedCellIds.clear();
+		m_OccupancyMasksEnabled = false;
+		m_OccupancyMasks.clear();
+		m_OccupiedCells.clear();
+		m_OccupiedCellIds.clear();
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -25,6 +31,8 @@ namespace RTE {
 		m_Width = width / cellSize;
 		m_Height = height / cellSize;
 		m_CellSize = cellSize;
+		m_SceneWidth = width;
+		m_SceneHeight = height;
 		for (int team = Activity::NoTeam; team < Activity::MaxTeamCount; ++team) {
 			m_Cells[team + 1].resize(m_Width * m_Height);
 			m_PhysicsCells[team + 1].resize(m_Width * m_Height);
@@ -38,9 +46,15 @@ namespace RTE {
 		m_Width = reference.m_Width;
 		m_Height = reference.m_Height;
 		m_CellSize = reference.m_CellSize;
+		m_SceneWidth = reference.m_SceneWidth;
+		m_SceneHeight = reference.m_SceneHeight;
 		m_Cells = reference.m_Cells;
 		m_PhysicsCells = reference.m_PhysicsCells;
 		m_UsedCellIds = reference.m_UsedCellIds;
+		m_OccupancyMasksEnabled = reference.m_OccupancyMasksEnabled;
+		m_OccupancyMasks = reference.m_OccupancyMasks;
+		m_OccupiedCells = reference.m_OccupiedCells;
+		m_OccupiedCellIds = reference.m_OccupiedCellIds;
 		return 0;
 	}
 
@@ -60,6 +74,12 @@ namespace RTE {
 		}
 
 		m_UsedCellIds.clear();
+
+		for (int occupiedCellId : m_OccupiedCellIds) {
+			std::fill_n(m_OccupancyMasks.begin() + (occupiedCellId * m_CellSize), m_CellSize, 0);
+			m_OccupiedCells[occupiedCellId] = 0;
+		}
+		m_OccupiedCellIds.clear();
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -101,8 +121,13 @@ namespace RTE {
 				m_UsedCellIds.insert(GetCellIdForCellCoords(x, y));
 			}
 		}
+
+		if (m_OccupancyMasksEnabled && mo.GetsHitByMOs()) {
+			mo.MarkOccupancy(*this);
+		}
 	}
-	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	std::vector<MovableObject *> SpatialPartitionGrid::GetMOsInBox(const Box &box, int ignoreTeam, bool getsHitByMOsOnly) const {
 		RTEAssert(ignoreTeam >= Activity::NoTeam && ignoreTeam < Activity::MaxTeamCount, "Invalid ignoreTeam given to SpatialPartitioningGrid::GetMOsInBox()!");
@@ -191,6 +216,75 @@ namespace RTE {
 		return cells[ignoreTeam + 1][GetCellIdForCellCoords(cellX, cellY)];
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SpatialPartitionGrid::SetOccupancyMasksEnabled(bool enable) {
+		m_OccupancyMasksEnabled = enable && m_CellSize > 0 && m_CellSize <= 32;
+
+		m_OccupancyMasks.clear();
+		m_OccupiedCells.clear();
+		m_OccupiedCellIds.clear();
+		if (m_OccupancyMasksEnabled) {
+			m_OccupancyMasks.resize(m_Width * m_Height * m_CellSize, 0);
+			m_OccupiedCells.resize(m_Width * m_Height, 0);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SpatialPartitionGrid::MarkOccupiedBox(int left, int top, int right, int bottom) {
+		if (!m_OccupancyMasksEnabled || right < left || bottom < top) {
+			return;
+		}
+		// Anything bigger than the Scene would just wrap over itself, so don't bother walking it more than once.
+		right = std::min(right, left + m_SceneWidth - 1);
+		bottom = std::min(bottom, top + m_SceneHeight - 1);
+
+		// Pixels are mapped to cells the same way GetMOIDsAtPosition and IsPixelOccupied do it, so pixels past the last full cell end up in the first cell of their row or column, same as there.
+		for (int y = top; y <= bottom; ++y) {
+			int wrappedY = y % m_SceneHeight;
+			if (wrappedY < 0) {
+				wrappedY += m_SceneHeight;
+			}
+			int cellY = wrappedY / m_CellSize;
+			int row = wrappedY - (cellY * m_CellSize);
+
+			int x = left;
+			while (x <= right) {
+				int wrappedX = x % m_SceneWidth;
+				if (wrappedX < 0) {
+					wrappedX += m_SceneWidth;
+				}
+				int cellX = wrappedX / m_CellSize;
+				int column = wrappedX - (cellX * m_CellSize);
+
+				// Fill as much of this row of the cell as we can in one go, stopping at the edge of the box, the cell or the Scene.
+				int spanWidth = std::min({ m_CellSize - column, right - x + 1, m_SceneWidth - wrappedX });
+				uint32_t spanBits = spanWidth >= 32 ? 0xFFFFFFFF : ((1U << spanWidth) - 1U);
+
+				int cellId = GetCellIdForCellCoords(cellX, cellY);
+				m_OccupancyMasks[(cellId * m_CellSize) + row] |= spanBits << column;
+				if (!m_OccupiedCells[cellId]) {
+					m_OccupiedCells[cellId] = 1;
+					m_OccupiedCellIds.push_back(cellId);
+				}
+				x += spanWidth;
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool SpatialPartitionGrid::IsPixelOccupied(int x, int y) const {
+		if (!m_OccupancyMasksEnabled) {
+			return true;
+		}
+		int cellX = x / m_CellSize;
+		int cellY = y / m_CellSize;
+		uint32_t rowMask = m_OccupancyMasks[(GetCellIdForCellCoords(cellX, cellY) * m_CellSize) + (y - (cellY * m_CellSize))];
+		return (rowMask >> (x - (cellX * m_CellSize))) & 1U;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	int SpatialPartitionGrid::GetCellIdForCellCoords(int cellX, int cellY) const {
@@ -89,11 +89,44 @@ namespace RTE {
 		const std::vector<int> & GetMOIDsAtPosition(int x, int y, int ignoreTeam, bool getsHitByMOsOnly) const;
 #pragma endregion
 
+#pragma region Occupancy Masks
+		/// <summary>
+		/// Gets whether this SpatialPartitionGrid keeps per-pixel occupancy masks of the MOs that get hit by MOs, alongside its cells.
+		/// </summary>
+		/// <returns>Whether occupancy masks are kept.</returns>
+		bool GetOccupancyMasksEnabled() const { return m_OccupancyMasksEnabled; }
+
+		/// <summary>
+		/// Sets whether this SpatialPartitionGrid keeps per-pixel occupancy masks of the MOs that get hit by MOs. Masks can't be kept if the cells are wider than 32 pixels.
+		/// </summary>
+		/// <param name="enable">Whether to keep occupancy masks.</param>
+		void SetOccupancyMasksEnabled(bool enable);
+
+		/// <summary>
+		/// Marks all the Scene pixels within the given box as occupied in the occupancy masks, automatically accounting for wrapping. Does nothing if occupancy masks aren't enabled.
+		/// </summary>
+		/// <param name="left">The left edge of the box, inclusive.</param>
+		/// <param name="top">The top edge of the box, inclusive.</param>
+		/// <param name="right">The right edge of the box, inclusive.</param>
+		/// <param name="bottom">The bottom edge of the box, inclusive.</param>
+		void MarkOccupiedBox(int left, int top, int right, int bottom);
+
+		/// <summary>
+		/// Gets whether any MO that gets hit by MOs was marked as occupying the given Scene pixel since the last Reset. Always true if occupancy masks aren't enabled.
+		/// </summary>
+		/// <param name="x">The X coordinate to check. Must be wrapped and within the Scene.</param>
+		/// <param name="y">The Y coordinate to check. Must be wrapped and within the Scene.</param>
+		/// <returns>Whether the pixel may be occupied by an MO.</returns>
+		bool IsPixelOccupied(int x, int y) const;
+#pragma endregion
+
 	private:
 
 		int m_Width; //!< The width of the SpatialPartitionGrid, in cells.
 		int m_Height; //!< The height of the SpatialPartitionGrid, in cells.
 		int m_CellSize; //!< The size of each of the SpatialPartitionGrid's cells, in pixels.
+		int m_SceneWidth; //!< The width of the Scene this SpatialPartitionGrid covers, in pixels.
+		int m_SceneHeight; //!< The height of the Scene this SpatialPartitionGrid covers, in pixels.
 
 		// We store a list per team, so overlapping Actors don't waste loads of time collision checking against themselves.
 		// Note that this is this list of MOIDs that are potentially colliding per team, so the list for team 1 contains the MOIDs for team 2, 3, 4, and no-team, as well as anything for team 1 that doesn't ignore team hits.
@@ -102,6 +135,13 @@ namespace RTE {
 
 		tsl::hopscotch_set<int> m_UsedCellIds; //!< Set of used cell Ids, maintained to avoid wasting time looping through and clearing unused cells.
 
+		// Occupancy masks let most pixel queries that land in a cell with MOs in it, but not on any of them, be answered without hit testing every MO in the cell.
+		// They aren't split per team, so they only ever tell whether a pixel is definitely empty.
+		bool m_OccupancyMasksEnabled; //!< Whether occupancy masks are kept.
+		std::vector<uint32_t> m_OccupancyMasks; //!< One bitmask per pixel row of each cell, indexed by (cell Id * cell size) + row. Bit N is set if the pixel in column N of the row is occupied by an MO that gets hit by MOs.
+		std::vector<unsigned char> m_OccupiedCells; //!< Whether each cell has any bits set in its occupancy mask.
+		std::vector<int> m_OccupiedCellIds; //!< The Ids of all cells with bits set in their occupancy masks, maintained to avoid wasting time clearing unused masks.
+
 		/// <summary>
 		/// Gets the Id of the cell at the given SpatialPartitionGrid coordinates, automatically accounting for wrapping.
 		/// </summary>
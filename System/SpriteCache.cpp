@@ -0,0 +1,249 @@
+#include "SpriteCache.h"
+#include "ReaderCache.h"
+#include "System.h"
+#include "RTETools.h"
+
+#include "allegro.h"
+
+namespace RTE {
+
+	const std::string SpriteCache::c_CacheFileName = "Cache/Sprites.cache";
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SpriteCache::Clear() {
+		m_CacheFilePath.clear();
+		m_CachedSprites.clear();
+		m_CacheChanged = false;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int SpriteCache::Create() {
+		m_CacheFilePath = System::GetWorkingDirectory() + System::GetUserdataDirectory() + c_CacheFileName;
+
+		if (m_CacheFile.Create(m_CacheFilePath) < 0) {
+			// No cache yet, it'll be written once the sprites are loaded.
+			m_CacheChanged = true;
+			return 0;
+		}
+		const char *cacheData = m_CacheFile.GetCursor();
+		size_t cacheSize = static_cast<size_t>(m_CacheFile.GetEnd() - cacheData);
+
+		size_t readPos = 0;
+		auto readBytes = [cacheData, cacheSize, &readPos](void *destination, size_t byteCount) {
+			if (cacheSize - readPos < byteCount) {
+				return false;
+			}
+			std::memcpy(destination, cacheData + readPos, byteCount);
+			readPos += byteCount;
+			return true;
+		};
+		auto readString = [cacheData, cacheSize, &readPos, &readBytes](std::string &destination) {
+			uint32_t stringLength = 0;
+			if (!readBytes(&stringLength, sizeof(stringLength)) || cacheSize - readPos < stringLength) {
+				return false;
+			}
+			destination.assign(cacheData + readPos, stringLength);
+			readPos += stringLength;
+			return true;
+		};
+
+		uint32_t signature = 0;
+		uint32_t formatVersion = 0;
+		uint32_t spriteCount = 0;
+		bool cacheValid = readBytes(&signature, sizeof(signature)) && readBytes(&formatVersion, sizeof(formatVersion)) && readBytes(&spriteCount, sizeof(spriteCount));
+		cacheValid = cacheValid && signature == c_CacheFileSignature && formatVersion == c_CacheFormatVersion;
+
+		for (uint32_t spriteIndex = 0; cacheValid && spriteIndex < spriteCount; ++spriteIndex) {
+			std::string dataPath;
+			CachedSprite cachedSprite;
+			uint64_t pixelDataOffset = 0;
+			cacheValid = readString(dataPath) && readBytes(&cachedSprite.ConversionMode, sizeof(cachedSprite.ConversionMode)) && readBytes(&cachedSprite.LoadColorDepth, sizeof(cachedSprite.LoadColorDepth)) &&
+				readBytes(&cachedSprite.PaletteHash, sizeof(cachedSprite.PaletteHash)) && readBytes(&cachedSprite.ModificationTime, sizeof(cachedSprite.ModificationTime)) && readBytes(&cachedSprite.FileSize, sizeof(cachedSprite.FileSize)) &&
+				readBytes(&cachedSprite.Width, sizeof(cachedSprite.Width)) && readBytes(&cachedSprite.Height, sizeof(cachedSprite.Height)) && readBytes(&cachedSprite.ColorDepth, sizeof(cachedSprite.ColorDepth)) &&
+				readBytes(&pixelDataOffset, sizeof(pixelDataOffset));
+
+			// The pixels are checked to be within the file before anything points into it.
+			cacheValid = cacheValid && cachedSprite.Width > 0 && cachedSprite.Height > 0 && static_cast<int64_t>(cachedSprite.Width) * cachedSprite.Height <= c_MaxCachedSpriteArea && cachedSprite.ColorDepth >= 8 && cachedSprite.ColorDepth <= 32;
+			cacheValid = cacheValid && pixelDataOffset <= cacheSize && GetRowSize(cachedSprite.Width, cachedSprite.ColorDepth) * cachedSprite.Height <= cacheSize - pixelDataOffset;
+			if (cacheValid) {
+				cachedSprite.Pixels = reinterpret_cast<const unsigned char *>(cacheData + pixelDataOffset);
+				cachedSprite.Used = false;
+				m_CachedSprites[dataPath].emplace_back(std::move(cachedSprite));
+			}
+		}
+		if (!cacheValid) {
+			// Stale format or a truncated write, throw it all away and rebuild it from the image files.
+			m_CachedSprites.clear();
+			m_CacheFile.Destroy();
+			m_CacheChanged = true;
+		}
+		return 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	BITMAP * SpriteCache::CreateBitmap(const std::string &dataPath, int conversionMode) {
+		auto cachedSpritesEntry = m_CachedSprites.find(dataPath);
+		if (cachedSpritesEntry == m_CachedSprites.end()) {
+			return nullptr;
+		}
+		std::vector<CachedSprite> &cachedSprites = cachedSpritesEntry->second;
+		int loadColorDepth = get_color_depth();
+		auto cachedSprite = std::find_if(cachedSprites.begin(), cachedSprites.end(), [conversionMode, loadColorDepth](const CachedSprite &sprite) { return sprite.ConversionMode == conversionMode && sprite.LoadColorDepth == loadColorDepth; });
+		if (cachedSprite == cachedSprites.end()) {
+			return nullptr;
+		}
+
+		long long modificationTime = 0;
+		uintmax_t fileSize = 0;
+		if (cachedSprite->PaletteHash != GetCurrentPaletteHash() || !ReaderCache::GetFileStamp(dataPath, modificationTime, fileSize) || cachedSprite->ModificationTime != modificationTime || cachedSprite->FileSize != fileSize) {
+			// The palette or the image changed since, so drop the stale sprite. The freshly loaded one is added in its place.
+			cachedSprites.erase(cachedSprite);
+			m_CacheChanged = true;
+			return nullptr;
+		}
+		BITMAP *bitmap = create_bitmap_ex(cachedSprite->ColorDepth, cachedSprite->Width, cachedSprite->Height);
+		if (!bitmap) {
+			return nullptr;
+		}
+		size_t rowSize = GetRowSize(cachedSprite->Width, cachedSprite->ColorDepth);
+		for (int y = 0; y < cachedSprite->Height; ++y) {
+			std::memcpy(bitmap->line[y], cachedSprite->Pixels + y * rowSize, rowSize);
+		}
+		cachedSprite->Used = true;
+		return bitmap;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SpriteCache::AddBitmap(const std::string &dataPath, int conversionMode, const BITMAP *bitmap) {
+		if (!bitmap || !is_memory_bitmap(const_cast<BITMAP *>(bitmap)) || bitmap->w * bitmap->h > c_MaxCachedSpriteArea || dataPath.starts_with(System::GetUserdataDirectory())) {
+			return;
+		}
+		CachedSprite cachedSprite;
+		if (!ReaderCache::GetFileStamp(dataPath, cachedSprite.ModificationTime, cachedSprite.FileSize)) {
+			return;
+		}
+		cachedSprite.ConversionMode = conversionMode;
+		cachedSprite.LoadColorDepth = get_color_depth();
+		cachedSprite.PaletteHash = GetCurrentPaletteHash();
+		cachedSprite.Width = bitmap->w;
+		cachedSprite.Height = bitmap->h;
+		cachedSprite.ColorDepth = bitmap_color_depth(const_cast<BITMAP *>(bitmap));
+
+		size_t rowSize = GetRowSize(cachedSprite.Width, cachedSprite.ColorDepth);
+		cachedSprite.AddedPixels.resize(rowSize * cachedSprite.Height);
+		for (int y = 0; y < cachedSprite.Height; ++y) {
+			std::memcpy(cachedSprite.AddedPixels.data() + y * rowSize, bitmap->line[y], rowSize);
+		}
+		cachedSprite.Pixels = cachedSprite.AddedPixels.data();
+		cachedSprite.Used = true;
+
+		std::vector<CachedSprite> &cachedSprites = m_CachedSprites[dataPath];
+		std::erase_if(cachedSprites, [&cachedSprite](const CachedSprite &sprite) { return sprite.ConversionMode == cachedSprite.ConversionMode && sprite.LoadColorDepth == cachedSprite.LoadColorDepth; });
+		cachedSprites.emplace_back(std::move(cachedSprite));
+		m_CacheChanged = true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool SpriteCache::Save() {
+		for (auto cachedSpritesEntry = m_CachedSprites.begin(); cachedSpritesEntry != m_CachedSprites.end();) {
+			const std::string &dataPath = cachedSpritesEntry->first;
+			size_t droppedSpriteCount = std::erase_if(cachedSpritesEntry->second, [&dataPath](const CachedSprite &cachedSprite) {
+				long long modificationTime = 0;
+				uintmax_t fileSize = 0;
+				return !cachedSprite.Used && (!ReaderCache::GetFileStamp(dataPath, modificationTime, fileSize) || cachedSprite.ModificationTime != modificationTime || cachedSprite.FileSize != fileSize);
+			});
+			if (droppedSpriteCount > 0) { m_CacheChanged = true; }
+			cachedSpritesEntry = cachedSpritesEntry->second.empty() ? m_CachedSprites.erase(cachedSpritesEntry) : std::next(cachedSpritesEntry);
+		}
+		if (!m_CacheChanged || m_CacheFilePath.empty()) {
+			return true;
+		}
+		const std::string cacheDirectory = std::filesystem::path(m_CacheFilePath).parent_path().generic_string();
+		if (!std::filesystem::exists(cacheDirectory)) { System::MakeDirectory(cacheDirectory); }
+
+		// Write to a temporary file first so a crash mid-write can't leave a truncated cache that looks valid.
+		const std::string tempCacheFilePath = m_CacheFilePath + ".tmp";
+		std::ofstream cacheFile(tempCacheFilePath, std::ios::binary | std::ios::trunc);
+		if (!cacheFile.good()) {
+			return false;
+		}
+		auto writeBytes = [&cacheFile](const void *source, size_t byteCount) { cacheFile.write(static_cast<const char *>(source), static_cast<std::streamsize>(byteCount)); };
+		auto writeString = [&writeBytes](const std::string &source) {
+			uint32_t stringLength = static_cast<uint32_t>(source.size());
+			writeBytes(&stringLength, sizeof(stringLength));
+			writeBytes(source.data(), source.size());
+		};
+		auto alignPixelDataOffset = [](uint64_t offset) { return (offset + c_PixelDataAlignment - 1) / c_PixelDataAlignment * c_PixelDataAlignment; };
+
+		// The index is written in full before the pixels, so the pixels' offsets need working out up front.
+		uint32_t spriteCount = 0;
+		uint64_t indexSize = sizeof(c_CacheFileSignature) + sizeof(c_CacheFormatVersion) + sizeof(spriteCount);
+		for (const auto &[dataPath, cachedSprites] : m_CachedSprites) {
+			spriteCount += static_cast<uint32_t>(cachedSprites.size());
+			indexSize += cachedSprites.size() * (sizeof(uint32_t) + dataPath.size() + sizeof(CachedSprite::ConversionMode) + sizeof(CachedSprite::LoadColorDepth) + sizeof(CachedSprite::PaletteHash) + sizeof(CachedSprite::ModificationTime) +
+				sizeof(CachedSprite::FileSize) + sizeof(CachedSprite::Width) + sizeof(CachedSprite::Height) + sizeof(CachedSprite::ColorDepth) + sizeof(uint64_t));
+		}
+
+		writeBytes(&c_CacheFileSignature, sizeof(c_CacheFileSignature));
+		writeBytes(&c_CacheFormatVersion, sizeof(c_CacheFormatVersion));
+		writeBytes(&spriteCount, sizeof(spriteCount));
+		uint64_t pixelDataOffset = alignPixelDataOffset(indexSize);
+		for (const auto &[dataPath, cachedSprites] : m_CachedSprites) {
+			for (const CachedSprite &cachedSprite : cachedSprites) {
+				writeString(dataPath);
+				writeBytes(&cachedSprite.ConversionMode, sizeof(cachedSprite.ConversionMode));
+				writeBytes(&cachedSprite.LoadColorDepth, sizeof(cachedSprite.LoadColorDepth));
+				writeBytes(&cachedSprite.PaletteHash, sizeof(cachedSprite.PaletteHash));
+				writeBytes(&cachedSprite.ModificationTime, sizeof(cachedSprite.ModificationTime));
+				writeBytes(&cachedSprite.FileSize, sizeof(cachedSprite.FileSize));
+				writeBytes(&cachedSprite.Width, sizeof(cachedSprite.Width));
+				writeBytes(&cachedSprite.Height, sizeof(cachedSprite.Height));
+				writeBytes(&cachedSprite.ColorDepth, sizeof(cachedSprite.ColorDepth));
+				writeBytes(&pixelDataOffset, sizeof(pixelDataOffset));
+				pixelDataOffset = alignPixelDataOffset(pixelDataOffset + GetRowSize(cachedSprite.Width, cachedSprite.ColorDepth) * cachedSprite.Height);
+			}
+		}
+
+		const std::array<char, c_PixelDataAlignment> padding = {};
+		uint64_t writePos = indexSize;
+		for (const auto &[dataPath, cachedSprites] : m_CachedSprites) {
+			for (const CachedSprite &cachedSprite : cachedSprites) {
+				writeBytes(padding.data(), static_cast<size_t>(alignPixelDataOffset(writePos) - writePos));
+				size_t pixelDataSize = GetRowSize(cachedSprite.Width, cachedSprite.ColorDepth) * cachedSprite.Height;
+				writeBytes(cachedSprite.Pixels, pixelDataSize);
+				writePos = alignPixelDataOffset(writePos) + pixelDataSize;
+			}
+		}
+		cacheFile.close();
+
+		std::error_code errorCode;
+		if (cacheFile.fail()) {
+			std::filesystem::remove(tempCacheFilePath, errorCode);
+			return false;
+		}
+		// The old cache file has to be unmapped before it can be replaced. Everything in it was just written to the new one, which is mapped in its place.
+		m_CacheFile.Destroy();
+		std::filesystem::rename(tempCacheFilePath, m_CacheFilePath, errorCode);
+		Clear();
+		Create();
+		return !errorCode;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	uint64_t SpriteCache::GetCurrentPaletteHash() {
+		PALETTE palette;
+		get_palette(palette);
+		std::string paletteColors;
+		paletteColors.reserve(PAL_SIZE * 3);
+		for (const RGB &color : palette) {
+			paletteColors.append({ static_cast<char>(color.r), static_cast<char>(color.g), static_cast<char>(color.b) });
+		}
+		return Hash(paletteColors);
+	}
+}
@@ -0,0 +1,129 @@
+#ifndef _RTESPRITECACHE_
+#define _RTESPRITECACHE_
+
+#include "ReaderStream.h"
+
+struct BITMAP;
+
+namespace RTE {
+
+	/// <summary>
+	/// A versioned binary cache of the sprites loaded from image files, already decoded and converted to the color depth they were loaded at, so the next launch can copy each sprite straight out of one memory-mapped file instead of decoding its image file again.
+	/// The pixels of all the sprites are packed back to back after an index, and each sprite is keyed on its path, the color conversion and palette it was loaded with and its image file's size and modification time, so any image that changed since is transparently decoded again and the cache rewritten.
+	/// </summary>
+	class SpriteCache {
+
+	public:
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate a SpriteCache object in system memory. Create() should be called before using the object.
+		/// </summary>
+		SpriteCache() { Clear(); }
+
+		/// <summary>
+		/// Makes the SpriteCache object ready for use, mapping the cache file into memory if there is a valid one.
+		/// </summary>
+		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
+		int Create();
+#pragma endregion
+
+#pragma region Destruction
+		/// <summary>
+		/// Destructor method used to clean up a SpriteCache object before deletion from system memory.
+		/// </summary>
+		~SpriteCache() { Destroy(); }
+
+		/// <summary>
+		/// Unmaps the cache file and drops all the sprites added since it was mapped, without saving them.
+		/// </summary>
+		void Destroy() { m_CacheFile.Destroy(); Clear(); }
+#pragma endregion
+
+#pragma region Concrete Methods
+		/// <summary>
+		/// Gets whether a sprite is cached for a data path, in any color conversion. Doesn't check whether the image file changed since.
+		/// </summary>
+		/// <param name="dataPath">The data path of the sprite.</param>
+		/// <returns>Whether a sprite is cached for the data path.</returns>
+		bool HasSprite(const std::string &dataPath) const { return m_CachedSprites.contains(dataPath); }
+
+		/// <summary>
+		/// Creates a BITMAP from the cached sprite of a data path, if it was cached with the same color conversion and palette and its image file didn't change since. Ownership of the BITMAP IS transferred!
+		/// </summary>
+		/// <param name="dataPath">The data path of the sprite.</param>
+		/// <param name="conversionMode">The Allegro color conversion mode the sprite is being loaded with.</param>
+		/// <returns>Pointer to the new BITMAP, or nullptr if the sprite isn't cached and needs to be loaded from its image file.</returns>
+		BITMAP * CreateBitmap(const std::string &dataPath, int conversionMode);
+
+		/// <summary>
+		/// Adds a sprite that was loaded from its image file to this SpriteCache. Sprites from userdata and very large images aren't cached.
+		/// </summary>
+		/// <param name="dataPath">The data path of the sprite.</param>
+		/// <param name="conversionMode">The Allegro color conversion mode the sprite was loaded with.</param>
+		/// <param name="bitmap">The loaded BITMAP. Its pixels are copied. Ownership is NOT transferred!</param>
+		void AddBitmap(const std::string &dataPath, int conversionMode, const BITMAP *bitmap);
+
+		/// <summary>
+		/// Writes this SpriteCache to its cache file if any sprite was added or dropped, then maps the new cache file.
+		/// Sprites that weren't loaded since the cache file was mapped are kept as long as their image files didn't change, as many sprites are only loaded once they're needed during play.
+		/// </summary>
+		/// <returns>Whether the cache file is up to date.</returns>
+		bool Save();
+#pragma endregion
+
+	private:
+
+		/// <summary>
+		/// A sprite's decoded pixels along with what they were loaded from.
+		/// </summary>
+		struct CachedSprite {
+			int ConversionMode; //!< The Allegro color conversion mode the sprite was loaded with.
+			int LoadColorDepth; //!< The color depth Allegro was set to when the sprite was loaded, which the conversion depends on as well.
+			uint64_t PaletteHash; //!< Hash of the palette that was set when the sprite was loaded, as converting to or from 8 bit colors maps them through it.
+			long long ModificationTime; //!< The modification time of the image file when the sprite was loaded, in file clock ticks.
+			uintmax_t FileSize; //!< The size of the image file when the sprite was loaded, in bytes.
+			int Width; //!< Width of the sprite, in pixels.
+			int Height; //!< Height of the sprite, in pixels.
+			int ColorDepth; //!< Color depth of the sprite, in bits per pixel.
+			const unsigned char *Pixels; //!< The sprite's pixels, row after row, either in the mapped cache file or in AddedPixels.
+			std::vector<unsigned char> AddedPixels; //!< The sprite's pixels if it was added since the cache file was mapped, otherwise empty.
+			bool Used; //!< Whether this sprite was loaded or added since the cache file was mapped.
+		};
+
+		static constexpr uint32_t c_CacheFileSignature = 0x53455452; //!< Signature at the start of every cache file, "RTES" in little-endian.
+		static constexpr uint32_t c_CacheFormatVersion = 2; //!< Version of the cache file layout. Cache files with any other version are discarded.
+		static constexpr size_t c_PixelDataAlignment = 64; //!< Alignment of each sprite's pixels in the cache file, in bytes, so copying them out starts on a cache line.
+		static constexpr int c_MaxCachedSpriteArea = 1024 * 1024; //!< The largest sprite that is cached, in pixels. Anything larger is a scene layer or background, which is loaded rarely enough that it isn't worth the disk space.
+		static const std::string c_CacheFileName; //!< The name of the cache file, inside the cache folder in the userdata directory.
+
+		std::string m_CacheFilePath; //!< Path to the cache file.
+		ReaderStream m_CacheFile; //!< The mapped cache file.
+		std::unordered_map<std::string, std::vector<CachedSprite>> m_CachedSprites; //!< The cached sprites, mapped by their data paths. Each data path can have a sprite for every color conversion it was loaded with.
+		bool m_CacheChanged; //!< Whether any sprite was added or dropped since the cache file was mapped, meaning it needs to be written again.
+
+		/// <summary>
+		/// Gets the size of each row of a sprite's pixels.
+		/// </summary>
+		/// <param name="width">Width of the sprite, in pixels.</param>
+		/// <param name="colorDepth">Color depth of the sprite, in bits per pixel.</param>
+		/// <returns>The size of each row, in bytes.</returns>
+		static size_t GetRowSize(int width, int colorDepth) { return static_cast<size_t>(width) * static_cast<size_t>((colorDepth + 7) / 8); }
+
+		/// <summary>
+		/// Gets a hash of the palette that is currently set, so sprites loaded with a different one aren't used.
+		/// </summary>
+		/// <returns>The hash of the current palette.</returns>
+		static uint64_t GetCurrentPaletteHash();
+
+		/// <summary>
+		/// Clears all the member variables of this SpriteCache, effectively resetting the members of this abstraction level only.
+		/// </summary>
+		void Clear();
+
+		// Disallow the use of some implicit methods.
+		SpriteCache(const SpriteCache &reference) = delete;
+		SpriteCache & operator=(const SpriteCache &rhs) = delete;
+	};
+}
+#endif
@@ -55,6 +55,7 @@
 #include <functional>
 #include <thread>
 #include <mutex>
+#include <shared_mutex>
 #include <cctype>
 #include <string>
 #include <cstring>
@@ -80,6 +81,8 @@
 #include <limits>
 #include <random>
 #include <array>
+#include <bitset>
+#include <span>
 #include <filesystem>
 #include <atomic>
 #include <execution>
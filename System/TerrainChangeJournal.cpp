@@ -0,0 +1,122 @@
+#include "TerrainChangeJournal.h"
+
+namespace RTE {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void TerrainChangeJournal::Clear() {
+		m_SceneWidth = 0;
+		m_SceneHeight = 0;
+		m_TileCountX = 0;
+		m_TileCountY = 0;
+		for (int layer = 0; layer < 2; ++layer) {
+			m_TileRects[layer].clear();
+			m_DirtyTiles[layer].clear();
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void TerrainChangeJournal::Create(int sceneWidth, int sceneHeight) {
+		Clear();
+		m_SceneWidth = std::max(sceneWidth, 0);
+		m_SceneHeight = std::max(sceneHeight, 0);
+		m_TileCountX = (m_SceneWidth + c_TileSize - 1) / c_TileSize;
+		m_TileCountY = (m_SceneHeight + c_TileSize - 1) / c_TileSize;
+		for (int layer = 0; layer < 2; ++layer) {
+			m_TileRects[layer].assign(m_TileCountX * m_TileCountY, DirtyRect());
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void TerrainChangeJournal::MarkChanged(int x, int y, int w, int h, bool back) {
+		int left = std::max(x, 0);
+		int top = std::max(y, 0);
+		int right = std::min(x + w, m_SceneWidth) - 1;
+		int bottom = std::min(y + h, m_SceneHeight) - 1;
+		if (left > right || top > bottom) {
+			return;
+		}
+		std::vector<DirtyRect> &tileRects = m_TileRects[back ? 1 : 0];
+		std::vector<int> &dirtyTiles = m_DirtyTiles[back ? 1 : 0];
+
+		for (int tileY = top / c_TileSize; tileY <= bottom / c_TileSize; ++tileY) {
+			int tileTop = tileY * c_TileSize;
+			unsigned char rectTop = static_cast<unsigned char>(std::max(top - tileTop, 0));
+			unsigned char rectBottom = static_cast<unsigned char>(std::min(bottom - tileTop, c_TileSize - 1));
+
+			for (int tileX = left / c_TileSize; tileX <= right / c_TileSize; ++tileX) {
+				int tileLeft = tileX * c_TileSize;
+				unsigned char rectLeft = static_cast<unsigned char>(std::max(left - tileLeft, 0));
+				unsigned char rectRight = static_cast<unsigned char>(std::min(right - tileLeft, c_TileSize - 1));
+
+				int tileIndex = tileY * m_TileCountX + tileX;
+				DirtyRect &tileRect = tileRects[tileIndex];
+				if (!tileRect.IsDirty) {
+					tileRect = { rectLeft, rectTop, rectRight, rectBottom, true };
+					dirtyTiles.push_back(tileIndex);
+				} else {
+					tileRect.Left = std::min(tileRect.Left, rectLeft);
+					tileRect.Top = std::min(tileRect.Top, rectTop);
+					tileRect.Right = std::max(tileRect.Right, rectRight);
+					tileRect.Bottom = std::max(tileRect.Bottom, rectBottom);
+				}
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void TerrainChangeJournal::TakeChangedAreas(std::vector<ChangedArea> &changedAreas, int maxAreaSize) {
+		changedAreas.clear();
+		for (int layer = 0; layer < 2; ++layer) {
+			std::vector<DirtyRect> &tileRects = m_TileRects[layer];
+			std::vector<int> &dirtyTiles = m_DirtyTiles[layer];
+			// Sorting the tile indices puts neighbouring tiles of the same row next to each other.
+			std::sort(dirtyTiles.begin(), dirtyTiles.end());
+
+			bool hasOpenArea = false;
+			ChangedArea openArea = {};
+			int openAreaLastTile = -1;
+			for (int tileIndex : dirtyTiles) {
+				DirtyRect &tileRect = tileRects[tileIndex];
+				int tileLeft = (tileIndex % m_TileCountX) * c_TileSize;
+				int tileTop = (tileIndex / m_TileCountX) * c_TileSize;
+				ChangedArea tileArea = { tileLeft + tileRect.Left, tileTop + tileRect.Top, tileRect.Right - tileRect.Left + 1, tileRect.Bottom - tileRect.Top + 1, layer == 1 };
+				tileRect.IsDirty = false;
+
+				// Only merge with the open area if the two actually touch across the tile edge, otherwise the merged area would needlessly cover unchanged pixels in between.
+				if (hasOpenArea && tileIndex == openAreaLastTile + 1 && tileIndex % m_TileCountX != 0 && openArea.X + openArea.W == tileLeft && tileRect.Left == 0) {
+					int mergedTop = std::min(openArea.Y, tileArea.Y);
+					int mergedBottom = std::max(openArea.Y + openArea.H, tileArea.Y + tileArea.H);
+					int mergedWidth = tileArea.X + tileArea.W - openArea.X;
+					if (mergedWidth * (mergedBottom - mergedTop) <= maxAreaSize) {
+						openArea.Y = mergedTop;
+						openArea.W = mergedWidth;
+						openArea.H = mergedBottom - mergedTop;
+						openAreaLastTile = tileIndex;
+						continue;
+					}
+				}
+				if (hasOpenArea) { changedAreas.push_back(openArea); }
+				openArea = tileArea;
+				openAreaLastTile = tileIndex;
+				hasOpenArea = true;
+			}
+			if (hasOpenArea) { changedAreas.push_back(openArea); }
+			dirtyTiles.clear();
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void TerrainChangeJournal::Reset() {
+		for (int layer = 0; layer < 2; ++layer) {
+			for (int tileIndex : m_DirtyTiles[layer]) {
+				m_TileRects[layer][tileIndex].IsDirty = false;
+			}
+			m_DirtyTiles[layer].clear();
+		}
+	}
+}
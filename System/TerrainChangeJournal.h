@@ -0,0 +1,117 @@
+#ifndef _RTETERRAINCHANGEJOURNAL_
+#define _RTETERRAINCHANGEJOURNAL_
+
+namespace RTE {
+
+	/// <summary>
+	/// A record of which parts of the terrain changed since it was last taken, kept as a dirty rectangle per fixed-size tile of each terrain layer.
+	/// Any number of edits to the same tile collapse into one rectangle, so a burst of single pixel changes costs no more to replicate than one bigger change covering them.
+	/// </summary>
+	class TerrainChangeJournal {
+
+	public:
+
+		/// <summary>
+		/// A changed area of one terrain layer, in Scene pixels.
+		/// </summary>
+		struct ChangedArea {
+			int X; //!< X position of the left edge of the area.
+			int Y; //!< Y position of the top edge of the area.
+			int W; //!< Width of the area.
+			int H; //!< Height of the area.
+			bool Back; //!< Whether the area is on the background layer rather than the foreground one.
+		};
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate a TerrainChangeJournal object in system memory. Create() should be called before using the object.
+		/// </summary>
+		TerrainChangeJournal() { Clear(); }
+
+		/// <summary>
+		/// Makes the TerrainChangeJournal object ready for use, covering a Scene of the given dimensions with nothing marked as changed.
+		/// </summary>
+		/// <param name="sceneWidth">The width of the Scene, in pixels.</param>
+		/// <param name="sceneHeight">The height of the Scene, in pixels.</param>
+		void Create(int sceneWidth, int sceneHeight);
+#pragma endregion
+
+#pragma region Getters
+		/// <summary>
+		/// Gets the width of the Scene this TerrainChangeJournal was created for.
+		/// </summary>
+		/// <returns>The width of the Scene, in pixels.</returns>
+		int GetSceneWidth() const { return m_SceneWidth; }
+
+		/// <summary>
+		/// Gets the height of the Scene this TerrainChangeJournal was created for.
+		/// </summary>
+		/// <returns>The height of the Scene, in pixels.</returns>
+		int GetSceneHeight() const { return m_SceneHeight; }
+
+		/// <summary>
+		/// Gets whether anything was marked as changed since the changes were last taken.
+		/// </summary>
+		/// <returns>Whether there are no changes to take.</returns>
+		bool IsEmpty() const { return m_DirtyTiles[0].empty() && m_DirtyTiles[1].empty(); }
+#pragma endregion
+
+#pragma region Concrete Methods
+		/// <summary>
+		/// Marks an area of one terrain layer as changed. Parts of it outside the Scene are ignored.
+		/// </summary>
+		/// <param name="x">X position of the left edge of the area.</param>
+		/// <param name="y">Y position of the top edge of the area.</param>
+		/// <param name="w">Width of the area.</param>
+		/// <param name="h">Height of the area.</param>
+		/// <param name="back">Whether the area is on the background layer rather than the foreground one.</param>
+		void MarkChanged(int x, int y, int w, int h, bool back);
+
+		/// <summary>
+		/// Takes all the changes marked since they were last taken, leaving this TerrainChangeJournal empty.
+		/// The changed areas of horizontally neighbouring tiles are merged into one where they meet, as long as the merged area isn't bigger than the given limit.
+		/// </summary>
+		/// <param name="changedAreas">The vector to fill with the changed areas, ordered by layer, then by row and column. It's cleared first.</param>
+		/// <param name="maxAreaSize">The maximum number of pixels a merged area can have. Areas of single tiles are never bigger than c_TileSize squared regardless.</param>
+		void TakeChangedAreas(std::vector<ChangedArea> &changedAreas, int maxAreaSize);
+
+		/// <summary>
+		/// Discards all the changes marked since they were last taken.
+		/// </summary>
+		void Reset();
+#pragma endregion
+
+	private:
+
+		/// <summary>
+		/// The changed part of one tile, in pixels relative to the tile's top left corner. All bounds are inclusive.
+		/// </summary>
+		struct DirtyRect {
+			unsigned char Left; //!< The leftmost changed column.
+			unsigned char Top; //!< The topmost changed row.
+			unsigned char Right; //!< The rightmost changed column.
+			unsigned char Bottom; //!< The bottommost changed row.
+			bool IsDirty; //!< Whether anything in the tile changed at all. The bounds are meaningless otherwise.
+		};
+
+		static constexpr int c_TileSize = 32; //!< The width and height of each tile, in pixels.
+
+		int m_SceneWidth; //!< The width of the Scene this TerrainChangeJournal was created for, in pixels.
+		int m_SceneHeight; //!< The height of the Scene this TerrainChangeJournal was created for, in pixels.
+		int m_TileCountX; //!< The number of tile columns covering the Scene.
+		int m_TileCountY; //!< The number of tile rows covering the Scene.
+
+		std::array<std::vector<DirtyRect>, 2> m_TileRects; //!< The changed part of every tile, for the foreground and background layers respectively.
+		std::array<std::vector<int>, 2> m_DirtyTiles; //!< The indices of the tiles that have changed, in the order they were first marked, for the foreground and background layers respectively.
+
+		/// <summary>
+		/// Clears all the member variables of this TerrainChangeJournal, effectively resetting the members of this abstraction level only.
+		/// </summary>
+		void Clear();
+
+		// Disallow the use of some implicit methods.
+		TerrainChangeJournal(const TerrainChangeJournal &reference) = delete;
+		TerrainChangeJournal & operator=(const TerrainChangeJournal &rhs) = delete;
+	};
+}
+#endif